@@ -33,6 +33,7 @@
 #define OT_DHT @DHT_EXPORT@
 #define OT_SCRIPT_CHAI @SCRIPT_CHAI_EXPORT@
 #define OT_STORAGE_FS @FS_EXPORT@
+#define OT_STORAGE_LMDB @LMDB_EXPORT@
 #define OT_STORAGE_SQLITE @SQLITE_EXPORT@
 
 #endif // OPENTXS_CORE_VERSION_HPP
@@ -515,6 +515,23 @@ enum class SendResult : std::int8_t {
     VALID_REPLY = 2,
 };
 
+// Envelope used for Message objects exchanged between clients and notaries.
+// Armored requests and replies consist of a single frame containing the
+// compressed, base64 encoded contract. Raw requests and replies consist of two
+// frames: a one byte frame containing MessageFormat::Raw followed by the
+// serialized contract. The notary always replies using the format of the
+// request.
+//
+// A notary which answers the raw format probe with an extra frame containing
+// MessageFormat::Notification also sends box updates, unrequested, on the same
+// connection: MessageFormat::Notification, nym ID, box type ("nymbox" or
+// "inbox"), account ID and the new box hash.
+enum class MessageFormat : std::uint8_t {
+    Armored = 0,
+    Raw = 1,
+    Notification = 2,
+};
+
 enum class ConnectionState : std::uint8_t {
     NOT_ESTABLISHED = 0,
     ACTIVE = 1,
@@ -624,6 +641,8 @@ enum class MessageType : std::uint8_t {
     requestAdminResponse = 58,
     addClaim = 59,
     addClaimResponse = 60,
+    getBoxReceipts = 61,
+    getBoxReceiptsResponse = 62,
 };
 
 enum class ThreadStatus : std::uint8_t {
@@ -24,6 +24,12 @@ class Endpoints
 {
 public:
     EXPORT virtual std::string AccountUpdate() const = 0;
+    /** Nymbox and inbox saves
+     *
+     *  Frames: box type (ledgerType), notary ID, account ID, new box hash.
+     *  The account ID of a nymbox is the nym ID.
+     */
+    EXPORT virtual std::string BoxUpdate() const = 0;
     EXPORT virtual std::string ConnectionStatus() const = 0;
     EXPORT virtual std::string ContactUpdate() const = 0;
     EXPORT virtual std::string DhtRequestNym() const = 0;
@@ -33,6 +39,12 @@ public:
     EXPORT virtual std::string NymDownload() const = 0;
     EXPORT virtual std::string PairEvent() const = 0;
     EXPORT virtual std::string PendingBailment() const = 0;
+    /** Box changes announced by connected notaries
+     *
+     *  Frames: notary ID, nym ID, box type ("nymbox" or "inbox"), account ID,
+     *  new box hash.
+     */
+    EXPORT virtual std::string RemoteBoxUpdate() const = 0;
     EXPORT virtual std::string ServerUpdate() const = 0;
     EXPORT virtual std::string ThreadUpdate(
         const std::string& thread) const = 0;
@@ -48,6 +48,12 @@ public:
     EXPORT virtual SharedAccount Account(const Identifier& accountID) const = 0;
     EXPORT virtual OTIdentifier AccountPartialMatch(
         const std::string& hint) const = 0;
+    /**   Announce a saved nymbox or inbox on the BoxUpdate endpoint */
+    EXPORT virtual void BoxUpdated(
+        const ledgerType type,
+        const Identifier& notaryID,
+        const Identifier& accountID,
+        const Identifier& hash) const = 0;
     EXPORT virtual ExclusiveAccount CreateAccount(
         const Identifier& ownerNymID,
         const Identifier& notaryID,
@@ -165,6 +165,16 @@ public:
     EXPORT virtual std::shared_ptr<proto::StorageThread> Thread(
         const Identifier& nymID,
         const Identifier& threadID) const = 0;
+    /**   Load the most recent items in a thread
+     *
+     *    \param[in] nymID the identifier of the nym who owns the thread
+     *    \param[in] threadID the thread to load
+     *    \param[in] count the maximum number of items to load
+     */
+    EXPORT virtual std::shared_ptr<proto::StorageThread> Thread(
+        const Identifier& nymID,
+        const Identifier& threadID,
+        const std::size_t count) const = 0;
     /**   Obtain a list of thread ids for the specified nym
      *
      *    \param[in] nym the identifier of the nym
@@ -114,6 +114,13 @@ public:
     EXPORT virtual std::vector<OTIdentifier> WorkflowsByAccount(
         const Identifier& nymID,
         const Identifier& accountID) const = 0;
+    /** Get the workflows of an account which are in the specified state,
+     *  most recently updated first */
+    EXPORT virtual std::vector<OTIdentifier> WorkflowsByAccount(
+        const Identifier& nymID,
+        const Identifier& accountID,
+        const proto::PaymentWorkflowType type,
+        const proto::PaymentWorkflowState state) const = 0;
     /** Create a new outgoing cheque workflow */
     EXPORT virtual OTIdentifier WriteCheque(
         const opentxs::Cheque& cheque) const = 0;
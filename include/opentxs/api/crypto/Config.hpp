@@ -27,6 +27,9 @@ public:
     EXPORT virtual std::uint32_t SymmetricBufferSize() const = 0;
     EXPORT virtual std::uint32_t PublicKeysize() const = 0;
     EXPORT virtual std::uint32_t PublicKeysizeMax() const = 0;
+    /** zlib compression level used by Armored, from 0 (no compression) to 9
+     *  (smallest output) */
+    EXPORT virtual std::int32_t CompressionLevel() const = 0;
 
     virtual ~Config() = default;
 
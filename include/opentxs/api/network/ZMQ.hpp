@@ -12,6 +12,7 @@
 #include "opentxs/Types.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -31,6 +32,8 @@ public:
         const std::chrono::seconds duration) const = 0;
     EXPORT virtual std::chrono::seconds Linger() const = 0;
     EXPORT virtual OTZMQContext NewContext() const = 0;
+    /** True if the connection to the server receives its box updates */
+    EXPORT virtual bool Notifications(const std::string& server) const = 0;
     EXPORT virtual std::chrono::seconds ReceiveTimeout() const = 0;
     EXPORT virtual const Flag& Running() const = 0;
     EXPORT virtual void RefreshConfig() const = 0;
@@ -41,6 +44,12 @@ public:
     EXPORT virtual std::string SocksProxy() const = 0;
     EXPORT virtual bool SocksProxy(std::string& proxy) const = 0;
     EXPORT virtual ConnectionState Status(const std::string& server) const = 0;
+    /** Identifies the subscription which receives a nym's box updates from
+     *  the server, or zero if they are not received
+     */
+    EXPORT virtual std::uint64_t Subscription(
+        const std::string& server,
+        const std::string& nymID) const = 0;
 
     EXPORT virtual ~ZMQ() = default;
 
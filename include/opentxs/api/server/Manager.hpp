@@ -44,6 +44,8 @@ public:
 #endif  // OT_CASH
     EXPORT virtual const std::string GetUserName() const = 0;
     EXPORT virtual const std::string GetUserTerms() const = 0;
+    /** Overrides the worker_threads setting of the server configuration */
+    EXPORT virtual const std::string GetWorkerThreads() const = 0;
     EXPORT virtual const Identifier& ID() const = 0;
     EXPORT virtual const Identifier& NymID() const = 0;
 #if OT_CASH
@@ -8,10 +8,19 @@
 
 #include "opentxs/Forward.hpp"
 
+#include <cstddef>
 #include <future>
 #include <memory>
 #include <string>
 
+namespace google
+{
+namespace protobuf
+{
+class MessageLite;
+}  // namespace protobuf
+}  // namespace google
+
 namespace opentxs
 {
 namespace api
@@ -22,12 +31,37 @@ namespace storage
 class Driver
 {
 public:
+    /** Read-only bytes of a stored object
+     *
+     *  The bytes may point directly into memory belonging to the driver, such
+     *  as a memory map. They remain valid for as long as any copy of the view
+     *  exists, which must not be longer than the driver itself.
+     */
+    struct View {
+        const char* data_{nullptr};
+        std::size_t size_{0};
+        std::shared_ptr<const void> owner_{};
+
+        /** Creates a view which owns the specified bytes */
+        static View Own(std::string&& bytes)
+        {
+            auto owner = std::make_shared<const std::string>(std::move(bytes));
+
+            return View{owner->data(), owner->size(), owner};
+        }
+    };
+
     virtual bool EmptyBucket(const bool bucket) const = 0;
 
     virtual bool Load(
         const std::string& key,
         const bool checking,
         std::string& value) const = 0;
+    /** Loads an object without copying it when the driver allows */
+    virtual bool LoadView(
+        const std::string& key,
+        const bool checking,
+        View& value) const = 0;
     virtual bool LoadFromBucket(
         const std::string& key,
         std::string& value,
@@ -50,11 +84,33 @@ public:
         std::string& key) const = 0;
 
     virtual bool Migrate(const std::string& key, const Driver& to) const = 0;
+    /** Indicates that the tree no longer references the object with the
+     *  specified key, which allows a write batch to skip writing it */
+    virtual void Release(const std::string& key) const = 0;
 
     virtual std::string LoadRoot() const = 0;
     virtual bool StoreRoot(const bool commit, const std::string& hash)
         const = 0;
 
+    /** Returns a previously decoded object which LoadProto can share or copy
+     *  instead of parsing, or an empty pointer. Drivers which do not cache
+     *  decoded objects use this default. */
+    virtual std::shared_ptr<const google::protobuf::MessageLite> Cached(
+        const std::string&) const
+    {
+        return {};
+    }
+    /** Offers an object decoded by LoadProto to the driver's cache
+     *
+     *  \param[in] size the serialized size of the object
+     */
+    virtual void Cache(
+        const std::string&,
+        const std::shared_ptr<const google::protobuf::MessageLite>&,
+        const std::size_t) const
+    {
+    }
+
     virtual ~Driver() = default;
 
     template <class T>
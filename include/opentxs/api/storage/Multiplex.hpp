@@ -52,10 +52,37 @@ namespace storage
 class Multiplex : virtual public Driver
 {
 public:
+    /** Starts an in-place garbage collection of the primary plugin
+     *
+     *  Until FinishCollection is called, every key passed to Migrate with
+     *  this object as the destination is marked as reachable, as is every key
+     *  which is written.
+     */
+    virtual void BeginCollection() const = 0;
     virtual std::string BestRoot(bool& primaryOutOfSync) = 0;
+    virtual std::uint64_t CacheHits() const = 0;
+    virtual std::uint64_t CacheMisses() const = 0;
+    /** Writes every object stored since StartBatch which is still referenced,
+     *  followed by the most recent root
+     *
+     *  On failure the batch is closed but the unwritten objects stay
+     *  readable. They are written again before the next root, and the root
+     *  is not written until they all succeed.
+     */
+    virtual bool CommitBatch() = 0;
+    /** Ends a collection started by BeginCollection
+     *
+     *  \param[in] sweep erase every object in the primary plugin which was
+     *                   not marked, in slices which each block writes only
+     *                   briefly
+     */
+    virtual bool FinishCollection(const bool sweep) const = 0;
     virtual void InitBackup() = 0;
     virtual void InitEncryptedBackup(opentxs::crypto::key::Symmetric& key) = 0;
     virtual Driver& Primary() = 0;
+    /** Holds transactional writes and root updates in memory until
+     *  CommitBatch */
+    virtual void StartBatch() = 0;
     virtual void SynchronizePlugins(
         const std::string& hash,
         const opentxs::storage::Root& root,
@@ -10,7 +10,9 @@
 
 #include "opentxs/api/storage/Driver.hpp"
 
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace opentxs
 {
@@ -23,6 +25,17 @@ class Plugin : public virtual Driver
 {
 public:
     virtual bool EmptyBucket(const bool bucket) const = 0;
+    /** Removes the specified keys from a bucket. Missing keys are ignored. */
+    virtual bool Erase(
+        const std::vector<std::string>& keys,
+        const bool bucket) const = 0;
+    /** Calls the callback once for every key stored in a bucket
+     *
+     *  The callback must not call back into the plugin.
+     */
+    virtual bool Keys(
+        const bool bucket,
+        const std::function<void(const std::string&)>& callback) const = 0;
 
     virtual std::string LoadRoot() const = 0;
 
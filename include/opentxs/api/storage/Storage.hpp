@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace opentxs
 {
@@ -87,6 +88,11 @@ public:
         proto::ContactItemType chain,
         std::string address) const = 0;
     virtual ObjectList BlockchainTransactionList() const = 0;
+    /** Number of loads served by the decoded object cache */
+    virtual std::uint64_t CacheHits() const = 0;
+    /** Number of loads which had to read and decode an object */
+    virtual std::uint64_t CacheMisses() const = 0;
+    virtual bool CommitBatch() const = 0;
     virtual std::string ContactAlias(const std::string& id) const = 0;
     virtual ObjectList ContactList() const = 0;
     virtual ObjectList ContextList(const std::string& nymID) const = 0;
@@ -203,6 +209,11 @@ public:
         const std::string& nymId,
         const std::string& threadId,
         std::shared_ptr<proto::StorageThread>& thread) const = 0;
+    virtual bool Load(
+        const std::string& nymId,
+        const std::string& threadId,
+        const std::size_t count,
+        std::shared_ptr<proto::StorageThread>& thread) const = 0;
     virtual bool Load(
         const std::string& id,
         std::shared_ptr<proto::UnitDefinition>& contract,
@@ -232,6 +243,12 @@ public:
     virtual std::set<std::string> PaymentWorkflowsByAccount(
         const std::string& nymID,
         const std::string& accountID) const = 0;
+    /** Workflows for an account in one state, most recently updated first */
+    virtual std::vector<std::string> PaymentWorkflowsByAccount(
+        const std::string& nymID,
+        const std::string& accountID,
+        const proto::PaymentWorkflowType type,
+        const proto::PaymentWorkflowState state) const = 0;
     virtual std::set<std::string> PaymentWorkflowsByState(
         const std::string& nymID,
         const proto::PaymentWorkflowType type,
@@ -285,6 +302,13 @@ public:
     virtual bool SetUnitDefinitionAlias(
         const std::string& id,
         const std::string& alias) const = 0;
+    /** Defers writing the storage indices and root until CommitBatch
+     *
+     *  Items stored while a batch is open are visible to readers immediately.
+     *  Each index touched during the batch is written once when the outermost
+     *  batch is committed.
+     */
+    virtual void StartBatch() const = 0;
     virtual bool Store(
         const std::string& accountID,
         const std::string& data,
@@ -94,6 +94,11 @@ private:
         const ServerContext& context,
         std::shared_ptr<Item> pReplyItem) const;
     void ProcessPayDividendResponse(OTTransaction& theTransaction) const;
+    bool process_box_receipt(
+        ServerContext& context,
+        const std::int64_t boxType,
+        const TransactionNumber number,
+        const String& strTransTypeObject);
     void load_str_trans_add_to_ledger(
         const Identifier& the_nym_id,
         const String& str_trans,
@@ -126,6 +131,9 @@ private:
         const Message& theReply,
         Ledger* pNymbox,
         ServerContext& context);
+    bool processServerReplyGetBoxReceipts(
+        const Message& theReply,
+        ServerContext& context);
     bool processServerReplyProcessBox(
         const Message& theReply,
         const Identifier& accountID,
@@ -725,6 +725,15 @@ public:
         std::int32_t nBoxType,         // 0/nymbox, 1/inbox, 2/outbox
         const TransactionNumber& lTransactionNum) const;
 
+    /** Downloads many box receipts with one request. If numbers is empty then
+     *  every receipt in the box is requested. The notary may send only some of
+     *  them, so check which receipts were saved before asking for the rest. */
+    EXPORT CommandResult getBoxReceipts(
+        ServerContext& context,
+        const Identifier& accountID,
+        const std::int32_t boxType,
+        const std::set<TransactionNumber>& numbers) const;
+
     EXPORT CommandResult queryInstrumentDefinitions(
         ServerContext& context,
         const Armored& ENCODED_MAP) const;
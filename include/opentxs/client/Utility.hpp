@@ -13,6 +13,7 @@
 
 #include <cstdint>
 #include <array>
+#include <set>
 #include <string>
 
 namespace opentxs
@@ -83,6 +84,17 @@ public:
         const std::string& accountID,
         std::int32_t nBoxType,
         std::int64_t strTransactionNum);
+    EXPORT bool getBoxReceiptsLowLevel(
+        const std::string& accountID,
+        std::int32_t nBoxType,
+        const std::set<TransactionNumber>& numbers,
+        bool& bWasSent);
+    EXPORT bool getBoxReceiptsWithErrorCorrection(
+        const std::string& notaryID,
+        const std::string& nymID,
+        const std::string& accountID,
+        std::int32_t nBoxType,
+        std::set<TransactionNumber>& missing);
     EXPORT std::int32_t getInboxAccount(
         const std::string& accountID,
         bool& bWasSentInbox,
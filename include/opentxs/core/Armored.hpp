@@ -112,6 +112,12 @@ public:
     EXPORT bool SaveToExactPath(const std::string& filename);
     EXPORT bool SetData(const Data& theData, bool bLineBreaks = true);
     EXPORT bool SetString(const String& theData, bool bLineBreaks = true);
+    /** Same as SetString(), except that the zlib compression level configured
+     *  in api::crypto::Config is overridden by compressionLevel */
+    EXPORT bool SetString(
+        const String& theData,
+        bool bLineBreaks,
+        std::int32_t compressionLevel);
 
     EXPORT ~Armored() = default;
 
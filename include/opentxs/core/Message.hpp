@@ -18,6 +18,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -183,6 +184,11 @@ public:
     // Server reply:   list of client-acknowledged replies (so client knows that
     // server knows.)
 
+    // Not part of the signed contents. Large objects, such as the box receipts
+    // in a getBoxReceiptsResponse, travel as additional frames after the
+    // message and each one is verified on its own.
+    std::vector<std::string> m_Attachments;
+
     std::int64_t m_lNewRequestNum{0};  // If you are SENDING a message, you set
                                        // m_strRequestNum. (For all msgs.)
     // Server Reply for all messages copies that same number into
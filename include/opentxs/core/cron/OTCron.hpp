@@ -9,9 +9,20 @@
 #include "opentxs/Forward.hpp"
 
 #include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/StringUtils.hpp"
 #include "opentxs/core/util/Timer.hpp"
 #include "opentxs/core/Contract.hpp"
+#include "opentxs/network/zeromq/PublishSocket.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -30,6 +41,9 @@ typedef std::map<std::int64_t, std::shared_ptr<OTCronItem>> mapOfCronItems;
 /** multimapOfCronItems: Mapped to date the item was added to Cron. */
 typedef std::multimap<time64_t, std::shared_ptr<OTCronItem>>
     multimapOfCronItems;
+/** setOfDueCronItems: Transaction numbers ordered by the time each item is
+ * next due to be processed. */
+typedef std::set<std::pair<time64_t, std::int64_t>> setOfDueCronItems;
 /** Mapped (uniquely) to market ID. */
 typedef std::map<std::string, std::shared_ptr<OTMarket>> mapOfMarkets;
 /** Cron stores a bunch of these on this list, which the server refreshes from
@@ -46,15 +60,41 @@ private:
 private:
     friend api::implementation::Factory;
 
+    // Held while accessing m_mapMarkets from GetMarket / AddMarket, which
+    // cron items may call from worker threads.
+    mutable std::recursive_mutex m_lockMarkets;
     // A list of all valid markets.
     mapOfMarkets m_mapMarkets;
     // Cron Items are found on both lists.
     mapOfCronItems m_mapCronItems;
     multimapOfCronItems m_multimapCronItems;
+    // Position of each item in m_multimapCronItems, by transaction number.
+    std::map<std::int64_t, multimapOfCronItems::iterator> m_mapMultimapIndex;
+    // Only items at the front of this set are visited by ProcessCronItems.
+    setOfDueCronItems m_setDueCronItems;
+    // Due time of each item in m_setDueCronItems, by transaction number.
+    std::map<std::int64_t, time64_t> m_mapDueTimes;
     // Always store this in any object that's associated with a specific server.
     OTIdentifier m_NOTARY_ID;
+    mutable std::mutex m_lockTransactionNumbers;
     // I can't put receipts in people's inboxes without a supply of these.
     listOfLongNumbers m_listTransactionNumbers;
+    // While worker threads are processing cron items, SaveCron() only sets
+    // m_bSaveRequested and the save happens once the workers have finished.
+    std::atomic<bool> m_bDeferSave{false};
+    std::atomic<bool> m_bSaveRequested{false};
+    mutable std::mutex m_lockChangedCronItems;
+    // Items changed outside of their own ProcessCron(), such as the resting
+    // trade in a match or a smart contract whose clause was triggered. Their
+    // files are written by the next SaveCron() or ProcessCronItems().
+    std::set<std::int64_t> m_setChangedCronItems;
+    // Items whose files are erased once the index no longer lists them.
+    std::set<std::int64_t> m_setRemovedCronItems;
+    // Market data (snapshots, deltas and trades) for subscribed clients.
+    OTZMQPublishSocket m_MarketPublisher;
+    std::atomic<bool> m_bPublishMarketData{false};
+    // When ProcessCronItems last published a snapshot of every market.
+    time64_t m_tLastMarketSnapshot{OT_TIME_ZERO};
     // I don't want to start Cron processing until everything else is all loaded
     //  up and ready to go.
     bool m_bIsActivated{false};
@@ -68,9 +108,71 @@ private:
     // Int. The maximum number of cron items any given Nym can have
     // active at the same time.
     static std::int32_t __cron_max_items_per_nym;
+    // Number of threads used to process due cron items which do not share
+    // any accounts. 0 or 1 processes every item on the calling thread.
+    static std::int32_t __cron_worker_threads;
+    // Seconds between the snapshots of every market which are published
+    // for clients that subscribe to market data. 0 disables them.
+    static std::int32_t __market_snapshot_seconds;
 
     static Timer tCron;
 
+public:
+    /** The accounts and nyms which the due cron items may modify */
+    struct CronKeys {
+        std::set<std::string> accounts_{};
+        std::set<std::string> nyms_{};
+        /** Set if a due item can not report its keys */
+        bool all_{false};
+    };
+
+private:
+
+    /** The earliest time at which item->ProcessCron() will do anything other
+     * than return true because its process interval has not yet elapsed. */
+    static time64_t due_time(const OTCronItem& item);
+
+    enum class CronResult : std::uint8_t {
+        Skipped = 0,
+        Unchanged = 1,
+        Changed = 2,
+        Removed = 3,
+        Deferred = 4,
+    };
+
+    /** Returns true if Cron must be saved */
+    bool apply_cron_result(
+        const std::shared_ptr<OTCronItem>& item,
+        const CronResult result);
+    /** Splits the due items into groups which share no conflict keys with
+     * each other. Items which can not report their keys go to serial.
+     * groupKeys receives the accounts and nyms of every active item in each
+     * group, whether due or not. */
+    void group_cron_items(
+        const std::vector<std::shared_ptr<OTCronItem>>& due,
+        std::vector<std::vector<std::size_t>>& groups,
+        std::vector<CronKeys>& groupKeys,
+        std::vector<std::size_t>& serial) const;
+    /** Safe to call from worker threads, as long as no two threads process
+     * items in the same group. */
+    CronResult process_cron_item(OTCronItem& item);
+    void process_cron_items(
+        const std::vector<std::shared_ptr<OTCronItem>>& due,
+        const std::vector<std::size_t>& indices,
+        const std::int32_t nMinimumNumbers,
+        std::vector<CronResult>& results);
+
+    bool erase_cron_item(const std::int64_t lTransactionNum) const;
+    void publish_market_snapshots(const time64_t now);
+    bool load_cron_item(
+        const std::int64_t lTransactionNum,
+        const time64_t tDateAdded);
+    void remove_cron_item(const std::int64_t lTransactionNum);
+    bool save_changed_cron_items();
+    bool save_cron_item(const OTCronItem& item) const;
+    void schedule(const OTCronItem& item);
+    void unschedule(const std::int64_t lTransactionNum);
+
     explicit OTCron(const api::Core& server);
 
     OTCron() = delete;
@@ -85,6 +187,22 @@ public:
         __cron_ms_between_process = lMS;
     }
 
+    static std::int32_t GetCronWorkerThreads()
+    {
+        return __cron_worker_threads;
+    }
+    static void SetCronWorkerThreads(std::int32_t nThreads)
+    {
+        __cron_worker_threads = nThreads;
+    }
+    static std::int32_t GetMarketSnapshotSeconds()
+    {
+        return __market_snapshot_seconds;
+    }
+    static void SetMarketSnapshotSeconds(std::int32_t nSeconds)
+    {
+        __market_snapshot_seconds = nSeconds;
+    }
     static std::int32_t GetCronRefillAmount() { return __trans_refill_amount; }
     static void SetCronRefillAmount(std::int32_t nAmount)
     {
@@ -99,6 +217,7 @@ public:
         __cron_max_items_per_nym = nMax;
     }
     inline bool IsActivated() const { return m_bIsActivated; }
+    bool IsPublishingMarketData() const { return m_bPublishMarketData.load(); }
     inline bool ActivateCron()
     {
         if (!m_bIsActivated)
@@ -111,6 +230,9 @@ public:
         std::shared_ptr<OTCronItem> theItem,
         bool bSaveReceipt,
         time64_t tDateAdded);  // Date it was FIRST added to Cron.
+    /** Call after changing an active item anywhere other than in its own
+     * ProcessCron(). Safe to call from worker threads. */
+    void FlagCronItemChanged(const std::int64_t lTransactionNum);
     /** if returns false, item wasn't found. */
     bool RemoveCronItem(std::int64_t lTransactionNum, ConstNym theRemover);
     std::shared_ptr<OTCronItem> GetItemByOfficialNum(
@@ -137,6 +259,23 @@ public:
         Armored& ascOutput,
         const Identifier& NYM_ID,
         std::int32_t& nOfferCount);
+    /** Sends a market data message to subscribed clients
+     *
+     *  Each message has four frames: the market ID, which subscribers may use
+     *  as a topic filter, the type ("snapshot", "delta" or "trade"), the
+     *  market sequence number as a std::int64_t, and the payload. A snapshot
+     *  contains every change with a lower sequence number.
+     */
+    void PublishMarketData(
+        const Identifier& MARKET_ID,
+        const std::string& type,
+        const std::int64_t lSequence,
+        const std::string& payload) const;
+    /** Binds the market data publisher. Nothing is published before this is
+     *  called. */
+    bool StartMarketData(
+        const std::string& endpoint,
+        const OTPassword& privateKey);
     // TRANSACTION NUMBERS
     /**The server starts out putting a bunch of numbers in here so Cron can use
      * them. Then the internal trades and payment plans get numbers from here as
@@ -148,13 +287,19 @@ public:
     std::int64_t GetNextTransactionNumber();
     /** How many numbers do I currently have on the list? */
     std::int32_t GetTransactionCount() const;
+    /** Collects the keys which ProcessCronItems() needs locked for the items
+     * which are due now. */
+    void GetDueCronKeys(CronKeys& keys) const;
     /** Make sure every time you call this, you check the GetTransactionCount()
      * first and replenish it to whatever your minimum supply is. (The
      * transaction numbers in there must be enough to last for the entire
      * ProcessCronItems() call, and all the trades and payment plans within,
      * since it will not be replenished again at least until the call has
-     * finished.) */
-    void ProcessCronItems();
+     * finished.)
+     *
+     * If pLocked is set, only the items whose keys it contains are processed.
+     * The others stay due until the next round. */
+    void ProcessCronItems(const CronKeys* pLocked = nullptr);
 
     std::int64_t computeTimeout();
 
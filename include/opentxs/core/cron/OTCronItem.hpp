@@ -16,6 +16,8 @@
 #include "opentxs/Types.hpp"
 
 #include <deque>
+#include <set>
+#include <string>
 
 namespace opentxs
 {
@@ -45,6 +47,16 @@ public:
         String* pstrNote = nullptr,
         String* pstrAttachment = nullptr);
     virtual bool CanRemoveItemFromCron(const ClientContext& context);
+    /** Adds the ids of every account and nym ProcessCron() may modify, and
+     *  any other key (such as a market) it shares with the items it may
+     *  affect. Cron processes items which share no keys on separate threads,
+     *  and locks the accounts and nymboxes while it does. Returns false if
+     *  the item can not tell, in which case it is processed alone.
+     */
+    virtual bool GetConflictKeys(
+        std::set<std::string>& accounts,
+        std::set<std::string>& nyms,
+        std::set<std::string>& other) const;
     virtual void HarvestOpeningNumber(ServerContext& context);
     virtual void HarvestClosingNumbers(ServerContext& context);
     // pActivator and pRemover are both "SOMETIMES nullptr"
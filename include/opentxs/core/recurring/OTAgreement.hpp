@@ -290,6 +290,10 @@ public:
      void    AddClosingTransactionNo(const std::int64_t& lClosingTransactionNo);
      */
     bool CanRemoveItemFromCron(const ClientContext& context) override;
+    bool GetConflictKeys(
+        std::set<std::string>& accounts,
+        std::set<std::string>& nyms,
+        std::set<std::string>& other) const override;
 
     EXPORT void HarvestOpeningNumber(ServerContext& context) override;
     EXPORT void HarvestClosingNumbers(ServerContext& context) override;
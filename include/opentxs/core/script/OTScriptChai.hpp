@@ -42,6 +42,7 @@ public:
     virtual ~OTScriptChai();
 
     bool ExecuteScript(OTVariable* pReturnVar = nullptr) override;
+    // Borrowed from a pool of engines for the lifetime of this object
     chaiscript::ChaiScript* const chai_{nullptr};
 };
 }  // namespace opentxs
@@ -101,6 +101,10 @@ public:
     bool Compare(OTScriptable& rhs) const override;
     // From OTCronItem (parent class of this)
     bool CanRemoveItemFromCron(const ClientContext& context) override;
+    bool GetConflictKeys(
+        std::set<std::string>& accounts,
+        std::set<std::string>& nyms,
+        std::set<std::string>& other) const override;
 
     void HarvestOpeningNumber(ServerContext& context) override;
     void HarvestClosingNumbers(ServerContext& context) override;
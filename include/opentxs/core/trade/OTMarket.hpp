@@ -16,13 +16,14 @@
 #include "opentxs/api/Core.hpp"
 #include "opentxs/api/Factory.hpp"
 #include "opentxs/core/cron/OTCron.hpp"
+#include "opentxs/core/trade/OrderBook.hpp"
 #include "opentxs/core/trade/OTOffer.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/OTStorage.hpp"
 
+#include <cstddef>
 #include <cstdint>
-#include <map>
 #include <string>
 
 namespace opentxs
@@ -40,13 +41,10 @@ class Factory;
 #define MAX_MARKET_QUERY_DEPTH                                                 \
     50  // todo add this to the ini file. (Now that we actually have one.)
 
-// Multiple offers, mapped by price limit.
-// Using multi-map since there will be more than one offer for each single
-// price.
-// (Map would only allow a single item on the map for each price.)
-typedef std::multimap<std::int64_t, OTOffer*> mapOfOffers;
-// The same offers are also mapped (uniquely) to transaction number.
-typedef std::map<std::int64_t, OTOffer*> mapOfOffersTrnsNum;
+// Changes to a market are appended to its journal. After this many journal
+// entries the whole market is signed and saved again, and the journal starts
+// over.
+#define MARKET_JOURNAL_SNAPSHOT_INTERVAL 100
 
 class OTMarket : public Contract
 {
@@ -60,6 +58,9 @@ public:
         bool bSaveFile = true,
         time64_t tDateAddedToMarket = OT_TIME_ZERO);
     bool RemoveOffer(const std::int64_t& lTransactionNum);
+    // Records the current contents of an offer which is already on the
+    // market, for example after the server has signed it.
+    bool SaveOffer(const OTOffer& theOffer);
     // returns general information about offers on the market
     EXPORT bool GetOfferList(
         Armored& ascOutput,
@@ -94,8 +95,8 @@ public:
     std::int64_t GetHighestBidPrice();
     std::int64_t GetLowestAskPrice();
 
-    mapOfOffers::size_type GetBidCount() { return m_mapBids.size(); }
-    mapOfOffers::size_type GetAskCount() { return m_mapAsks.size(); }
+    std::size_t GetBidCount() const { return m_bookBids.size(); }
+    std::size_t GetAskCount() const { return m_bookAsks.size(); }
     void SetInstrumentDefinitionID(const Identifier& INSTRUMENT_DEFINITION_ID)
     {
         m_INSTRUMENT_DEFINITION_ID = INSTRUMENT_DEFINITION_ID;
@@ -141,8 +142,13 @@ public:
 
     inline void SetCronPointer(OTCron& theCron) { m_pCron = &theCron; }
     inline OTCron* GetCron() { return m_pCron; }
+    /** Loads the last signed snapshot, then replays the journal */
     bool LoadMarket();
+    /** Signs and saves the whole market, and discards the journal */
     bool SaveMarket();
+    /** Publishes every offer on the market to subscribed clients, packed the
+     *  same way as a getMarketOffers reply */
+    void PublishSnapshot();
 
     void InitMarket();
 
@@ -167,11 +173,10 @@ private:
 
     OTDB::TradeListMarket* m_pTradeList{nullptr};
 
-    mapOfOffers m_mapBids;  // The buyers, ordered by price limit
-    mapOfOffers m_mapAsks;  // The sellers, ordered by price limit
-
-    mapOfOffersTrnsNum m_mapOffers;  // All of the offers on a single list,
-                                     // ordered by transaction number.
+    // The buyers, highest price limit first. Owns the offers.
+    OrderBook<OTOffer> m_bookBids{true};
+    // The sellers, lowest price limit first. Owns the offers.
+    OrderBook<OTOffer> m_bookAsks{false};
 
     OTIdentifier m_NOTARY_ID;  // Always store this in any object that's
                                // associated with a specific server.
@@ -194,6 +199,12 @@ private:
     std::int64_t m_lLastSalePrice{0};
     std::string m_strLastSaleDate;
 
+    // Sequence number of the first journal entry written after the most
+    // recent snapshot.
+    std::int64_t m_lJournalStart{0};
+    // Sequence number of the next journal entry.
+    std::int64_t m_lJournalNext{0};
+
     // The server stores a map of markets, one for each unique combination of
     // instrument definitions. That's what this market class represents: one
     // instrument definition being traded and priced in another. It could be
@@ -214,6 +225,30 @@ private:
         const Identifier& CURRENCY_TYPE_ID,
         const std::int64_t& lScale);
 
+    // Writes a change to the journal, signed by the server nym, or a new
+    // snapshot when the journal is long enough.
+    bool append_journal(Tag& entry);
+    // Adds to the list of recent trades, dropping the oldest past
+    // MAX_MARKET_QUERY_DEPTH.
+    void add_trade(OTDB::TradeDataMarket& theTrade);
+    bool erase_journal(const std::int64_t lFrom, const std::int64_t lTo) const;
+    bool has_trade(const OTDB::TradeDataMarket& theTrade);
+    String journal_file(const std::int64_t lSequence) const;
+    void publish_trade(OTDB::TradeDataMarket& theTrade);
+    bool remove_offer(const std::int64_t& lTransactionNum);
+    // Swaps in a new version of an offer already on the market, keeping its
+    // place in the queue at its price.
+    bool replace_offer(OTOffer& theOffer, time64_t tDateAddedToMarket);
+    // Fails without changing the market unless every entry verifies.
+    bool replay_journal();
+    // Journals both offers of a fill together with the trade record.
+    bool save_fill(
+        const OTOffer& theOffer,
+        const OTOffer& theOtherOffer,
+        const OTDB::TradeDataMarket& theTrade);
+
+    static void serialize_offer(Tag& parent, const OTOffer& theOffer);
+
     void rollback_four_accounts(
         Account& p1,
         bool b1,
@@ -138,6 +138,10 @@ public:
     bool ProcessCron() override;  // OTCron calls this regularly, which is my
                                   // chance to expire, etc.
     bool CanRemoveItemFromCron(const ClientContext& context) override;
+    bool GetConflictKeys(
+        std::set<std::string>& accounts,
+        std::set<std::string>& nyms,
+        std::set<std::string>& other) const override;
 
     // From OTScriptable, we override this function. OTScriptable now does fancy
     // stuff like checking to see
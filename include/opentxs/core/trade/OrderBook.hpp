@@ -0,0 +1,239 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENTXS_CORE_TRADE_ORDERBOOK_HPP
+#define OPENTXS_CORE_TRADE_ORDERBOOK_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace opentxs
+{
+/** One side of a market: orders grouped into price levels
+ *
+ *  Levels are kept in a sorted vector with the best price at the back, so the
+ *  best level is found in constant time and the levels nearest the top of the
+ *  book are the cheapest to add and remove. Each level is a FIFO queue stored
+ *  in a vector. Removing an order leaves a hole which iteration skips; holes
+ *  are reclaimed once they outnumber the orders left on the level. Orders are
+ *  located by transaction number through an index which records the price
+ *  and position of each one.
+ *
+ *  The book does not own the orders.
+ */
+template <typename T>
+class OrderBook
+{
+public:
+    using size_type = std::size_t;
+
+    /** Best price, or 0 if the book is empty
+     *
+     *  \param[in] skipZero ignore orders priced at 0 (market orders)
+     */
+    std::int64_t BestPrice(const bool skipZero = false) const
+    {
+        auto level = levels_.rbegin();
+
+        if (skipZero && (levels_.rend() != level) && (0 == level->price_)) {
+            ++level;
+        }
+
+        if (levels_.rend() == level) { return 0; }
+
+        return level->price_;
+    }
+    T* Find(const std::int64_t transaction) const
+    {
+        const auto position = index_.find(transaction);
+
+        if (index_.end() == position) { return nullptr; }
+
+        const auto level = find_level(position->second.price_);
+
+        return level->orders_.at(position->second.slot_).order_;
+    }
+    /** Visits every order from the best price to the worst, oldest first
+     *  within a price level, until the callback returns false
+     *
+     *  The callback must not add or remove orders.
+     */
+    template <typename F>
+    void ForEach(F callback) const
+    {
+        for (auto level = levels_.rbegin(); level != levels_.rend(); ++level) {
+            for (const auto& entry : level->orders_) {
+                if (nullptr == entry.order_) { continue; }
+
+                if (false == callback(*entry.order_)) { return; }
+            }
+        }
+    }
+    size_type LevelCount() const { return levels_.size(); }
+    size_type size() const { return size_; }
+
+    void Clear()
+    {
+        levels_.clear();
+        index_.clear();
+        size_ = 0;
+    }
+    /** Adds an order behind any others at the same price
+     *
+     *  Returns false if the transaction number is already in the book.
+     */
+    bool Insert(
+        const std::int64_t transaction,
+        const std::int64_t price,
+        T& order)
+    {
+        if (index_.end() != index_.find(transaction)) { return false; }
+
+        auto level = find_level(price);
+
+        if ((levels_.end() == level) || (price != level->price_)) {
+            level = levels_.emplace(level);
+            level->price_ = price;
+        }
+
+        index_.emplace(transaction, Position{price, level->orders_.size()});
+        level->orders_.push_back(Entry{transaction, &order});
+        ++level->live_;
+        ++size_;
+
+        return true;
+    }
+    /** Swaps in a new version of an order without moving it in its queue
+     *
+     *  Returns the previous version, or nullptr if the transaction number is
+     *  not in the book at that price.
+     */
+    T* Replace(
+        const std::int64_t transaction,
+        const std::int64_t price,
+        T& order)
+    {
+        const auto position = index_.find(transaction);
+
+        if ((index_.end() == position) || (price != position->second.price_)) {
+            return nullptr;
+        }
+
+        auto level = find_level(price);
+        auto& entry = level->orders_.at(position->second.slot_);
+        T* output = entry.order_;
+        entry.order_ = &order;
+
+        return output;
+    }
+    /** Returns the removed order, or nullptr if it was not in the book */
+    T* Remove(const std::int64_t transaction)
+    {
+        const auto position = index_.find(transaction);
+
+        if (index_.end() == position) { return nullptr; }
+
+        auto level = find_level(position->second.price_);
+        auto& entry = level->orders_.at(position->second.slot_);
+        T* output = entry.order_;
+        entry.order_ = nullptr;
+        --level->live_;
+        --size_;
+        index_.erase(position);
+
+        if (0 == level->live_) {
+            levels_.erase(level);
+        } else if ((level->orders_.size() - level->live_) > level->live_) {
+            compact(*level);
+        }
+
+        return output;
+    }
+
+    /** \param[in] highestFirst true for bids, false for asks */
+    explicit OrderBook(const bool highestFirst)
+        : highest_first_(highestFirst)
+        , levels_()
+        , index_()
+        , size_(0)
+    {
+    }
+    OrderBook(const OrderBook&) = default;
+    OrderBook(OrderBook&&) = default;
+    OrderBook& operator=(const OrderBook&) = default;
+    OrderBook& operator=(OrderBook&&) = default;
+
+    ~OrderBook() = default;
+
+private:
+    struct Entry {
+        std::int64_t transaction_{0};
+        T* order_{nullptr};
+    };
+
+    struct Level {
+        std::int64_t price_{0};
+        size_type live_{0};
+        std::vector<Entry> orders_{};
+    };
+
+    struct Position {
+        std::int64_t price_{0};
+        size_type slot_{0};
+    };
+
+    using Levels = std::vector<Level>;
+
+    bool highest_first_{false};
+    // Sorted from the worst price to the best
+    Levels levels_{};
+    std::map<std::int64_t, Position> index_{};
+    size_type size_{0};
+
+    void compact(Level& level)
+    {
+        size_type slot{0};
+
+        for (const auto& entry : level.orders_) {
+            if (nullptr == entry.order_) { continue; }
+
+            index_.at(entry.transaction_).slot_ = slot;
+            level.orders_.at(slot) = entry;
+            ++slot;
+        }
+
+        level.orders_.resize(slot);
+    }
+    typename Levels::const_iterator find_level(const std::int64_t price) const
+    {
+        return std::lower_bound(
+            levels_.begin(), levels_.end(), price, worse_than(highest_first_));
+    }
+    typename Levels::iterator find_level(const std::int64_t price)
+    {
+        return std::lower_bound(
+            levels_.begin(), levels_.end(), price, worse_than(highest_first_));
+    }
+
+    struct worse_than {
+        bool highest_first_{false};
+
+        explicit worse_than(const bool highestFirst)
+            : highest_first_(highestFirst)
+        {
+        }
+
+        bool operator()(const Level& level, const std::int64_t price) const
+        {
+            return highest_first_ ? (level.price_ < price)
+                                  : (level.price_ > price);
+        }
+    };
+};
+}  // namespace opentxs
+#endif
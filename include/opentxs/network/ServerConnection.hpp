@@ -11,6 +11,8 @@
 #include "opentxs/Proto.hpp"
 #include "opentxs/Types.hpp"
 
+#include <cstdint>
+#include <future>
 #include <string>
 
 namespace opentxs
@@ -24,13 +26,38 @@ public:
         const api::Core& api,
         const api::network::ZMQ& zmq,
         const zeromq::PublishSocket& updates,
+        const zeromq::PublishSocket& boxUpdates,
         const std::shared_ptr<const ServerContract>& contract);
 
     EXPORT virtual bool ChangeAddressType(const proto::AddressType type) = 0;
     EXPORT virtual bool ClearProxy() = 0;
     EXPORT virtual bool EnableProxy() = 0;
+    /** True if the notary pushes box updates on this connection
+     *
+     *  The notary advertises this while negotiating the raw format. It pushes
+     *  a nym's updates only to the connection which carried that nym's most
+     *  recent successful request. The updates are republished on the
+     *  RemoteBoxUpdate endpoint.
+     */
+    EXPORT virtual bool Notifications() const = 0;
     EXPORT virtual NetworkReplyMessage Send(const Message& message) = 0;
+    /** Send a request without waiting for the reply
+     *
+     *  Replies are matched to requests by nym and request number, so any
+     *  number of requests may be outstanding at once. The future is ready
+     *  when the reply arrives or when the send timeout expires.
+     */
+    EXPORT virtual std::future<NetworkReplyMessage> SendAsync(
+        const Message& message) = 0;
     EXPORT virtual bool Status() const = 0;
+    /** Identifies the subscription which receives a nym's box updates
+     *
+     *  Zero if the nym's box updates are not received. The value changes
+     *  whenever the nym is subscribed again after the socket was replaced,
+     *  since any update pushed before that was missed.
+     */
+    EXPORT virtual std::uint64_t Subscription(
+        const std::string& nymID) const = 0;
 
     virtual ~ServerConnection() = default;
 
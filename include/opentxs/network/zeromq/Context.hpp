@@ -8,6 +8,7 @@
 
 #include "opentxs/Forward.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -34,6 +35,12 @@ class Context
 {
 public:
     EXPORT static Pimpl<opentxs::network::zeromq::Context> Factory();
+    /** Receiving sockets created through the returned context share
+     *  reactorThreads polling threads instead of starting one thread each.
+     *  Zero keeps one thread per socket.
+     */
+    EXPORT static Pimpl<opentxs::network::zeromq::Context> Factory(
+        const std::size_t reactorThreads);
 
     EXPORT static std::string EncodePrivateZ85(
         const opentxs::crypto::key::Ed25519& key);
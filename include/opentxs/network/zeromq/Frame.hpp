@@ -9,12 +9,15 @@
 #include "opentxs/Forward.hpp"
 
 #include <string>
+#include <string_view>
 
 struct zmq_msg_t;
 
 #ifdef SWIG
 // clang-format off
 %ignore opentxs::network::zeromq::Frame::data;
+%ignore opentxs::network::zeromq::Frame::Factory(std::string&&);
+%ignore opentxs::network::zeromq::Frame::View;
 %ignore opentxs::network::zeromq::Frame::operator zmq_msg_t*;
 %ignore opentxs::Pimpl<opentxs::network::zeromq::Frame>::Pimpl(opentxs::network::zeromq::Frame const &);
 %ignore opentxs::Pimpl<opentxs::network::zeromq::Frame>::operator opentxs::network::zeromq::Frame&;
@@ -40,11 +43,16 @@ public:
         const opentxs::Data& input);
     EXPORT static Pimpl<opentxs::network::zeromq::Frame> Factory(
         const std::string& input);
+    /** Takes ownership of the buffer instead of copying it */
+    EXPORT static Pimpl<opentxs::network::zeromq::Frame> Factory(
+        std::string&& input);
 
     EXPORT virtual operator std::string() const = 0;
 
     EXPORT virtual const void* data() const = 0;
     EXPORT virtual std::size_t size() const = 0;
+    /** Valid for as long as the frame is neither modified nor destroyed */
+    EXPORT virtual std::string_view View() const = 0;
 
     EXPORT virtual operator zmq_msg_t*() = 0;
 
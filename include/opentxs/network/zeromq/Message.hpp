@@ -13,6 +13,7 @@
 %ignore opentxs::Pimpl<opentxs::network::zeromq::Message>::Pimpl(opentxs::network::zeromq::Message const &);
 %ignore opentxs::Pimpl<opentxs::network::zeromq::Message>::operator opentxs::network::zeromq::Message&;
 %ignore opentxs::Pimpl<opentxs::network::zeromq::Message>::operator const opentxs::network::zeromq::Message &;
+%ignore opentxs::network::zeromq::Message::AddFrame(std::string&&);
 %ignore opentxs::network::zeromq::Message::at(const std::size_t) const;
 %ignore opentxs::network::zeromq::Message::begin() const;
 %ignore opentxs::network::zeromq::Message::end() const;
@@ -52,6 +53,7 @@ public:
     EXPORT virtual Frame& AddFrame() = 0;
     EXPORT virtual Frame& AddFrame(const opentxs::Data& input) = 0;
     EXPORT virtual Frame& AddFrame(const std::string& input) = 0;
+    EXPORT virtual Frame& AddFrame(std::string&& input) = 0;
     EXPORT virtual Frame& at(const std::size_t index) = 0;
 
     EXPORT virtual void EnsureDelimiter() = 0;
@@ -35,6 +35,12 @@ public:
         const class Context& context,
         const ListenCallback& callback);
 
+    /** Receive only messages whose first frame begins with a topic
+     *
+     *  Without any topics every message is received. May be called more than
+     *  once to receive several topics.
+     */
+    EXPORT virtual bool AddTopic(const std::string& topic) const = 0;
     EXPORT virtual bool SetSocksProxy(const std::string& proxy) const = 0;
 
     EXPORT virtual ~SubscribeSocket() = default;
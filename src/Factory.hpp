@@ -303,6 +303,14 @@ public:
         const Digest& hash,
         const Random& random,
         const Flag& bucket);
+#endif
+#if OT_STORAGE_LMDB
+    static opentxs::api::storage::Plugin* StorageLMDB(
+        const api::storage::Storage& storage,
+        const StorageConfig& config,
+        const Digest& hash,
+        const Random& random,
+        const Flag& bucket);
 #endif
     static opentxs::api::storage::Plugin* StorageMemDB(
         const api::storage::Storage& storage,
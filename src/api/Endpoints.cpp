@@ -15,6 +15,7 @@
 #define ENDPOINT_VERSION_1 1
 
 #define ACCOUNT_UPDATE_ENDPOINT "accountupdate"
+#define BOX_UPDATE_ENDPOINT "boxupdate"
 #define CONNECTION_STATUS_ENDPOINT "connectionstatus"
 #define CONTACT_UPDATE_ENDPOINT "contactupdate"
 #define DHT_NYM_REQUEST_ENDPOINT "dht/requestnym"
@@ -24,6 +25,7 @@
 #define NYM_UPDATE_ENDPOINT "nymupdate"
 #define PAIR_EVENT_ENDPOINT "pairevent"
 #define PENDING_BAILMENT_ENDPOINT "peerrequest/pendingbailment"
+#define REMOTE_BOX_UPDATE_ENDPOINT "remoteboxupdate"
 #define SERVER_UPDATE_ENDPOINT "serverupdate"
 #define THREAD_UPDATE_ENDPOINT "threadupdate/"
 #define WIDGET_UPDATE_ENDPOINT "ui/widgetupdate"
@@ -71,6 +73,11 @@ std::string Endpoints::AccountUpdate() const
     return build_inproc_path(ACCOUNT_UPDATE_ENDPOINT, ENDPOINT_VERSION_1);
 }
 
+std::string Endpoints::BoxUpdate() const
+{
+    return build_inproc_path(BOX_UPDATE_ENDPOINT, ENDPOINT_VERSION_1);
+}
+
 std::string Endpoints::ConnectionStatus() const
 {
     return build_inproc_path(CONNECTION_STATUS_ENDPOINT, ENDPOINT_VERSION_1);
@@ -116,6 +123,11 @@ std::string Endpoints::PendingBailment() const
     return build_inproc_path(PENDING_BAILMENT_ENDPOINT, ENDPOINT_VERSION_1);
 }
 
+std::string Endpoints::RemoteBoxUpdate() const
+{
+    return build_inproc_path(REMOTE_BOX_UPDATE_ENDPOINT, ENDPOINT_VERSION_1);
+}
+
 std::string Endpoints::ServerUpdate() const
 {
     return build_inproc_path(SERVER_UPDATE_ENDPOINT, ENDPOINT_VERSION_1);
@@ -11,12 +11,14 @@ class Endpoints final : public opentxs::api::Endpoints
 {
 public:
     std::string AccountUpdate() const override;
+    std::string BoxUpdate() const override;
     std::string ConnectionStatus() const override;
     std::string ContactUpdate() const override;
     std::string IssuerUpdate() const override;
     std::string NymDownload() const override;
     std::string PairEvent() const override;
     std::string PendingBailment() const override;
+    std::string RemoteBoxUpdate() const override;
     std::string ServerUpdate() const override;
     std::string ThreadUpdate(const std::string& thread) const override;
     std::string WidgetUpdate() const override;
@@ -94,6 +94,7 @@ Wallet::Wallet(const api::Core& core)
     , nymfile_map_lock_()
     , nymfile_lock_()
     , account_publisher_(api_.ZeroMQ().PublishSocket())
+    , box_publisher_(api_.ZeroMQ().PublishSocket())
     , issuer_publisher_(api_.ZeroMQ().PublishSocket())
     , nym_publisher_(api_.ZeroMQ().PublishSocket())
     , server_publisher_(api_.ZeroMQ().PublishSocket())
@@ -102,6 +103,7 @@ Wallet::Wallet(const api::Core& core)
     , dht_unit_requester_{api_.ZeroMQ().RequestSocket()}
 {
     account_publisher_->Start(api_.Endpoints().AccountUpdate());
+    box_publisher_->Start(api_.Endpoints().BoxUpdate());
     issuer_publisher_->Start(api_.Endpoints().IssuerUpdate());
     nym_publisher_->Start(api_.Endpoints().NymDownload());
     server_publisher_->Start(api_.Endpoints().ServerUpdate());
@@ -174,7 +176,19 @@ SharedAccount Wallet::Account(const Identifier& accountID) const
         auto& rowMutex = std::get<0>(row);
         auto& pAccount = std::get<1>(row);
 
-        if (pAccount) { return SharedAccount(pAccount.get(), rowMutex); }
+        if (pAccount) {
+            const auto* pointer = pAccount.get();
+            // Rows are never removed from the map so they remain valid after
+            // the map lock is released. Waiting for the row while holding the
+            // map lock would deadlock against a thread which holds this
+            // account exclusively and needs to check out another one.
+            mapLock.unlock();
+            SharedAccount output(pointer, rowMutex);
+
+            // The account may have been deleted before the row lock was
+            // obtained
+            if (pAccount.get() == pointer) { return output; }
+        }
     } catch (...) {
 
         return {};
@@ -275,6 +289,20 @@ OTIdentifier Wallet::AccountPartialMatch(const std::string& hint) const
     return Identifier::Factory();
 }
 
+void Wallet::BoxUpdated(
+    const ledgerType type,
+    const Identifier& notaryID,
+    const Identifier& accountID,
+    const Identifier& hash) const
+{
+    auto message = opentxs::network::zeromq::Message::Factory();
+    message->AddFrame(Data::Factory(&type, sizeof(type)));
+    message->AddFrame(notaryID.str());
+    message->AddFrame(accountID.str());
+    message->AddFrame(hash.str());
+    box_publisher_->Publish(message);
+}
+
 ExclusiveAccount Wallet::CreateAccount(
     const Identifier& ownerNymID,
     const Identifier& notaryID,
@@ -437,10 +465,13 @@ ExclusiveAccount Wallet::mutable_Account(const Identifier& accountID) const
                                std::unique_ptr<opentxs::Account>& in,
                                eLock& lock,
                                bool success) -> void {
-                this->save(id, in, lock, success);
+                if (in) { this->save(id, in, lock, success); }
             };
+            // See Account()
+            mapLock.unlock();
+            ExclusiveAccount output(&pAccount, rowMutex, callback);
 
-            return ExclusiveAccount(&pAccount, rowMutex, callback);
+            if (pAccount) { return output; }
         }
     } catch (...) {
 
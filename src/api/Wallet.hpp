@@ -23,6 +23,11 @@ class Wallet : virtual public opentxs::api::Wallet, public Lockable
 public:
     SharedAccount Account(const Identifier& accountID) const override;
     OTIdentifier AccountPartialMatch(const std::string& hint) const override;
+    void BoxUpdated(
+        const ledgerType type,
+        const Identifier& notaryID,
+        const Identifier& accountID,
+        const Identifier& hash) const override;
     ExclusiveAccount CreateAccount(
         const Identifier& ownerNymID,
         const Identifier& notaryID,
@@ -235,6 +240,7 @@ private:
     mutable std::mutex nymfile_map_lock_;
     mutable std::map<OTIdentifier, std::mutex> nymfile_lock_;
     OTZMQPublishSocket account_publisher_;
+    OTZMQPublishSocket box_publisher_;
     OTZMQPublishSocket issuer_publisher_;
     OTZMQPublishSocket nym_publisher_;
     OTZMQPublishSocket server_publisher_;
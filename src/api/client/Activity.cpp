@@ -642,6 +642,18 @@ std::shared_ptr<proto::StorageThread> Activity::Thread(
     return output;
 }
 
+std::shared_ptr<proto::StorageThread> Activity::Thread(
+    const Identifier& nymID,
+    const Identifier& threadID,
+    const std::size_t count) const
+{
+    sLock lock(shared_lock_);
+    std::shared_ptr<proto::StorageThread> output;
+    api_.Storage().Load(nymID.str(), threadID.str(), count, output);
+
+    return output;
+}
+
 void Activity::thread_preload_thread(
     const std::string nymID,
     const std::string threadID,
@@ -157,6 +157,10 @@ public:
     std::shared_ptr<proto::StorageThread> Thread(
         const Identifier& nymID,
         const Identifier& threadID) const override;
+    std::shared_ptr<proto::StorageThread> Thread(
+        const Identifier& nymID,
+        const Identifier& threadID,
+        const std::size_t count) const override;
 
     /**   Obtain a list of thread ids for the specified nym
      *
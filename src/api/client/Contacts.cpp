@@ -662,8 +662,10 @@ void Contacts::start()
         case 0:
         case 1: {
             rLock lock(lock_);
+            api_.Storage().StartBatch();
             init_nym_map(lock);
             import_contacts(lock);
+            api_.Storage().CommitBatch();
         }
         case 2:
         default: {
@@ -11,6 +11,7 @@
 #include "opentxs/api/client/Sync.hpp"
 #include "opentxs/api/client/ServerAction.hpp"
 #include "opentxs/api/client/Workflow.hpp"
+#include "opentxs/api/network/ZMQ.hpp"
 #include "opentxs/api/crypto/Encode.hpp"
 #include "opentxs/api/storage/Storage.hpp"
 #include "opentxs/api/Endpoints.hpp"
@@ -56,6 +57,8 @@
 #include <chrono>
 #include <memory>
 #include <map>
+#include <set>
+#include <string>
 #include <thread>
 #include <tuple>
 
@@ -65,6 +68,8 @@
 #define CONTRACT_DOWNLOAD_MILLISECONDS 10000
 #define MAIN_LOOP_MILLISECONDS 5000
 #define NYM_REGISTRATION_MILLISECONDS 10000
+// Nyms whose box updates are pushed are still polled at this interval
+#define NOTIFIED_POLL_SECONDS 60
 
 #define SHUTDOWN()                                                             \
     {                                                                          \
@@ -189,8 +194,10 @@ Sync::Sync(
     , client_(client)
     , introduction_server_lock_()
     , nym_fetch_lock_()
+    , poll_lock_()
     , task_status_lock_()
     , refresh_counter_(0)
+    , last_poll_()
     , operations_()
     , server_nym_fetch_()
     , missing_nyms_()
@@ -206,6 +213,13 @@ Sync::Sync(
               }))
     , account_subscriber_(
           client_.ZeroMQ().SubscribeSocket(account_subscriber_callback_.get()))
+    , box_subscriber_callback_(
+          opentxs::network::zeromq::ListenCallback::Factory(
+              [this](const opentxs::network::zeromq::Message& message) -> void {
+                  this->process_box_update(message);
+              }))
+    , box_subscriber_(
+          client_.ZeroMQ().SubscribeSocket(box_subscriber_callback_.get()))
 {
     // WARNING: do not access client_.Wallet() during construction
     const auto endpoint = client_.Endpoints().AccountUpdate();
@@ -214,6 +228,11 @@ Sync::Sync(
     const auto listening = account_subscriber_->Start(endpoint);
 
     OT_ASSERT(listening)
+
+    const auto boxes = box_subscriber_->Start(
+        client_.Endpoints().RemoteBoxUpdate());
+
+    OT_ASSERT(boxes)
 }
 
 std::pair<bool, std::size_t> Sync::accept_incoming(
@@ -899,8 +918,12 @@ bool Sync::download_account(
     OT_ASSERT(false == serverID.empty())
     OT_ASSERT(false == accountID.empty())
 
+    // Catching up on an account writes the boxes, the account and every
+    // workflow the new box items touch, so they share one root update
+    client_.Storage().StartBatch();
     const auto success = client_.ServerAction().DownloadAccount(
         nymID, serverID, accountID, false);
+    client_.Storage().CommitBatch();
 
     return finish_task(taskID, success);
 }
@@ -1481,6 +1504,80 @@ void Sync::process_account(
            << std::endl;
 }
 
+// Queues a download of the box a notary says has changed
+void Sync::process_box_update(
+    const opentxs::network::zeromq::Message& message) const
+{
+    const auto body = message.Body();
+
+    if (5 != body.size()) { return; }
+
+    const auto serverID = Identifier::Factory(std::string(body.at(0)));
+    const auto nymID = Identifier::Factory(std::string(body.at(1)));
+    const std::string type(body.at(2));
+    const auto accountID = Identifier::Factory(std::string(body.at(3)));
+    const std::string hash(body.at(4));
+
+    if (false == client_.Wallet().IsLocalNym(nymID->str())) { return; }
+
+    otInfo << OT_METHOD << __FUNCTION__ << ": " << type << " of nym "
+           << nymID->str() << " changed on server " << serverID->str()
+           << std::endl;
+    const auto taskID(Identifier::Random());
+
+    if ("nymbox" == type) {
+        const auto context = client_.Wallet().ServerContext(nymID, serverID);
+
+        // Our own requests also change the nymbox
+        if (context && (context->LocalNymboxHash()->str() == hash)) { return; }
+
+        auto& queue = get_operations({nymID, serverID});
+        queue.download_nymbox_.Push(taskID, true);
+    } else if ("inbox" == type) {
+        const auto owner = client_.Storage().AccountOwner(accountID);
+
+        if (owner->str() != nymID->str()) { return; }
+
+        // Only the notary of the account may ask for it to be downloaded
+        const auto server = client_.Storage().AccountServer(accountID);
+
+        if (server->str() != serverID->str()) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Account "
+                  << accountID->str() << " is not on server "
+                  << serverID->str() << std::endl;
+
+            return;
+        }
+
+        auto& queue = get_operations({nymID, serverID});
+        queue.download_account_.Push(taskID, accountID);
+    }
+}
+
+// PUB/SUB drops messages, so the boxes of a nym whose updates are pushed are
+// still polled now and then. They are also polled once after every new
+// subscription, since updates published before it were missed.
+bool Sync::poll_boxes(const Identifier& nymID, const Identifier& serverID)
+    const
+{
+    const auto subscription =
+        client_.ZMQ().Subscription(serverID.str(), nymID.str());
+    const auto now = std::chrono::steady_clock::now();
+    Lock lock(poll_lock_);
+    auto& [polled, last] =
+        last_poll_[{Identifier::Factory(nymID), Identifier::Factory(serverID)}];
+    const bool poll =
+        (0 == subscription) || (polled != subscription) ||
+        (std::chrono::seconds(NOTIFIED_POLL_SECONDS) <= (now - last));
+
+    if (poll) {
+        polled = subscription;
+        last = now;
+    }
+
+    return poll;
+}
+
 bool Sync::publish_server_contract(
     const Identifier& taskID,
     const Identifier& nymID,
@@ -1566,6 +1663,8 @@ void Sync::refresh_accounts() const
     otInfo << OT_METHOD << __FUNCTION__ << ": Begin" << std::endl;
     const auto serverList = client_.Wallet().ServerList();
     const auto accounts = client_.Storage().AccountList();
+    // Nyms whose box updates will be announced: nymID, serverID
+    std::set<std::pair<std::string, std::string>> notified{};
 
     for (const auto server : serverList) {
         SHUTDOWN()
@@ -1583,9 +1682,14 @@ void Sync::refresh_accounts() const
 
             if (registered) {
                 otWarn << "is ";
-                auto& queue = get_operations({nymID, serverID});
-                const auto taskID(Identifier::Random());
-                queue.download_nymbox_.Push(taskID, true);
+
+                if (poll_boxes(nymID, serverID)) {
+                    auto& queue = get_operations({nymID, serverID});
+                    const auto taskID(Identifier::Random());
+                    queue.download_nymbox_.Push(taskID, true);
+                } else {
+                    notified.emplace(nymID->str(), serverID->str());
+                }
             } else {
                 otWarn << "is not ";
             }
@@ -1601,6 +1705,9 @@ void Sync::refresh_accounts() const
         const auto accountID = Identifier::Factory(it.first);
         const auto nymID = client_.Storage().AccountOwner(accountID);
         const auto serverID = client_.Storage().AccountServer(accountID);
+
+        if (0 < notified.count({nymID->str(), serverID->str()})) { continue; }
+
         otWarn << OT_METHOD << __FUNCTION__ << ": Account " << accountID->str()
                << ":\n"
                << "  * Owned by nym: " << nymID->str() << "\n"
@@ -194,8 +194,15 @@ private:
     const api::client::Manager& client_;
     mutable std::mutex introduction_server_lock_{};
     mutable std::mutex nym_fetch_lock_{};
+    mutable std::mutex poll_lock_{};
     mutable std::mutex task_status_lock_{};
     mutable std::atomic<std::uint64_t> refresh_counter_{0};
+    // The box update subscription and the time of the last poll of each
+    // context. Guarded by poll_lock_
+    mutable std::map<
+        ContextID,
+        std::pair<std::uint64_t, std::chrono::steady_clock::time_point>>
+        last_poll_;
     mutable std::map<ContextID, OperationQueue> operations_;
     mutable std::map<OTIdentifier, UniqueQueue<OTIdentifier>> server_nym_fetch_;
     UniqueQueue<OTIdentifier> missing_nyms_;
@@ -207,6 +214,8 @@ private:
     mutable std::map<OTIdentifier, OTIdentifier> task_message_id_;
     OTZMQListenCallback account_subscriber_callback_;
     OTZMQSubscribeSocket account_subscriber_;
+    OTZMQListenCallback box_subscriber_callback_;
+    OTZMQSubscribeSocket box_subscriber_;
 
     std::pair<bool, std::size_t> accept_incoming(
         const rLock& lock,
@@ -308,6 +317,9 @@ private:
 #endif  // OT_CASH
     void process_account(
         const opentxs::network::zeromq::Message& message) const;
+    void process_box_update(
+        const opentxs::network::zeromq::Message& message) const;
+    bool poll_boxes(const Identifier& nymID, const Identifier& serverID) const;
     bool publish_server_contract(
         const Identifier& taskID,
         const Identifier& nymID,
@@ -27,6 +27,7 @@
 #include <chrono>
 #include <cstdint>
 #include <ctime>
+#include <iterator>
 #include <memory>
 
 #include "Workflow.hpp"
@@ -1041,6 +1042,26 @@ std::vector<OTIdentifier> Workflow::WorkflowsByAccount(
     return output;
 }
 
+std::vector<OTIdentifier> Workflow::WorkflowsByAccount(
+    const Identifier& nymID,
+    const Identifier& accountID,
+    const proto::PaymentWorkflowType type,
+    const proto::PaymentWorkflowState state) const
+{
+    std::vector<OTIdentifier> output{};
+    const auto workflows = api_.Storage().PaymentWorkflowsByAccount(
+        nymID.str(), accountID.str(), type, state);
+    std::transform(
+        workflows.begin(),
+        workflows.end(),
+        std::back_inserter(output),
+        [](const std::string& id) -> OTIdentifier {
+            return Identifier::Factory(id);
+        });
+
+    return output;
+}
+
 OTIdentifier Workflow::WriteCheque(const opentxs::Cheque& cheque) const
 {
     if (false == isCheque(cheque)) { return Identifier::Factory(); }
@@ -58,6 +58,11 @@ public:
     std::vector<OTIdentifier> WorkflowsByAccount(
         const Identifier& nymID,
         const Identifier& accountID) const override;
+    std::vector<OTIdentifier> WorkflowsByAccount(
+        const Identifier& nymID,
+        const Identifier& accountID,
+        const proto::PaymentWorkflowType type,
+        const proto::PaymentWorkflowState state) const override;
     OTIdentifier WriteCheque(const opentxs::Cheque& cheque) const override;
 
     ~Workflow() = default;
@@ -30,6 +30,9 @@
 #define OT_DEFAULT_SYMMETRIC_BUFFER_SIZE 4096  // in bytes
 #define OT_DEFAULT_PUBLIC_KEYSIZE 128          // in bytes == 4096 bits
 #define OT_DEFAULT_PUBLIC_KEYSIZE_MAX 512      // in bytes == 1024 bits
+#define OT_DEFAULT_COMPRESSION_LEVEL 9         // Z_BEST_COMPRESSION
+#define OT_MIN_COMPRESSION_LEVEL 0             // Z_NO_COMPRESSION
+#define OT_MAX_COMPRESSION_LEVEL 9             // Z_BEST_COMPRESSION
 
 #define OT_KEY_ITERATION_COUNT "iteration_count"
 #define OT_KEY_SYMMETRIC_SALT_SIZE "symmetric_salt_size"
@@ -39,6 +42,7 @@
 #define OT_KEY_SYMMETRIC_BUFFER_SIZE "symmetric_buffer_size"
 #define OT_KEY_PUBLIC_KEYSIZE "public_keysize"
 #define OT_KEY_PUBLIC_KEYSIZE_MAX "public_keysize_max"
+#define OT_KEY_COMPRESSION_LEVEL "compression_level"
 
 namespace opentxs
 {
@@ -98,6 +102,20 @@ bool Config::GetSetAll() const
             OT_DEFAULT_PUBLIC_KEYSIZE_MAX,
             sp_nPublicKeysizeMax))
         return false;
+    if (!GetSetValue(
+            OT_KEY_COMPRESSION_LEVEL,
+            OT_DEFAULT_COMPRESSION_LEVEL,
+            sp_nCompressionLevel))
+        return false;
+
+    if ((OT_MIN_COMPRESSION_LEVEL > sp_nCompressionLevel) ||
+        (OT_MAX_COMPRESSION_LEVEL < sp_nCompressionLevel)) {
+        otErr << "Config::" << __FUNCTION__ << ": Invalid "
+              << OT_KEY_COMPRESSION_LEVEL << " " << sp_nCompressionLevel
+              << ". Using " << OT_DEFAULT_COMPRESSION_LEVEL << " instead."
+              << std::endl;
+        sp_nCompressionLevel = OT_DEFAULT_COMPRESSION_LEVEL;
+    }
 
     return config_.Save();
 }
@@ -137,4 +155,5 @@ std::uint32_t Config::SymmetricBufferSize() const
 }
 std::uint32_t Config::PublicKeysize() const { return sp_nPublicKeysize; }
 std::uint32_t Config::PublicKeysizeMax() const { return sp_nPublicKeysizeMax; }
+std::int32_t Config::CompressionLevel() const { return sp_nCompressionLevel; }
 }  // namespace opentxs::api::crypto::implementation
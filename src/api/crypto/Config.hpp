@@ -20,6 +20,7 @@ public:
     std::uint32_t SymmetricBufferSize() const override;
     std::uint32_t PublicKeysize() const override;
     std::uint32_t PublicKeysizeMax() const override;
+    std::int32_t CompressionLevel() const override;
 
 private:
     friend opentxs::Factory;
@@ -33,6 +34,7 @@ private:
     mutable std::int32_t sp_nSymmetricBufferSize{0};
     mutable std::int32_t sp_nPublicKeysize{0};
     mutable std::int32_t sp_nPublicKeysizeMax{0};
+    mutable std::int32_t sp_nCompressionLevel{0};
 
     bool GetSetAll() const;
     bool GetSetValue(
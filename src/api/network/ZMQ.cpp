@@ -58,9 +58,11 @@ ZMQ::ZMQ(const api::Core& api, const Flag& running)
     , socks_proxy_()
     , server_connections_()
     , status_publisher_(api_.ZeroMQ().PublishSocket())
+    , box_publisher_(api_.ZeroMQ().PublishSocket())
 {
     // WARNING: do not access api_.Wallet() during construction
     status_publisher_->Start(api_.Endpoints().ConnectionStatus());
+    box_publisher_->Start(api_.Endpoints().RemoteBoxUpdate());
 
     Lock lock(lock_);
 
@@ -138,6 +140,16 @@ OTZMQContext ZMQ::NewContext() const
     return OTZMQContext(opentxs::network::zeromq::Context::Factory());
 }
 
+bool ZMQ::Notifications(const std::string& server) const
+{
+    Lock lock(lock_);
+    const auto it = server_connections_.find(server);
+
+    if (server_connections_.end() == it) { return false; }
+
+    return it->second->Notifications();
+}
+
 std::chrono::seconds ZMQ::ReceiveTimeout() const
 {
     return receive_timeout_.load();
@@ -168,7 +180,7 @@ opentxs::network::ServerConnection& ZMQ::Server(const std::string& id) const
     auto [it, created] = server_connections_.emplace(
         id,
         opentxs::network::ServerConnection::Factory(
-            api_, *this, status_publisher_, contract));
+            api_, *this, status_publisher_, box_publisher_, contract));
     auto& connection = it->second;
 
     OT_ASSERT(created);
@@ -255,6 +267,18 @@ ConnectionState ZMQ::Status(const std::string& server) const
     return ConnectionState::NOT_ESTABLISHED;
 }
 
+std::uint64_t ZMQ::Subscription(
+    const std::string& server,
+    const std::string& nymID) const
+{
+    Lock lock(lock_);
+    const auto it = server_connections_.find(server);
+
+    if (server_connections_.end() == it) { return 0; }
+
+    return it->second->Subscription(nymID);
+}
+
 bool ZMQ::verify_lock(const Lock& lock) const
 {
     if (lock.mutex() != &lock_) {
@@ -16,6 +16,7 @@ public:
     void KeepAlive(const std::chrono::seconds duration) const override;
     std::chrono::seconds Linger() const override;
     OTZMQContext NewContext() const override;
+    bool Notifications(const std::string& server) const override;
     std::chrono::seconds ReceiveTimeout() const override;
     void RefreshConfig() const override;
     const Flag& Running() const override;
@@ -27,6 +28,9 @@ public:
     std::string SocksProxy() const override;
     bool SocksProxy(std::string& proxy) const override;
     ConnectionState Status(const std::string& server) const override;
+    std::uint64_t Subscription(
+        const std::string& server,
+        const std::string& nymID) const override;
 
     ~ZMQ();
 
@@ -43,6 +47,7 @@ private:
     mutable std::string socks_proxy_;
     mutable std::map<std::string, OTServerConnection> server_connections_;
     OTZMQPublishSocket status_publisher_;
+    OTZMQPublishSocket box_publisher_;
 
     bool verify_lock(const Lock& lock) const;
 
@@ -318,6 +318,11 @@ const std::string Manager::GetUserTerms() const
     return get_arg(OPENTXS_ARG_TERMS);
 }
 
+const std::string Manager::GetWorkerThreads() const
+{
+    return get_arg(OPENTXS_ARG_WORKERTHREADS);
+}
+
 const Identifier& Manager::ID() const { return server_.GetServerID(); }
 
 void Manager::Init()
@@ -485,6 +490,7 @@ void Manager::Start()
 
     message_processor_.init(
         (proto::ADDRESSTYPE_INPROC == type), port, *privateKey);
+    server_.StartMarketData((proto::ADDRESSTYPE_INPROC == type), *privateKey);
     message_processor_.Start();
 #if OT_CASH
     ScanMints();
@@ -31,6 +31,7 @@ public:
 #endif  // OT_CASH
     const std::string GetUserName() const override;
     const std::string GetUserTerms() const override;
+    const std::string GetWorkerThreads() const override;
     const Identifier& ID() const override;
     const Identifier& NymID() const override;
 #if OT_CASH
@@ -153,6 +153,13 @@ api::storage::StorageInternal* Factory::Storage(
         defaultGcInterval,
         configGcInterval,
         notUsed);
+    const std::int64_t defaultCacheSize{storageConfig.cache_size_};
+    config.CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "cache_size",
+        defaultCacheSize,
+        storageConfig.cache_size_,
+        notUsed);
     config.CheckSet_str(
         STORAGE_CONFIG_KEY,
         "path",
@@ -193,6 +200,12 @@ api::storage::StorageInternal* Factory::Storage(
         notUsed);
     encryptedDirectory =
         String(storageConfig.fs_encrypted_backup_directory_.c_str());
+    config.CheckSet_bool(
+        STORAGE_CONFIG_KEY,
+        "fs_archive_compression",
+        storageConfig.fs_archive_compression_,
+        storageConfig.fs_archive_compression_,
+        notUsed);
 #endif
 #if OT_STORAGE_SQLITE
     config.CheckSet_str(
@@ -225,6 +238,51 @@ api::storage::StorageInternal* Factory::Storage(
         String(storageConfig.sqlite3_db_file_),
         storageConfig.sqlite3_db_file_,
         notUsed);
+    config.CheckSet_str(
+        STORAGE_CONFIG_KEY,
+        "sqlite3_synchronous",
+        String(storageConfig.sqlite3_synchronous_),
+        storageConfig.sqlite3_synchronous_,
+        notUsed);
+#endif
+#if OT_STORAGE_LMDB
+    const std::int64_t defaultMapSize{storageConfig.lmdb_map_size_};
+    config.CheckSet_str(
+        STORAGE_CONFIG_KEY,
+        "lmdb_primary",
+        String(storageConfig.lmdb_primary_bucket_),
+        storageConfig.lmdb_primary_bucket_,
+        notUsed);
+    config.CheckSet_str(
+        STORAGE_CONFIG_KEY,
+        "lmdb_secondary",
+        String(storageConfig.lmdb_secondary_bucket_),
+        storageConfig.lmdb_secondary_bucket_,
+        notUsed);
+    config.CheckSet_str(
+        STORAGE_CONFIG_KEY,
+        "lmdb_control",
+        String(storageConfig.lmdb_control_table_),
+        storageConfig.lmdb_control_table_,
+        notUsed);
+    config.CheckSet_str(
+        STORAGE_CONFIG_KEY,
+        "lmdb_root_key",
+        String(storageConfig.lmdb_root_key_),
+        storageConfig.lmdb_root_key_,
+        notUsed);
+    config.CheckSet_str(
+        STORAGE_CONFIG_KEY,
+        "lmdb_db_file",
+        String(storageConfig.lmdb_db_file_),
+        storageConfig.lmdb_db_file_,
+        notUsed);
+    config.CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "lmdb_map_size",
+        defaultMapSize,
+        storageConfig.lmdb_map_size_,
+        notUsed);
 #endif
 
     if (haveGCInterval) {
@@ -262,6 +320,7 @@ Storage::Storage(
     : running_(running)
     , gc_interval_(config.gc_interval_)
     , write_lock_()
+    , batch_depth_(0)
     , root_(nullptr)
     , primary_bucket_(Flag::Factory(false))
     , background_threads_()
@@ -578,7 +637,27 @@ void Storage::Cleanup_Storage()
 
 void Storage::Cleanup() { Cleanup_Storage(); }
 
-void Storage::CollectGarbage() const { Root().Migrate(multiplex_.Primary()); }
+std::uint64_t Storage::CacheHits() const { return multiplex_.CacheHits(); }
+
+std::uint64_t Storage::CacheMisses() const { return multiplex_.CacheMisses(); }
+
+bool Storage::CommitBatch() const
+{
+    Lock lock(write_lock_);
+
+    if (0 == batch_depth_) {
+        otErr << OT_METHOD << __FUNCTION__ << ": No batch in progress."
+              << std::endl;
+
+        return false;
+    }
+
+    --batch_depth_;
+
+    if (0 < batch_depth_) { return true; }
+
+    return multiplex_.CommitBatch();
+}
 
 std::string Storage::ContactAlias(const std::string& id) const
 {
@@ -1010,6 +1089,15 @@ bool Storage::Load(
     const std::string& nymId,
     const std::string& threadId,
     std::shared_ptr<proto::StorageThread>& thread) const
+{
+    return Load(nymId, threadId, 0, thread);
+}
+
+bool Storage::Load(
+    const std::string& nymId,
+    const std::string& threadId,
+    const std::size_t count,
+    std::shared_ptr<proto::StorageThread>& thread) const
 {
     const bool exists =
         Root().Tree().NymNode().Nym(nymId).Threads().Exists(threadId);
@@ -1020,8 +1108,13 @@ bool Storage::Load(
 
     if (!thread) { return false; }
 
-    *thread =
-        Root().Tree().NymNode().Nym(nymId).Threads().Thread(threadId).Items();
+    *thread = Root()
+                  .Tree()
+                  .NymNode()
+                  .Nym(nymId)
+                  .Threads()
+                  .Thread(threadId)
+                  .Items(count);
 
     return bool(thread);
 }
@@ -1295,6 +1388,23 @@ std::set<std::string> Storage::PaymentWorkflowsByAccount(
         accountID);
 }
 
+std::vector<std::string> Storage::PaymentWorkflowsByAccount(
+    const std::string& nymID,
+    const std::string& accountID,
+    const proto::PaymentWorkflowType type,
+    const proto::PaymentWorkflowState state) const
+{
+    if (false == Root().Tree().NymNode().Exists(nymID)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Nym " << nymID
+              << " doesn't exist." << std::endl;
+
+        return {};
+    }
+
+    return Root().Tree().NymNode().Nym(nymID).PaymentWorkflows().ListByAccount(
+        accountID, type, state);
+}
+
 std::set<std::string> Storage::PaymentWorkflowsByState(
     const std::string& nymID,
     const proto::PaymentWorkflowType type,
@@ -1570,7 +1680,16 @@ void Storage::RunGC() const
 {
     if (!running_) { return; }
 
-    CollectGarbage();
+    const auto& root = Root();
+    Lock lock(write_lock_);
+
+    // Garbage collection sweeps the primary plugin, which does not contain
+    // anything written during an open batch yet. The lock is held until the
+    // collection has begun marking, after which a new batch is safe because
+    // its objects are marked when they are committed.
+    if (0 < batch_depth_) { return; }
+
+    root.Migrate(multiplex_);
 }
 
 void Storage::RunMapPublicNyms(NymLambda lambda) const
@@ -1794,6 +1913,15 @@ ObjectList Storage::ServerList() const
 
 void Storage::start() { InitPlugins(); }
 
+void Storage::StartBatch() const
+{
+    Lock lock(write_lock_);
+
+    if (0 == batch_depth_) { multiplex_.StartBatch(); }
+
+    ++batch_depth_;
+}
+
 bool Storage::Store(
     const std::string& accountID,
     const std::string& data,
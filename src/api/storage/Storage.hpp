@@ -86,6 +86,9 @@ public:
         proto::ContactItemType chain,
         std::string address) const override;
     ObjectList BlockchainTransactionList() const override;
+    std::uint64_t CacheHits() const override;
+    std::uint64_t CacheMisses() const override;
+    bool CommitBatch() const override;
     std::string ContactAlias(const std::string& id) const override;
     ObjectList ContactList() const override;
     ObjectList ContextList(const std::string& nymID) const override;
@@ -202,6 +205,11 @@ public:
         const std::string& nymId,
         const std::string& threadId,
         std::shared_ptr<proto::StorageThread>& thread) const override;
+    bool Load(
+        const std::string& nymId,
+        const std::string& threadId,
+        const std::size_t count,
+        std::shared_ptr<proto::StorageThread>& thread) const override;
     bool Load(
         const std::string& id,
         std::shared_ptr<proto::UnitDefinition>& contract,
@@ -230,6 +238,11 @@ public:
     std::set<std::string> PaymentWorkflowsByAccount(
         const std::string& nymID,
         const std::string& accountID) const override;
+    std::vector<std::string> PaymentWorkflowsByAccount(
+        const std::string& nymID,
+        const std::string& accountID,
+        const proto::PaymentWorkflowType type,
+        const proto::PaymentWorkflowState state) const override;
     std::set<std::string> PaymentWorkflowsByState(
         const std::string& nymID,
         const proto::PaymentWorkflowType type,
@@ -280,6 +293,7 @@ public:
         const std::string& alias) const override;
     bool SetUnitDefinitionAlias(const std::string& id, const std::string& alias)
         const override;
+    void StartBatch() const override;
     bool Store(
         const std::string& accountID,
         const std::string& data,
@@ -357,6 +371,7 @@ private:
     const Flag& running_;
     std::int64_t gc_interval_{std::numeric_limits<std::int64_t>::max()};
     mutable std::mutex write_lock_;
+    mutable std::size_t batch_depth_{0};
     mutable std::unique_ptr<opentxs::storage::Root> root_;
     mutable OTFlag primary_bucket_;
     std::vector<std::thread> background_threads_;
@@ -370,7 +385,6 @@ private:
 
     void Cleanup();
     void Cleanup_Storage();
-    void CollectGarbage() const;
     void InitBackup() override;
     void InitEncryptedBackup(opentxs::crypto::key::Symmetric& key) override;
     void InitPlugins();
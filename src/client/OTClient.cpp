@@ -49,6 +49,7 @@
 #include "opentxs/core/Ledger.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Message.hpp"
+#include "opentxs/core/NumList.hpp"
 #include "opentxs/core/Nym.hpp"
 #include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/OTTransaction.hpp"
@@ -65,6 +66,7 @@
 #include <cstdio>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
 
 #define OT_METHOD "opentxs::OTClient::"
@@ -2741,16 +2743,329 @@ bool OTClient::processServerReplyGetNymBox(
     return true;
 }
 
+// Verifies a box receipt from the notary and saves it. Instrument notices are
+// also added to the payment inbox, and peer objects to the activity records.
+bool OTClient::process_box_receipt(
+    ServerContext& context,
+    const std::int64_t boxType,
+    const TransactionNumber number,
+    const String& strTransTypeObject)
+{
+    const auto& nymID = context.Nym()->ID();
+    const auto& serverNym = context.RemoteNym();
+    const auto& strNotaryID = String(context.Server());
+    bool saved{false};
+    std::unique_ptr<OTTransactionType> pTransType;
+
+    if (strTransTypeObject.Exists())
+        pTransType = api_.Factory().Transaction(strTransTypeObject);
+
+    if (false == bool(pTransType))
+        otErr << OT_METHOD << __FUNCTION__
+              << ": getBoxReceiptResponse: Error instantiating transaction "
+                 "type based on box receipt:\n\n"
+              << strTransTypeObject << "\n";
+    else {
+        OTTransaction* pBoxReceipt =
+            dynamic_cast<OTTransaction*>(pTransType.get());
+
+        if (nullptr == pBoxReceipt)
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": getBoxReceiptResponse: Error dynamic_cast from "
+                     "transaction type to transaction, based on "
+                     "box receipt:\n\n"
+                  << strTransTypeObject << "\n\n";
+        else if (!pBoxReceipt->VerifyAccount(serverNym))
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": getBoxReceiptResponse: Error: Box Receipt "
+                  << pBoxReceipt->GetTransactionNum() << " in "
+                  << ((boxType == 0) ? "nymbox"
+                                     : ((boxType == 1) ? "inbox" : "outbox"))
+                  << " fails VerifyAccount().\n";  // outbox is 2.);
+        else if (pBoxReceipt->GetTransactionNum() != number)
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": getBoxReceiptResponse: Error: Transaction Number "
+                     "doesn't match on the box receipt itself ("
+                  << pBoxReceipt->GetTransactionNum()
+                  << "), versus the one listed in the reply message ("
+                  << number << ").\n";
+        // Note: Account ID and Notary ID were already verified, in
+        // VerifyAccount().
+        else if (pBoxReceipt->GetNymID() != nymID) {
+            const String strPurportedNymID(pBoxReceipt->GetNymID());
+            otErr
+                << __FUNCTION__
+                << ": getBoxReceiptResponse: Error: NymID doesn't match on "
+                   "the box receipt itself ("
+                << strPurportedNymID
+                << "), versus the one listed in the reply message ("
+                << String(nymID) << ").\n";
+        } else  // FINALLY we have the Ledger AND the Box Receipt both
+                // loaded at the same time.
+        {  // UPDATE: Not loading the ledger at this point. Not necessary.
+            // Faster without it.
+
+            // UPDATE: We will ASSUME the abbreviated receipt is in the
+            // NYMBOX, which is WHY we are now downloading the FULL BOX
+            // RECEIPT. We will SAVE it for the Nymbox, which finishes
+            // the Nymbox (already in box as abbreviated, and already
+            // saved in full in box receipts folder). Next we will also
+            // add it to the PAYMENT INBOX and RECORD BOX, if it's the
+            // right sort of receipt. We will also save THEIR versions
+            // of the FULL BOX RECEIPT, just as we did for the Nymbox
+            // here.
+
+            const auto rcpt_type = pBoxReceipt->GetType();
+            //---------------------------------------------------
+            if (transactionType::message == rcpt_type) {
+                String strOTMessage;
+                pBoxReceipt->GetReferenceString(strOTMessage);
+                auto pMessage = api_.Factory().Message();
+
+                OT_ASSERT(false != bool(pMessage));
+
+                //
+                // The original message that was sent to me by the sender
+                // (with an encrypted envelope in the payload, and with the
+                // sender's ID and recipient IDs as m_strNymID and
+                // m_strNymID2) is stored within strOTMessage. Let's load it
+                // up into an OTMessage instance,  and save it into whatever
+                // box is its true destination. (The Nymbox is simply going
+                // to "accept" it -- to get it removed. It was for temporary
+                // transit purposes only in there).
+                //
+                if (pMessage->LoadContractFromString(strOTMessage)) {
+                    const auto recipientNymId =
+                        Identifier::Factory(pMessage->m_strNymID2);
+                    const auto senderNymID =
+                        Identifier::Factory(pMessage->m_strNymID);
+
+                    if (senderNymID->empty()) {
+                        otErr << OT_METHOD << __FUNCTION__
+                              << ": Missing sender nym ID" << std::endl;
+                    } else {
+                        contacts_.NymToContact(senderNymID);
+                    }
+
+                    if (recipientNymId == nymID) {
+                        const auto peerObject = PeerObject::Factory(
+                            contacts_,
+                            api_.Wallet(),
+                            context.Nym(),
+                            pMessage->m_ascPayload);
+                        proto::PeerObjectType type =
+                            proto::PEEROBJECT_ERROR;
+
+                        if (peerObject) { type = peerObject->Type(); }
+
+                        switch (type) {
+                            case (proto::PEEROBJECT_MESSAGE): {
+                                activity_.Mail(
+                                    recipientNymId,
+                                    *pMessage,
+                                    StorageBox::MAILINBOX);
+                            } break;
+                            case (proto::PEEROBJECT_PAYMENT): {
+                                const bool bCreated =
+                                    createInstrumentNoticeFromPeerObject(
+                                        context,
+                                        *pMessage,
+                                        *peerObject,
+                                        pBoxReceipt->GetTransactionNum());
+
+                                if (!bCreated) {
+                                    otErr << OT_METHOD << __FUNCTION__
+                                          << ": Failed unexpectedly in "
+                                             "createInstrumentNoticeFromPee"
+                                             "rObject."
+                                          << std::endl;
+                                }
+                            } break;
+                            case (proto::PEEROBJECT_REQUEST): {
+                                api_.Wallet().PeerRequestReceive(
+                                    recipientNymId, *peerObject);
+                            } break;
+                            case (proto::PEEROBJECT_RESPONSE): {
+                                api_.Wallet().PeerReplyReceive(
+                                    recipientNymId, *peerObject);
+                            } break;
+                            default: {
+                                otErr << OT_METHOD << __FUNCTION__
+                                      << ": Unable to decode peer object: "
+                                      << "unknown peer object type."
+                                      << std::endl;
+                            }
+                        }
+                    } else {
+                        otErr << OT_METHOD << __FUNCTION__
+                              << ": Missing recipient nym." << std::endl;
+                    }
+                } else {
+                    otErr << OT_METHOD << __FUNCTION__
+                          << ": Unable to decode peer object: "
+                          << "failed to deserialize message." << std::endl;
+                }
+            }  // if (transactionType::message == rcpt_type)
+            //---------------------------------------------------
+            else if (
+                (transactionType::instrumentNotice == rcpt_type) ||
+                (transactionType::instrumentRejection == rcpt_type)) {
+                // Just make sure not to add it if it's already there...
+                if (!strNotaryID.Exists()) {
+                    otErr << OT_METHOD << __FUNCTION__
+                          << ": strNotaryID doesn't exist!\n";
+                    OT_FAIL;
+                }
+                if (!String(context.Nym()->ID()).Exists()) {
+                    otErr << OT_METHOD << __FUNCTION__
+                          << ": strNymID doesn't exist!\n";
+                    OT_FAIL;
+                }
+                const bool bExists = OTDB::Exists(
+                    api_.DataFolder(),
+                    OTFolders::PaymentInbox().Get(),
+                    strNotaryID.Get(),
+                    String(context.Nym()->ID()).Get(),
+                    "");
+                auto thePmntInbox = api_.Factory().Ledger(
+                    nymID,
+                    nymID,
+                    context.Server());  // payment inbox
+
+                OT_ASSERT(false != bool(thePmntInbox));
+
+                bool bSuccessLoading =
+                    (bExists && thePmntInbox->LoadPaymentInbox());
+                if (bExists && bSuccessLoading)
+                    bSuccessLoading =
+                        (thePmntInbox->VerifyContractID() &&
+                         thePmntInbox->VerifySignature(*context.Nym()));
+                // No need here to load all the box receipts using
+                // VerifyAccount.
+                //                      bSuccessLoading =
+                //                      (thePmntInbox->VerifyAccount(*pNym));
+                else if (!bExists)
+                    bSuccessLoading = thePmntInbox->GenerateLedger(
+                        nymID,
+                        context.Server(),
+                        ledgerType::paymentInbox,
+                        true);  // bGenerateFile=true
+                // By this point, the nymbox DEFINITELY exists -- or not.
+                // (generation might have failed, or verification.)
+
+                if (!bSuccessLoading) {
+                    String strNymID(nymID), strAcctID(nymID);
+                    otOut << __FUNCTION__
+                          << ": getBoxReceiptResponse: WARNING: Unable to "
+                             "load, verify, or generate paymentInbox, "
+                             "with IDs: "
+                          << strNymID << " / " << strAcctID << "\n";
+                } else  // --- ELSE --- Success loading the payment inbox
+                        // and recordBox and verifying their contractID
+                        // and signature, (OR success generating the
+                        // ledger.)
+                {
+                    // The transaction (which we are putting into the
+                    // payment inbox) will not be removed from the nymbox
+                    // until we receive the server's success reply to this
+                    // "process Nymbox" message. That's why you see me
+                    // adding it here to the payment inbox, while not
+                    // removing it from the Nymbox (because that will
+                    // happen once the reply is received.) NOTE: Need to
+                    // make sure the associated box receipt doesn't get
+                    // MARKED FOR DELETION when being removed at that time.
+                    //
+                    // void load_str_trans_add_to_ledger(const Identifier&
+                    //  the_nym_id, const OTString& str_trans,
+                    //                                   const OTString
+                    //                                   str_box_type, const
+                    //                                   std::int64_t&
+                    //                                   lTransNum,
+                    //                                   OTPseudonym&
+                    //                                   the_nym, OTLedger&
+                    //                                   ledger);
+
+                    // Basically we are taking this receipt from the
+                    // Nymbox, and also adding copies of it
+                    // to the paymentInbox and the recordBox.
+                    //
+                    // QUESTION: what if I ERASE it out of my recordBox.
+                    // Won't it pop back up again?
+                    // ANSWER: YES, but not if I do this instead at
+                    // getBoxReceiptResponse which will only happen once.
+                    // UPDATE: which I now AM (see our location here...)
+                    // HOWEVER: Most likely not, because this notice
+                    // will no longer BE in my Nymbox...
+                    //
+                    // QUESTION: What if I ERASE it out of my
+                    // paymentInbox? Won't this pop back there again?
+                    //
+                    // ANSWER: I can't erase it out of there. I can
+                    // either accept it or reject it. Either way,
+                    // it is removed from my paymentInbox at that time
+                    // by OT. Like above, if a copy were still
+                    // in the Nymbox, I would get a duplicate here when
+                    // processing Nymbox again. But MOST TIMES,
+                    // there will be no duplicate, because it will
+                    // already be cleaned out of my Nymbox anyway.
+                    //
+                    //
+                    const auto lTransNum = pBoxReceipt->GetTransactionNum();
+
+                    // If pBoxReceipt->GetType() is instrument notice,
+                    // add to the payments inbox.
+                    // (It will be moved to record box after the
+                    // incoming payment is deposited or discarded.)
+                    //
+                    load_str_trans_add_to_ledger(
+                        nymID,
+                        strTransTypeObject,
+                        "paymentInbox",
+                        lTransNum,
+                        *context.Nym(),
+                        *thePmntInbox);
+                }  // --- ELSE --- Success loading the payment inbox and
+                   // verifying its contractID and signature, OR success
+                   // generating the ledger.
+
+            }  // if pBoxReceipt is instrumentNotice or
+               // instrumentRejection...
+
+            //              pBoxReceipt->ReleaseSignatures();
+
+            // I don't release the server's signature, so later on I can
+            // verify either signature -- the server's or pNym's. Both
+            // should be on the receipt. UPDATE: We're not changing the
+            // content of the Box Receipt AT ALL because we don't want
+            // to change its message digest, which will be compared to
+            // the hash stored in the abbreviated version of the same
+            // receipt.
+            //
+            //              pBoxReceipt->SignContract(*context.Nym());
+            //              pBoxReceipt->SaveContract();
+
+            //              if (!pBoxReceipt->SaveBoxReceipt(*pLedger)) //
+            //              <==============
+            if (!pBoxReceipt->SaveBoxReceipt(boxType))
+                otErr << OT_METHOD << __FUNCTION__
+                      << ": getBoxReceiptResponse(): Failed trying to "
+                         "SaveBoxReceipt. Contents:\n\n"
+                      << strTransTypeObject << "\n\n";
+            else
+                saved = true;
+            // Value of boxType can be: 0/nymbox,1/inbox,2/outbox
+        }  // We can save the box receipt.
+    }      // Success loading the boxReceipt from the server reply
+
+    return saved;
+}
+
 bool OTClient::processServerReplyGetBoxReceipt(
     const Message& theReply,
     Ledger* pNymbox,
     ServerContext& context)
 {
     setRecentHash(theReply, false, context);
-    const auto& nym = *context.Nym();
-    const auto& nymID = nym.ID();
-    const auto& serverNym = context.RemoteNym();
-    const auto& strNotaryID = String(context.Server());
 
     otInfo << "Received server response to getBoxReceipt request ("
            << (theReply.m_bSuccess ? "success" : "failure") << ")\n";
@@ -2797,318 +3112,65 @@ bool OTClient::processServerReplyGetBoxReceipt(
         // base64-Decode the server reply's payload into strTransaction
         //
         const String strTransTypeObject(theReply.m_ascPayload);
-        std::unique_ptr<OTTransactionType> pTransType;
+        process_box_receipt(
+            context,
+            theReply.m_lDepth,
+            theReply.m_lTransactionNum,
+            strTransTypeObject);
+    }  // No error condition.
+    else {
+        otErr
+            << __FUNCTION__
+            << ": SHOULD NEVER HAPPEN: getBoxReceiptResponse: failure loading "
+               "box, or verifying it. NymID: "
+            << theReply.m_strNymID << "  AcctID: " << theReply.m_strAcctID
+            << " \n";
+    }
+
+    return true;
+}
 
-        if (strTransTypeObject.Exists())
-            pTransType = api_.Factory().Transaction(strTransTypeObject);
+bool OTClient::processServerReplyGetBoxReceipts(
+    const Message& theReply,
+    ServerContext& context)
+{
+    setRecentHash(theReply, false, context);
 
-        if (false == bool(pTransType))
+    otInfo << "Received server response to getBoxReceipts request ("
+           << (theReply.m_bSuccess ? "success" : "failure") << ")\n";
+
+    switch (theReply.m_lDepth) {
+        case 0:
+        case 1:
+        case 2:
+            break;
+        default:
             otErr << OT_METHOD << __FUNCTION__
-                  << ": getBoxReceiptResponse: Error instantiating transaction "
-                     "type based on decoded theReply.m_ascPayload:\n\n"
-                  << strTransTypeObject << "\n";
-        else {
-            OTTransaction* pBoxReceipt =
-                dynamic_cast<OTTransaction*>(pTransType.get());
-
-            if (nullptr == pBoxReceipt)
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": getBoxReceiptResponse: Error dynamic_cast from "
-                         "transaction type to transaction, based on "
-                         "decoded theReply.m_ascPayload:\n\n"
-                      << strTransTypeObject << "\n\n";
-            else if (!pBoxReceipt->VerifyAccount(serverNym))
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": getBoxReceiptResponse: Error: Box Receipt "
-                      << pBoxReceipt->GetTransactionNum() << " in "
-                      << ((theReply.m_lDepth == 0)
-                              ? "nymbox"
-                              : ((theReply.m_lDepth == 1) ? "inbox" : "outbox"))
-                      << " fails VerifyAccount().\n";  // outbox is 2.);
-            else if (
-                pBoxReceipt->GetTransactionNum() != theReply.m_lTransactionNum)
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": getBoxReceiptResponse: Error: Transaction Number "
-                         "doesn't match on the box receipt itself ("
-                      << pBoxReceipt->GetTransactionNum()
-                      << "), versus the one listed in the reply message ("
-                      << theReply.m_lTransactionNum << ").\n";
-            // Note: Account ID and Notary ID were already verified, in
-            // VerifyAccount().
-            else if (pBoxReceipt->GetNymID() != nymID) {
-                const String strPurportedNymID(pBoxReceipt->GetNymID());
-                otErr
-                    << __FUNCTION__
-                    << ": getBoxReceiptResponse: Error: NymID doesn't match on "
-                       "the box receipt itself ("
-                    << strPurportedNymID
-                    << "), versus the one listed in the reply message ("
-                    << theReply.m_strNymID << ").\n";
-            } else  // FINALLY we have the Ledger AND the Box Receipt both
-                    // loaded at the same time.
-            {  // UPDATE: Not loading the ledger at this point. Not necessary.
-                // Faster without it.
-
-                // UPDATE: We will ASSUME the abbreviated receipt is in the
-                // NYMBOX, which is WHY we are now downloading the FULL BOX
-                // RECEIPT. We will SAVE it for the Nymbox, which finishes
-                // the Nymbox (already in box as abbreviated, and already
-                // saved in full in box receipts folder). Next we will also
-                // add it to the PAYMENT INBOX and RECORD BOX, if it's the
-                // right sort of receipt. We will also save THEIR versions
-                // of the FULL BOX RECEIPT, just as we did for the Nymbox
-                // here.
-
-                const auto rcpt_type = pBoxReceipt->GetType();
-                //---------------------------------------------------
-                if (transactionType::message == rcpt_type) {
-                    String strOTMessage;
-                    pBoxReceipt->GetReferenceString(strOTMessage);
-                    auto pMessage = api_.Factory().Message();
-
-                    OT_ASSERT(false != bool(pMessage));
+                  << ": Unknown box type: " << theReply.m_lDepth << std::endl;
 
-                    //
-                    // The original message that was sent to me by the sender
-                    // (with an encrypted envelope in the payload, and with the
-                    // sender's ID and recipient IDs as m_strNymID and
-                    // m_strNymID2) is stored within strOTMessage. Let's load it
-                    // up into an OTMessage instance,  and save it into whatever
-                    // box is its true destination. (The Nymbox is simply going
-                    // to "accept" it -- to get it removed. It was for temporary
-                    // transit purposes only in there).
-                    //
-                    if (pMessage->LoadContractFromString(strOTMessage)) {
-                        const auto recipientNymId =
-                            Identifier::Factory(pMessage->m_strNymID2);
-                        const auto senderNymID =
-                            Identifier::Factory(pMessage->m_strNymID);
+            return true;
+    }
 
-                        if (senderNymID->empty()) {
-                            otErr << OT_METHOD << __FUNCTION__
-                                  << ": Missing sender nym ID" << std::endl;
-                        } else {
-                            contacts_.NymToContact(senderNymID);
-                        }
+    std::set<TransactionNumber> numbers{};
+    NumList(String(theReply.m_ascPayload)).Output(numbers);
+    const auto& receipts = theReply.m_Attachments;
+    const auto count = static_cast<std::size_t>(theReply.m_lTransactionNum);
 
-                        if (recipientNymId == nymID) {
-                            const auto peerObject = PeerObject::Factory(
-                                contacts_,
-                                api_.Wallet(),
-                                context.Nym(),
-                                pMessage->m_ascPayload);
-                            proto::PeerObjectType type =
-                                proto::PEEROBJECT_ERROR;
-
-                            if (peerObject) { type = peerObject->Type(); }
-
-                            switch (type) {
-                                case (proto::PEEROBJECT_MESSAGE): {
-                                    activity_.Mail(
-                                        recipientNymId,
-                                        *pMessage,
-                                        StorageBox::MAILINBOX);
-                                } break;
-                                case (proto::PEEROBJECT_PAYMENT): {
-                                    const bool bCreated =
-                                        createInstrumentNoticeFromPeerObject(
-                                            context,
-                                            *pMessage,
-                                            *peerObject,
-                                            pBoxReceipt->GetTransactionNum());
-
-                                    if (!bCreated) {
-                                        otErr << OT_METHOD << __FUNCTION__
-                                              << ": Failed unexpectedly in "
-                                                 "createInstrumentNoticeFromPee"
-                                                 "rObject."
-                                              << std::endl;
-                                    }
-                                } break;
-                                case (proto::PEEROBJECT_REQUEST): {
-                                    api_.Wallet().PeerRequestReceive(
-                                        recipientNymId, *peerObject);
-                                } break;
-                                case (proto::PEEROBJECT_RESPONSE): {
-                                    api_.Wallet().PeerReplyReceive(
-                                        recipientNymId, *peerObject);
-                                } break;
-                                default: {
-                                    otErr << OT_METHOD << __FUNCTION__
-                                          << ": Unable to decode peer object: "
-                                          << "unknown peer object type."
-                                          << std::endl;
-                                }
-                            }
-                        } else {
-                            otErr << OT_METHOD << __FUNCTION__
-                                  << ": Missing recipient nym." << std::endl;
-                        }
-                    } else {
-                        otErr << OT_METHOD << __FUNCTION__
-                              << ": Unable to decode peer object: "
-                              << "failed to deserialize message." << std::endl;
-                    }
-                }  // if (transactionType::message == rcpt_type)
-                //---------------------------------------------------
-                else if (
-                    (transactionType::instrumentNotice == rcpt_type) ||
-                    (transactionType::instrumentRejection == rcpt_type)) {
-                    // Just make sure not to add it if it's already there...
-                    if (!strNotaryID.Exists()) {
-                        otErr << OT_METHOD << __FUNCTION__
-                              << ": strNotaryID doesn't exist!\n";
-                        OT_FAIL;
-                    }
-                    if (!String(context.Nym()->ID()).Exists()) {
-                        otErr << OT_METHOD << __FUNCTION__
-                              << ": strNymID doesn't exist!\n";
-                        OT_FAIL;
-                    }
-                    const bool bExists = OTDB::Exists(
-                        api_.DataFolder(),
-                        OTFolders::PaymentInbox().Get(),
-                        strNotaryID.Get(),
-                        String(context.Nym()->ID()).Get(),
-                        "");
-                    auto thePmntInbox = api_.Factory().Ledger(
-                        nymID,
-                        nymID,
-                        context.Server());  // payment inbox
-
-                    OT_ASSERT(false != bool(thePmntInbox));
-
-                    bool bSuccessLoading =
-                        (bExists && thePmntInbox->LoadPaymentInbox());
-                    if (bExists && bSuccessLoading)
-                        bSuccessLoading =
-                            (thePmntInbox->VerifyContractID() &&
-                             thePmntInbox->VerifySignature(*context.Nym()));
-                    // No need here to load all the box receipts using
-                    // VerifyAccount.
-                    //                      bSuccessLoading =
-                    //                      (thePmntInbox->VerifyAccount(*pNym));
-                    else if (!bExists)
-                        bSuccessLoading = thePmntInbox->GenerateLedger(
-                            nymID,
-                            context.Server(),
-                            ledgerType::paymentInbox,
-                            true);  // bGenerateFile=true
-                    // By this point, the nymbox DEFINITELY exists -- or not.
-                    // (generation might have failed, or verification.)
-
-                    if (!bSuccessLoading) {
-                        String strNymID(nymID), strAcctID(nymID);
-                        otOut << __FUNCTION__
-                              << ": getBoxReceiptResponse: WARNING: Unable to "
-                                 "load, verify, or generate paymentInbox, "
-                                 "with IDs: "
-                              << strNymID << " / " << strAcctID << "\n";
-                    } else  // --- ELSE --- Success loading the payment inbox
-                            // and recordBox and verifying their contractID
-                            // and signature, (OR success generating the
-                            // ledger.)
-                    {
-                        // The transaction (which we are putting into the
-                        // payment inbox) will not be removed from the nymbox
-                        // until we receive the server's success reply to this
-                        // "process Nymbox" message. That's why you see me
-                        // adding it here to the payment inbox, while not
-                        // removing it from the Nymbox (because that will
-                        // happen once the reply is received.) NOTE: Need to
-                        // make sure the associated box receipt doesn't get
-                        // MARKED FOR DELETION when being removed at that time.
-                        //
-                        // void load_str_trans_add_to_ledger(const Identifier&
-                        //  the_nym_id, const OTString& str_trans,
-                        //                                   const OTString
-                        //                                   str_box_type, const
-                        //                                   std::int64_t&
-                        //                                   lTransNum,
-                        //                                   OTPseudonym&
-                        //                                   the_nym, OTLedger&
-                        //                                   ledger);
-
-                        // Basically we are taking this receipt from the
-                        // Nymbox, and also adding copies of it
-                        // to the paymentInbox and the recordBox.
-                        //
-                        // QUESTION: what if I ERASE it out of my recordBox.
-                        // Won't it pop back up again?
-                        // ANSWER: YES, but not if I do this instead at
-                        // getBoxReceiptResponse which will only happen once.
-                        // UPDATE: which I now AM (see our location here...)
-                        // HOWEVER: Most likely not, because this notice
-                        // will no longer BE in my Nymbox...
-                        //
-                        // QUESTION: What if I ERASE it out of my
-                        // paymentInbox? Won't this pop back there again?
-                        //
-                        // ANSWER: I can't erase it out of there. I can
-                        // either accept it or reject it. Either way,
-                        // it is removed from my paymentInbox at that time
-                        // by OT. Like above, if a copy were still
-                        // in the Nymbox, I would get a duplicate here when
-                        // processing Nymbox again. But MOST TIMES,
-                        // there will be no duplicate, because it will
-                        // already be cleaned out of my Nymbox anyway.
-                        //
-                        //
-                        const auto lTransNum = pBoxReceipt->GetTransactionNum();
+    // The receipts are attached in the same order as the list
+    if ((numbers.size() != count) || (receipts.size() != count)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Expected " << count
+              << " box receipts, but the reply lists " << numbers.size()
+              << " and has " << receipts.size() << " attached." << std::endl;
 
-                        // If pBoxReceipt->GetType() is instrument notice,
-                        // add to the payments inbox.
-                        // (It will be moved to record box after the
-                        // incoming payment is deposited or discarded.)
-                        //
-                        load_str_trans_add_to_ledger(
-                            nymID,
-                            strTransTypeObject,
-                            "paymentInbox",
-                            lTransNum,
-                            *context.Nym(),
-                            *thePmntInbox);
-                    }  // --- ELSE --- Success loading the payment inbox and
-                       // verifying its contractID and signature, OR success
-                       // generating the ledger.
-
-                }  // if pBoxReceipt is instrumentNotice or
-                   // instrumentRejection...
-
-                //              pBoxReceipt->ReleaseSignatures();
-
-                // I don't release the server's signature, so later on I can
-                // verify either signature -- the server's or pNym's. Both
-                // should be on the receipt. UPDATE: We're not changing the
-                // content of the Box Receipt AT ALL because we don't want
-                // to change its message digest, which will be compared to
-                // the hash stored in the abbreviated version of the same
-                // receipt.
-                //
-                //              pBoxReceipt->SignContract(*context.Nym());
-                //              pBoxReceipt->SaveContract();
+        return true;
+    }
 
-                //              if (!pBoxReceipt->SaveBoxReceipt(*pLedger)) //
-                //              <==============
-                if (!pBoxReceipt->SaveBoxReceipt(
-                        theReply.m_lDepth))  // <===================
-                    otErr << OT_METHOD << __FUNCTION__
-                          << ": getBoxReceiptResponse(): Failed trying to "
-                             "SaveBoxReceipt. Contents:\n\n"
-                          << strTransTypeObject << "\n\n";
-                // theReply.m_lDepth in this context stores boxType.
-                // Value can be: 0/nymbox,1/inbox,2/outbox
-
-            }  // We can save the box receipt.
-        }      // Success loading the boxReceipt from the server reply
-    }          // No error condition.
-    else {
-        otErr
-            << __FUNCTION__
-            << ": SHOULD NEVER HAPPEN: getBoxReceiptResponse: failure loading "
-               "box, or verifying it. NymID: "
-            << theReply.m_strNymID << "  AcctID: " << theReply.m_strAcctID
-            << " \n";
+    auto receipt = receipts.begin();
+
+    for (const auto& number : numbers) {
+        process_box_receipt(
+            context, theReply.m_lDepth, number, String(*receipt));
+        ++receipt;
     }
 
     return true;
@@ -7305,6 +7367,9 @@ bool OTClient::processServerReply(
     if (theReply.m_strCommand.Compare("getBoxReceiptResponse")) {
         return processServerReplyGetBoxReceipt(theReply, pNymbox, context);
     }
+    if (theReply.m_strCommand.Compare("getBoxReceiptsResponse")) {
+        return processServerReplyGetBoxReceipts(theReply, context);
+    }
     if ((theReply.m_strCommand.Compare("processInboxResponse") ||
          theReply.m_strCommand.Compare("processNymboxResponse"))) {
 
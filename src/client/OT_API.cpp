@@ -11205,6 +11205,53 @@ CommandResult OT_API::getBoxReceipt(
     return output;
 }
 
+CommandResult OT_API::getBoxReceipts(
+    ServerContext& context,
+    const Identifier& accountID,
+    const std::int32_t boxType,
+    const std::set<TransactionNumber>& numbers) const
+{
+    rLock lock(
+        lock_callback_({context.Nym()->ID().str(), context.Server().str()}));
+    CommandResult output{};
+    auto& [requestNum, transactionNum, result] = output;
+    auto& [status, reply] = result;
+    requestNum = -1;
+    transactionNum = 0;
+    status = SendResult::ERROR;
+    reply.reset();
+    const auto& nym = *context.Nym();
+    const auto& nymID = nym.ID();
+
+    if (nymID != accountID) {
+        auto account = api_.Wallet().Account(accountID);
+
+        if (false == bool(account)) { return output; }
+    }
+
+    auto [newRequestNumber, message] = context.InitializeServerCommand(
+        MessageType::getBoxReceipts, requestNum);
+    requestNum = newRequestNumber;
+
+    if (false == bool(message)) { return output; }
+
+    message->m_strAcctID = String(accountID);
+    message->m_lDepth = static_cast<std::int64_t>(boxType);
+    message->m_bBool = numbers.empty();
+
+    if (false == numbers.empty()) {
+        String serialized{};
+        NumList(numbers).Output(serialized);
+        message->m_ascPayload.SetString(serialized);
+    }
+
+    if (false == context.FinalizeServerCommand(*message)) { return output; }
+
+    result = send_message({}, context, *message);
+
+    return output;
+}
+
 CommandResult OT_API::getAccountData(
     ServerContext& context,
     const Identifier& accountID) const
@@ -1488,6 +1488,107 @@ bool Utility::getBoxReceiptWithErrorCorrection(
     return false;
 }
 
+// called by getBoxReceiptsWithErrorCorrection
+bool Utility::getBoxReceiptsLowLevel(
+    const std::string& accountID,
+    std::int32_t nBoxType,
+    const std::set<TransactionNumber>& numbers,
+    bool& bWasSent)
+{
+    bWasSent = false;
+
+    auto [nRequestNum, transactionNum, result] = api_.OTAPI().getBoxReceipts(
+        context_, Identifier::Factory(accountID), nBoxType, numbers);
+    const auto& [status, reply] = result;
+    [[maybe_unused]] const auto& notUsed1 = transactionNum;
+    [[maybe_unused]] const auto& notUsed3 = nRequestNum;
+
+    switch (status) {
+        case SendResult::VALID_REPLY: {
+            bWasSent = true;
+            setLastReplyReceived(String(*reply).Get());
+
+            return reply->m_bSuccess;
+        } break;
+        case SendResult::TIMEOUT: {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to send getBoxReceipts message due to error."
+                  << std::endl;
+            setLastReplyReceived("");
+
+            return false;
+        } break;
+        default: {
+        }
+    }
+
+    otErr << OT_METHOD << __FUNCTION__ << ": Error" << std::endl;
+    setLastReplyReceived("");
+
+    return false;
+}
+
+// called by insureHaveAllBoxReceipts
+//
+// The notary limits how many receipts it sends in each reply, so this keeps
+// asking for the receipts which are still missing until none are left.
+// Receipts are removed from missing as they are saved.
+bool Utility::getBoxReceiptsWithErrorCorrection(
+    const std::string& notaryID,
+    const std::string& nymID,
+    const std::string& accountID,
+    std::int32_t nBoxType,
+    std::set<TransactionNumber>& missing)
+{
+    std::string strLocation = "Utility::getBoxReceiptsWithErrorCorrection";
+
+    const auto theNotaryID = Identifier::Factory(notaryID),
+               theNymID = Identifier::Factory(nymID),
+               theAccountID = Identifier::Factory(accountID);
+
+    while (false == missing.empty()) {
+        bool bWasSent = false;
+        bool bWasRequestSent = false;
+        bool bDownloaded =
+            getBoxReceiptsLowLevel(accountID, nBoxType, missing, bWasSent);
+
+        if (!bDownloaded && bWasSent &&
+            (0 < context_.UpdateRequestNumber(bWasRequestSent)) &&
+            bWasRequestSent) {
+            bDownloaded =
+                getBoxReceiptsLowLevel(accountID, nBoxType, missing, bWasSent);
+        }
+
+        if (!bDownloaded) {
+            otOut << strLocation
+                  << ": getBoxReceiptsLowLevel failed. (I give up.)\n";
+
+            return false;
+        }
+
+        const auto before = missing.size();
+
+        for (auto it = missing.begin(); it != missing.end();) {
+            if (api_.OTAPI().DoesBoxReceiptExist(
+                    theNotaryID, theNymID, theAccountID, nBoxType, *it)) {
+                it = missing.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        // Asking again would only return the same reply
+        if (before == missing.size()) {
+            otOut << strLocation << ": None of the " << before
+                  << " remaining box receipts were received.\n";
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
 // This function assumes you just downloaded the latest version of the box
 // (inbox, outbox, or nymbox)
 // and its job is to make sure all the related box receipts are downloaded as
@@ -1568,11 +1669,14 @@ bool Utility::insureHaveAllBoxReceipts(
     // At this point, the box is definitely loaded.
     //
     // Next we'll iterate the receipts within, and for each, verify that the
-    // Box Receipt already exists. If not, then we'll download it using
-    // getBoxReceiptLowLevel(). If any download fails, then we break out of the
-    // loop (WITHOUT continuing on to try the rest.)
+    // Box Receipt already exists. The missing ones are downloaded in batches
+    // using getBoxReceiptsWithErrorCorrection(). Any which are still missing
+    // after that are downloaded one at a time using getBoxReceiptLowLevel().
+    // If any download fails, then we break out of the loop (WITHOUT continuing
+    // on to try the rest.)
     //
     auto& map_receipts = pLedger->GetTransactionMap();
+    std::set<TransactionNumber> missing{};
 
     for (auto& receipt_entry : map_receipts) {
         const auto& lTransactionNum = receipt_entry.first;
@@ -1602,37 +1706,45 @@ bool Utility::insureHaveAllBoxReceipts(
         if (bShouldDownload) {
             bool bHaveBoxReceipt = api_.OTAPI().DoesBoxReceiptExist(
                 theNotaryID, theNymID, theAccountID, nBoxType, lTransactionNum);
-            if (!bHaveBoxReceipt) {
-                otWarn << strLocation
-                       << ": Downloading box receipt to add to my collection..."
-                          "\n";
-                const bool bDownloaded = getBoxReceiptWithErrorCorrection(
-                    notaryID, nymID, accountID, nBoxType, lTransactionNum);
-                if (!bDownloaded) {
-                    otOut << strLocation
-                          << ": Failed downloading box receipt. "
-                             "(Skipping any others.) Transaction "
-                             "number: "
-                          << lTransactionNum << "\n";
-
-                    bReturnValue = false;
-                    break;
-                    // No point continuing to loop and fail 500
-                    // times, when
-                    // getBoxReceiptWithErrorCorrection()
-                    // already failed
-                    // even doing the getRequestNumber() trick
-                    // and everything, and whatever retries are
-                    // inside OT, before it finally
-                    // gave up.
-                }
-                // else (Download success.)
-            }  // if (!bHaveBoxReceipt)
+            if (!bHaveBoxReceipt) { missing.emplace(lTransactionNum); }
         }
 
         // else we already have the box receipt, no need to
         // download again.
     }  // for
+
+    if (false == missing.empty()) {
+        otWarn << strLocation << ": Downloading " << missing.size()
+               << " box receipts to add to my collection...\n";
+        getBoxReceiptsWithErrorCorrection(
+            notaryID, nymID, accountID, nBoxType, missing);
+    }
+
+    for (const auto& lTransactionNum : missing) {
+        otWarn << strLocation
+               << ": Downloading box receipt to add to my collection...\n";
+        const bool bDownloaded = getBoxReceiptWithErrorCorrection(
+            notaryID, nymID, accountID, nBoxType, lTransactionNum);
+        if (!bDownloaded) {
+            otOut << strLocation
+                  << ": Failed downloading box receipt. "
+                     "(Skipping any others.) Transaction "
+                     "number: "
+                  << lTransactionNum << "\n";
+
+            bReturnValue = false;
+            break;
+            // No point continuing to loop and fail 500
+            // times, when
+            // getBoxReceiptWithErrorCorrection()
+            // already failed
+            // even doing the getRequestNumber() trick
+            // and everything, and whatever retries are
+            // inside OT, before it finally
+            // gave up.
+        }
+        // else (Download success.)
+    }
     // ----------------------------------------------------------------
     //
     // if nRequestSeeking is >0, that means the caller wants to know if there is
@@ -7,6 +7,7 @@
 
 #include "opentxs/core/Armored.hpp"
 
+#include "opentxs/api/crypto/Config.hpp"
 #include "opentxs/api/crypto/Crypto.hpp"
 #include "opentxs/api/crypto/Encode.hpp"
 #include "opentxs/api/Native.hpp"
@@ -154,7 +155,7 @@ Armored* Armored::clone() const { return new Armored(*this); }
  * the binary data. */
 std::string Armored::compress_string(
     const std::string& str,
-    std::int32_t compressionlevel = Z_BEST_COMPRESSION) const
+    std::int32_t compressionlevel) const
 {
     z_stream zs;  // z_stream is zlib's control structure
     memset(&zs, 0, sizeof(zs));
@@ -165,28 +166,19 @@ std::string Armored::compress_string(
     zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(str.data()));
     zs.avail_in = static_cast<uInt>(str.size());  // set the z_stream's input
 
-    std::int32_t ret;
-    char outbuffer[32768];
-    std::string outstring;
-
-    // retrieve the compressed bytes blockwise
-    do {
-        zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-        zs.avail_out = sizeof(outbuffer);
-
-        ret = deflate(&zs, Z_FINISH);
-
-        if (outstring.size() < zs.total_out) {
-            // append the block to the output string
-            outstring.append(outbuffer, zs.total_out - outstring.size());
-        }
-    } while (ret == Z_OK);
-
+    // deflateBound() is an upper bound on the compressed size, so the whole
+    // input is compressed in a single call without intermediate copies.
+    std::string outstring(deflateBound(&zs, zs.avail_in), '\0');
+    zs.next_out = reinterpret_cast<Bytef*>(&outstring[0]);
+    zs.avail_out = static_cast<uInt>(outstring.size());
+    const std::int32_t ret = deflate(&zs, Z_FINISH);
+    outstring.resize(zs.total_out);
     deflateEnd(&zs);
 
     if (ret != Z_STREAM_END) {  // an error occurred that was not EOF
         std::ostringstream oss;
-        oss << "Exception during zlib compression: (" << ret << ") " << zs.msg;
+        oss << "Exception during zlib compression: (" << ret << ")";
+        if (zs.msg != nullptr) { oss << " " << zs.msg; }
         throw(std::runtime_error(oss.str()));
     }
 
@@ -486,12 +478,33 @@ bool Armored::SaveToExactPath(const std::string& filename)
 
 // Compress and Base64-encode
 bool Armored::SetString(const String& strData, bool bLineBreaks)  //=true
+{
+    return SetString(
+        strData,
+        bLineBreaks,
+        OT::App().Crypto().Config().CompressionLevel());
+}
+
+bool Armored::SetString(
+    const String& strData,
+    bool bLineBreaks,
+    std::int32_t compressionLevel)
 {
     Release();
 
     if (strData.GetLength() < 1) return true;
 
-    std::string str_compressed = compress_string(strData.Get());
+    std::string str_compressed;
+
+    try {
+        str_compressed = compress_string(
+            std::string(strData.Get(), strData.GetLength()), compressionLevel);
+    } catch (const std::runtime_error&) {
+        otErr << "Armored::" << __FUNCTION__ << ": compression failed."
+              << std::endl;
+
+        return false;
+    }
 
     // "Success"
     if (str_compressed.size() == 0) {
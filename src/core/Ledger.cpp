@@ -764,6 +764,10 @@ bool Ledger::save_box(
         if (false == (this->*calc)(hash)) {
             otErr << OT_METHOD << __FUNCTION__
                   << ": Failed trying to calculate box hash." << std::endl;
+        } else if (ledgerType::outbox != type) {
+            // Only the owner changes its outbox
+            api_.Wallet().BoxUpdated(
+                type, GetRealNotaryID(), GetRealAccountID(), hash);
         }
     }
 
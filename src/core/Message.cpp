@@ -68,6 +68,8 @@
 #define GET_NYMBOX_RESPONSE "getNymboxResponse"
 #define GET_BOX_RECEIPT "getBoxReceipt"
 #define GET_BOX_RECEIPT_RESPONSE "getBoxReceiptResponse"
+#define GET_BOX_RECEIPTS "getBoxReceipts"
+#define GET_BOX_RECEIPTS_RESPONSE "getBoxReceiptsResponse"
 #define GET_ACCOUNT_DATA "getAccountData"
 #define GET_ACCOUNT_DATA_RESPONSE "getAccountDataResponse"
 #define PROCESS_NYMBOX "processNymbox"
@@ -149,6 +151,8 @@ const Message::TypeMap Message::message_names_{
     {MessageType::getNymboxResponse, GET_NYMBOX_RESPONSE},
     {MessageType::getBoxReceipt, GET_BOX_RECEIPT},
     {MessageType::getBoxReceiptResponse, GET_BOX_RECEIPT_RESPONSE},
+    {MessageType::getBoxReceipts, GET_BOX_RECEIPTS},
+    {MessageType::getBoxReceiptsResponse, GET_BOX_RECEIPTS_RESPONSE},
     {MessageType::getAccountData, GET_ACCOUNT_DATA},
     {MessageType::getAccountDataResponse, GET_ACCOUNT_DATA_RESPONSE},
     {MessageType::processNymbox, PROCESS_NYMBOX},
@@ -202,6 +206,7 @@ const std::map<MessageType, MessageType> Message::reply_message_{
      MessageType::notarizeTransactionResponse},
     {MessageType::getNymbox, MessageType::getNymboxResponse},
     {MessageType::getBoxReceipt, MessageType::getBoxReceiptResponse},
+    {MessageType::getBoxReceipts, MessageType::getBoxReceiptsResponse},
     {MessageType::getAccountData, MessageType::getAccountDataResponse},
     {MessageType::processNymbox, MessageType::processNymboxResponse},
     {MessageType::processInbox, MessageType::processInboxResponse},
@@ -2791,6 +2796,187 @@ RegisterStrategy StrategyGetBoxReceiptResponse::reg(
     "getBoxReceiptResponse",
     new StrategyGetBoxReceiptResponse());
 
+class StrategyGetBoxReceipts : public OTMessageStrategy
+{
+public:
+    virtual void writeXml(Message& m, Tag& parent)
+    {
+        TagPtr pTag(new Tag(m.m_strCommand.Get()));
+
+        pTag->add_attribute("requestNum", m.m_strRequestNum.Get());
+        pTag->add_attribute("nymID", m.m_strNymID.Get());
+        pTag->add_attribute("notaryID", m.m_strNotaryID.Get());
+        // If retrieving box receipts for Nymbox, NymID
+        // will appear in this variable.
+        pTag->add_attribute("accountID", m.m_strAcctID.Get());
+        pTag->add_attribute(
+            "boxType",  // outbox is 2.
+            (m.m_lDepth == 0) ? "nymbox"
+                              : ((m.m_lDepth == 1) ? "inbox" : "outbox"));
+
+        pTag->add_attribute("allReceipts", formatBool(m.m_bBool));
+
+        if (!m.m_bBool) {
+            pTag->add_tag("transactionNums", m.m_ascPayload.Get());
+        }
+
+        parent.add_tag(pTag);
+    }
+
+    std::int32_t processXml(Message& m, irr::io::IrrXMLReader*& xml)
+    {
+        m.m_strCommand = xml->getNodeName();  // Command
+        m.m_strNymID = xml->getAttributeValue("nymID");
+        m.m_strNotaryID = xml->getAttributeValue("notaryID");
+        m.m_strAcctID = xml->getAttributeValue("accountID");
+        m.m_strRequestNum = xml->getAttributeValue("requestNum");
+
+        const String strBoxType = xml->getAttributeValue("boxType");
+
+        if (strBoxType.Compare("nymbox"))
+            m.m_lDepth = 0;
+        else if (strBoxType.Compare("inbox"))
+            m.m_lDepth = 1;
+        else if (strBoxType.Compare("outbox"))
+            m.m_lDepth = 2;
+        else {
+            m.m_lDepth = 0;
+            otErr << "Error in OTMessage::ProcessXMLNode:\n"
+                     "Expected boxType to be inbox, outbox, or nymbox, in "
+                     "getBoxReceipts\n";
+            return (-1);
+        }
+
+        const String strAll = xml->getAttributeValue("allReceipts");
+        m.m_bBool = strAll.Compare("true");
+
+        if (!m.m_bBool) {
+            const char* pElementExpected = "transactionNums";
+            Armored& ascTextExpected = m.m_ascPayload;
+
+            if (!Contract::LoadEncodedTextFieldByName(
+                    xml, ascTextExpected, pElementExpected)) {
+                otErr << "Error in OTMessage::ProcessXMLNode: "
+                         "Expected "
+                      << pElementExpected << " element with text field, for "
+                      << m.m_strCommand << ".\n";
+                return (-1);  // error condition
+            }
+        }
+
+        otWarn << "\n Command: " << m.m_strCommand
+               << " \n NymID:    " << m.m_strNymID
+               << "\n AccountID:    " << m.m_strAcctID
+               << "\n"
+                  " NotaryID: "
+               << m.m_strNotaryID << "\n Request#: " << m.m_strRequestNum
+               << "   boxType: "
+               << ((m.m_lDepth == 0) ? "nymbox"
+                                     : (m.m_lDepth == 1) ? "inbox" : "outbox")
+               << "\n\n";  // outbox is 2.);
+
+        return 1;
+    }
+    static RegisterStrategy reg;
+};
+RegisterStrategy StrategyGetBoxReceipts::reg(
+    "getBoxReceipts",
+    new StrategyGetBoxReceipts());
+
+// The receipts themselves are attached as additional frames, in the order of
+// the transactionNums list. receiptCount is the number of attached receipts.
+// moreReceipts is set if the notary left some of the requested receipts for a
+// later request.
+class StrategyGetBoxReceiptsResponse : public OTMessageStrategy
+{
+public:
+    virtual void writeXml(Message& m, Tag& parent)
+    {
+        TagPtr pTag(new Tag(m.m_strCommand.Get()));
+
+        pTag->add_attribute("success", formatBool(m.m_bSuccess));
+        pTag->add_attribute("requestNum", m.m_strRequestNum.Get());
+        pTag->add_attribute("nymID", m.m_strNymID.Get());
+        pTag->add_attribute("notaryID", m.m_strNotaryID.Get());
+        pTag->add_attribute("nymboxHash", m.m_strNymboxHash.Get());
+        pTag->add_attribute("accountID", m.m_strAcctID.Get());
+        pTag->add_attribute(
+            "boxType",  // outbox is 2.
+            (m.m_lDepth == 0) ? "nymbox"
+                              : ((m.m_lDepth == 1) ? "inbox" : "outbox"));
+        pTag->add_attribute("moreReceipts", formatBool(m.m_bBool));
+        pTag->add_attribute("receiptCount", formatLong(m.m_lTransactionNum));
+
+        if (m.m_bSuccess && (0 < m.m_lTransactionNum)) {
+            pTag->add_tag("transactionNums", m.m_ascPayload.Get());
+        }
+
+        parent.add_tag(pTag);
+    }
+
+    std::int32_t processXml(Message& m, irr::io::IrrXMLReader*& xml)
+    {
+        processXmlSuccess(m, xml);
+
+        m.m_strCommand = xml->getNodeName();  // Command
+        m.m_strRequestNum = xml->getAttributeValue("requestNum");
+        m.m_strNymID = xml->getAttributeValue("nymID");
+        m.m_strNotaryID = xml->getAttributeValue("notaryID");
+        m.m_strNymboxHash = xml->getAttributeValue("nymboxHash");
+        m.m_strAcctID = xml->getAttributeValue("accountID");
+
+        const String strMore = xml->getAttributeValue("moreReceipts");
+        m.m_bBool = strMore.Compare("true");
+
+        const String strBoxType = xml->getAttributeValue("boxType");
+
+        if (strBoxType.Compare("nymbox"))
+            m.m_lDepth = 0;
+        else if (strBoxType.Compare("inbox"))
+            m.m_lDepth = 1;
+        else if (strBoxType.Compare("outbox"))
+            m.m_lDepth = 2;
+        else {
+            m.m_lDepth = 0;
+            otErr << "Error in OTMessage::ProcessXMLNode:\n"
+                     "Expected boxType to be inbox, outbox, or nymbox, in "
+                     "getBoxReceiptsResponse reply\n";
+            return (-1);
+        }
+
+        String strCount = xml->getAttributeValue("receiptCount");
+        m.m_lTransactionNum = strCount.Exists() ? strCount.ToLong() : 0;
+
+        if (m.m_bSuccess && (0 < m.m_lTransactionNum)) {
+            const char* pElementExpected = "transactionNums";
+            Armored& ascTextExpected = m.m_ascPayload;
+
+            if (!Contract::LoadEncodedTextFieldByName(
+                    xml, ascTextExpected, pElementExpected)) {
+                otErr << "Error in OTMessage::ProcessXMLNode: "
+                         "Expected "
+                      << pElementExpected << " element with text field, for "
+                      << m.m_strCommand << ".\n";
+                return (-1);  // error condition
+            }
+        }
+
+        otWarn << "\nCommand: " << m.m_strCommand << "   "
+               << (m.m_bSuccess ? "SUCCESS" : "FAILED")
+               << "\nNymID:    " << m.m_strNymID
+               << "\nAccountID: " << m.m_strAcctID
+               << "\n"
+                  "NotaryID: "
+               << m.m_strNotaryID << "\n\n";
+
+        return 1;
+    }
+    static RegisterStrategy reg;
+};
+RegisterStrategy StrategyGetBoxReceiptsResponse::reg(
+    "getBoxReceiptsResponse",
+    new StrategyGetBoxReceiptsResponse());
+
 class StrategyUnregisterAccount : public OTMessageStrategy
 {
 public:
@@ -25,15 +25,29 @@
 #include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/OTStringXML.hpp"
 #include "opentxs/core/String.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/PublishSocket.hpp"
 
 #include <irrxml/irrXML.hpp>
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <ostream>
+#include <set>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
+
+#define OT_CRON_ACTIVE_FOLDER "active"
 
 namespace opentxs
 {
@@ -53,15 +67,35 @@ std::int32_t OTCron::__cron_max_items_per_nym =
          // items any given Nym can have
          // active at the same time.
 
+std::int32_t OTCron::__cron_worker_threads =
+    0;  // The number of threads used to
+        // process cron items which do not
+        // share any accounts.
+
+std::int32_t OTCron::__market_snapshot_seconds =
+    60;  // The number of seconds between
+         // published snapshots of every
+         // market.
+
 Timer OTCron::tCron(true);
 
 OTCron::OTCron(const api::Core& server)
     : Contract(server)
+    , m_lockMarkets()
     , m_mapMarkets()
     , m_mapCronItems()
     , m_multimapCronItems()
+    , m_mapMultimapIndex()
+    , m_setDueCronItems()
+    , m_mapDueTimes()
     , m_NOTARY_ID(Identifier::Factory())
+    , m_lockTransactionNumbers()
     , m_listTransactionNumbers()
+    , m_lockChangedCronItems()
+    , m_setChangedCronItems()
+    , m_setRemovedCronItems()
+    , m_MarketPublisher(server.ZeroMQ().PublishSocket())
+    , m_tLastMarketSnapshot(OT_TIME_ZERO)
     , m_bIsActivated(false)
     , m_pServerNym(nullptr)  // just here for convenience, not responsible to
                              // cleanup this pointer.
@@ -70,6 +104,381 @@ OTCron::OTCron(const api::Core& server)
     otLog3 << "OTCron::OTCron: Finished calling InitCron 0.\n";
 }
 
+bool OTCron::apply_cron_result(
+    const std::shared_ptr<OTCronItem>& item,
+    const CronResult result)
+{
+    OT_ASSERT(false != bool(item));
+
+    const auto lTransactionNum = item->GetTransactionNum();
+
+    if (CronResult::Removed == result) {
+        remove_cron_item(lTransactionNum);
+
+        return true;
+    }
+
+    // Only items whose contents changed while processing are written.
+    if (CronResult::Changed == result) { save_cron_item(*item); }
+
+    // Skipped and deferred items were never processed, so they remain due.
+    schedule(*item);
+
+    return false;
+}
+
+time64_t OTCron::due_time(const OTCronItem& item)
+{
+    // ProcessCron() returns immediately unless more than GetProcessInterval()
+    // seconds have elapsed since GetLastProcessDate(). An item which has never
+    // been processed is due right away.
+    if (OT_TIME_ZERO >= item.GetLastProcessDate()) { return OT_TIME_ZERO; }
+
+    return OTTimeAddTimeInterval(
+        item.GetLastProcessDate(), item.GetProcessInterval() + 1);
+}
+
+bool OTCron::erase_cron_item(const std::int64_t lTransactionNum) const
+{
+    String strFilename;
+    strFilename.Format("%" PRId64 ".crn", lTransactionNum);
+
+    if (!OTDB::Exists(
+            api_.DataFolder(),
+            OTFolders::Cron().Get(),
+            OT_CRON_ACTIVE_FOLDER,
+            strFilename.Get(),
+            "")) {
+        return true;
+    }
+
+    return OTDB::EraseValueByKey(
+        api_.DataFolder(),
+        OTFolders::Cron().Get(),
+        OT_CRON_ACTIVE_FOLDER,
+        strFilename.Get(),
+        "");
+}
+
+void OTCron::group_cron_items(
+    const std::vector<std::shared_ptr<OTCronItem>>& due,
+    std::vector<std::vector<std::size_t>>& groups,
+    std::vector<CronKeys>& groupKeys,
+    std::vector<std::size_t>& serial) const
+{
+    // Union-find over conflict keys. Every active item contributes its keys,
+    // not only the due ones, so that items which meet through an item that is
+    // not itself due (a trade matching against a resting offer, for example)
+    // still end up in the same group.
+    std::map<std::string, std::string> parent{};
+    auto root_of = [&parent](const std::string& key) -> std::string {
+        auto root = parent.emplace(key, key).first->second;
+
+        while (parent.at(root) != root) { root = parent.at(root); }
+
+        auto current = key;
+
+        while (current != root) {
+            auto& next = parent.at(current);
+            current = next;
+            next = root;
+        }
+
+        return root;
+    };
+    std::map<std::int64_t, std::set<std::string>> itemKeys{};
+    std::map<std::int64_t, CronKeys> itemLocks{};
+
+    for (const auto& it : m_mapCronItems) {
+        const auto& pItem = it.second;
+
+        OT_ASSERT(false != bool(pItem));
+
+        CronKeys locks{};
+        std::set<std::string> keys{};
+
+        if (false ==
+            pItem->GetConflictKeys(locks.accounts_, locks.nyms_, keys)) {
+            continue;
+        }
+
+        keys.insert(locks.accounts_.begin(), locks.accounts_.end());
+        keys.insert(locks.nyms_.begin(), locks.nyms_.end());
+
+        if (false == keys.empty()) {
+            const auto root = root_of(*keys.begin());
+
+            for (const auto& key : keys) { parent[root_of(key)] = root; }
+        }
+
+        itemKeys.emplace(it.first, std::move(keys));
+        itemLocks.emplace(it.first, std::move(locks));
+    }
+
+    // Every item which shares a root contributes its accounts and nyms to
+    // that root, since processing one of them may reach any of the others.
+    std::map<std::string, CronKeys> rootLocks{};
+
+    for (const auto& [number, keys] : itemKeys) {
+        if (keys.empty()) { continue; }
+
+        auto& locks = rootLocks[root_of(*keys.begin())];
+        const auto& item = itemLocks.at(number);
+        locks.accounts_.insert(item.accounts_.begin(), item.accounts_.end());
+        locks.nyms_.insert(item.nyms_.begin(), item.nyms_.end());
+    }
+
+    std::map<std::string, std::size_t> groupIndex{};
+
+    for (std::size_t i = 0; i < due.size(); ++i) {
+        const auto& pItem = due.at(i);
+        const auto keys = itemKeys.find(pItem->GetTransactionNum());
+
+        if (itemKeys.end() == keys) {
+            serial.push_back(i);
+
+            continue;
+        }
+
+        if (keys->second.empty()) {
+            groups.emplace_back(1, i);
+            groupKeys.emplace_back();
+
+            continue;
+        }
+
+        const auto root = root_of(*keys->second.begin());
+        auto group = groupIndex.find(root);
+
+        if (groupIndex.end() == group) {
+            group = groupIndex.emplace(root, groups.size()).first;
+            groups.emplace_back();
+            groupKeys.emplace_back(rootLocks.at(root));
+        }
+
+        groups.at(group->second).push_back(i);
+    }
+}
+
+// Loads an active cron item from its own file in the cron/active folder. The
+// main cron file only lists the transaction numbers of these items.
+bool OTCron::load_cron_item(
+    const std::int64_t lTransactionNum,
+    const time64_t tDateAdded)
+{
+    String strFilename;
+    strFilename.Format("%" PRId64 ".crn", lTransactionNum);
+
+    // An index written before a crash may still list an item whose file was
+    // already erased. That item had been removed, so there is nothing to load.
+    if (!OTDB::Exists(
+            api_.DataFolder(),
+            OTFolders::Cron().Get(),
+            OT_CRON_ACTIVE_FOLDER,
+            strFilename.Get(),
+            "")) {
+        otErr << "OTCron::" << __FUNCTION__
+              << ": Skipping cron item with no file: " << lTransactionNum
+              << "\n";
+
+        return true;
+    }
+
+    const String strData(OTDB::QueryPlainString(
+        api_.DataFolder(),
+        OTFolders::Cron().Get(),
+        OT_CRON_ACTIVE_FOLDER,
+        strFilename.Get(),
+        ""));
+
+    if (2 > strData.GetLength()) {
+        otErr << "OTCron::" << __FUNCTION__
+              << ": Error reading file: " << OTFolders::Cron()
+              << Log::PathSeparator() << OT_CRON_ACTIVE_FOLDER
+              << Log::PathSeparator() << strFilename << "\n";
+
+        return false;
+    }
+
+    auto pItem{api_.Factory().CronItem(strData)};
+
+    if (false == bool(pItem)) {
+        otErr << "OTCron::" << __FUNCTION__
+              << ": Unable to create cron item from data in file: "
+              << strFilename << "\n";
+
+        return false;
+    }
+
+    std::shared_ptr<OTCronItem> item{pItem.release()};
+
+    if (lTransactionNum != item->GetTransactionNum()) {
+        otErr << "OTCron::" << __FUNCTION__
+              << ": ERROR SECURITY: Wrong transaction number in cron item "
+                 "file: "
+              << strFilename << "\n";
+
+        return false;
+    }
+
+    if (!item->VerifySignature(*m_pServerNym)) {
+        otErr << "OTCron::" << __FUNCTION__
+              << ": ERROR SECURITY: Server signature failed to verify on a "
+                 "cron item while loading: "
+              << lTransactionNum << "\n";
+
+        return false;
+    }
+
+    return AddCronItem(item, false, tDateAdded);
+}
+
+OTCron::CronResult OTCron::process_cron_item(OTCronItem& item)
+{
+    otInfo << "OTCron::" << __FUNCTION__
+           << ": Processing item number: " << item.GetTransactionNum() << " \n";
+
+    const String strBefore(item);
+
+    // If the item returns true, that means leave it on the list. Otherwise,
+    // if it returns false, that means "it's done: remove it."
+    if (item.ProcessCron()) {
+        if (strBefore == String(item)) { return CronResult::Unchanged; }
+
+        return CronResult::Changed;
+    }
+
+    item.HookRemovalFromCron(
+        api_.Wallet(), nullptr, GetNextTransactionNumber());
+    otOut << "OTCron::" << __FUNCTION__
+          << ": Removing cron item: " << item.GetTransactionNum() << "\n";
+
+    return CronResult::Removed;
+}
+
+void OTCron::process_cron_items(
+    const std::vector<std::shared_ptr<OTCronItem>>& due,
+    const std::vector<std::size_t>& indices,
+    const std::int32_t nMinimumNumbers,
+    std::vector<CronResult>& results)
+{
+    for (const auto& index : indices) {
+        // The remaining items stay due and are retried on the next round.
+        if (GetTransactionCount() <= nMinimumNumbers) { return; }
+
+        const auto& pItem = due.at(index);
+
+        OT_ASSERT(false != bool(pItem));
+
+        results.at(index) = process_cron_item(*pItem);
+    }
+}
+
+void OTCron::publish_market_snapshots(const time64_t now)
+{
+    const auto nSeconds = GetMarketSnapshotSeconds();
+
+    if ((false == m_bPublishMarketData.load()) || (1 > nSeconds)) { return; }
+
+    if (OTTimeGetTimeInterval(now, m_tLastMarketSnapshot) < nSeconds) {
+        return;
+    }
+
+    m_tLastMarketSnapshot = now;
+    rLock lock(m_lockMarkets);
+
+    for (const auto& it : m_mapMarkets) {
+        const auto& pMarket = it.second;
+
+        OT_ASSERT(false != bool(pMarket));
+
+        pMarket->PublishSnapshot();
+    }
+}
+
+// Removes an item from every index. Does not call HookRemovalFromCron.
+void OTCron::remove_cron_item(const std::int64_t lTransactionNum)
+{
+    unschedule(lTransactionNum);
+
+    auto it_index = m_mapMultimapIndex.find(lTransactionNum);
+
+    if (m_mapMultimapIndex.end() != it_index) {
+        m_multimapCronItems.erase(it_index->second);
+        m_mapMultimapIndex.erase(it_index);
+    }
+
+    m_mapCronItems.erase(lTransactionNum);
+    Lock lock(m_lockChangedCronItems);
+    m_setChangedCronItems.erase(lTransactionNum);
+    m_setRemovedCronItems.insert(lTransactionNum);
+}
+
+bool OTCron::save_changed_cron_items()
+{
+    Lock lock(m_lockChangedCronItems);
+    auto changed = std::move(m_setChangedCronItems);
+    m_setChangedCronItems.clear();
+    lock.unlock();
+    bool output{true};
+
+    for (const auto& lTransactionNum : changed) {
+        const auto pItem = GetItemByOfficialNum(lTransactionNum);
+
+        if (false == bool(pItem)) { continue; }
+
+        if (false == save_cron_item(*pItem)) {
+            output = false;
+            FlagCronItemChanged(lTransactionNum);
+        }
+    }
+
+    return output;
+}
+
+bool OTCron::save_cron_item(const OTCronItem& item) const
+{
+    String strFilename;
+    strFilename.Format("%" PRId64 ".crn", item.GetTransactionNum());
+    const String strItem(item);
+
+    const bool bSaved = OTDB::StorePlainString(
+        strItem.Get(),
+        api_.DataFolder(),
+        OTFolders::Cron().Get(),
+        OT_CRON_ACTIVE_FOLDER,
+        strFilename.Get(),
+        "");
+
+    if (!bSaved) {
+        otErr << "OTCron::" << __FUNCTION__
+              << ": Error saving file: " << OTFolders::Cron()
+              << Log::PathSeparator() << OT_CRON_ACTIVE_FOLDER
+              << Log::PathSeparator() << strFilename << "\n";
+    }
+
+    return bSaved;
+}
+
+void OTCron::schedule(const OTCronItem& item)
+{
+    const auto lTransactionNum = item.GetTransactionNum();
+    const auto tDue = due_time(item);
+    unschedule(lTransactionNum);
+    m_setDueCronItems.emplace(tDue, lTransactionNum);
+    m_mapDueTimes[lTransactionNum] = tDue;
+}
+
+void OTCron::unschedule(const std::int64_t lTransactionNum)
+{
+    auto it = m_mapDueTimes.find(lTransactionNum);
+
+    if (m_mapDueTimes.end() == it) { return; }
+
+    m_setDueCronItems.erase({it->second, lTransactionNum});
+    m_mapDueTimes.erase(it);
+}
+
 // Make sure Server Nym is set on this cron object before loading or saving,
 // since it's
 // used for signing and verifying..
@@ -89,6 +498,13 @@ bool OTCron::LoadCron()
 
 bool OTCron::SaveCron()
 {
+    if (m_bDeferSave.load()) {
+        m_bSaveRequested.store(true);
+
+        return true;
+    }
+
+    save_changed_cron_items();
     const char* szFoldername = OTFolders::Cron().Get();
     const char* szFilename = "OT-CRON.crn";  // todo stop hardcoding filenames.
 
@@ -103,8 +519,24 @@ bool OTCron::SaveCron()
         otErr << "Error saving main Cronfile:\n"
               << szFoldername << Log::PathSeparator() << szFilename << "\n";
         return false;
-    } else
-        return true;
+    }
+
+    // Files of removed items are only erased once the saved index no longer
+    // lists them.
+    Lock lock(m_lockChangedCronItems);
+    auto removed = std::move(m_setRemovedCronItems);
+    m_setRemovedCronItems.clear();
+    lock.unlock();
+
+    for (const auto& lTransactionNum : removed) {
+        if (!erase_cron_item(lTransactionNum)) {
+            otErr << "OTCron::" << __FUNCTION__
+                  << ": Failed to erase file for cron item: "
+                  << lTransactionNum << "\n";
+        }
+    }
+
+    return true;
 }
 
 // Loops through ALL markets, and calls pMarket->GetNym_OfferList(NYM_ID,
@@ -239,13 +671,11 @@ bool OTCron::GetMarketList(Armored& ascOutput, std::int32_t& nMarketCount)
 
         pMarketData->last_sale_date = pMarket->GetLastSaleDate();
 
-        const mapOfOffers::size_type theBidCount = pMarket->GetBidCount();
-        const mapOfOffers::size_type theAskCount = pMarket->GetAskCount();
+        const std::size_t theBidCount = pMarket->GetBidCount();
+        const std::size_t theAskCount = pMarket->GetAskCount();
 
-        pMarketData->number_bids =
-            to_string<mapOfOffers::size_type>(theBidCount);
-        pMarketData->number_asks =
-            to_string<mapOfOffers::size_type>(theAskCount);
+        pMarketData->number_bids = to_string<std::size_t>(theBidCount);
+        pMarketData->number_asks = to_string<std::size_t>(theAskCount);
 
         // In the past 24 hours.
         // (I'm not collecting this data yet, (maybe never), so these values
@@ -317,6 +747,8 @@ bool OTCron::GetMarketList(Armored& ascOutput, std::int32_t& nMarketCount)
 
 std::int32_t OTCron::GetTransactionCount() const
 {
+    Lock lock(m_lockTransactionNumbers);
+
     if (m_listTransactionNumbers.empty()) return 0;
 
     return static_cast<std::int32_t>(m_listTransactionNumbers.size());
@@ -324,6 +756,7 @@ std::int32_t OTCron::GetTransactionCount() const
 
 void OTCron::AddTransactionNumber(const std::int64_t& lTransactionNum)
 {
+    Lock lock(m_lockTransactionNumbers);
     m_listTransactionNumbers.push_back(lTransactionNum);
 }
 
@@ -331,6 +764,8 @@ void OTCron::AddTransactionNumber(const std::int64_t& lTransactionNum)
 // payment plans until the server object replenishes this list.
 std::int64_t OTCron::GetNextTransactionNumber()
 {
+    Lock lock(m_lockTransactionNumbers);
+
     if (m_listTransactionNumbers.empty()) return 0;
 
     std::int64_t lTransactionNum = m_listTransactionNumbers.front();
@@ -379,8 +814,28 @@ std::int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
         // Make sure to save Cron when it
         // changes.
 
+        nReturnVal = 1;
+    } else if (!strcmp("activeCronItem", xml->getNodeName())) {
+        const std::int64_t lTransactionNum =
+            String::StringToLong(xml->getAttributeValue("transactionNum"));
+        const String str_date_added = xml->getAttributeValue("dateAdded");
+        const std::int64_t lDateAdded =
+            (!str_date_added.Exists() ? 0
+                                      : parseTimestamp(str_date_added.Get()));
+        const time64_t tDateAdded = OTTimeGetTimeFromSeconds(lDateAdded);
+
+        if (!load_cron_item(lTransactionNum, tDateAdded)) {
+            otErr << "OTCron::ProcessXMLNode: Unable to load, verify, or add "
+                     "active cron item: "
+                  << lTransactionNum << "\n";
+            return (-1);
+        }
+
+        otInfo << "Successfully loaded cron item and added to list.\n";
         nReturnVal = 1;
     } else if (!strcmp("cronItem", xml->getNodeName())) {
+        // Cron files written before active items were stored individually
+        // embed each item. Those are moved to their own files as they load.
         const String str_date_added = xml->getAttributeValue("dateAdded");
         const std::int64_t lDateAdded =
             (!str_date_added.Exists() ? 0
@@ -433,6 +888,8 @@ std::int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
                 // as a receipt in the first place -- so we have a record of the
                 // user's authorization.)
                 otInfo << "Successfully loaded cron item and added to list.\n";
+
+                if (!save_cron_item(*item)) { return (-1); }
             } else {
                 otErr << "OTCron::ProcessXMLNode: Though loaded / verified "
                          "successfully, "
@@ -523,17 +980,17 @@ void OTCron::UpdateContents()
         tag.add_tag(tagMarket);
     }
 
-    // Save the Cron Items
+    // Save the Cron Item index (the items themselves are saved in the
+    // cron/active folder.)
     for (auto& it : m_multimapCronItems) {
         auto pItem = it.second;
         OT_ASSERT(false != bool(pItem));
 
         time64_t tDateAdded = it.first;
-        String strItem(*pItem);    // Extract the cron item contract into string
-                                   // form.
-        Armored ascItem(strItem);  // Base64-encode that for storage.
 
-        TagPtr tagCronItem(new Tag("cronItem", ascItem.Get()));
+        TagPtr tagCronItem(new Tag("activeCronItem"));
+        tagCronItem->add_attribute(
+            "transactionNum", formatLong(pItem->GetTransactionNum()));
         tagCronItem->add_attribute("dateAdded", formatTimestamp(tDateAdded));
         tag.add_tag(tagCronItem);
     }
@@ -559,7 +1016,34 @@ std::int64_t OTCron::computeTimeout()
 
 // Make sure to call this regularly so the CronItems get a chance to process and
 // expire.
-void OTCron::ProcessCronItems()
+void OTCron::GetDueCronKeys(CronKeys& keys) const
+{
+    const auto now = OTTimeGetCurrentTime();
+    std::vector<std::shared_ptr<OTCronItem>> due{};
+
+    for (const auto& [tDue, lTransactionNum] : m_setDueCronItems) {
+        if (tDue > now) { break; }
+
+        const auto it = m_mapCronItems.find(lTransactionNum);
+
+        if (m_mapCronItems.end() != it) { due.push_back(it->second); }
+    }
+
+    if (due.empty()) { return; }
+
+    std::vector<std::vector<std::size_t>> groups{};
+    std::vector<CronKeys> groupKeys{};
+    std::vector<std::size_t> serial{};
+    group_cron_items(due, groups, groupKeys, serial);
+    keys.all_ |= (false == serial.empty());
+
+    for (const auto& group : groupKeys) {
+        keys.accounts_.insert(group.accounts_.begin(), group.accounts_.end());
+        keys.nyms_.insert(group.nyms_.begin(), group.nyms_.end());
+    }
+}
+
+void OTCron::ProcessCronItems(const CronKeys* pLocked)
 {
     if (!m_bIsActivated) {
         otErr << "OTCron::ProcessCronItems: Not activated yet. (Skipping.)\n";
@@ -585,50 +1069,129 @@ void OTCron::ProcessCronItems()
                  "ROUND!!!\n\n";
         return;
     }
-    bool bNeedToSave = false;
+    const auto now = OTTimeGetCurrentTime();
+    std::vector<std::shared_ptr<OTCronItem>> due{};
 
-    // loop through the cron items and tell each one to ProcessCron().
-    // If the item returns true, that means leave it on the list. Otherwise,
-    // if it returns false, that means "it's done: remove it."
-    for (auto it = m_multimapCronItems.begin();
-         it != m_multimapCronItems.end();) {
-        if (GetTransactionCount() <= nTwentyPercent) {
-            otErr << "WARNING: Cron has fewer than 20 percent of its normal "
-                     "transaction "
-                     "number count available since the previous cron item "
-                     "alone! \n"
-                     "That is, "
-                  << GetTransactionCount()
-                  << " are currently available, with a max of "
-                  << OTCron::GetCronRefillAmount() << ", meaning "
-                  << OTCron::GetCronRefillAmount() - GetTransactionCount()
-                  << " were used in the current round alone!!! \n"
-                     "SKIPPING THE REMAINDER OF THE CRON ITEMS THAT WERE "
-                     "SCHEDULED FOR THIS ROUND!!!\n\n";
-            break;
+    // Visit only the items whose process interval has elapsed, in the order
+    // they became due.
+    while (false == m_setDueCronItems.empty()) {
+        const auto next = *m_setDueCronItems.begin();
+
+        if (next.first > now) { break; }
+
+        unschedule(next.second);
+        auto pItem = GetItemByOfficialNum(next.second);
+
+        if (pItem) { due.push_back(pItem); }
+    }
+
+    std::vector<CronResult> results(due.size(), CronResult::Skipped);
+    const auto nThreads =
+        static_cast<std::size_t>(std::max(GetCronWorkerThreads(), 1));
+    const bool bLimited = (nullptr != pLocked) && (false == pLocked->all_);
+    std::vector<std::vector<std::size_t>> groups{};
+    std::vector<std::size_t> serial{};
+
+    if (bLimited || ((1 < nThreads) && (1 < due.size()))) {
+        std::vector<CronKeys> groupKeys{};
+        group_cron_items(due, groups, groupKeys, serial);
+
+        if (bLimited) {
+            // An item added, or an offer placed, after the caller collected
+            // its keys may reach accounts which the caller has not locked.
+            auto covered = [&](const CronKeys& keys) -> bool {
+                return std::includes(
+                           pLocked->accounts_.begin(),
+                           pLocked->accounts_.end(),
+                           keys.accounts_.begin(),
+                           keys.accounts_.end()) &&
+                       std::includes(
+                           pLocked->nyms_.begin(),
+                           pLocked->nyms_.end(),
+                           keys.nyms_.begin(),
+                           keys.nyms_.end());
+            };
+            std::vector<std::vector<std::size_t>> lockedGroups{};
+
+            for (std::size_t i = 0; i < groups.size(); ++i) {
+                if (covered(groupKeys.at(i))) {
+                    lockedGroups.emplace_back(std::move(groups.at(i)));
+                } else {
+                    for (const auto& index : groups.at(i)) {
+                        results.at(index) = CronResult::Deferred;
+                    }
+                }
+            }
+
+            for (const auto& index : serial) {
+                results.at(index) = CronResult::Deferred;
+            }
+
+            groups.swap(lockedGroups);
+            serial.clear();
         }
-        auto pItem = it->second;
-        OT_ASSERT(false != bool(pItem));
-        otInfo << "OTCron::" << __FUNCTION__
-               << ": Processing item number: " << pItem->GetTransactionNum()
-               << " \n";
+    } else {
+        serial.resize(due.size());
+        std::iota(serial.begin(), serial.end(), 0);
+    }
 
-        if (pItem->ProcessCron()) {
-            it++;
-            continue;
+    if ((1 < nThreads) && (1 < groups.size())) {
+        std::atomic<std::size_t> nextGroup{0};
+        auto worker = [&]() {
+            for (auto i = nextGroup++; i < groups.size(); i = nextGroup++) {
+                process_cron_items(due, groups.at(i), nTwentyPercent, results);
+            }
+        };
+        std::vector<std::thread> threads{};
+        m_bDeferSave.store(true);
+
+        for (std::size_t i = 1; i < std::min(nThreads, groups.size()); ++i) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for (auto& thread : threads) { thread.join(); }
+
+        m_bDeferSave.store(false);
+    } else {
+        for (const auto& group : groups) {
+            process_cron_items(due, group, nTwentyPercent, results);
         }
-        pItem->HookRemovalFromCron(
-            api_.Wallet(), nullptr, GetNextTransactionNumber());
-        otOut << "OTCron::" << __FUNCTION__
-              << ": Removing cron item: " << pItem->GetTransactionNum() << "\n";
-        it = m_multimapCronItems.erase(it);
-        auto it_map = FindItemOnMap(pItem->GetTransactionNum());
-        OT_ASSERT(m_mapCronItems.end() != it_map);
-        m_mapCronItems.erase(it_map);
-
-        bNeedToSave = true;
     }
-    if (bNeedToSave) SaveCron();
+
+    process_cron_items(due, serial, nTwentyPercent, results);
+
+    bool bNeedToSave = m_bSaveRequested.exchange(false);
+    bool bSkipped = false;
+
+    for (std::size_t i = 0; i < due.size(); ++i) {
+        bSkipped |= (CronResult::Skipped == results.at(i));
+        bNeedToSave |= apply_cron_result(due.at(i), results.at(i));
+    }
+
+    if (bSkipped) {
+        otErr << "WARNING: Cron has fewer than 20 percent of its normal "
+                 "transaction "
+                 "number count available since the previous cron item "
+                 "alone! \n"
+                 "That is, "
+              << GetTransactionCount()
+              << " are currently available, with a max of "
+              << OTCron::GetCronRefillAmount() << ", meaning "
+              << OTCron::GetCronRefillAmount() - GetTransactionCount()
+              << " were used in the current round alone!!! \n"
+                 "SKIPPED THE REMAINDER OF THE CRON ITEMS THAT WERE "
+                 "SCHEDULED FOR THIS ROUND!!!\n\n";
+    }
+
+    if (bNeedToSave) {
+        SaveCron();
+    } else {
+        save_changed_cron_items();
+    }
+
+    publish_market_snapshots(now);
 }
 
 // OTCron IS responsible for cleaning up theItem, and takes ownership.
@@ -681,10 +1244,11 @@ bool OTCron::AddCronItem(
 
         // Insert to the MULTIMAP (by Date)
         //
-        m_multimapCronItems.insert(
-            m_multimapCronItems.upper_bound(tDateAdded),
-            std::pair<time64_t, std::shared_ptr<OTCronItem>>(
-                tDateAdded, theItem));
+        m_mapMultimapIndex[theItem->GetTransactionNum()] =
+            m_multimapCronItems.insert(
+                m_multimapCronItems.upper_bound(tDateAdded),
+                std::pair<time64_t, std::shared_ptr<OTCronItem>>(
+                    tDateAdded, theItem));
 
         theItem->SetCronPointer(*this);
         theItem->setServerNym(m_pServerNym);
@@ -698,6 +1262,8 @@ bool OTCron::AddCronItem(
         // But if actually being activated for the first time, then this is
         // true.
 
+        schedule(*theItem);
+
         // When an item is added to Cron for the first time, a copy of it is
         // saved to the
         // cron folder, and it has the user's original signature on it. (If it's
@@ -722,7 +1288,7 @@ bool OTCron::AddCronItem(
             //            theItem->SaveContract();
 
             // Since we added an item to the Cron, we SAVE it.
-            bSuccess = SaveCron();
+            bSuccess = save_cron_item(*theItem) && SaveCron();
 
             if (bSuccess)
                 otOut << __FUNCTION__
@@ -777,8 +1343,8 @@ bool OTCron::RemoveCronItem(
         pItem->HookRemovalFromCron(
             api_.Wallet(), theRemover, GetNextTransactionNumber());
 
-        m_mapCronItems.erase(it_map);            // Remove from MAP.
-        m_multimapCronItems.erase(it_multimap);  // Remove from MULTIMAP.
+        // Remove from MAP, MULTIMAP, the schedule, and the active folder.
+        remove_cron_item(lTransactionNum);
 
         // An item has been removed from Cron. SAVE.
         return SaveCron();
@@ -787,6 +1353,12 @@ bool OTCron::RemoveCronItem(
     return false;
 }
 
+void OTCron::FlagCronItemChanged(const std::int64_t lTransactionNum)
+{
+    Lock lock(m_lockChangedCronItems);
+    m_setChangedCronItems.insert(lTransactionNum);
+}
+
 // Look up a transaction by transaction number and see if it is in the map.
 // If it is, return an iterator to it, otherwise return m_mapCronItems.end()
 //
@@ -826,18 +1398,15 @@ mapOfCronItems::iterator OTCron::FindItemOnMap(std::int64_t lTransactionNum)
 multimapOfCronItems::iterator OTCron::FindItemOnMultimap(
     std::int64_t lTransactionNum)
 {
-    auto itt = m_multimapCronItems.begin();
+    auto itt = m_mapMultimapIndex.find(lTransactionNum);
 
-    while (m_multimapCronItems.end() != itt) {
-        auto pItem = itt->second;
-        OT_ASSERT(false != bool(pItem));
+    if (m_mapMultimapIndex.end() == itt) { return m_multimapCronItems.end(); }
 
-        if (pItem->GetTransactionNum() == lTransactionNum) break;
-
-        ++itt;
-    }
+    auto pItem = itt->second->second;
+    OT_ASSERT(false != bool(pItem));
+    OT_ASSERT(pItem->GetTransactionNum() == lTransactionNum);
 
-    return itt;
+    return itt->second;
 }
 
 // Look up a transaction by transaction number and see if it is in the map.
@@ -927,6 +1496,7 @@ bool OTCron::AddMarket(
 {
     OT_ASSERT(nullptr != GetServerNym());
 
+    rLock lock(m_lockMarkets);
     theMarket->SetCronPointer(*this);  // This way every Market has a pointer to
                                        // Cron.
 
@@ -992,6 +1562,7 @@ std::shared_ptr<OTMarket> OTCron::GetOrCreateMarket(
     const Identifier& CURRENCY_ID,
     const std::int64_t& lScale)
 {
+    rLock lock(m_lockMarkets);
     auto pMarket{api_.Factory().Market(
         GetNotaryID(), INSTRUMENT_DEFINITION_ID, CURRENCY_ID, lScale)};
 
@@ -1024,6 +1595,7 @@ std::shared_ptr<OTMarket> OTCron::GetOrCreateMarket(
 // If it is, return a pointer to it, otherwise return nullptr.
 std::shared_ptr<OTMarket> OTCron::GetMarket(const Identifier& MARKET_ID)
 {
+    rLock lock(m_lockMarkets);
     String str_MARKET_ID(MARKET_ID);
     std::string std_MARKET_ID = str_MARKET_ID.Get();
 
@@ -1054,6 +1626,41 @@ std::shared_ptr<OTMarket> OTCron::GetMarket(const Identifier& MARKET_ID)
     return nullptr;
 }
 
+void OTCron::PublishMarketData(
+    const Identifier& MARKET_ID,
+    const std::string& type,
+    const std::int64_t lSequence,
+    const std::string& payload) const
+{
+    if (false == m_bPublishMarketData.load()) { return; }
+
+    auto message = network::zeromq::Message::Factory();
+    message->AddFrame(MARKET_ID.str());
+    message->AddFrame(type);
+    message->AddFrame(Data::Factory(&lSequence, sizeof(lSequence)));
+    message->AddFrame(payload);
+    m_MarketPublisher->Publish(message);
+}
+
+bool OTCron::StartMarketData(
+    const std::string& endpoint,
+    const OTPassword& privateKey)
+{
+    if (!m_MarketPublisher->SetPrivateKey(privateKey) ||
+        !m_MarketPublisher->Start(endpoint)) {
+        otErr << "OTCron::" << __FUNCTION__
+              << ": Failed to start market data publisher on " << endpoint
+              << "\n";
+        return false;
+    }
+
+    otErr << "OTCron::" << __FUNCTION__ << ": Publishing market data on "
+          << endpoint << "\n";
+    m_bPublishMarketData.store(true);
+
+    return true;
+}
+
 void OTCron::InitCron() { m_strContractType = "CRON"; }
 
 void OTCron::Release() { Contract::Release(); }
@@ -643,6 +643,14 @@ void OTCronItem::AddClosingTransactionNo(
     m_dequeClosingNumbers.push_back(lClosingTransactionNo);
 }
 
+bool OTCronItem::GetConflictKeys(
+    std::set<std::string>&,
+    std::set<std::string>&,
+    std::set<std::string>&) const
+{
+    return false;
+}
+
 /// See if theNym has rights to remove this item from Cron.
 bool OTCronItem::CanRemoveItemFromCron(const ClientContext& context)
 {
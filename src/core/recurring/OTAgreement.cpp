@@ -695,6 +695,19 @@ bool OTAgreement::ProcessCron()
     return true;
 }
 
+bool OTAgreement::GetConflictKeys(
+    std::set<std::string>& accounts,
+    std::set<std::string>& nyms,
+    std::set<std::string>&) const
+{
+    accounts.insert(String(GetSenderAcctID()).Get());
+    nyms.insert(String(GetSenderNymID()).Get());
+    accounts.insert(String(GetRecipientAcctID()).Get());
+    nyms.insert(String(GetRecipientNymID()).Get());
+
+    return true;
+}
+
 /// See if theNym has rights to remove this item from Cron.
 ///
 bool OTAgreement::CanRemoveItemFromCron(const ClientContext& context)
@@ -1196,42 +1196,9 @@ void OTPaymentPlan::ProcessInitialPayment(const api::Wallet& wallet)
     // saved inside the ProcessPayment() call as part of constructing the
     // receipt.
 
-    // Since this' data file is actually a blob as part of Cron,
-    // then we need to save Cron as well. Only then are these changes truly
-    // saved.
-    // I'm actually lucky to even be able to save cron here, since I know for a
-    // fact
-    // that I have to save no matter what. In cases where I don't know for sure,
-    // the
-    // save call has to go a level deeper, since only there would the code know
-    // whether
-    // or not something has actually changed.
-    // HMM Todo: Look into adding a "DIRTY" field to OT objects.
-    // Double-hmm, todo: I could make a series of macros for serializable member
-    // variables,
-    // that would deal with all the xml read/write very compactly, and
-    // automatically track
-    // whether the variable was dirty. Then anywhere in the code I can just ask
-    // an object
-    // if it is dirty, or instruct it to update itself if it is.  Anyway, let's
-    // save Cron...
-
-    GetCron()->SaveCron();
-
-    // Todo: put the actual Cron items in separate files, so I don't have to
-    // update
-    // the entire cron file every time an item changes. That way the main cron
-    // file
-    // can just keep a record of the active items, and will change only when an
-    // item
-    // is added or removed.
-    //
-    // Until then, the entire Cron file will have to save EVERY time this call
-    // happens.
-    //
-    // (I'll add something to Cron so it can't save more than once per second or
-    // something.)
-    // (DONE: Payment Plans process hourly and Trades process every 10 seconds.)
+    // This payment plan is stored in its own cron file, which is written
+    // along with the other changed items instead of rewriting all of Cron.
+    GetCron()->FlagCronItemChanged(GetTransactionNum());
 }
 
 /*
@@ -1292,12 +1259,9 @@ void OTPaymentPlan::ProcessPaymentPlan(const api::Wallet& wallet)
     // saved inside the ProcessPayment() call as part of constructing the
     // receipt.
 
-    // Either way, Cron should save, since it just updated.
-    // (The above function call WILL change this payment plan
-    // and re-sign it and save it, no matter what. So I just
-    // call this here to keep it simple:
-
-    GetCron()->SaveCron();
+    // The above function call WILL change this payment plan and re-sign it,
+    // no matter what, so its cron file needs to be written.
+    GetCron()->FlagCronItemChanged(GetTransactionNum());
 }
 
 // OTCron calls this regularly, which is my chance to expire, etc.
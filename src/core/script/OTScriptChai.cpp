@@ -24,10 +24,105 @@
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
+
+#define OT_SCRIPT_CHAI_IDLE_ENGINES 16
 
 namespace opentxs
 {
+namespace
+{
+// Building a ChaiScript engine registers the whole standard library, which
+// costs far more than running a typical clause. Engines are kept after use
+// and put back into the state they had when they were built, so the bindings
+// and globals added for one script are never visible to the next. An engine
+// is only handed to one script at a time, so nested and concurrent scripts
+// each get their own.
+class EnginePool
+{
+public:
+    chaiscript::ChaiScript* Get()
+    {
+        Lock lock(lock_);
+
+        if (false == idle_.empty()) {
+            auto* output = idle_.back();
+            idle_.pop_back();
+
+            return output;
+        }
+
+        lock.unlock();
+        std::unique_ptr<Engine> engine(new Engine);
+        auto* output = engine->chai_.get();
+        lock.lock();
+        engines_.emplace(output, std::move(engine));
+
+        return output;
+    }
+    void Return(chaiscript::ChaiScript* chai)
+    {
+        Lock lock(lock_);
+        auto it = engines_.find(chai);
+
+        OT_ASSERT(engines_.end() != it);
+
+        auto& engine = *it->second;
+        lock.unlock();
+        const bool reset = engine.Reset();
+        lock.lock();
+
+        if (reset && (OT_SCRIPT_CHAI_IDLE_ENGINES > idle_.size())) {
+            idle_.push_back(chai);
+        } else {
+            engines_.erase(chai);
+        }
+    }
+
+private:
+    struct Engine {
+        std::unique_ptr<chaiscript::ChaiScript> chai_;
+        const chaiscript::ChaiScript::State state_;
+        const std::map<std::string, chaiscript::Boxed_Value> locals_;
+
+        bool Reset()
+        {
+            try {
+                chai_->set_state(state_);
+                chai_->set_locals(locals_);
+            } catch (...) {
+                otErr << "OTScriptChai: Failed to reset script engine.\n";
+
+                return false;
+            }
+
+            return true;
+        }
+
+        Engine()
+            : chai_(new chaiscript::ChaiScript)
+            , state_(chai_->get_state())
+            , locals_(chai_->get_locals())
+        {
+        }
+    };
+
+    std::mutex lock_;
+    std::map<chaiscript::ChaiScript*, std::unique_ptr<Engine>> engines_;
+    std::vector<chaiscript::ChaiScript*> idle_;
+};
+
+EnginePool& engine_pool()
+{
+    static EnginePool pool;
+
+    return pool;
+}
+}  // namespace
 
 bool OTScriptChai::ExecuteScript(OTVariable* pReturnVar)
 {
@@ -341,31 +436,31 @@ bool OTScriptChai::ExecuteScript(OTVariable* pReturnVar)
 
 OTScriptChai::OTScriptChai()
     : OTScript()
-    , chai_(new chaiscript::ChaiScript)
+    , chai_(engine_pool().Get())
 {
 }
 
 OTScriptChai::OTScriptChai(const OTString& strValue)
     : OTScript(strValue)
-    , chai_(new chaiscript::ChaiScript)
+    , chai_(engine_pool().Get())
 {
 }
 
 OTScriptChai::OTScriptChai(const char* new_string)
     : OTScript(new_string)
-    , chai_(new chaiscript::ChaiScript)
+    , chai_(engine_pool().Get())
 {
 }
 
 OTScriptChai::OTScriptChai(const char* new_string, size_t sizeLength)
     : OTScript(new_string, sizeLength)
-    , chai_(new chaiscript::ChaiScript)
+    , chai_(engine_pool().Get())
 {
 }
 
 OTScriptChai::OTScriptChai(const std::string& new_string)
     : OTScript(new_string)
-    , chai_(new chaiscript::ChaiScript)
+    , chai_(engine_pool().Get())
 {
 }
 
@@ -373,31 +468,31 @@ OTScriptChai::OTScriptChai(const std::string& new_string)
 
 OTScriptChai::OTScriptChai()
     : OTScript()
-    , chai_(new chaiscript::ChaiScript)
+    , chai_(engine_pool().Get())
 {
 }
 
 OTScriptChai::OTScriptChai(const String& strValue)
     : OTScript(strValue)
-    , chai_(new chaiscript::ChaiScript)
+    , chai_(engine_pool().Get())
 {
 }
 
 OTScriptChai::OTScriptChai(const char* new_string)
     : OTScript(new_string)
-    , chai_(new chaiscript::ChaiScript)
+    , chai_(engine_pool().Get())
 {
 }
 
 OTScriptChai::OTScriptChai(const char* new_string, size_t sizeLength)
     : OTScript(new_string, sizeLength)
-    , chai_(new chaiscript::ChaiScript)
+    , chai_(engine_pool().Get())
 {
 }
 
 OTScriptChai::OTScriptChai(const std::string& new_string)
     : OTScript(new_string)
-    , chai_(new chaiscript::ChaiScript)
+    , chai_(engine_pool().Get())
 {
 }
 
@@ -405,9 +500,7 @@ OTScriptChai::OTScriptChai(const std::string& new_string)
 
 OTScriptChai::~OTScriptChai()
 {
-    if (nullptr != chai_) delete chai_;
-
-    // chai = nullptr;  (It's const).
+    if (nullptr != chai_) engine_pool().Return(chai_);
 }
 }  // namespace opentxs
 #endif  // OT_SCRIPT_CHAI
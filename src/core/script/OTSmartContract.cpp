@@ -520,6 +520,8 @@ various sequence numbers. Hm.
 
 #include <ctime>
 #include <memory>
+#include <set>
+#include <string>
 
 #ifndef SMART_CONTRACT_PROCESS_INTERVAL
 #define SMART_CONTRACT_PROCESS_INTERVAL                                        \
@@ -2903,17 +2905,10 @@ bool OTSmartContract::StashFunds(
     }  // By the time we enter this block, accounts and nyms are already loaded.
        // As we begin, inboxes are instantiated.
 
-    // Either way, Cron should save, since it just updated.
-    // The above function call WILL change this smart contract
-    // and re-sign it and save it, no matter what. So I just
-    // call this here to keep it simple:
-
-    pCron->SaveCron();  // TODO No need to call this here if I can make sure
-                        // it's being called higher up somewhere
-    // (Imagine a script that has 10 account moves in it -- maybe don't need to
-    // save cron until
-    // after all 10 are done. Or maybe DO need to do in between. Todo research
-    // this. Optimization.)
+    // Either way, this smart contract has changed. Flagging it means a script
+    // with 10 account moves writes its cron file once, not 10 times.
+    pCron->FlagCronItemChanged(GetTransactionNum());
+
     return bSuccess;
 }
 
@@ -3833,6 +3828,36 @@ bool OTSmartContract::CanCancelContract(std::string str_party_name)
     return true;
 }
 
+// Scripts may only move funds between the accounts of the parties (and the
+// contract's own stashes), so those accounts and the party nyms are the keys.
+bool OTSmartContract::GetConflictKeys(
+    std::set<std::string>& accounts,
+    std::set<std::string>& nyms,
+    std::set<std::string>&) const
+{
+    for (const auto& it : m_mapParties) {
+        OTParty* pParty = it.second;
+
+        OT_ASSERT(nullptr != pParty);
+
+        const auto nymID = pParty->GetNymID();
+
+        if (false == nymID.empty()) { nyms.insert(nymID); }
+
+        for (std::int32_t i = 0; i < pParty->GetAccountCount(); ++i) {
+            const OTPartyAccount* pAccount = pParty->GetAccountByIndex(i);
+
+            if (nullptr == pAccount) { continue; }
+
+            const String& accountID = pAccount->GetAcctID();
+
+            if (accountID.Exists()) { accounts.insert(accountID.Get()); }
+        }
+    }
+
+    return true;
+}
+
 /// See if theNym has rights to remove this item from Cron.
 ///
 bool OTSmartContract::CanRemoveItemFromCron(const ClientContext& context)
@@ -6034,12 +6059,9 @@ bool OTSmartContract::MoveFunds(
 
     // Todo: possibly notify ALL parties here (in Nymbox.)
 
-    // Either way, Cron should save, since it just updated.
-    // The above function WILL change this smart contract.
-    // and re-sign it and save it, no matter what. So I just
-    // call this here to keep it simple:
-
-    GetCron()->SaveCron();
+    // Either way, the above function WILL change this smart contract, so its
+    // cron file needs to be written.
+    GetCron()->FlagCronItemChanged(GetTransactionNum());
 
     return bSuccess;
 }
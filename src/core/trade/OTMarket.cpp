@@ -10,6 +10,7 @@
 #include "opentxs/api/Wallet.hpp"
 #include "opentxs/core/cron/OTCron.hpp"
 #include "opentxs/core/cron/OTCronItem.hpp"
+#include "opentxs/core/crypto/OTSignedFile.hpp"
 #include "opentxs/core/trade/OTOffer.hpp"
 #include "opentxs/core/trade/OTTrade.hpp"
 #include "opentxs/core/util/Assert.hpp"
@@ -33,6 +34,7 @@
 
 #include <irrxml/irrXML.hpp>
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdint>
 #include <iterator>
@@ -41,6 +43,9 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
+
+#define OT_MARKET_JOURNAL_FOLDER "journal"
 
 namespace opentxs
 {
@@ -48,15 +53,16 @@ OTMarket::OTMarket(const api::Core& core, const char* szFilename)
     : Contract(core)
     , m_pCron(nullptr)
     , m_pTradeList(nullptr)
-    , m_mapBids()
-    , m_mapAsks()
-    , m_mapOffers()
+    , m_bookBids(true)
+    , m_bookAsks(false)
     , m_NOTARY_ID(Identifier::Factory())
     , m_INSTRUMENT_DEFINITION_ID(Identifier::Factory())
     , m_CURRENCY_TYPE_ID(Identifier::Factory())
     , m_lScale(1)
     , m_lLastSalePrice(0)
     , m_strLastSaleDate()
+    , m_lJournalStart(0)
+    , m_lJournalNext(0)
 {
     OT_ASSERT(nullptr != szFilename);
 
@@ -69,15 +75,16 @@ OTMarket::OTMarket(const api::Core& core)
     : Contract(core)
     , m_pCron(nullptr)
     , m_pTradeList(nullptr)
-    , m_mapBids()
-    , m_mapAsks()
-    , m_mapOffers()
+    , m_bookBids(true)
+    , m_bookAsks(false)
     , m_NOTARY_ID(Identifier::Factory())
     , m_INSTRUMENT_DEFINITION_ID(Identifier::Factory())
     , m_CURRENCY_TYPE_ID(Identifier::Factory())
     , m_lScale(1)
     , m_lLastSalePrice(0)
     , m_strLastSaleDate()
+    , m_lJournalStart(0)
+    , m_lJournalNext(0)
 {
     InitMarket();
 }
@@ -91,15 +98,16 @@ OTMarket::OTMarket(
     : Contract(core)
     , m_pCron(nullptr)
     , m_pTradeList(nullptr)
-    , m_mapBids()
-    , m_mapAsks()
-    , m_mapOffers()
+    , m_bookBids(true)
+    , m_bookAsks(false)
     , m_NOTARY_ID(Identifier::Factory(NOTARY_ID))
     , m_INSTRUMENT_DEFINITION_ID(Identifier::Factory(INSTRUMENT_DEFINITION_ID))
     , m_CURRENCY_TYPE_ID(Identifier::Factory(CURRENCY_TYPE_ID))
     , m_lScale(1)
     , m_lLastSalePrice(0)
     , m_strLastSaleDate()
+    , m_lJournalStart(0)
+    , m_lJournalNext(0)
 {
     InitMarket();
     SetScale(lScale);
@@ -128,6 +136,12 @@ std::int32_t OTMarket::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
             String::StringToLong(xml->getAttributeValue("lastSalePrice"));
         m_strLastSaleDate = xml->getAttributeValue("lastSaleDate");
 
+        const String strJournalSequence(
+            xml->getAttributeValue("journalSequence"));
+        m_lJournalNext = strJournalSequence.Exists()
+                             ? strJournalSequence.ToLong()
+                             : 0;
+
         const String strNotaryID(xml->getAttributeValue("notaryID")),
             strInstrumentDefinitionID(
                 xml->getAttributeValue("instrumentDefinitionID")),
@@ -171,8 +185,22 @@ std::int32_t OTMarket::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
             OT_ASSERT(false != bool(pOffer));
 
             OTOffer* offer = pOffer.release();
-            if (pOffer->LoadContractFromString(strData) &&
-                AddOffer(nullptr, *offer, false, tDateAdded))
+            bool bLoaded = offer->LoadContractFromString(strData);
+
+            // Journal entries replace the previous version of an offer, which
+            // keeps its place among the offers at its price.
+            if (bLoaded &&
+                (nullptr != GetOffer(offer->GetTransactionNum()))) {
+                if (replace_offer(*offer, tDateAdded)) {
+                    otWarn << "Successfully updated offer on market.\n";
+
+                    return 1;
+                }
+
+                bLoaded = false;
+            }
+
+            if (bLoaded && AddOffer(nullptr, *offer, false, tDateAdded))
             // bSaveMarket = false (Don't SAVE -- we're loading right now!)
             {
                 otWarn << "Successfully loaded offer and added to market.\n";
@@ -184,12 +212,345 @@ std::int32_t OTMarket::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
             }
         }
 
+        nReturnVal = 1;
+    } else if (!strcmp("marketJournal", xml->getNodeName())) {
+        const String strLastSalePrice(xml->getAttributeValue("lastSalePrice"));
+        const String strLastSaleDate(xml->getAttributeValue("lastSaleDate"));
+
+        if (strLastSalePrice.Exists()) {
+            m_lLastSalePrice = strLastSalePrice.ToLong();
+        }
+
+        if (strLastSaleDate.Exists()) {
+            m_strLastSaleDate = strLastSaleDate.Get();
+        }
+
+        nReturnVal = 1;
+    } else if (!strcmp("trade", xml->getNodeName())) {
+        std::unique_ptr<OTDB::TradeDataMarket> pTradeData(
+            dynamic_cast<OTDB::TradeDataMarket*>(
+                OTDB::CreateObject(OTDB::STORED_OBJ_TRADE_DATA_MARKET)));
+
+        OT_ASSERT(nullptr != pTradeData);
+
+        pTradeData->transaction_id =
+            String(xml->getAttributeValue("transactionID")).Get();
+        pTradeData->date = String(xml->getAttributeValue("date")).Get();
+        pTradeData->price = String(xml->getAttributeValue("price")).Get();
+        pTradeData->amount_sold =
+            String(xml->getAttributeValue("amountSold")).Get();
+
+        // The recent trades are saved before the snapshot, so if the server
+        // stopped in between they already include this one.
+        if (!has_trade(*pTradeData)) { add_trade(*pTradeData); }
+
+        nReturnVal = 1;
+    } else if (!strcmp("removeOffer", xml->getNodeName())) {
+        const std::int64_t lTransactionNum =
+            String::StringToLong(xml->getAttributeValue("transactionNum"));
+
+        if (!remove_offer(lTransactionNum)) {
+            otErr << "Error in OTMarket::" << __FUNCTION__
+                  << ": unable to remove offer " << lTransactionNum
+                  << " while replaying market journal.\n";
+            return (-1);
+        }
+
         nReturnVal = 1;
     }
 
     return nReturnVal;
 }
 
+bool OTMarket::append_journal(Tag& entry)
+{
+    // The snapshot includes whatever change this entry was going to record.
+    // SaveMarket publishes it in place of a delta.
+    if (MARKET_JOURNAL_SNAPSHOT_INTERVAL <=
+        (m_lJournalNext - m_lJournalStart)) {
+        return SaveMarket();
+    }
+
+    OT_ASSERT(nullptr != GetCron());
+    OT_ASSERT(nullptr != GetCron()->GetServerNym());
+
+    const String str_MARKET_ID(Identifier::Factory(*this));
+    const String strFilename = journal_file(m_lJournalNext);
+
+    entry.add_attribute("sequence", formatLong(m_lJournalNext));
+
+    std::string str_result;
+    entry.output(str_result);
+
+    // The signed file names its market and sequence number, so an entry
+    // can't be replayed in another position.
+    auto pSigned{api_.Factory().SignedFile(str_MARKET_ID, strFilename)};
+
+    OT_ASSERT(false != bool(pSigned));
+
+    String strSigned;
+    pSigned->SetFilePayload(String(str_result));
+
+    if (!pSigned->SignContract(*(GetCron()->GetServerNym())) ||
+        !pSigned->SaveContract() || !pSigned->SaveContractRaw(strSigned)) {
+        otErr << "OTMarket::" << __FUNCTION__
+              << ": Error signing journal entry " << strFilename
+              << " for Market: " << str_MARKET_ID << "\n";
+        return false;
+    }
+
+    if (!OTDB::StorePlainString(
+            strSigned.Get(),
+            api_.DataFolder(),
+            OTFolders::Market().Get(),
+            OT_MARKET_JOURNAL_FOLDER,
+            str_MARKET_ID.Get(),
+            strFilename.Get())) {
+        otErr << "Error saving journal entry for Market:\n"
+              << OTFolders::Market() << Log::PathSeparator()
+              << OT_MARKET_JOURNAL_FOLDER << Log::PathSeparator()
+              << str_MARKET_ID << Log::PathSeparator() << strFilename << "\n";
+        return false;
+    }
+
+    if (nullptr != m_pCron) {
+        m_pCron->PublishMarketData(
+            Identifier::Factory(*this), "delta", m_lJournalNext, str_result);
+    }
+
+    ++m_lJournalNext;
+
+    return true;
+}
+
+bool OTMarket::erase_journal(const std::int64_t lFrom, const std::int64_t lTo)
+    const
+{
+    const String str_MARKET_ID(Identifier::Factory(*this));
+    bool bSuccess = true;
+
+    for (auto lSequence = lFrom; lSequence < lTo; ++lSequence) {
+        const String strFilename = journal_file(lSequence);
+
+        if (!OTDB::Exists(
+                api_.DataFolder(),
+                OTFolders::Market().Get(),
+                OT_MARKET_JOURNAL_FOLDER,
+                str_MARKET_ID.Get(),
+                strFilename.Get())) {
+            continue;
+        }
+
+        bSuccess &= OTDB::EraseValueByKey(
+            api_.DataFolder(),
+            OTFolders::Market().Get(),
+            OT_MARKET_JOURNAL_FOLDER,
+            str_MARKET_ID.Get(),
+            strFilename.Get());
+    }
+
+    return bSuccess;
+}
+
+String OTMarket::journal_file(const std::int64_t lSequence) const
+{
+    String output;
+    output.Format("%" PRId64 ".jnl", lSequence);
+
+    return output;
+}
+
+bool OTMarket::replay_journal()
+{
+    OT_ASSERT(nullptr != GetCron());
+    OT_ASSERT(nullptr != GetCron()->GetServerNym());
+
+    const String str_MARKET_ID(Identifier::Factory(*this));
+    std::vector<String> entries{};
+
+    // Every entry is verified before any of them is applied, so a journal
+    // which fails verification leaves the market untouched.
+    for (auto lSequence = m_lJournalNext;; ++lSequence) {
+        const String strFilename = journal_file(lSequence);
+
+        if (!OTDB::Exists(
+                api_.DataFolder(),
+                OTFolders::Market().Get(),
+                OT_MARKET_JOURNAL_FOLDER,
+                str_MARKET_ID.Get(),
+                strFilename.Get())) {
+            break;
+        }
+
+        const String strEntry(OTDB::QueryPlainString(
+            api_.DataFolder(),
+            OTFolders::Market().Get(),
+            OT_MARKET_JOURNAL_FOLDER,
+            str_MARKET_ID.Get(),
+            strFilename.Get()));
+        auto pSigned{api_.Factory().SignedFile(str_MARKET_ID, strFilename)};
+
+        OT_ASSERT(false != bool(pSigned));
+
+        if (!pSigned->LoadContractFromString(strEntry) ||
+            !pSigned->VerifyFile() ||
+            !pSigned->VerifySignature(*(GetCron()->GetServerNym()))) {
+            otErr << "OTMarket::" << __FUNCTION__
+                  << ": ERROR SECURITY: Server signature failed to verify on "
+                     "journal entry "
+                  << strFilename << " for Market: " << str_MARKET_ID << "\n";
+            return false;
+        }
+
+        entries.emplace_back(pSigned->GetFilePayload());
+    }
+
+    for (const auto& strEntry : entries) {
+        OTStringXML xmlEntry(strEntry);
+        xmlEntry.reset();
+        irr::io::IrrXMLReader* xml = irr::io::createIrrXMLReader(xmlEntry);
+
+        OT_ASSERT(nullptr != xml);
+
+        std::unique_ptr<irr::io::IrrXMLReader> xmlAngel(xml);
+
+        while (xml->read()) {
+            if (irr::io::EXN_ELEMENT != xml->getNodeType()) { continue; }
+
+            if (1 != ProcessXMLNode(xml)) {
+                otErr << "OTMarket::" << __FUNCTION__
+                      << ": Error replaying journal entry "
+                      << journal_file(m_lJournalNext)
+                      << " for Market: " << str_MARKET_ID << "\n";
+                return false;
+            }
+        }
+
+        ++m_lJournalNext;
+    }
+
+    // If the server stopped after writing a snapshot but before erasing the
+    // journal it replaced, those entries are still here. The snapshot already
+    // includes them.
+    auto lStale = m_lJournalStart;
+
+    while (0 < lStale) {
+        const String strFilename = journal_file(lStale - 1);
+
+        if (!OTDB::Exists(
+                api_.DataFolder(),
+                OTFolders::Market().Get(),
+                OT_MARKET_JOURNAL_FOLDER,
+                str_MARKET_ID.Get(),
+                strFilename.Get())) {
+            break;
+        }
+
+        --lStale;
+    }
+
+    erase_journal(lStale, m_lJournalStart);
+
+    return true;
+}
+
+bool OTMarket::save_fill(
+    const OTOffer& theOffer,
+    const OTOffer& theOtherOffer,
+    const OTDB::TradeDataMarket& theTrade)
+{
+    Tag entry("marketJournal");
+    entry.add_attribute("lastSalePrice", formatLong(m_lLastSalePrice));
+    entry.add_attribute("lastSaleDate", m_strLastSaleDate);
+    serialize_offer(entry, theOffer);
+    serialize_offer(entry, theOtherOffer);
+
+    TagPtr tagTrade(new Tag("trade"));
+    tagTrade->add_attribute("transactionID", theTrade.transaction_id);
+    tagTrade->add_attribute("date", theTrade.date);
+    tagTrade->add_attribute("price", theTrade.price);
+    tagTrade->add_attribute("amountSold", theTrade.amount_sold);
+    entry.add_tag(tagTrade);
+
+    return append_journal(entry);
+}
+
+void OTMarket::add_trade(OTDB::TradeDataMarket& theTrade)
+{
+    if (nullptr == m_pTradeList) {
+        m_pTradeList = dynamic_cast<OTDB::TradeListMarket*>(
+            OTDB::CreateObject(OTDB::STORED_OBJ_TRADE_LIST_MARKET));
+    }
+
+    OT_ASSERT(nullptr != m_pTradeList);
+
+    // theTrade is CLONED here, so the caller still owns it.
+    m_pTradeList->AddTradeDataMarket(theTrade);
+
+    // Here we erase the oldest elements so the list never exceeds 50 elements
+    // total.
+    while (m_pTradeList->GetTradeDataMarketCount() > MAX_MARKET_QUERY_DEPTH) {
+        m_pTradeList->RemoveTradeDataMarket(0);
+    }
+}
+
+bool OTMarket::has_trade(const OTDB::TradeDataMarket& theTrade)
+{
+    if (nullptr == m_pTradeList) { return false; }
+
+    const auto count = m_pTradeList->GetTradeDataMarketCount();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto* pTrade = m_pTradeList->GetTradeDataMarket(i);
+
+        if ((nullptr != pTrade) &&
+            (pTrade->transaction_id == theTrade.transaction_id) &&
+            (pTrade->date == theTrade.date) &&
+            (pTrade->price == theTrade.price) &&
+            (pTrade->amount_sold == theTrade.amount_sold)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Trades carry the sequence number of the delta which records the fill.
+void OTMarket::publish_trade(OTDB::TradeDataMarket& theTrade)
+{
+    if ((nullptr == m_pCron) || !m_pCron->IsPublishingMarketData()) { return; }
+
+    OTDB::Storage* pStorage = OTDB::GetDefaultStorage();
+    OT_ASSERT(nullptr != pStorage);
+
+    OTDB::OTPacker* pPacker = pStorage->GetPacker();
+    std::unique_ptr<OTDB::PackedBuffer> pBuffer(pPacker->Pack(theTrade));
+
+    if ((nullptr == pBuffer) || (nullptr == pBuffer->GetData())) {
+        otErr << "OTMarket::" << __FUNCTION__ << ": Failed packing trade.\n";
+        return;
+    }
+
+    auto theData = Data::Factory(
+        pBuffer->GetData(), static_cast<std::uint32_t>(pBuffer->GetSize()));
+    Armored ascTrade;
+    ascTrade.SetData(theData);
+    m_pCron->PublishMarketData(
+        Identifier::Factory(*this), "trade", m_lJournalNext, ascTrade.Get());
+}
+
+void OTMarket::serialize_offer(Tag& parent, const OTOffer& theOffer)
+{
+    String strOffer(theOffer);   // Extract the offer contract into string
+                                 // form.
+    Armored ascOffer(strOffer);  // Base64-encode that for storage.
+
+    TagPtr tagOffer(new Tag("offer", ascOffer.Get()));
+    tagOffer->add_attribute(
+        "dateAdded", formatTimestamp(theOffer.GetDateAddedToMarket()));
+    parent.add_tag(tagOffer);
+}
+
 void OTMarket::UpdateContents()
 {
     // I release this because I'm about to repopulate it.
@@ -208,36 +569,22 @@ void OTMarket::UpdateContents()
     tag.add_attribute("marketScale", formatLong(m_lScale));
     tag.add_attribute("lastSaleDate", m_strLastSaleDate);
     tag.add_attribute("lastSalePrice", formatLong(m_lLastSalePrice));
+    // Journal entries from this sequence number on were written after this
+    // snapshot.
+    tag.add_attribute("journalSequence", formatLong(m_lJournalNext));
 
-    // Save the offers for sale.
-    for (auto& it : m_mapAsks) {
-        OTOffer* pOffer = it.second;
-        OT_ASSERT(nullptr != pOffer);
-
-        String strOffer(*pOffer);    // Extract the offer contract into string
-                                     // form.
-        Armored ascOffer(strOffer);  // Base64-encode that for storage.
-
-        TagPtr tagOffer(new Tag("offer", ascOffer.Get()));
-        tagOffer->add_attribute(
-            "dateAdded", formatTimestamp(pOffer->GetDateAddedToMarket()));
-        tag.add_tag(tagOffer);
-    }
+    // Each side is saved in priority order, so offers at the same price are
+    // still in the order they arrived after the market is loaded again.
+    const auto save = [&](const OTOffer& offer) -> bool {
+        serialize_offer(tag, offer);
+
+        return true;
+    };
 
+    // Save the offers for sale.
+    m_bookAsks.ForEach(save);
     // Save the bids.
-    for (auto& it : m_mapBids) {
-        OTOffer* pOffer = it.second;
-        OT_ASSERT(nullptr != pOffer);
-
-        String strOffer(*pOffer);    // Extract the offer contract into string
-                                     // form.
-        Armored ascOffer(strOffer);  // Base64-encode that for storage.
-
-        TagPtr tagOffer(new Tag("offer", ascOffer.Get()));
-        tagOffer->add_attribute(
-            "dateAdded", formatTimestamp(pOffer->GetDateAddedToMarket()));
-        tag.add_tag(tagOffer);
-    }
+    m_bookBids.ForEach(save);
 
     std::string str_result;
     tag.output(str_result);
@@ -249,12 +596,11 @@ std::int64_t OTMarket::GetTotalAvailableAssets()
 {
     std::int64_t lTotal = 0;
 
-    for (auto& it : m_mapAsks) {
-        OTOffer* pOffer = it.second;
-        OT_ASSERT(nullptr != pOffer);
+    m_bookAsks.ForEach([&](const OTOffer& offer) -> bool {
+        lTotal += offer.GetAmountAvailable();
 
-        lTotal += pOffer->GetAmountAvailable();
-    }
+        return true;
+    });
 
     return lTotal;
 }
@@ -272,9 +618,8 @@ bool OTMarket::GetNym_OfferList(
     // Loop through the offers, up to some maximum depth, and then add each
     // as a data member to an offer list, then pack it into ascOutput.
     //
-    for (auto& it : m_mapOffers) {
-        OTOffer* pOffer = it.second;
-        OT_ASSERT(nullptr != pOffer);
+    const auto add = [&](OTOffer& offer) -> bool {
+        OTOffer* pOffer = &offer;
 
         OTTrade* pTrade = pOffer->GetTrade();
 
@@ -282,7 +627,7 @@ bool OTMarket::GetNym_OfferList(
         // info only for that Nym.
         //
         if ((nullptr == pTrade) || (pTrade->GetSenderNymID() != NYM_ID))
-            continue;
+            return true;
 
         // Below this point, I KNOW pTrade and pOffer are both good pointers.
         // with no need to cleanup. I also know they are for the right Nym.
@@ -357,7 +702,12 @@ bool OTMarket::GetNym_OfferList(
         //
         theOutputList.AddOfferDataNym(*pOfferData);
         nNymOfferCount++;
-    }
+
+        return true;
+    };
+
+    m_bookBids.ForEach(add);
+    m_bookAsks.ForEach(add);
 
     return true;
 }
@@ -448,23 +798,17 @@ bool OTMarket::GetOfferList(
         dynamic_cast<OTDB::OfferListMarket*>(
             OTDB::CreateObject(OTDB::STORED_OBJ_OFFER_LIST_MARKET)));
 
-    //    mapOfOffers            m_mapBids;        // The buyers, ordered by
-    // price limit
-    //    mapOfOffers            m_mapAsks;        // The sellers, ordered by
-    // price limit
-
     std::int32_t nTempDepth = 0;
 
-    for (auto& it : m_mapBids) {
-        if (nTempDepth++ > lDepth) break;
-
-        OTOffer* pOffer = it.second;
-        OT_ASSERT(nullptr != pOffer);
+    // Both sides are listed starting from the best price.
+    m_bookBids.ForEach([&](OTOffer& offer) -> bool {
+        if (nTempDepth++ > lDepth) return false;
 
+        OTOffer* pOffer = &offer;
         const std::int64_t& lPriceLimit = pOffer->GetPriceLimit();
 
         if (0 == lPriceLimit)  // Skipping any market orders.
-            continue;
+            return true;
 
         // OfferDataMarket
         std::unique_ptr<OTDB::BidData> pOfferData(dynamic_cast<OTDB::BidData*>(
@@ -489,15 +833,16 @@ bool OTMarket::GetOfferList(
         //
         pOfferList->AddBidData(*pOfferData);
         nOfferCount++;
-    }
+
+        return true;
+    });
 
     nTempDepth = 0;
 
-    for (auto& it : m_mapAsks) {
-        if (nTempDepth++ > lDepth) break;
+    m_bookAsks.ForEach([&](OTOffer& offer) -> bool {
+        if (nTempDepth++ > lDepth) return false;
 
-        OTOffer* pOffer = it.second;
-        OT_ASSERT(nullptr != pOffer);
+        OTOffer* pOffer = &offer;
 
         // OfferDataMarket
         std::unique_ptr<OTDB::AskData> pOfferData(dynamic_cast<OTDB::AskData*>(
@@ -523,7 +868,9 @@ bool OTMarket::GetOfferList(
         //
         pOfferList->AddAskData(*pOfferData);
         nOfferCount++;
-    }
+
+        return true;
+    });
 
     // Now pack the list into strOutput...
 
@@ -569,33 +916,19 @@ bool OTMarket::GetOfferList(
     return false;
 }
 
-// To insure that offers of a specific price are always inserted at the upper
-// bound,
-// use this:  my_mmap.insert(my_mmap.upper_bound(key), my_mmap::value_type(key,
-// val));
-// This way I can read them from the lower bound later, and always get them in
-// the
-// order received for that price.
-//
-// typedef std::multimap<std::int64_t, OTOffer *>    mapOfOffers;
-// mapOfOffers    m_mapBids; // The buyers, ordered
-// mapOfOffers    m_mapAsks; // The sellers, ordered
-
 OTOffer* OTMarket::GetOffer(const std::int64_t& lTransactionNum)
 {
     // See if there's something there with that transaction number.
-    auto it = m_mapOffers.find(lTransactionNum);
+    OTOffer* pOffer = m_bookBids.Find(lTransactionNum);
+
+    if (nullptr == pOffer) { pOffer = m_bookAsks.Find(lTransactionNum); }
 
-    if (it == m_mapOffers.end()) {
+    if (nullptr == pOffer) {
         // nothing found.
         return nullptr;
     }
     // Found it!
     else {
-        OTOffer* pOffer = it->second;
-
-        OT_ASSERT((nullptr != pOffer));
-
         if (pOffer->GetTransactionNum() == lTransactionNum)
             return pOffer;
         else
@@ -611,86 +944,77 @@ bool OTMarket::RemoveOffer(const std::int64_t& lTransactionNum)  // if false,
                                                                  // offer
 // wasn't found.
 {
-    bool bReturnValue = false;
+    if (!remove_offer(lTransactionNum)) { return false; }
 
-    // See if there's something there with that transaction number.
-    auto it = m_mapOffers.find(lTransactionNum);
+    Tag entry("marketJournal");
+    TagPtr tagRemove(new Tag("removeOffer"));
+    tagRemove->add_attribute("transactionNum", formatLong(lTransactionNum));
+    entry.add_tag(tagRemove);
+
+    return append_journal(entry);  // <====== SAVE since an offer was removed.
+}
+
+// Removes the offer without saving the market.
+bool OTMarket::remove_offer(const std::int64_t& lTransactionNum)
+{
+    // Each offer is on exactly one side of the market.
+    OTOffer* pOffer = m_bookBids.Remove(lTransactionNum);
+
+    if (nullptr == pOffer) { pOffer = m_bookAsks.Remove(lTransactionNum); }
 
     // If it's not already on the list, then there's nothing to remove.
-    if (it == m_mapOffers.end()) {
+    if (nullptr == pOffer) {
         otErr << "Attempt to remove non-existent Offer from Market. "
                  "Transaction #: "
               << lTransactionNum << "\n";
         return false;
     }
-    // Otherwise, if it WAS already there, remove it properly.
-    else {
-        OTOffer* pOffer = it->second;
 
-        OT_ASSERT(nullptr != pOffer);
+    delete pOffer;
 
-        // This removes it from one list (the one indexed by transaction
-        // number.)
-        // But it's still on one of the other lists...
-        m_mapOffers.erase(it);
-
-        // The code operates the same whether ask or bid. Just use a pointer.
-        mapOfOffers* pMap = (pOffer->IsBid() ? &m_mapBids : &m_mapAsks);
-
-        // Future solution here: instead of looping through all the offers and
-        // finding it,
-        // I could just have each Offer store a copy of the iterator that's
-        // returned when
-        // it's first inserted. Later I just erase that iterator from the right
-        // list to remove. Todo.
-        OTOffer* pSameOffer = nullptr;
+    return true;
+}
 
-        for (mapOfOffers::iterator iii = pMap->begin(); iii != pMap->end();
-             ++iii) {
-            pSameOffer = iii->second;
+bool OTMarket::replace_offer(OTOffer& theOffer, time64_t tDateAddedToMarket)
+{
+    const auto lTransactionNum = theOffer.GetTransactionNum();
 
-            OT_ASSERT_MSG(
-                nullptr != pSameOffer,
-                "nullptr offer pointer in OTMarket::RemoveOffer.\n");
+    if (!ValidateOfferForMarket(theOffer)) {
+        otErr << "OTMarket::" << __FUNCTION__
+              << ": Invalid new version of offer " << lTransactionNum << "\n";
+        return false;
+    }
 
-            // found it!
-            if (lTransactionNum == pSameOffer->GetTransactionNum()) {
-                pMap->erase(iii);
-                break;
-            }
+    auto& book = theOffer.IsBid() ? m_bookBids : m_bookAsks;
+    OTOffer* pOld =
+        book.Replace(lTransactionNum, theOffer.GetPriceLimit(), theOffer);
 
-            // Later on, below this loop, this pointer will be nullptr or not,
-            // and
-            // I will know if it was removed.
-            pSameOffer = nullptr;
-        }
+    if (nullptr == pOld) {
+        otErr << "OTMarket::" << __FUNCTION__
+              << ": New version of offer " << lTransactionNum
+              << " changed its side or price.\n";
+        return false;
+    }
 
-        if (nullptr == pSameOffer) {
-            otErr << "Removed Offer from offers list, but not found on bid/ask "
-                     "list.\n";
-        } else  // This means it was found and removed from the second list as
-                // well.
-        {
-            bReturnValue = true;  // Success.
-        }
+    theOffer.SetDateAddedToMarket(tDateAddedToMarket);
+    delete pOld;
 
-        // pOffer was found on the Offers list.
-        // pSameOffer was found on the Bid or Ask list, with the same
-        // transaction ID.
-        // They SHOULD be pointers to the SAME object.
-        // Therefore I CANNOT delete them both.
-        //
-        OT_ASSERT(pOffer == pSameOffer);
+    return true;
+}
 
-        delete pOffer;
-        pOffer = nullptr;
-        pSameOffer = nullptr;
+bool OTMarket::SaveOffer(const OTOffer& theOffer)
+{
+    if (nullptr == GetOffer(theOffer.GetTransactionNum())) {
+        otErr << "OTMarket::" << __FUNCTION__
+              << ": Attempt to save an offer which is not on the market: "
+              << theOffer.GetTransactionNum() << "\n";
+        return false;
     }
 
-    if (bReturnValue)
-        return SaveMarket();  // <====== SAVE since an offer was removed.
-    else
-        return false;
+    Tag entry("marketJournal");
+    serialize_offer(entry, theOffer);
+
+    return append_journal(entry);
 }
 
 // This method demands an Offer reference in order to verify that it really
@@ -715,52 +1039,23 @@ bool OTMarket::AddOffer(
 
         if (nullptr != pTrade) pTrade->FlagForRemoval();
     } else {
-        // I store duplicate lists of offer pointers. Two multimaps ordered by
-        // price,
-        // (for buyers and sellers) and one map ordered by transaction number.
-
-        // See if there's something else already there with the same transaction
-        // number.
-        //
-        auto it = m_mapOffers.find(lTransactionNum);
-
-        // If it's not already on the list, then add it...
-        if (it == m_mapOffers.end()) {
-            m_mapOffers[lTransactionNum] = &theOffer;
-            otLog4 << "Offer added as an offer to the market...\n";
-        }
-        // Otherwise, if it was already there, log an error.
-        else {
+        // See if there's something else already there with the same
+        // transaction number. Checking both sides also catches an offer
+        // which changed sides.
+        if (nullptr != GetOffer(lTransactionNum)) {
             otErr << "Attempt to add Offer to Market with pre-existing "
                      "transaction number: "
                   << lTransactionNum << "\n";
             return false;
         }
 
-        // Okay so we successfully added it to one list (indexed by Transaction
-        // Num) and we
-        // know it validated as an offer, AND we know it wasn't already on the
-        // market.
-        //
-        // So next, let's add it to the lists that are indexed by price:
-
-        // Determine if it's a buy or sell, and add it to the right list.
+        // Determine if it's a buy or sell, and add it to the right list. Each
+        // offer goes behind any others already waiting at the same price.
         if (theOffer.IsBid()) {
-            // No bother checking if the offer is already on this list,
-            // since the code above basically already verifies that for us.
-
-            m_mapBids.insert(
-                m_mapBids.lower_bound(lPriceLimit),  // highest bidders go
-                                                     // first, so I am last in
-                                                     // line at lower bound.
-                std::pair<std::int64_t, OTOffer*>(lPriceLimit, &theOffer));
+            m_bookBids.Insert(lTransactionNum, lPriceLimit, theOffer);
             otLog4 << "Offer added as a bid to the market.\n";
         } else {
-            m_mapAsks.insert(
-                m_mapAsks.upper_bound(lPriceLimit),  // lowest price sells
-                                                     // first, so I am last in
-                                                     // line at upper bound.
-                std::pair<std::int64_t, OTOffer*>(lPriceLimit, &theOffer));
+            m_bookAsks.Insert(lTransactionNum, lPriceLimit, theOffer);
             otLog4 << "Offer added as an ask to the market.\n";
         }
 
@@ -770,9 +1065,11 @@ bool OTMarket::AddOffer(
             //
             theOffer.SetDateAddedToMarket(OTTimeGetCurrentTime());
 
-            return SaveMarket();  // <====== SAVE since an offer was added to
-                                  // the
-                                  // Market.
+            Tag entry("marketJournal");
+            serialize_offer(entry, theOffer);
+
+            return append_journal(entry);  // <====== SAVE since an offer was
+                                           // added to the Market.
         } else {
             // Set this to the date passed in, since this offer was
             // added to the market in the past, and we are preserving that date.
@@ -804,7 +1101,8 @@ bool OTMarket::LoadMarket()
 
     if (bSuccess) bSuccess = VerifySignature(*(GetCron()->GetServerNym()));
 
-    // Load the list of recent market trades (informational only.)
+    // Load the list of recent market trades (informational only.) The
+    // journal adds the trades made since it was saved.
     //
     if (bSuccess) {
         if (nullptr != m_pTradeList) delete m_pTradeList;
@@ -823,6 +1121,12 @@ bool OTMarket::LoadMarket()
             ""));  // markets/recent/<market_ID>.bin
     }
 
+    // Apply the changes made since the snapshot was signed.
+    if (bSuccess) {
+        m_lJournalStart = m_lJournalNext;
+        bSuccess = replay_journal();
+    }
+
     return bSuccess;
 }
 
@@ -837,6 +1141,27 @@ bool OTMarket::SaveMarket()
     const char* szFoldername = OTFolders::Market().Get();
     const char* szFilename = str_MARKET_ID.Get();
 
+    // Save a copy of recent trades. This happens before the snapshot so the
+    // journal it replaces still holds any trade the copy is missing.
+    if (nullptr != m_pTradeList) {
+        String str_TRADES_FILE;
+        str_TRADES_FILE.Format("%s.bin", str_MARKET_ID.Get());
+
+        const char* szSubFolder = "recent";  // todo stop hardcoding.
+
+        // If this fails, oh well. It's informational, anyway.
+        if (!OTDB::StoreObject(
+                *m_pTradeList,
+                api_.DataFolder(),
+                szFoldername,  // markets
+                szSubFolder,   // markets/recent
+                str_TRADES_FILE.Get(),
+                ""))  // markets/recent/<Market_ID>.bin
+            otErr << "Error saving recent trades for Market:\n"
+                  << szFoldername << Log::PathSeparator() << szSubFolder
+                  << Log::PathSeparator() << szFilename << "\n";
+    }
+
     // Remember, if the market has changed, the new contents will not be written
     // anywhere
     // until that market has been signed. So I have to re-sign here, or it would
@@ -844,38 +1169,43 @@ bool OTMarket::SaveMarket()
     // the old version of the market from before the most recent changes.
     ReleaseSignatures();
 
+    // The snapshot replaces every journal entry written so far.
+    const auto lJournalStart = m_lJournalStart;
+    m_lJournalStart = m_lJournalNext;
+
     // Sign it, save it internally to string, and then save that out to the
     // file.
     if (!SignContract(*(GetCron()->GetServerNym())) || !SaveContract() ||
         !SaveContract(szFoldername, szFilename)) {
         otErr << "Error saving Market:\n"
               << szFoldername << Log::PathSeparator() << szFilename << "\n";
+        m_lJournalStart = lJournalStart;
         return false;
     }
 
-    // Save a copy of recent trades.
+    erase_journal(lJournalStart, m_lJournalStart);
+    PublishSnapshot();
 
-    if (nullptr != m_pTradeList) {
+    return true;
+}
 
-        String str_TRADES_FILE;
-        str_TRADES_FILE.Format("%s.bin", str_MARKET_ID.Get());
+void OTMarket::PublishSnapshot()
+{
+    if ((nullptr == m_pCron) || !m_pCron->IsPublishingMarketData()) { return; }
 
-        const char* szSubFolder = "recent";  // todo stop hardcoding.
+    Armored ascOffers;
+    std::int32_t nOfferCount{0};
+    const auto lDepth = static_cast<std::int64_t>(
+        std::max(m_bookBids.size(), m_bookAsks.size()));
 
-        // If this fails, oh well. It's informational, anyway.
-        if (!OTDB::StoreObject(
-                *m_pTradeList,
-                api_.DataFolder(),
-                szFoldername,  // markets
-                szSubFolder,   // markets/recent
-                str_TRADES_FILE.Get(),
-                ""))  // markets/recent/<Market_ID>.bin
-            otErr << "Error saving recent trades for Market:\n"
-                  << szFoldername << Log::PathSeparator() << szSubFolder
-                  << Log::PathSeparator() << szFilename << "\n";
-    }
+    if (!GetOfferList(ascOffers, lDepth, nOfferCount)) { return; }
 
-    return true;
+    // The snapshot contains every change before the next journal entry.
+    m_pCron->PublishMarketData(
+        Identifier::Factory(*this),
+        "snapshot",
+        m_lJournalNext,
+        ascOffers.Get());
 }
 
 // A Market's ID is based on the instrument definition, the currency type, and
@@ -903,44 +1233,19 @@ void OTMarket::GetIdentifier(Identifier& theIdentifier) const
 // bid on the market.
 std::int64_t OTMarket::GetHighestBidPrice()
 {
-    std::int64_t lPrice = 0;
-
-    mapOfOffers::reverse_iterator rr = m_mapBids.rbegin();
-
-    if (rr != m_mapBids.rend()) { lPrice = rr->first; }
-
-    return lPrice;
+    return m_bookBids.BestPrice();
 }
 
 // returns 0 if there are no asks. Otherwise returns the value of the lowest ask
 // on the market.
 std::int64_t OTMarket::GetLowestAskPrice()
 {
-    std::int64_t lPrice = 0;
-
-    auto it = m_mapAsks.begin();
-
-    if (it != m_mapAsks.end()) {
-        lPrice = it->first;
-
-        // Market orders have a 0 price, so we need to skip any if they are
-        // here.
-        //
-        // Note that we don't have to do this with the highest bid price (above
-        // function) but in the case of asks, a "0 price" will undercut the
-        // other
-        // actual prices, so we need to skip any that have a 0 price.
-        //
-        while (0 == lPrice) {
-            ++it;
-
-            if (it == m_mapAsks.end()) break;
-
-            lPrice = it->first;
-        }
-    }
-
-    return lPrice;
+    // Market orders have a 0 price, so we need to skip any if they are here.
+    //
+    // Note that we don't have to do this with the highest bid price (above
+    // function) but in the case of asks, a "0 price" will undercut the other
+    // actual prices, so we need to skip any that have a 0 price.
+    return m_bookAsks.BestPrice(true);
 }
 
 // This utility function is used directly below (only).
@@ -1182,13 +1487,28 @@ void OTMarket::ProcessTrade(
     // Make sure have ALL FOUR accounts loaded and checked out.
     // (first nym's asset/currency, and other nym's asset/currency.)
 
-    auto pFirstAssetAcct = wallet.mutable_Account(theTrade.GetSenderAcctID());
-    auto pFirstCurrencyAcct =
-        wallet.mutable_Account(theTrade.GetCurrencyAcctID());
-    auto pOtherAssetAcct =
-        wallet.mutable_Account(pOtherTrade->GetSenderAcctID());
-    auto pOtherCurrencyAcct =
-        wallet.mutable_Account(pOtherTrade->GetCurrencyAcctID());
+    ExclusiveAccount pFirstAssetAcct{};
+    ExclusiveAccount pFirstCurrencyAcct{};
+    ExclusiveAccount pOtherAssetAcct{};
+    ExclusiveAccount pOtherCurrencyAcct{};
+
+    {
+        // Accounts are always checked out in sorted order so that another
+        // thread checking out an overlapping set of accounts can not
+        // deadlock against this one.
+        std::map<OTIdentifier, ExclusiveAccount*> accounts{
+            {Identifier::Factory(theTrade.GetSenderAcctID()), &pFirstAssetAcct},
+            {Identifier::Factory(theTrade.GetCurrencyAcctID()),
+             &pFirstCurrencyAcct},
+            {Identifier::Factory(pOtherTrade->GetSenderAcctID()),
+             &pOtherAssetAcct},
+            {Identifier::Factory(pOtherTrade->GetCurrencyAcctID()),
+             &pOtherCurrencyAcct}};
+
+        for (auto& [id, account] : accounts) {
+            *account = wallet.mutable_Account(id);
+        }
+    }
 
     if ((!pFirstAssetAcct) || (!pFirstCurrencyAcct)) {
         otOut << "ERROR verifying existence of one of the first trader's "
@@ -1827,6 +2147,8 @@ void OTMarket::ProcessTrade(
                 pOtherTrade->ReleaseSignatures();
                 pOtherTrade->SignContract(*pServerNym);
                 pOtherTrade->SaveContract();
+                // Only theTrade is saved by the cron round processing it
+                pCron->FlagCronItemChanged(pOtherTrade->GetTransactionNum());
 
                 theOffer.ReleaseSignatures();
                 theOffer.SignContract(*pServerNym);
@@ -1841,59 +2163,38 @@ void OTMarket::ProcessTrade(
 
                 // Here we save this trade in a list of the most recent
                 // 50 trades.
-                {
-                    if (nullptr == m_pTradeList) {
-                        m_pTradeList = dynamic_cast<OTDB::TradeListMarket*>(
-                            OTDB::CreateObject(
-                                OTDB::STORED_OBJ_TRADE_LIST_MARKET));
-                    }
+                std::unique_ptr<OTDB::TradeDataMarket> pTradeData(
+                    dynamic_cast<OTDB::TradeDataMarket*>(OTDB::CreateObject(
+                        OTDB::STORED_OBJ_TRADE_DATA_MARKET)));
 
-                    std::unique_ptr<OTDB::TradeDataMarket> pTradeData(
-                        dynamic_cast<OTDB::TradeDataMarket*>(OTDB::CreateObject(
-                            OTDB::STORED_OBJ_TRADE_DATA_MARKET)));
-
-                    const std::int64_t& lTransactionNum =
-                        theOffer.GetTransactionNum();
-                    const time64_t theDate = OTTimeGetCurrentTime();
-                    const std::int64_t& lPriceLimit =
-                        theOtherOffer.GetPriceLimit();  // Priced per
-                                                        // scale.
-                    const std::int64_t& lAmountSold = lOfferFinished;
-
-                    pTradeData->transaction_id =
-                        to_string<std::int64_t>(lTransactionNum);
-                    pTradeData->date = to_string<time64_t>(theDate);
-                    pTradeData->price = to_string<std::int64_t>(lPriceLimit);
-                    pTradeData->amount_sold =
-                        to_string<std::int64_t>(lAmountSold);
-
-                    m_strLastSaleDate = pTradeData->date;
-
-                    // *pTradeData is CLONED at this time (I'm still
-                    // responsible to delete.) That's also why I add it
-                    // here, after all the above: So the data is set
-                    // right BEFORE the cloning occurs.
-                    //
-                    m_pTradeList->AddTradeDataMarket(*pTradeData);
-
-                    // Here we erase the oldest elements so the list
-                    // never exceeds 50 elements total.
-                    //
-                    while (m_pTradeList->GetTradeDataMarketCount() >
-                           MAX_MARKET_QUERY_DEPTH)
-                        m_pTradeList->RemoveTradeDataMarket(0);
-                }
+                OT_ASSERT(nullptr != pTradeData);
+
+                const std::int64_t& lTransactionNum =
+                    theOffer.GetTransactionNum();
+                const time64_t theDate = OTTimeGetCurrentTime();
+                const std::int64_t& lPriceLimit =
+                    theOtherOffer.GetPriceLimit();  // Priced per scale.
+                const std::int64_t& lAmountSold = lOfferFinished;
+
+                pTradeData->transaction_id =
+                    to_string<std::int64_t>(lTransactionNum);
+                pTradeData->date = to_string<time64_t>(theDate);
+                pTradeData->price = to_string<std::int64_t>(lPriceLimit);
+                pTradeData->amount_sold = to_string<std::int64_t>(lAmountSold);
+
+                m_strLastSaleDate = pTradeData->date;
+
+                add_trade(*pTradeData);
+                publish_trade(*pTradeData);
 
                 // Account balances have changed based on these trades
                 // that we just processed. Make sure to save the Market
                 // since it contains those offers that have just
-                // updated.
-                SaveMarket();
+                // updated. The trade is journaled with them.
+                save_fill(theOffer, theOtherOffer, *pTradeData);
 
-                // The Trade has changed, and it is stored as a
-                // CronItem. So I save Cron as well, for the same reason
-                // I saved the Market.
-                pCron->SaveCron();
+                // Both trades are stored as cron items. Their files are
+                // written with the other changed items of this cron round.
             }
 
             //
@@ -2367,21 +2668,20 @@ bool OTMarket::ProcessTrade(
     // THIS TRADE'S PRICE LIMITS. So we're going to go up the list of
     // what's available, and trade.
 
+    // Set when the matching loop below decides whether this trade stays on
+    // the market. The callbacks return false to stop the loop.
+    bool bFinished{false};
+    bool bStayOnMarket{true};
+
     if (theOffer.IsAsk())  // If I'm selling,
     {
-        // rbegin puts us on the upper bound of the highest bidder (any
-        // new bidders at the same price would be added at the lower
-        // bound, where they are last in line.) The upper bound, on the
-        // other hand, is first in line.  So we start there, and loop
-        // backwards until there are no other bids within my price
-        // range.
-        for (mapOfOffers::reverse_iterator rr = m_mapBids.rbegin();
-             rr != m_mapBids.rend();
-             ++rr) {
+        // The bid book visits the highest bidder first, and the oldest bid
+        // first among bids at the same price. So we start there, and loop
+        // until there are no other bids within my price range.
+        m_bookBids.ForEach([&](OTOffer& offer) -> bool {
             // then I want to start at the highest bidder and loop DOWN
             // until hitting my price limit.
-            OTOffer* pBid = rr->second;
-            OT_ASSERT(nullptr != pBid);
+            OTOffer* pBid = &offer;
 
             // NOTE: Market orders only process once, and they are
             // processed in the order they were added to the market.
@@ -2399,7 +2699,7 @@ bool OTMarket::ProcessTrade(
                 //          if (theOffer.IsMarketOrder() &&
                 // pBid->IsMarketOrder())
                 //              continue;
-                break;
+                return false;
             // NOTE: Why break, instead of continue? Because since we
             // are looping through the bids, from the HIGHEST down to
             // the LOWEST, and since market orders have a ZERO price, we
@@ -2444,9 +2744,11 @@ bool OTMarket::ProcessTrade(
             // all the remaining bids are even lower.)
             //
             else if (theOffer.IsLimitOrder()) {
-                pBid = nullptr;
-                return true;  // stay on cron for more processing (for
-                              // now.)
+                // stay on cron for more processing (for now.)
+                bFinished = true;
+                bStayOnMarket = true;
+
+                return false;
             }
 
             // The offer has no more trading to do--it's done.
@@ -2467,26 +2769,26 @@ bool OTMarket::ProcessTrade(
                            theOffer.GetAmountAvailable())
                        << "\n";
 
-                return false;  // remove this trade from cron
+                // remove this trade from cron
+                bFinished = true;
+                bStayOnMarket = false;
+
+                return false;
             }
 
-            pBid = nullptr;
-        }
+            return true;
+        });
     }
     // I'm buying
     else {
-        // Begin puts us on the lower bound of the lowest seller (any
-        // new sellers at the same price would be added at the upper
-        // bound for that price, where they are last in line.) The lower
-        // bound, on the other hand, is first in line.  So we start
-        // there, and loop forwards until there are no other asks within
-        // my price range.
+        // The ask book visits the lowest seller first, and the oldest ask
+        // first among asks at the same price. So we start there, and loop
+        // until there are no other asks within my price range.
         //
-        for (auto& it : m_mapAsks) {
+        m_bookAsks.ForEach([&](OTOffer& offer) -> bool {
             // then I want to start at the lowest seller and loop UP
             // until hitting my price limit.
-            OTOffer* pAsk = it.second;
-            OT_ASSERT(nullptr != pAsk);
+            OTOffer* pAsk = &offer;
 
             // NOTE: Market orders only process once, and they are
             // processed in the order they were added to the market.
@@ -2503,7 +2805,7 @@ bool OTMarket::ProcessTrade(
             if (pAsk->IsMarketOrder())
                 //          if (theOffer.IsMarketOrder() &&
                 // pAsk->IsMarketOrder())
-                continue;
+                return true;
 
             // I'm buying.
             // If the ask price is less than, or equal to, my price
@@ -2535,8 +2837,11 @@ bool OTMarket::ProcessTrade(
             // Else, the ask price is higher than I am willing to pay.
             // (And all the remaining sellers are even HIGHER.)
             else if (theOffer.IsLimitOrder()) {
-                pAsk = nullptr;
-                return true;  // stay on the market for now.
+                // stay on the market for now.
+                bFinished = true;
+                bStayOnMarket = true;
+
+                return false;
             }
 
             // The offer has no more trading to do--it's done.
@@ -2557,13 +2862,19 @@ bool OTMarket::ProcessTrade(
                            theOffer.GetAmountAvailable())
                        << "\n";
 
-                return false;  // remove this trade from the market.
+                // remove this trade from the market.
+                bFinished = true;
+                bStayOnMarket = false;
+
+                return false;
             }
 
-            pAsk = nullptr;
-        }
+            return true;
+        });
     }
 
+    if (bFinished) { return bStayOnMarket; }
+
     // Market orders only process once.
     // (So tell the caller to remove it.)
     //
@@ -2665,6 +2976,9 @@ void OTMarket::Release_Market()
 
     m_NOTARY_ID->Release();
 
+    m_lJournalStart = 0;
+    m_lJournalNext = 0;
+
     // Elements of this list are cleaned up automatically.
     if (nullptr != m_pTradeList) {
         delete m_pTradeList;
@@ -2673,18 +2987,15 @@ void OTMarket::Release_Market()
 
     // If there were any dynamically allocated objects, clean them up
     // here.
-    while (!m_mapBids.empty()) {
-        OTOffer* pOffer = m_mapBids.begin()->second;
-        m_mapBids.erase(m_mapBids.begin());
-        delete pOffer;
-        pOffer = nullptr;
-    }
-    while (!m_mapAsks.empty()) {
-        OTOffer* pOffer = m_mapAsks.begin()->second;
-        m_mapAsks.erase(m_mapAsks.begin());
-        delete pOffer;
-        pOffer = nullptr;
-    }
+    const auto cleanup = [](OTOffer& offer) -> bool {
+        delete &offer;
+
+        return true;
+    };
+    m_bookBids.ForEach(cleanup);
+    m_bookAsks.ForEach(cleanup);
+    m_bookBids.Clear();
+    m_bookAsks.Clear();
 }
 
 void OTMarket::Release()
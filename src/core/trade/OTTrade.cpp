@@ -517,7 +517,7 @@ OTOffer* OTTrade::GetOffer(Identifier& offerMarketId, OTMarket** market)
             offer_->SignContract(*(GetCron()->GetServerNym()));
             offer_->SaveContract();
 
-            pMarket->SaveMarket();
+            pMarket->SaveOffer(*offer_);
 
             // Now when the market loads next time, it can verify this offer
             // using the server's signature,
@@ -583,7 +583,7 @@ OTOffer* OTTrade::GetOffer(Identifier& offerMarketId, OTMarket** market)
                 offer_->SignContract(*(GetCron()->GetServerNym()));
                 offer_->SaveContract();
 
-                pMarket->SaveMarket();
+                pMarket->SaveOffer(*offer_);
 
                 // Now when the market loads next time, it can verify this offer
                 // using the server's signature,
@@ -711,6 +711,26 @@ std::int64_t OTTrade::GetCurrencyAcctClosingNum() const
                                           : 0;  // todo stop hardcoding.
 }
 
+bool OTTrade::GetConflictKeys(
+    std::set<std::string>& accounts,
+    std::set<std::string>& nyms,
+    std::set<std::string>& other) const
+{
+    accounts.insert(String(GetSenderAcctID()).Get());
+    nyms.insert(String(GetSenderNymID()).Get());
+    accounts.insert(String(GetCurrencyAcctID()).Get());
+
+    // Any other trade on the same market may be matched against this one, so
+    // all of them share a key. (Markets which differ only by scale share it
+    // too.)
+    const String instrumentDefinitionID(GetInstrumentDefinitionID());
+    const String currencyID(GetCurrencyID());
+    other.insert(
+        std::string(instrumentDefinitionID.Get()) + "/" + currencyID.Get());
+
+    return true;
+}
+
 /// See if nym has rights to remove this item from Cron.
 bool OTTrade::CanRemoveItemFromCron(const ClientContext& context)
 {
@@ -11,6 +11,7 @@
 #include "opentxs/api/Core.hpp"
 #include "opentxs/core/contract/ServerContract.hpp"
 #include "opentxs/core/Armored.hpp"
+#include "opentxs/core/Data.hpp"
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Lockable.hpp"
@@ -31,12 +32,18 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <ctime>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "ServerConnection.hpp"
 
@@ -51,12 +58,13 @@ OTServerConnection ServerConnection::Factory(
     const api::Core& api,
     const api::network::ZMQ& zmq,
     const zeromq::PublishSocket& updates,
+    const zeromq::PublishSocket& boxUpdates,
     const std::shared_ptr<const ServerContract>& contract)
 {
     OT_ASSERT(contract)
 
-    return OTServerConnection(
-        new implementation::ServerConnection(api, zmq, updates, contract));
+    return OTServerConnection(new implementation::ServerConnection(
+        api, zmq, updates, boxUpdates, contract));
 }
 }  // namespace opentxs::network
 
@@ -66,10 +74,12 @@ ServerConnection::ServerConnection(
     const api::Core& api,
     const api::network::ZMQ& zmq,
     const zeromq::PublishSocket& updates,
+    const zeromq::PublishSocket& boxUpdates,
     const std::shared_ptr<const ServerContract>& contract)
     : zmq_(zmq)
     , api_(api)
     , updates_(updates)
+    , box_updates_(boxUpdates)
     , server_id_(contract->ID()->str())
     , address_type_(zmq.DefaultAddressType())
     , remote_contract_(contract)
@@ -81,8 +91,20 @@ ServerConnection::ServerConnection(
     , socket_(zmq.Context().DealerSocket(callback_, true))
     , last_activity_(std::time(nullptr))
     , socket_ready_(Flag::Factory(false))
+    , socket_stale_(Flag::Factory(false))
     , status_(Flag::Factory(false))
     , use_proxy_(Flag::Factory(false))
+    , negotiated_(Flag::Factory(false))
+    , probing_(Flag::Factory(false))
+    , probe_failed_(Flag::Factory(false))
+    , raw_format_(Flag::Factory(false))
+    , incoming_lock_()
+    , negotiation_()
+    , pending_()
+    , notifications_ready_(Flag::Factory(false))
+    , topic_lock_()
+    , topics_()
+    , subscription_(0)
 {
     thread_.reset(new std::thread(&ServerConnection::activity_timer, this));
 
@@ -106,8 +128,12 @@ void ServerConnection::activity_timer()
             }
         }
 
+        expire(false);
         Log::Sleep(std::chrono::seconds(1));
     }
+
+    expire(true);
+    negotiation_.notify_all();
 }
 
 bool ServerConnection::ChangeAddressType(const proto::AddressType type)
@@ -159,6 +185,57 @@ std::string ServerConnection::endpoint() const
     return endpoint;
 }
 
+// Fails requests whose deadline has passed, or every outstanding request if
+// all is set
+void ServerConnection::expire(const bool all)
+{
+    const auto now = std::chrono::system_clock::now();
+    const auto status =
+        zmq_.Running() ? SendResult::TIMEOUT : SendResult::ERROR;
+    std::vector<std::promise<NetworkReplyMessage>> expired{};
+    Lock lock(incoming_lock_);
+
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (all || (it->second.deadline_ <= now)) {
+            expired.emplace_back(std::move(it->second.promise_));
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (expired.empty()) { return; }
+
+    release_socket(lock, SendResult::TIMEOUT == status);
+    lock.unlock();
+
+    for (auto& promise : expired) { promise.set_value(reply(status)); }
+}
+
+bool ServerConnection::finish(
+    const PendingKey& key,
+    NetworkReplyMessage&& reply,
+    const bool stale)
+{
+    Lock lock(incoming_lock_);
+    auto it = pending_.find(key);
+
+    if (pending_.end() == it) {
+        otInfo << OT_METHOD << __FUNCTION__ << ": No request " << key.second
+               << " is waiting for a reply." << std::endl;
+
+        return false;
+    }
+
+    auto promise = std::move(it->second.promise_);
+    pending_.erase(it);
+    release_socket(lock, stale);
+    lock.unlock();
+    promise.set_value(std::move(reply));
+
+    return true;
+}
+
 std::string ServerConnection::form_endpoint(
     proto::AddressType type,
     std::string hostname,
@@ -186,6 +263,7 @@ zeromq::DealerSocket& ServerConnection::get_socket(const Lock& lock)
     OT_ASSERT(verify_lock(lock))
 
     if (false == socket_ready_.get()) {
+        reset_format(lock);
         socket_ = socket(lock);
         socket_ready_->On();
     }
@@ -193,12 +271,59 @@ zeromq::DealerSocket& ServerConnection::get_socket(const Lock& lock)
     return socket_;
 }
 
+// Notaries which understand the raw format answer an empty raw request with an
+// empty raw reply. Older notaries fail to parse it and reply with a single
+// empty frame. If the probe is not answered at all the armored format is used
+// until the socket is replaced, so that later requests do not wait on another
+// probe.
+MessageFormat ServerConnection::format(const Lock& lock)
+{
+    OT_ASSERT(verify_lock(lock))
+
+    // Replacing a stale socket resets the format, so it happens first
+    get_socket(lock);
+
+    if ((false == negotiated_.get()) && (false == probe_failed_.get())) {
+        const auto tag{MessageFormat::Raw};
+        auto probe = zeromq::Message::Factory();
+        probe->AddFrame();
+        probe->AddFrame(Data::Factory(&tag, sizeof(tag)));
+        probe->AddFrame();
+        probing_->On();
+
+        if (get_socket(lock).Send(probe)) {
+            Lock incoming(incoming_lock_);
+            negotiation_.wait_until(incoming, get_timeout(), [&]() -> bool {
+                return negotiated_.get() || (false == zmq_.Running());
+            });
+        }
+
+        probing_->Off();
+
+        if (false == negotiated_.get()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": No reply to format probe. Using armored format."
+                  << std::endl;
+            probe_failed_->On();
+        }
+    }
+
+    if (raw_format_.get()) { return MessageFormat::Raw; }
+
+    return MessageFormat::Armored;
+}
+
 std::chrono::time_point<std::chrono::system_clock> ServerConnection::
     get_timeout()
 {
     return std::chrono::system_clock::now() + zmq_.SendTimeout();
 }
 
+bool ServerConnection::Notifications() const
+{
+    return notifications_ready_.get();
+}
+
 void ServerConnection::process_incoming(const zeromq::Message& in)
 {
     if (status_->On()) { publish(); }
@@ -207,22 +332,96 @@ void ServerConnection::process_incoming(const zeromq::Message& in)
 
     OT_ASSERT(false != bool(message));
 
-    if (1 != in.Body().size()) {
+    const auto body = in.Body();
+    auto format{MessageFormat::Armored};
+    // Position of the reply, which may be followed by attachments
+    std::size_t index{0};
+
+    if (0 < body.size()) {
+        const auto& tag = body.at(0);
+
+        // A serialized reply is never as short as the format tag
+        if (sizeof(MessageFormat) == tag.size()) {
+            format = *static_cast<const MessageFormat*>(tag.data());
+
+            if (MessageFormat::Notification == format) {
+                process_notification(in);
+
+                return;
+            }
+
+            if (MessageFormat::Raw == format) {
+                index = 1;
+            } else {
+                format = MessageFormat::Armored;
+            }
+        }
+    }
+
+    if (index >= body.size()) {
         otErr << OT_METHOD << __FUNCTION__ << ": Invalid incoming message."
               << std::endl;
 
         return;
     }
 
-    auto& frame = *in.Body().begin();
+    auto& frame = body.at(index);
+
+    if (0 == frame.size()) {
+        Lock lock(incoming_lock_);
+
+        if (MessageFormat::Raw == format) {
+            if (index + 1 < body.size()) {
+                const auto& push = body.at(index + 1);
+
+                if ((sizeof(MessageFormat) == push.size()) &&
+                    (MessageFormat::Notification ==
+                     *static_cast<const MessageFormat*>(push.data()))) {
+                    notifications_ready_->On();
+                }
+            }
+
+            raw_format_->On();
+            negotiated_->On();
+        } else if (probing_.get()) {
+            negotiated_->On();
+        }
+
+        lock.unlock();
+        negotiation_.notify_all();
 
-    if (0 == frame.size()) { return; }
+        return;
+    }
 
-    Armored armored{};
-    armored.Set(std::string(frame).c_str());
     String serialized{};
-    armored.GetString(serialized);
+    const auto view = frame.View();
+    const auto size = static_cast<std::uint32_t>(view.size());
+
+    if (MessageFormat::Raw == format) {
+        serialized.MemSet(view.data(), size);
+    } else {
+        Armored armored{};
+        armored.MemSet(view.data(), size);
+        armored.GetString(serialized);
+    }
+
     const auto loaded = message->LoadContractFromString(serialized);
+    reset_timer();
+
+    if (false == loaded) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Received server reply, "
+              << "but unable to instantiate it as a Message:\n"
+              << std::string(frame) << std::endl;
+        // The request it answers can not be identified, so that request is
+        // left to time out rather than failing one which may still succeed
+
+        return;
+    }
+
+    for (auto i = index + 1; i < body.size(); ++i) {
+        message->m_Attachments.emplace_back(body.at(i).View());
+    }
+
     const RequestNumber number = message->m_strRequestNum.ToLong();
 
     if (0 > number) {
@@ -232,17 +431,38 @@ void ServerConnection::process_incoming(const zeromq::Message& in)
         return;
     }
 
-    Lock lock(incoming_lock_);
-    auto& reply = incoming_[number];
+    const PendingKey key{message->m_strNymID.Get(), number};
+    std::shared_ptr<Message> output{message.release()};
 
-    if (loaded) {
-        reply.reset(message.release());
-    } else {
-        otErr << OT_METHOD << __FUNCTION__ << ": Received server reply, "
-              << "but unable to instantiate it as a Message:\n"
-              << std::string(frame) << std::endl;
-        reply.reset();
+    // The notary pushes a nym's box updates to the connection which carried
+    // its latest successful raw request
+    if (output->m_bSuccess && raw_format_.get()) {
+        subscribe(output->m_strNymID.Get());
+    }
+
+    finish(key, {SendResult::VALID_REPLY, output});
+}
+
+// Box updates are republished with the notary ID in place of the tag
+void ServerConnection::process_notification(const zeromq::Message& in)
+{
+    const auto body = in.Body();
+
+    if (5 != body.size()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid notification."
+              << std::endl;
+
+        return;
+    }
+
+    auto message = zeromq::Message::Factory();
+    message->AddFrame(server_id_);
+
+    for (std::size_t i = 1; i < body.size(); ++i) {
+        message->AddFrame(std::string(body.at(i)));
     }
+
+    box_updates_.Publish(message);
 }
 
 void ServerConnection::publish() const
@@ -254,11 +474,44 @@ void ServerConnection::publish() const
     updates_.Publish(message);
 }
 
+// Expects incoming_lock_ to be held. A lost reply may never arrive, so the
+// socket is replaced before the next request, but not while other requests
+// still expect replies on it.
+void ServerConnection::release_socket(const Lock& lock, const bool stale)
+{
+    OT_ASSERT((&incoming_lock_ == lock.mutex()) && lock.owns_lock())
+
+    if (stale) { socket_stale_->On(); }
+
+    if (socket_stale_.get() && pending_.empty()) {
+        socket_stale_->Off();
+        socket_ready_->Off();
+    }
+}
+
+// The replacement socket may reach a different endpoint, so the format is
+// negotiated again. The notary pushes nothing to the new socket until each nym
+// sends another request on it.
+void ServerConnection::reset_format(const Lock& lock)
+{
+    OT_ASSERT(verify_lock(lock))
+
+    Lock incoming(incoming_lock_);
+    negotiated_->Off();
+    probe_failed_->Off();
+    raw_format_->Off();
+    notifications_ready_->Off();
+    incoming.unlock();
+    Lock topicLock(topic_lock_);
+    topics_.clear();
+}
+
 void ServerConnection::reset_socket(const Lock& lock)
 {
     OT_ASSERT(verify_lock(lock))
 
     socket_ready_->Off();
+    reset_format(lock);
 }
 
 void ServerConnection::reset_timer()
@@ -266,59 +519,89 @@ void ServerConnection::reset_timer()
     last_activity_.store(std::time(nullptr));
 }
 
+NetworkReplyMessage ServerConnection::reply(const SendResult status) const
+{
+    NetworkReplyMessage output{status, nullptr};
+    output.second.reset(api_.Factory().Message().release());
+
+    OT_ASSERT(false != bool(output.second));
+
+    return output;
+}
+
 NetworkReplyMessage ServerConnection::Send(const Message& message)
 {
-    NetworkReplyMessage output{SendResult::ERROR, nullptr};
-    auto& status = output.first;
-    auto& reply = output.second;
-    reply.reset(api_.Factory().Message().release());
+    auto future = SendAsync(message);
+    const auto limit = get_timeout();
 
-    OT_ASSERT(false != bool(reply));
+    if (std::future_status::ready != future.wait_until(limit)) {
+        const PendingKey key{message.m_strNymID.Get(),
+                             message.m_strRequestNum.ToLong()};
+        const auto status =
+            zmq_.Running() ? SendResult::TIMEOUT : SendResult::ERROR;
+
+        finish(key, reply(status), SendResult::TIMEOUT == status);
+    }
+
+    return future.get();
+}
 
+std::future<NetworkReplyMessage> ServerConnection::SendAsync(
+    const Message& message)
+{
+    std::promise<NetworkReplyMessage> promise{};
+    auto output = promise.get_future();
     String raw;
     message.SaveContractRaw(raw);
-    Armored envelope(raw);
 
-    if (false == envelope.Exists()) { return output; }
+    // Nothing would expire the request after the activity timer has exited
+    if ((false == zmq_.Running()) || (false == raw.Exists())) {
+        promise.set_value(reply(SendResult::ERROR));
 
-    Lock socketLock(lock_);
-    auto request =
-        network::zeromq::Message::Factory(std::string(envelope.Get()));
-    request->EnsureDelimiter();
-    auto sent = get_socket(socketLock).Send(request);
+        return output;
+    }
 
-    if (false == sent) { return output; }
+    Lock socketLock(lock_);
+    auto request = network::zeromq::Message::Factory();
 
-    const auto limit = get_timeout();
-    const RequestNumber number = message.m_strRequestNum.ToLong();
+    if (MessageFormat::Raw == format(socketLock)) {
+        const auto tag{MessageFormat::Raw};
+        request->AddFrame();
+        request->AddFrame(Data::Factory(&tag, sizeof(tag)));
+        request->AddFrame(std::string(raw.Get(), raw.GetLength()));
+    } else {
+        Armored envelope(raw);
 
-    while (zmq_.Running() && (std::chrono::system_clock::now() < limit)) {
-        Lock mapLock(incoming_lock_);
-        auto it = incoming_.find(number);
+        if (false == envelope.Exists()) {
+            promise.set_value(reply(SendResult::ERROR));
 
-        if (incoming_.end() != it) {
-            reply.reset(it->second.release());
+            return output;
+        }
 
-            if (reply) {
-                status = SendResult::VALID_REPLY;
-            } else {
-                status = SendResult::INVALID_REPLY;
-                reset_socket(socketLock);
-            }
+        request->AddFrame(std::string(envelope.Get()));
+        request->EnsureDelimiter();
+    }
 
-            incoming_.erase(it);
-            reset_timer();
+    const PendingKey key{message.m_strNymID.Get(),
+                         message.m_strRequestNum.ToLong()};
+    Lock incomingLock(incoming_lock_);
 
-            return output;
-        }
+    if (0 < pending_.count(key)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Request " << key.second
+              << " is already in progress." << std::endl;
+        promise.set_value(reply(SendResult::ERROR));
 
-        mapLock.unlock();
-        Log::Sleep(std::chrono::milliseconds(5));
+        return output;
     }
 
-    if (zmq_.Running()) {
-        status = SendResult::TIMEOUT;
-        reset_socket(socketLock);
+    // Registered before sending so that a fast reply can not be missed
+    auto& pending = pending_[key];
+    pending.promise_ = std::move(promise);
+    pending.deadline_ = get_timeout();
+    incomingLock.unlock();
+
+    if (false == get_socket(socketLock).Send(request)) {
+        finish(key, reply(SendResult::ERROR));
     }
 
     return output;
@@ -377,6 +660,27 @@ OTZMQDealerSocket ServerConnection::socket(const Lock& lock) const
 
 bool ServerConnection::Status() const { return status_.get(); }
 
+void ServerConnection::subscribe(const std::string& nymID)
+{
+    if ((false == notifications_ready_.get()) || nymID.empty()) { return; }
+
+    Lock lock(topic_lock_);
+
+    if (0 == topics_.count(nymID)) { topics_[nymID] = ++subscription_; }
+}
+
+std::uint64_t ServerConnection::Subscription(const std::string& nymID) const
+{
+    if (false == notifications_ready_.get()) { return 0; }
+
+    Lock lock(topic_lock_);
+    const auto it = topics_.find(nymID);
+
+    if (topics_.end() == it) { return 0; }
+
+    return it->second;
+}
+
 ServerConnection::~ServerConnection()
 {
     if (thread_) { thread_->join(); }
@@ -16,17 +16,29 @@ public:
     bool ChangeAddressType(const proto::AddressType type) override;
     bool ClearProxy() override;
     bool EnableProxy() override;
+    bool Notifications() const override;
     NetworkReplyMessage Send(const Message& message) override;
+    std::future<NetworkReplyMessage> SendAsync(const Message& message) override;
     bool Status() const override;
+    std::uint64_t Subscription(const std::string& nymID) const override;
 
     ~ServerConnection();
 
 private:
     friend opentxs::network::ServerConnection;
 
+    // Replies are routed by nym and request number
+    using PendingKey = std::pair<std::string, RequestNumber>;
+
+    struct Pending {
+        std::promise<NetworkReplyMessage> promise_{};
+        std::chrono::time_point<std::chrono::system_clock> deadline_{};
+    };
+
     const api::network::ZMQ& zmq_;
     const api::Core& api_;
     const zeromq::PublishSocket& updates_;
+    const zeromq::PublishSocket& box_updates_;
     const std::string server_id_{};
     proto::AddressType address_type_{proto::ADDRESSTYPE_ERROR};
     std::shared_ptr<const ServerContract> remote_contract_{nullptr};
@@ -35,10 +47,28 @@ private:
     OTZMQDealerSocket socket_;
     std::atomic<std::time_t> last_activity_{0};
     OTFlag socket_ready_;
+    // Set when a reply was lost. The socket is replaced once no other request
+    // is waiting for a reply on it
+    OTFlag socket_stale_;
     OTFlag status_;
     OTFlag use_proxy_;
+    OTFlag negotiated_;
+    OTFlag probing_;
+    // Set when a probe went unanswered. Cleared when the socket is replaced
+    OTFlag probe_failed_;
+    OTFlag raw_format_;
     std::mutex incoming_lock_;
-    std::map<RequestNumber, std::unique_ptr<Message>> incoming_;
+    // Signalled when format negotiation finishes
+    std::condition_variable negotiation_;
+    std::map<PendingKey, Pending> pending_;
+    // Set when the notary advertises box updates during format negotiation
+    OTFlag notifications_ready_;
+    mutable std::mutex topic_lock_;
+    // Nyms whose box updates are pushed to the current socket, each with the
+    // subscription which receives them. Guarded by topic_lock_
+    std::map<std::string, std::uint64_t> topics_;
+    // Incremented whenever a nym is subscribed. Guarded by topic_lock_
+    std::uint64_t subscription_{0};
 
     ServerConnection* clone() const override { return nullptr; }
     std::string endpoint() const;
@@ -54,15 +84,27 @@ private:
     OTZMQDealerSocket socket(const Lock& lock) const;
 
     void activity_timer();
+    void expire(const bool all);
+    bool finish(
+        const PendingKey& key,
+        NetworkReplyMessage&& reply,
+        const bool stale = false);
+    MessageFormat format(const Lock& lock);
     zeromq::DealerSocket& get_socket(const Lock& lock);
     void process_incoming(const zeromq::Message& in);
+    void process_notification(const zeromq::Message& in);
+    void release_socket(const Lock& lock, const bool stale);
+    NetworkReplyMessage reply(const SendResult status) const;
+    void reset_format(const Lock& lock);
     void reset_socket(const Lock& lock);
     void reset_timer();
+    void subscribe(const std::string& nymID);
 
     ServerConnection(
         const api::Core& api,
         const api::network::ZMQ& zmq,
         const zeromq::PublishSocket& updates,
+        const zeromq::PublishSocket& boxUpdates,
         const std::shared_ptr<const ServerContract>& contract);
     ServerConnection() = delete;
     ServerConnection(const ServerConnection&) = delete;
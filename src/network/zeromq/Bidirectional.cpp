@@ -15,6 +15,7 @@
 
 #include <zmq.h>
 #include "Message.hpp"
+#include "Reactor.hpp"
 
 #define CALLBACK_WAIT_MILLISECONDS 50
 #define POLL_MILLISECONDS 1000
@@ -29,7 +30,7 @@ Bidirectional::Bidirectional(
     std::mutex& lock,
     void* socket,
     const bool startThread)
-    : Receiver(lock, socket, false)
+    : Receiver(context, lock, socket, false)
     , push_socket_{zmq_socket(context, ZMQ_PUSH)}
     , endpoint_{INPROC_PREFIX}
     , pull_socket_{zmq_socket(context, ZMQ_PULL)}
@@ -47,7 +48,11 @@ Bidirectional::Bidirectional(
 
     OT_ASSERT(false != connected);
 
-    if (startThread) {
+    if (false == startThread) { return; }
+
+    if (nullptr != reactor_) {
+        reactor_->Add(*this, {receiver_socket_, pull_socket_});
+    } else {
         receiver_thread_.reset(new std::thread(&Bidirectional::thread, this));
 
         OT_ASSERT(receiver_thread_)
@@ -205,6 +210,13 @@ bool Bidirectional::process_receiver_socket()
     return true;
 }
 
+bool Bidirectional::process_socket(void* socket)
+{
+    if (pull_socket_ == socket) { return process_pull_socket(); }
+
+    return process_receiver_socket();
+}
+
 bool Bidirectional::queue_message(zeromq::Message& message) const
 {
     OT_ASSERT(nullptr != push_socket_);
@@ -47,6 +47,7 @@ private:
         const;
     bool process_pull_socket();
     bool process_receiver_socket();
+    bool process_socket(void* socket) override;
     bool send(zeromq::Message& message);
     void thread() override;
 
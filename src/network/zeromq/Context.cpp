@@ -22,6 +22,7 @@
 #include "opentxs/network/zeromq/SubscribeSocket.hpp"
 
 #include "PairEventListener.hpp"
+#include "Reactor.hpp"
 
 #include <zmq.h>
 
@@ -32,9 +33,11 @@ template class opentxs::Pimpl<opentxs::network::zeromq::Context>;
 
 namespace opentxs::network::zeromq
 {
-OTZMQContext Context::Factory()
+OTZMQContext Context::Factory() { return Factory(0); }
+
+OTZMQContext Context::Factory(const std::size_t reactorThreads)
 {
-    return OTZMQContext(new implementation::Context());
+    return OTZMQContext(new implementation::Context(reactorThreads));
 }
 
 std::string Context::EncodePrivateZ85(const opentxs::crypto::key::Ed25519& key)
@@ -66,11 +69,19 @@ std::string Context::EncodePrivateZ85(const opentxs::crypto::key::Ed25519& key)
 
 namespace opentxs::network::zeromq::implementation
 {
-Context::Context()
+Context::Context(const std::size_t reactorThreads)
     : context_(zmq_ctx_new())
+    , reactor_threads_(reactorThreads)
+    , reactor_(nullptr)
 {
     OT_ASSERT(nullptr != context_);
     OT_ASSERT(1 == zmq_has("curve"));
+
+    if (0 < reactor_threads_) {
+        reactor_.reset(new Reactor(context_, reactor_threads_));
+
+        OT_ASSERT(reactor_)
+    }
 }
 
 Context::operator void*() const
@@ -98,7 +109,7 @@ std::string Context::BuildEndpoint(
     return BuildEndpoint(path, instance, version) + PATH_SEPERATOR + suffix;
 }
 
-Context* Context::clone() const { return new Context; }
+Context* Context::clone() const { return new Context(reactor_threads_); }
 
 OTZMQDealerSocket Context::DealerSocket(
     const ListenCallback& callback,
@@ -191,6 +202,8 @@ OTZMQSubscribeSocket Context::SubscribeSocket(
 
 Context::~Context()
 {
+    reactor_.reset();
+
     if (nullptr != context_) { zmq_ctx_shutdown(context_); }
 }
 }  // namespace opentxs::network::zeromq::implementation
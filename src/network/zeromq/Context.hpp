@@ -9,8 +9,12 @@
 
 #include "opentxs/network/zeromq/Context.hpp"
 
+#include <memory>
+
 namespace opentxs::network::zeromq::implementation
 {
+class Reactor;
+
 class Context : virtual public zeromq::Context
 {
 public:
@@ -58,16 +62,21 @@ public:
     OTZMQSubscribeSocket SubscribeSocket(
         const ListenCallback& callback) const override;
 
+    /** Returns nullptr unless receiving sockets share reactor threads */
+    implementation::Reactor* SharedReactor() const { return reactor_.get(); }
+
     ~Context();
 
 private:
     friend network::zeromq::Context;
 
     void* context_{nullptr};
+    const std::size_t reactor_threads_{0};
+    std::unique_ptr<implementation::Reactor> reactor_;
 
     Context* clone() const override;
 
-    Context();
+    explicit Context(const std::size_t reactorThreads);
     Context(const Context&) = delete;
     Context(Context&&) = delete;
     Context& operator=(const Context&) = delete;
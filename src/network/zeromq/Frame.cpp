@@ -15,6 +15,10 @@
 
 template class opentxs::Pimpl<opentxs::network::zeromq::Frame>;
 
+// Moved strings no larger than this are copied, since they are likely held
+// inline by std::string and zeromq stores frames this small inline as well
+#define FRAME_COPY_LIMIT 32
+
 namespace opentxs::network::zeromq
 {
 OTZMQFrame Frame::Factory() { return OTZMQFrame(new implementation::Frame()); }
@@ -28,6 +32,15 @@ OTZMQFrame Frame::Factory(const std::string& input)
 {
     return OTZMQFrame(new implementation::Frame(input));
 }
+
+OTZMQFrame Frame::Factory(std::string&& input)
+{
+    if (FRAME_COPY_LIMIT >= input.size()) {
+        return OTZMQFrame(new implementation::Frame(input));
+    }
+
+    return OTZMQFrame(new implementation::Frame(std::move(input)));
+}
 }  // namespace opentxs::network::zeromq
 
 namespace opentxs::network::zeromq::implementation
@@ -74,6 +87,22 @@ Frame::Frame(const std::string& input)
     OT_ASSERT(0 == init);
 }
 
+Frame::Frame(std::string&& input)
+    : message_(new zmq_msg_t)
+{
+    OT_ASSERT(nullptr != message_);
+
+    // zeromq calls release once the last copy of the frame is closed
+    auto buffer = new std::string(std::move(input));
+
+    OT_ASSERT(nullptr != buffer);
+
+    const auto init = zmq_msg_init_data(
+        message_, buffer->data(), buffer->size(), &Frame::release, buffer);
+
+    OT_ASSERT(0 == init);
+}
+
 Frame::operator zmq_msg_t*() { return message_; }
 
 Frame::operator std::string() const
@@ -83,7 +112,19 @@ Frame::operator std::string() const
     return output;
 }
 
-Frame* Frame::clone() const { return new Frame(std::string(*this)); }
+Frame* Frame::clone() const
+{
+    auto output = new Frame();
+
+    OT_ASSERT(nullptr != output);
+
+    // zeromq shares the buffer of all but the smallest frames
+    const auto copied = zmq_msg_copy(output->message_, message_);
+
+    OT_ASSERT(0 == copied);
+
+    return output;
+}
 
 const void* Frame::data() const
 {
@@ -92,6 +133,11 @@ const void* Frame::data() const
     return zmq_msg_data(message_);
 }
 
+void Frame::release(void*, void* hint)
+{
+    delete static_cast<std::string*>(hint);
+}
+
 std::size_t Frame::size() const
 {
     OT_ASSERT(nullptr != message_);
@@ -99,8 +145,17 @@ std::size_t Frame::size() const
     return zmq_msg_size(message_);
 }
 
+std::string_view Frame::View() const
+{
+    return std::string_view(static_cast<const char*>(data()), size());
+}
+
 Frame::~Frame()
 {
-    if (nullptr != message_) { zmq_msg_close(message_); }
+    if (nullptr != message_) {
+        zmq_msg_close(message_);
+        delete message_;
+        message_ = nullptr;
+    }
 }
 }  // namespace opentxs::network::zeromq::implementation
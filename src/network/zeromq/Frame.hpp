@@ -18,6 +18,7 @@ public:
 
     const void* data() const override;
     std::size_t size() const override;
+    std::string_view View() const override;
 
     operator zmq_msg_t*() override;
 
@@ -28,11 +29,14 @@ private:
 
     zmq_msg_t* message_{nullptr};
 
+    static void release(void* data, void* hint);
+
     Frame* clone() const override;
 
     Frame();
     explicit Frame(const Data& input);
     explicit Frame(const std::string& input);
+    explicit Frame(std::string&& input);
     Frame(const Frame&) = delete;
     Frame(Frame&&) = delete;
     Frame& operator=(Frame&&) = delete;
@@ -69,7 +69,7 @@ Frame& Message::AddFrame()
 {
     OTZMQFrame message = Frame::Factory();
 
-    messages_.emplace_back(message);
+    messages_.emplace_back(std::move(message));
     return messages_.back().get();
 }
 
@@ -77,7 +77,7 @@ Frame& Message::AddFrame(const opentxs::Data& input)
 {
     OTZMQFrame message = Frame::Factory(input);
 
-    messages_.emplace_back(message);
+    messages_.emplace_back(std::move(message));
     return messages_.back().get();
 }
 
@@ -85,7 +85,15 @@ Frame& Message::AddFrame(const std::string& input)
 {
     OTZMQFrame message = Frame::Factory(input);
 
-    messages_.emplace_back(message);
+    messages_.emplace_back(std::move(message));
+    return messages_.back().get();
+}
+
+Frame& Message::AddFrame(std::string&& input)
+{
+    OTZMQFrame message = Frame::Factory(std::move(input));
+
+    messages_.emplace_back(std::move(message));
     return messages_.back().get();
 }
 
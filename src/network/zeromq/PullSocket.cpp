@@ -47,7 +47,7 @@ PullSocket::PullSocket(
     const bool startThread)
     : ot_super(context, SocketType::Pull)
     , CurveServer(lock_, socket_)
-    , Receiver(lock_, socket_, startThread)
+    , Receiver(context, lock_, socket_, startThread)
     , client_(client)
     , callback_(callback)
 {
@@ -0,0 +1,277 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "Reactor.hpp"
+
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Log.hpp"
+
+#include "Receiver.hpp"
+
+#include <zmq.h>
+
+#include <algorithm>
+
+#define POLL_MILLISECONDS 1000
+#define INPROC_PREFIX "inproc://opentxs/reactor/"
+
+#define OT_METHOD "opentxs::network::zeromq::implementation::Reactor::"
+
+namespace opentxs::network::zeromq::implementation
+{
+Reactor::Reactor(void* context, const std::size_t threads)
+    : running_(Flag::Factory(true))
+    , workers_()
+    , lock_()
+    , assigned_()
+    , load_(threads, 0)
+{
+    OT_ASSERT(nullptr != context)
+    OT_ASSERT(0 < threads)
+
+    const int linger{0};
+
+    for (std::size_t i = 0; i < threads; ++i) {
+        auto& worker = *workers_.emplace_back(new Worker);
+        const auto endpoint =
+            std::string(INPROC_PREFIX) + Identifier::Random()->str();
+        worker.wakeup_ = zmq_socket(context, ZMQ_PULL);
+        worker.wake_ = zmq_socket(context, ZMQ_PUSH);
+
+        OT_ASSERT(nullptr != worker.wakeup_)
+        OT_ASSERT(nullptr != worker.wake_)
+
+        zmq_setsockopt(worker.wake_, ZMQ_LINGER, &linger, sizeof(linger));
+        zmq_setsockopt(worker.wakeup_, ZMQ_LINGER, &linger, sizeof(linger));
+        const auto bound = zmq_bind(worker.wakeup_, endpoint.c_str());
+
+        OT_ASSERT(0 == bound)
+
+        const auto connected = zmq_connect(worker.wake_, endpoint.c_str());
+
+        OT_ASSERT(0 == connected)
+
+        worker.thread_.reset(
+            new std::thread(&Reactor::run, this, std::ref(worker)));
+
+        OT_ASSERT(worker.thread_)
+    }
+}
+
+void Reactor::Add(Receiver& receiver, const std::vector<void*>& sockets)
+{
+    Lock lock(lock_);
+
+    OT_ASSERT(0 == assigned_.count(&receiver))
+
+    const auto index = static_cast<std::size_t>(std::distance(
+        load_.begin(), std::min_element(load_.begin(), load_.end())));
+    ++load_.at(index);
+    assigned_.emplace(&receiver, index);
+    auto& worker = *workers_.at(index);
+    lock.unlock();
+    Lock pending(worker.pending_lock_);
+
+    for (const auto& socket : sockets) {
+        OT_ASSERT(nullptr != socket)
+
+        worker.added_.emplace_back(socket, &receiver);
+    }
+
+    wake(pending, worker);
+}
+
+void Reactor::drain(void* socket)
+{
+    char buffer[1]{};
+
+    while (-1 != zmq_recv(socket, buffer, sizeof(buffer), ZMQ_DONTWAIT)) {}
+}
+
+void Reactor::merge(const Lock& lock, Worker& worker)
+{
+    OT_ASSERT(lock.mutex() == &worker.lock_)
+
+    Lock pending(worker.pending_lock_);
+
+    for (const auto& [socket, receiver] : worker.added_) {
+        worker.receivers_.emplace(socket, receiver);
+        worker.changed_ = true;
+    }
+
+    worker.added_.clear();
+}
+
+void Reactor::Remove(const Receiver& receiver)
+{
+    Lock lock(lock_);
+    const auto it = assigned_.find(&receiver);
+
+    if (assigned_.end() == it) { return; }
+
+    const auto index = it->second;
+    assigned_.erase(it);
+    --load_.at(index);
+    auto& worker = *workers_.at(index);
+    lock.unlock();
+    const bool callback =
+        worker.thread_ &&
+        (std::this_thread::get_id() == worker.thread_->get_id());
+
+    if (callback) {
+        // The worker thread already holds its lock while dispatching
+        Lock dispatch(worker.lock_, std::adopt_lock);
+        remove(dispatch, worker, receiver);
+        dispatch.release();
+
+        return;
+    }
+
+    Lock dispatch(worker.lock_);
+    remove(dispatch, worker, receiver);
+
+    if (false == worker.polling_) { return; }
+
+    // The sockets may still be in the set the worker is polling
+    const auto cycle = worker.cycle_;
+
+    {
+        Lock pending(worker.pending_lock_);
+        wake(pending, worker);
+    }
+
+    while (worker.polling_ && (cycle == worker.cycle_)) {
+        worker.polled_.wait(dispatch);
+    }
+}
+
+void Reactor::remove(
+    const Lock& lock,
+    Worker& worker,
+    const Receiver& receiver)
+{
+    OT_ASSERT(lock.mutex() == &worker.lock_)
+
+    for (auto it = worker.receivers_.begin(); it != worker.receivers_.end();) {
+        if (&receiver == it->second) {
+            it = worker.receivers_.erase(it);
+            worker.changed_ = true;
+        } else {
+            ++it;
+        }
+    }
+
+    Lock pending(worker.pending_lock_);
+    auto& added = worker.added_;
+    added.erase(
+        std::remove_if(
+            added.begin(),
+            added.end(),
+            [&receiver](const Registration& registration) -> bool {
+                return &receiver == registration.second;
+            }),
+        added.end());
+}
+
+void Reactor::run(Worker& worker)
+{
+    otInfo << OT_METHOD << __FUNCTION__ << ": Starting reactor" << std::endl;
+    std::vector<zmq_pollitem_t> poll{};
+    Lock lock(worker.lock_);
+
+    while (running_.get()) {
+        merge(lock, worker);
+
+        if (worker.changed_) {
+            poll.clear();
+            poll.emplace_back();
+            poll.back().socket = worker.wakeup_;
+            poll.back().events = ZMQ_POLLIN;
+
+            for (const auto& [socket, receiver] : worker.receivers_) {
+                poll.emplace_back();
+                poll.back().socket = socket;
+                poll.back().events = ZMQ_POLLIN;
+            }
+
+            worker.changed_ = false;
+        }
+
+        worker.polling_ = true;
+        lock.unlock();
+        const auto events = zmq_poll(
+            poll.data(), static_cast<int>(poll.size()), POLL_MILLISECONDS);
+        lock.lock();
+        worker.polling_ = false;
+        ++worker.cycle_;
+        worker.polled_.notify_all();
+
+        if (0 == events) { continue; }
+
+        if (-1 == events) {
+            const auto error = zmq_errno();
+
+            if (ETERM == error) { break; }
+
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Poll error: " << zmq_strerror(error) << std::endl;
+
+            continue;
+        }
+
+        if (ZMQ_POLLIN == poll[0].revents) { drain(worker.wakeup_); }
+
+        for (std::size_t i = 1; i < poll.size(); ++i) {
+            auto& item = poll[i];
+
+            if (ZMQ_POLLIN != item.revents) { continue; }
+
+            const auto it = worker.receivers_.find(item.socket);
+
+            // Removed by an earlier callback during this cycle
+            if (worker.receivers_.end() == it) { continue; }
+
+            auto& receiver = *it->second;
+
+            if (false == receiver.have_callback()) { continue; }
+
+            receiver.process_socket(item.socket);
+        }
+    }
+
+    worker.polling_ = false;
+    worker.polled_.notify_all();
+    otInfo << OT_METHOD << __FUNCTION__ << ": Shutting down" << std::endl;
+}
+
+void Reactor::wake(const Lock& lock, Worker& worker)
+{
+    OT_ASSERT(lock.mutex() == &worker.pending_lock_)
+
+    zmq_send(worker.wake_, nullptr, 0, ZMQ_DONTWAIT);
+}
+
+Reactor::~Reactor()
+{
+    running_->Off();
+
+    for (auto& worker : workers_) {
+        {
+            Lock pending(worker->pending_lock_);
+            wake(pending, *worker);
+        }
+
+        if (worker->thread_ && worker->thread_->joinable()) {
+            worker->thread_->join();
+            worker->thread_.reset();
+        }
+
+        zmq_close(worker->wake_);
+        zmq_close(worker->wakeup_);
+    }
+}
+}  // namespace opentxs::network::zeromq::implementation
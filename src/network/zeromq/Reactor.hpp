@@ -0,0 +1,85 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Internal.hpp"
+
+#include "opentxs/core/Flag.hpp"
+#include "opentxs/Types.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opentxs::network::zeromq::implementation
+{
+class Receiver;
+
+/** Polls the sockets of many receivers from a small set of threads
+ *
+ *  Each receiver is assigned to the worker with the fewest receivers. Workers
+ *  are woken through an inproc socket whenever their poll set changes.
+ *  Callbacks run on the worker thread, so a slow callback delays the other
+ *  receivers which share its worker.
+ */
+class Reactor
+{
+public:
+    void Add(Receiver& receiver, const std::vector<void*>& sockets);
+    /** Returns once no worker can dispatch to the receiver */
+    void Remove(const Receiver& receiver);
+
+    Reactor(void* context, const std::size_t threads);
+
+    ~Reactor();
+
+private:
+    // socket, receiver
+    using Registration = std::pair<void*, Receiver*>;
+
+    struct Worker {
+        // Held by the worker thread except while it is polling
+        std::mutex lock_{};
+        std::condition_variable polled_{};
+        std::uint64_t cycle_{0};
+        bool polling_{false};
+        bool changed_{true};
+        std::map<void*, Receiver*> receivers_{};
+        // Guards added_ and wake_
+        std::mutex pending_lock_{};
+        std::vector<Registration> added_{};
+        void* wake_{nullptr};
+        void* wakeup_{nullptr};
+        std::unique_ptr<std::thread> thread_{nullptr};
+    };
+
+    OTFlag running_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex lock_;
+    std::map<const Receiver*, std::size_t> assigned_;
+    std::vector<std::size_t> load_;
+
+    static void drain(void* socket);
+    static void merge(const Lock& lock, Worker& worker);
+    static void remove(
+        const Lock& lock,
+        Worker& worker,
+        const Receiver& receiver);
+    static void wake(const Lock& lock, Worker& worker);
+
+    void run(Worker& worker);
+
+    Reactor() = delete;
+    Reactor(const Reactor&) = delete;
+    Reactor(Reactor&&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+    Reactor& operator=(Reactor&&) = delete;
+};
+}  // namespace opentxs::network::zeromq::implementation
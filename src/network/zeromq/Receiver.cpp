@@ -7,11 +7,14 @@
 
 #include "Receiver.hpp"
 #include "opentxs/core/Log.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
 #include "opentxs/network/zeromq/Frame.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
 
 #include <zmq.h>
+#include "Context.hpp"
 #include "Message.hpp"
+#include "Reactor.hpp"
 
 #define CALLBACK_WAIT_MILLISECONDS 50
 #define POLL_MILLISECONDS 1000
@@ -20,19 +23,89 @@
 
 namespace opentxs::network::zeromq::implementation
 {
-Receiver::Receiver(std::mutex& lock, void* socket, const bool startThread)
+Receiver::Receiver(
+    const zeromq::Context& context,
+    std::mutex& lock,
+    void* socket,
+    const bool startThread)
     : receiver_lock_(lock)
     , receiver_socket_(socket)
     , receiver_run_(Flag::Factory(true))
     , receiver_thread_(nullptr)
+    , reactor_(reactor(context))
 {
-    if (startThread) {
+    if (false == startThread) { return; }
+
+    if (nullptr != reactor_) {
+        reactor_->Add(*this, {receiver_socket_});
+    } else {
         receiver_thread_.reset(new std::thread(&Receiver::thread, this));
 
         OT_ASSERT(receiver_thread_)
     }
 }
 
+bool Receiver::process_socket(void* socket)
+{
+    OT_ASSERT(receiver_socket_ == socket)
+
+    Lock lock(receiver_lock_, std::try_to_lock);
+
+    if (!lock.owns_lock()) { return false; }
+
+    auto reply = Message::Factory();
+
+    bool receiving{true};
+
+    while (receiving) {
+        auto& frame = reply->AddFrame();
+        const bool received = (-1 != zmq_msg_recv(frame, receiver_socket_, 0));
+
+        if (false == received) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Receive error: " << zmq_strerror(zmq_errno())
+                  << std::endl;
+
+            return false;
+        }
+
+        int option{0};
+        std::size_t optionBytes{sizeof(option)};
+
+        const bool haveOption =
+            (-1 != zmq_getsockopt(
+                       receiver_socket_, ZMQ_RCVMORE, &option, &optionBytes));
+
+        if (false == haveOption) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to check socket options error:\n"
+                  << zmq_strerror(zmq_errno()) << std::endl;
+
+            return false;
+        }
+
+        OT_ASSERT(optionBytes == sizeof(option))
+
+        if (1 != option) { receiving = false; }
+    }
+
+    process_incoming(lock, reply);
+
+    lock.unlock();
+
+    return true;
+}
+
+Reactor* Receiver::reactor(const zeromq::Context& context)
+{
+    const auto* implementation =
+        dynamic_cast<const zeromq::implementation::Context*>(&context);
+
+    if (nullptr == implementation) { return nullptr; }
+
+    return implementation->SharedReactor();
+}
+
 void Receiver::thread()
 {
     otInfo << OT_METHOD << __FUNCTION__ << ": Starting listener" << std::endl;
@@ -66,50 +139,7 @@ void Receiver::thread()
             continue;
         }
 
-        Lock lock(receiver_lock_, std::try_to_lock);
-        if (!lock.owns_lock()) { return; }
-
-        auto reply = Message::Factory();
-
-        bool receiving{true};
-
-        while (receiving) {
-            auto& frame = reply->AddFrame();
-            const bool received =
-                (-1 != zmq_msg_recv(frame, receiver_socket_, 0));
-
-            if (false == received) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": Receive error: " << zmq_strerror(zmq_errno())
-                      << std::endl;
-
-                return;
-            }
-
-            int option{0};
-            std::size_t optionBytes{sizeof(option)};
-
-            const bool haveOption =
-                (-1 !=
-                 zmq_getsockopt(
-                     receiver_socket_, ZMQ_RCVMORE, &option, &optionBytes));
-
-            if (false == haveOption) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": Failed to check socket options error:\n"
-                      << zmq_strerror(zmq_errno()) << std::endl;
-
-                return;
-            }
-
-            OT_ASSERT(optionBytes == sizeof(option))
-
-            if (1 != option) { receiving = false; }
-        }
-
-        process_incoming(lock, reply);
-
-        lock.unlock();
+        if (false == process_socket(receiver_socket_)) { return; }
     }
 
     otInfo << OT_METHOD << __FUNCTION__ << ": Shutting down" << std::endl;
@@ -117,6 +147,8 @@ void Receiver::thread()
 
 Receiver::~Receiver()
 {
+    if (nullptr != reactor_) { reactor_->Remove(*this); }
+
     Lock lock(receiver_lock_);
     receiver_run_->Off();
 
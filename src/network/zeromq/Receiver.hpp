@@ -16,10 +16,16 @@
 
 namespace opentxs::network::zeromq::implementation
 {
+class Reactor;
+
 class Receiver
 {
 protected:
-    Receiver(std::mutex& lock, void* socket, const bool startThread);
+    Receiver(
+        const zeromq::Context& context,
+        std::mutex& lock,
+        void* socket,
+        const bool startThread);
 
     virtual ~Receiver();
 
@@ -28,13 +34,21 @@ protected:
     void* receiver_socket_{nullptr};
     OTFlag receiver_run_;
     std::unique_ptr<std::thread> receiver_thread_{nullptr};
+    // Not owned by this class. Set if the context polls sockets for us.
+    Reactor* const reactor_{nullptr};
 
     virtual bool have_callback() const { return false; }
 
     virtual void process_incoming(const Lock& lock, Message& message) = 0;
+    /** Receives one message from a socket which is ready for reading */
+    virtual bool process_socket(void* socket);
     virtual void thread();
 
 private:
+    friend Reactor;
+
+    static Reactor* reactor(const zeromq::Context& context);
+
     Receiver() = delete;
     Receiver(const Receiver&) = delete;
     Receiver(Receiver&&) = delete;
@@ -38,15 +38,38 @@ SubscribeSocket::SubscribeSocket(
     const zeromq::ListenCallback& callback)
     : ot_super(context, SocketType::Subscribe)
     , CurveClient(lock_, socket_)
-    , Receiver(lock_, socket_, true)
+    , Receiver(context, lock_, socket_, true)
     , callback_(callback)
+    , filtered_(false)
 {
-    // subscribe to all messages until filtering is implemented
+    // subscribe to all messages until a topic is added
     const auto set = zmq_setsockopt(socket_, ZMQ_SUBSCRIBE, "", 0);
 
     OT_ASSERT(0 == set);
 }
 
+bool SubscribeSocket::AddTopic(const std::string& topic) const
+{
+    Lock lock(lock_);
+
+    const auto set =
+        zmq_setsockopt(socket_, ZMQ_SUBSCRIBE, topic.data(), topic.size());
+
+    if (0 != set) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to add topic."
+              << std::endl;
+
+        return false;
+    }
+
+    if (false == filtered_) {
+        zmq_setsockopt(socket_, ZMQ_UNSUBSCRIBE, "", 0);
+        filtered_ = true;
+    }
+
+    return true;
+}
+
 SubscribeSocket* SubscribeSocket::clone() const
 {
     return new SubscribeSocket(context_, callback_);
@@ -21,6 +21,7 @@ class SubscribeSocket : virtual public zeromq::SubscribeSocket,
                         Receiver
 {
 public:
+    bool AddTopic(const std::string& topic) const override;
     bool SetSocksProxy(const std::string& proxy) const override;
     bool Start(const std::string& endpoint) const override;
 
@@ -28,6 +29,7 @@ public:
 
 protected:
     const ListenCallback& callback_;
+    mutable bool filtered_{false};
 
     SubscribeSocket(
         const zeromq::Context& context,
@@ -20,6 +20,8 @@
 
 #include "ServerSettings.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -123,6 +125,39 @@ bool ConfigLoader::load(
         OTCron::SetCronMaxItemsPerNym(static_cast<std::int32_t>(lValue));
     }
 
+    {
+        const char* szComment = "; worker_threads is the number of threads "
+                                "cron uses to process items (such as\n"
+                                "; payment plans) which share no accounts "
+                                "with each other. 0 processes every\n"
+                                "; item on the cron thread.\n";
+
+        bool bIsNewKey = false;
+        std::int64_t lValue = 0;
+        config.CheckSet_long(
+            "cron", "worker_threads", 0, lValue, bIsNewKey, szComment);
+        OTCron::SetCronWorkerThreads(static_cast<std::int32_t>(lValue));
+    }
+
+    {
+        const char* szComment = "; market_snapshot_seconds is how often a "
+                                "snapshot of every market is published\n"
+                                "; to clients which subscribe to market "
+                                "data. 0 publishes snapshots only when\n"
+                                "; a market is saved.\n";
+
+        bool bIsNewKey = false;
+        std::int64_t lValue = 0;
+        config.CheckSet_long(
+            "cron",
+            "market_snapshot_seconds",
+            60,
+            lValue,
+            bIsNewKey,
+            szComment);
+        OTCron::SetMarketSnapshotSeconds(static_cast<std::int32_t>(lValue));
+    }
+
     // HEARTBEAT
 
     {
@@ -157,6 +192,30 @@ bool ConfigLoader::load(
             static_cast<std::int32_t>(lValue));
     }
 
+    // PROCESSING
+
+    {
+        const char* szComment = ";; PROCESSING\n";
+
+        bool bSectionExist = false;
+        config.CheckSetSection("processing", szComment, bSectionExist);
+    }
+
+    {
+        const char* szComment = "; worker_threads is the number of threads "
+                                "processing client requests in parallel.\n"
+                                "; Requests from the same nym are always "
+                                "processed in order by the same thread.\n"
+                                "; 0 processes all requests serially.\n";
+
+        bool bIsNewKey = false;
+        std::int64_t lValue = 0;
+        config.CheckSet_long(
+            "processing", "worker_threads", 0, lValue, bIsNewKey, szComment);
+        ServerSettings::SetWorkerThreads(
+            static_cast<std::size_t>(std::max<std::int64_t>(lValue, 0)));
+    }
+
     // PERMISSIONS
 
     {
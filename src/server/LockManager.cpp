@@ -0,0 +1,91 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "LockManager.hpp"
+
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/Identifier.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+
+namespace opentxs::server
+{
+LockManager::LockManager()
+    : operation_lock_()
+    , map_lock_()
+    , locks_()
+{
+}
+
+LockManager::Locks LockManager::Acquire(const Keys& keys) const
+{
+    Locks output{};
+    output.shared_.reset(new sLock(operation_lock_));
+
+    OT_ASSERT(output.shared_);
+
+    lock_keys(keys, output);
+
+    return output;
+}
+
+LockManager::Locks LockManager::AcquireExclusive() const
+{
+    Locks output{};
+    output.exclusive_.reset(new eLock(operation_lock_));
+
+    OT_ASSERT(output.exclusive_);
+
+    return output;
+}
+
+LockManager::Locks LockManager::AcquireNymbox(const Identifier& nymID) const
+{
+    Keys keys{};
+    AddNymbox(nymID, keys);
+    Locks output{};
+    lock_keys(keys, output);
+
+    return output;
+}
+
+void LockManager::AddAccount(const Identifier& accountID, Keys& keys)
+{
+    if (accountID.empty()) { return; }
+
+    const auto id = accountID.str();
+    keys.emplace(Type::Account, id);
+    keys.emplace(Type::Inbox, id);
+    keys.emplace(Type::Outbox, id);
+}
+
+void LockManager::AddNymbox(const Identifier& nymID, Keys& keys)
+{
+    if (nymID.empty()) { return; }
+
+    keys.emplace(Type::Nymbox, nymID.str());
+}
+
+std::recursive_mutex& LockManager::get(const Key& key) const
+{
+    Lock lock(map_lock_);
+
+    return locks_[key];
+}
+
+void LockManager::lock_keys(const Keys& keys, Locks& output) const
+{
+    // std::set iterates in sorted order, which is what makes concurrent
+    // acquisition deadlock free.
+    for (const auto& key : keys) { output.keys_.emplace_back(get(key)); }
+}
+}  // namespace opentxs::server
@@ -0,0 +1,96 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Internal.hpp"
+
+#include "opentxs/Types.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace opentxs::server
+{
+/** Serializes access to accounts and boxes between request threads
+ *
+ *  An operation which touches more than one account must request every key
+ *  it needs with a single call to Acquire(). Keys are always locked in sorted
+ *  order so overlapping operations can not deadlock each other. Operations
+ *  whose keys can not be determined in advance use AcquireExclusive()
+ *  instead, which waits until no other operation holds any keys.
+ */
+class LockManager
+{
+public:
+    enum class Type : std::uint8_t {
+        Account = 0,
+        Inbox = 1,
+        Outbox = 2,
+        Nymbox = 3,
+    };
+
+    using Key = std::pair<Type, std::string>;
+    using Keys = std::set<Key>;
+
+    class Locks
+    {
+    public:
+        Locks(Locks&&) = default;
+        Locks& operator=(Locks&&) = default;
+
+        ~Locks() = default;
+
+    private:
+        friend LockManager;
+
+        std::unique_ptr<sLock> shared_{nullptr};
+        std::unique_ptr<eLock> exclusive_{nullptr};
+        std::vector<rLock> keys_{};
+
+        Locks() = default;
+        Locks(const Locks&) = delete;
+        Locks& operator=(const Locks&) = delete;
+    };
+
+    /** Adds the account and its inbox and outbox */
+    static void AddAccount(const Identifier& accountID, Keys& keys);
+    static void AddNymbox(const Identifier& nymID, Keys& keys);
+
+    Locks Acquire(const Keys& keys) const;
+    Locks AcquireExclusive() const;
+    /** Locks a nymbox without waiting for exclusive operations
+     *
+     *  Nymbox keys are leaf locks: they may be acquired while holding the
+     *  keys of an operation, but no other key may be acquired while holding
+     *  a nymbox key.
+     */
+    Locks AcquireNymbox(const Identifier& nymID) const;
+
+    LockManager();
+
+    ~LockManager() = default;
+
+private:
+    mutable std::shared_mutex operation_lock_;
+    mutable std::mutex map_lock_;
+    mutable std::map<Key, std::recursive_mutex> locks_;
+
+    std::recursive_mutex& get(const Key& key) const;
+    void lock_keys(const Keys& keys, Locks& output) const;
+
+    LockManager(const LockManager&) = delete;
+    LockManager(LockManager&&) = delete;
+    LockManager& operator=(const LockManager&) = delete;
+    LockManager& operator=(LockManager&&) = delete;
+};
+}  // namespace opentxs::server
@@ -51,6 +51,8 @@ MainFile::MainFile(Server& server)
 
 bool MainFile::SaveMainFileToString(String& strMainFile)
 {
+    rLock lock(server_.GetTransactor().lock_);
+
     Tag tag("notaryServer");
 
     // We're on version 2.0 since adding the master key.
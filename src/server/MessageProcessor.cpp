@@ -8,10 +8,13 @@
 #include "MessageProcessor.hpp"
 
 #include "opentxs/api/network/ZMQ.hpp"
+#include "opentxs/api/storage/Storage.hpp"
 #include "opentxs/api/Core.hpp"
+#include "opentxs/api/Endpoints.hpp"
 #include "opentxs/api/Factory.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/Armored.hpp"
+#include "opentxs/core/Data.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Message.hpp"
@@ -27,14 +30,21 @@
 #include "opentxs/network/zeromq/ReplyCallback.hpp"
 #include "opentxs/network/zeromq/ReplySocket.hpp"
 #include "opentxs/network/zeromq/RouterSocket.hpp"
+#include "opentxs/network/zeromq/SubscribeSocket.hpp"
 
 #include "Server.hpp"
+#include "ServerSettings.hpp"
 #include "UserCommandProcessor.hpp"
 
 #include <stddef.h>
 #include <sys/types.h>
+#include <cstdint>
+#include <functional>
 #include <ostream>
 #include <string>
+#include <utility>
+
+#define WORKER_WAIT_MILLISECONDS 100
 
 #define OT_METHOD "opentxs::MessageProcessor::"
 
@@ -63,15 +73,30 @@ MessageProcessor::MessageProcessor(
     , backend_socket_(context.ReplySocket(backend_callback_.get(), false))
     , internal_callback_(network::zeromq::ListenCallback::Factory(
           [=](const network::zeromq::Message& incoming) -> void {
-              this->process_internal(incoming);
+              this->process_backend_reply(incoming);
           }))
     , internal_socket_(context.DealerSocket(internal_callback_, true))
+    , box_callback_(network::zeromq::ListenCallback::Factory(
+          [=](const network::zeromq::Message& message) -> void {
+              this->process_box_update(message);
+          }))
+    , box_subscriber_(context.SubscribeSocket(box_callback_))
+    , push_(Flag::Factory(false))
     , thread_(nullptr)
     , internal_endpoint_(
           std::string("inproc://opentxs/notary/") + Identifier::Random()->str())
     , counter_lock_()
     , drop_incoming_(0)
     , drop_outgoing_(0)
+    , partitions_()
+    , queue_lock_()
+    , queue_signal_()
+    , unparsed_()
+    , parsed_()
+    , next_sequence_(0)
+    , release_sequence_(0)
+    , connection_lock_()
+    , connections_()
 {
     auto bound = backend_socket_->Start(internal_endpoint_);
     bound &= internal_socket_->Start(internal_endpoint_);
@@ -79,12 +104,59 @@ MessageProcessor::MessageProcessor(
     OT_ASSERT(bound);
 }
 
+// Clients negotiate the raw format with an empty raw request. The reply to it
+// says whether box updates are pushed on the connection.
+void MessageProcessor::advertise(
+    const MessageFormat format,
+    const std::string_view request,
+    std::vector<std::string>& attachments) const
+{
+    if ((MessageFormat::Raw != format) || (false == request.empty())) {
+        return;
+    }
+
+    if (false == push_.get()) { return; }
+
+    const auto tag{MessageFormat::Notification};
+    attachments.emplace_back(reinterpret_cast<const char*>(&tag), sizeof(tag));
+}
+
+// The router socket drops messages for a connection which has since closed, so
+// an entry is only replaced, never removed
+void MessageProcessor::associate(
+    const std::string& nymID,
+    const network::zeromq::Message& incoming)
+{
+    if (nymID.empty() || (0 == incoming.Header().size())) { return; }
+
+    Lock lock(connection_lock_);
+    auto it = connections_.find(nymID);
+    auto envelope = network::zeromq::Message::ReplyFactory(incoming);
+
+    if (connections_.end() == it) {
+        connections_.emplace(nymID, std::move(envelope));
+    } else {
+        it->second = std::move(envelope);
+    }
+}
+
 void MessageProcessor::cleanup()
 {
     if (thread_) {
         thread_->join();
         thread_.reset();
     }
+
+    queue_signal_.notify_all();
+
+    for (auto& partition : partitions_) {
+        if (partition->thread_) {
+            partition->thread_->join();
+            partition->thread_.reset();
+        }
+    }
+
+    partitions_.clear();
 }
 
 void MessageProcessor::DropIncoming(const int count) const
@@ -99,6 +171,35 @@ void MessageProcessor::DropOutgoing(const int count) const
     drop_outgoing_ = count;
 }
 
+std::string_view MessageProcessor::extract_request(
+    const network::zeromq::Message& incoming,
+    MessageFormat& format)
+{
+    const auto body = incoming.Body();
+    format = MessageFormat::Armored;
+
+    if (2 == body.size()) {
+        const auto& tag = body.at(0);
+
+        if ((sizeof(MessageFormat) == tag.size()) &&
+            (MessageFormat::Raw ==
+             *static_cast<const MessageFormat*>(tag.data()))) {
+            format = MessageFormat::Raw;
+
+            return body.at(1).View();
+        }
+
+        otErr << OT_METHOD << __FUNCTION__ << ": Unknown request format."
+              << std::endl;
+
+        return {};
+    }
+
+    if (0 < body.size()) { return body.at(0).View(); }
+
+    return {};
+}
+
 void MessageProcessor::init(
     const bool inproc,
     const int port,
@@ -128,6 +229,13 @@ void MessageProcessor::init(
     otErr << std::endl
           << OT_METHOD << __FUNCTION__ << ": Bound to endpoint "
           << endpoint.str() << std::endl;
+
+    if (box_subscriber_->Start(server_.API().Endpoints().BoxUpdate())) {
+        push_->On();
+    } else {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to subscribe to box updates." << std::endl;
+    }
 }
 
 void MessageProcessor::run()
@@ -136,36 +244,158 @@ void MessageProcessor::run()
         // timeout is the time left until the next cron should execute.
         const auto timeout = server_.ComputeTimeout();
 
-        if (timeout <= 0) {
-            // ProcessCron and process_backend must not run simultaneously
-            Lock lock(lock_);
-            server_.ProcessCron();
-        }
+        // Cron locks the accounts of the items it processes, so requests for
+        // other accounts keep running
+        if (timeout <= 0) { server_.ProcessCron(); }
 
         Log::Sleep(std::chrono::milliseconds(50));
     }
 }
 
+std::unique_ptr<Message> MessageProcessor::parse_request(
+    const std::string_view messageString,
+    const MessageFormat format) const
+{
+    if (messageString.size() < 1) { return nullptr; }
+
+    String serialized;
+
+    const auto size = static_cast<std::uint32_t>(messageString.size());
+
+    if (MessageFormat::Raw == format) {
+        serialized.MemSet(messageString.data(), size);
+    } else {
+        Armored armored;
+        armored.MemSet(messageString.data(), size);
+        armored.GetString(serialized);
+    }
+
+    auto request{server_.API().Factory().Message()};
+
+    if (false == serialized.Exists()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Empty serialized request."
+              << std::endl;
+
+        return nullptr;
+    }
+
+    if (false == request->LoadContractFromString(serialized)) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to deserialized request." << std::endl;
+
+        return nullptr;
+    }
+
+    return request;
+}
+
+// A nym may only change the boxes of its own accounts, so partitioning by nym
+// also orders every box mutation of an account. A nym's requests must run in
+// the order they arrived since each one carries the next request number.
+// Requests which could not be parsed are only answered with an error, so any
+// partition will do.
+MessageProcessor::Partition& MessageProcessor::partition(
+    const Request& request)
+{
+    OT_ASSERT(0 < partitions_.size());
+
+    std::string key{};
+
+    if (request.message_) {
+        key = request.message_->m_strNymID.Get();
+    } else {
+        for (const auto& frame : request.incoming_->Header()) {
+            const auto view = frame.View();
+            key.append(view.data(), view.size());
+        }
+    }
+
+    const auto hash = std::hash<std::string>{}(key);
+
+    return *partitions_.at(hash % partitions_.size());
+}
+
+// The reply socket hides the address of the client, so the authenticated nym
+// travels to process_backend_reply as an extra last frame
 OTZMQMessage MessageProcessor::process_backend(
     const network::zeromq::Message& incoming)
 {
-    // ProcessCron and process_backend must not run simultaneously
-    Lock lock(lock_);
     std::string reply{};
+    std::vector<std::string> attachments{};
+    std::string authenticated{};
+    auto format{MessageFormat::Armored};
+    const auto messageString = extract_request(incoming, format);
+    bool error = processMessage(
+        messageString, format, reply, attachments, authenticated);
+
+    if (error) {
+        reply = "";
+        attachments.clear();
+        advertise(format, messageString, attachments);
+    }
 
-    std::string messageString{};
-    if (0 < incoming.Body().size()) {
-        messageString = *incoming.Body().begin();
+    auto output = reply_message(
+        incoming, format, std::move(reply), std::move(attachments));
+    output->AddFrame(authenticated);
+
+    return output;
+}
+
+void MessageProcessor::process_backend_reply(
+    const network::zeromq::Message& incoming)
+{
+    const auto body = incoming.Body();
+
+    if (0 == body.size()) { return; }
+
+    auto reply = network::zeromq::Message::ReplyFactory(incoming);
+
+    for (std::size_t i = 0; i < body.size() - 1; ++i) {
+        reply->AddFrame(std::string(body.at(i).View()));
     }
 
-    bool error = processMessage(messageString, reply);
+    associate(std::string(body.at(body.size() - 1)), incoming);
+    process_internal(reply);
+}
 
-    if (error) { reply = ""; }
+void MessageProcessor::process_box_update(
+    const network::zeromq::Message& message)
+{
+    const auto body = message.Body();
 
-    auto output = network::zeromq::Message::ReplyFactory(incoming);
-    output->AddFrame(reply);
+    if (4 != body.size()) { return; }
 
-    return output;
+    const auto& typeFrame = body.at(0);
+
+    if (sizeof(ledgerType) != typeFrame.size()) { return; }
+
+    const auto type = *static_cast<const ledgerType*>(typeFrame.data());
+    const auto notaryID = std::string(body.at(1));
+    const auto accountID = std::string(body.at(2));
+    const auto hash = std::string(body.at(3));
+
+    if (server_.GetServerID().str() != notaryID) { return; }
+
+    switch (type) {
+        case ledgerType::nymbox: {
+            push(accountID, {accountID, "nymbox", accountID, hash});
+        } break;
+        case ledgerType::inbox: {
+            const auto nymID = server_.API().Storage().AccountOwner(
+                Identifier::Factory(accountID));
+
+            if (nymID->empty()) {
+                otInfo << OT_METHOD << __FUNCTION__
+                       << ": No owner for account " << accountID << std::endl;
+
+                return;
+            }
+
+            push(nymID->str(), {nymID->str(), "inbox", accountID, hash});
+        } break;
+        default: {
+        }
+    }
 }
 
 void MessageProcessor::process_frontend(
@@ -175,6 +405,9 @@ void MessageProcessor::process_frontend(
 
     if (0 < drop_incoming_) {
         --drop_incoming_;
+    } else if (0 < partitions_.size()) {
+        lock.unlock();
+        queue_request(incoming);
     } else {
         OTZMQMessage request{incoming};
         internal_socket_->Send(request);
@@ -195,47 +428,50 @@ void MessageProcessor::process_internal(
 }
 
 bool MessageProcessor::processMessage(
-    const std::string& messageString,
-    std::string& reply)
+    const std::string_view messageString,
+    const MessageFormat format,
+    std::string& reply,
+    std::vector<std::string>& attachments,
+    std::string& authenticated)
 {
-    if (messageString.size() < 1) { return true; }
-
-    Armored armored;
-    armored.MemSet(messageString.data(), messageString.size());
-    String serialized;
-    armored.GetString(serialized);
-    auto request{server_.API().Factory().Message()};
+    const auto request = parse_request(messageString, format);
 
-    if (false == serialized.Exists()) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Empty serialized request."
-              << std::endl;
+    if (false == bool(request)) { return true; }
 
-        return true;
-    }
-
-    if (false == request->LoadContractFromString(serialized)) {
-        otErr << OT_METHOD << __FUNCTION__
-              << ": Failed to deserialized request." << std::endl;
-
-        return true;
-    }
+    return process_request(
+        *request, format, reply, attachments, authenticated);
+}
 
+// authenticated is set to the nym of a successful raw request. Every command
+// which can succeed verifies the signature of the request first. Armored
+// requests come from clients which do not understand pushed box updates.
+bool MessageProcessor::process_request(
+    const Message& request,
+    const MessageFormat format,
+    std::string& reply,
+    std::vector<std::string>& attachments,
+    std::string& authenticated)
+{
     auto replymsg{server_.API().Factory().Message()};
 
     OT_ASSERT(false != bool(replymsg));
 
     const bool processed =
-        server_.CommandProcessor().ProcessUserCommand(*request, *replymsg);
+        server_.CommandProcessor().ProcessUserCommand(request, *replymsg);
 
     if (false == processed) {
         otWarn << OT_METHOD << __FUNCTION__
-               << ": Failed to process user command " << request->m_strCommand
+               << ": Failed to process user command " << request.m_strCommand
                << std::endl;
-        otInfo << String(*request) << std::endl;
+        otInfo << String(request) << std::endl;
     } else {
         otWarn << OT_METHOD << __FUNCTION__
                << ": Successfully processed user command "
-               << request->m_strCommand << std::endl;
+               << request.m_strCommand << std::endl;
+    }
+
+    if (processed && replymsg->m_bSuccess && (MessageFormat::Raw == format)) {
+        authenticated = request.m_strNymID.Get();
     }
 
     String serializedReply(*replymsg);
@@ -247,6 +483,14 @@ bool MessageProcessor::processMessage(
         return true;
     }
 
+    attachments = std::move(replymsg->m_Attachments);
+
+    if (MessageFormat::Raw == format) {
+        reply.assign(serializedReply.Get(), serializedReply.GetLength());
+
+        return false;
+    }
+
     Armored armoredReply(serializedReply);
 
     if (false == armoredReply.Exists()) {
@@ -261,12 +505,164 @@ bool MessageProcessor::processMessage(
     return false;
 }
 
+void MessageProcessor::process_queued(Request& request)
+{
+    std::string reply{};
+    std::vector<std::string> attachments{};
+    std::string authenticated{};
+    auto format{MessageFormat::Armored};
+    const auto messageString = extract_request(request.incoming_, format);
+    bool error{true};
+
+    if (request.message_) {
+        error = process_request(
+            *request.message_, format, reply, attachments, authenticated);
+    }
+
+    associate(authenticated, request.incoming_);
+
+    if (error) {
+        reply = "";
+        attachments.clear();
+        advertise(format, messageString, attachments);
+    }
+
+    process_internal(reply_message(
+        request.incoming_, format, std::move(reply), std::move(attachments)));
+}
+
+// Box updates are sent on the frontend socket, like replies, but they are not
+// subject to the test counters which drop replies
+void MessageProcessor::push(
+    const std::string& nymID,
+    std::vector<std::string>&& frames)
+{
+    Lock connectionLock(connection_lock_);
+    const auto it = connections_.find(nymID);
+
+    if (connections_.end() == it) { return; }
+
+    OTZMQMessage message{it->second};
+    connectionLock.unlock();
+    const auto tag{MessageFormat::Notification};
+    message->AddFrame(Data::Factory(&tag, sizeof(tag)));
+
+    for (auto& frame : frames) { message->AddFrame(std::move(frame)); }
+
+    Lock lock(counter_lock_);
+    frontend_socket_->Send(message);
+}
+
+// The frontend thread only numbers requests. Parsing them is left to the
+// workers.
+void MessageProcessor::queue_request(const network::zeromq::Message& incoming)
+{
+    Lock lock(queue_lock_);
+    unparsed_.emplace_back(next_sequence_++, OTZMQMessage{incoming});
+    lock.unlock();
+    queue_signal_.notify_all();
+}
+
+// Workers parse in parallel, so requests may finish parsing out of order.
+// They are handed to their partitions in arrival order.
+void MessageProcessor::release_requests(const Lock& lock)
+{
+    OT_ASSERT(lock.mutex() == &queue_lock_);
+    OT_ASSERT(lock.owns_lock());
+
+    while (false == parsed_.empty()) {
+        auto it = parsed_.begin();
+
+        if (release_sequence_ != it->first) { break; }
+
+        auto& target = partition(it->second);
+        target.queue_.emplace_back(std::move(it->second));
+        parsed_.erase(it);
+        ++release_sequence_;
+    }
+}
+
+OTZMQMessage MessageProcessor::reply_message(
+    const network::zeromq::Message& incoming,
+    const MessageFormat format,
+    std::string&& reply,
+    std::vector<std::string>&& attachments)
+{
+    auto output = network::zeromq::Message::ReplyFactory(incoming);
+
+    if (MessageFormat::Raw == format) {
+        output->AddFrame(Data::Factory(&format, sizeof(format)));
+    }
+
+    output->AddFrame(std::move(reply));
+
+    for (auto& attachment : attachments) {
+        output->AddFrame(std::move(attachment));
+    }
+
+    return output;
+}
+
 void MessageProcessor::Start()
 {
+    start_partitions(ServerSettings::GetWorkerThreads());
+
     if (false == bool(thread_)) {
         thread_.reset(new std::thread(&MessageProcessor::run, this));
     }
 }
 
+void MessageProcessor::start_partitions(const std::size_t count)
+{
+    if (0 < partitions_.size()) { return; }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        partitions_.emplace_back(new Partition);
+        auto& partition = *partitions_.back();
+        partition.thread_.reset(new std::thread(
+            &MessageProcessor::worker, this, std::ref(partition)));
+    }
+
+    if (0 < count) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Processing requests with "
+              << count << " worker threads." << std::endl;
+    }
+}
+
+// Each worker processes the requests of its own partition first. While that
+// is empty it parses whichever request arrived first.
+void MessageProcessor::worker(Partition& partition)
+{
+    while (running_) {
+        Lock lock(queue_lock_);
+        queue_signal_.wait_for(
+            lock, std::chrono::milliseconds(WORKER_WAIT_MILLISECONDS), [&]() {
+                return (false == partition.queue_.empty()) ||
+                       (false == unparsed_.empty()) || (false == running_);
+            });
+
+        if (false == partition.queue_.empty()) {
+            auto request = std::move(partition.queue_.front());
+            partition.queue_.pop_front();
+            lock.unlock();
+            process_queued(request);
+        } else if (false == unparsed_.empty()) {
+            auto [sequence, incoming] = std::move(unparsed_.front());
+            unparsed_.pop_front();
+            lock.unlock();
+            auto format{MessageFormat::Armored};
+            auto message =
+                parse_request(extract_request(incoming, format), format);
+            lock.lock();
+            parsed_.emplace(
+                sequence,
+                Request{std::move(incoming), format, std::move(message)});
+            release_requests(lock);
+            lock.unlock();
+            queue_signal_.notify_all();
+        }
+    }
+}
+
 MessageProcessor::~MessageProcessor() {}
 }  // namespace opentxs::server
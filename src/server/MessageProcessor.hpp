@@ -7,18 +7,25 @@
 
 #include "Internal.hpp"
 
-#include "opentxs/core/Lockable.hpp"
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/network/zeromq/Socket.hpp"
 
 #include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace opentxs::server
 {
-class MessageProcessor : Lockable
+class MessageProcessor
 {
 public:
     void DropIncoming(const int count) const;
@@ -36,6 +43,19 @@ public:
     ~MessageProcessor();
 
 private:
+    struct Request {
+        OTZMQMessage incoming_;
+        MessageFormat format_{MessageFormat::Armored};
+        // nullptr if the request could not be parsed
+        std::unique_ptr<Message> message_{nullptr};
+    };
+    // Requests from a single nym always land in the same partition so they
+    // are processed in the order they were received
+    struct Partition {
+        std::deque<Request> queue_{};
+        std::unique_ptr<std::thread> thread_{nullptr};
+    };
+
     Server& server_;
     const Flag& running_;
     [[maybe_unused]] const network::zeromq::Context& context_;
@@ -45,17 +65,75 @@ private:
     OTZMQReplySocket backend_socket_;
     OTZMQListenCallback internal_callback_;
     OTZMQDealerSocket internal_socket_;
+    OTZMQListenCallback box_callback_;
+    OTZMQSubscribeSocket box_subscriber_;
+    // Set once box updates are received, so that they can be pushed to clients
+    OTFlag push_;
     std::unique_ptr<std::thread> thread_{nullptr};
     const std::string internal_endpoint_;
     mutable std::mutex counter_lock_;
     mutable int drop_incoming_{0};
     mutable int drop_outgoing_{0};
+    std::vector<std::unique_ptr<Partition>> partitions_;
+    // Protects everything below, and the queues of the partitions
+    std::mutex queue_lock_;
+    std::condition_variable queue_signal_;
+    // Requests waiting to be parsed by any free worker, by arrival sequence
+    std::deque<std::pair<std::uint64_t, OTZMQMessage>> unparsed_;
+    // Parsed requests wait here until every earlier request is parsed too
+    std::map<std::uint64_t, Request> parsed_;
+    std::uint64_t next_sequence_{0};
+    std::uint64_t release_sequence_{0};
+    std::mutex connection_lock_;
+    // The reply envelope of the connection which carried each nym's most
+    // recent authenticated raw request. A nym's box updates go only there.
+    std::map<std::string, OTZMQMessage> connections_;
+
+    // The returned view points into incoming
+    static std::string_view extract_request(
+        const network::zeromq::Message& incoming,
+        MessageFormat& format);
+    static OTZMQMessage reply_message(
+        const network::zeromq::Message& incoming,
+        const MessageFormat format,
+        std::string&& reply,
+        std::vector<std::string>&& attachments);
 
+    void advertise(
+        const MessageFormat format,
+        const std::string_view request,
+        std::vector<std::string>& attachments) const;
+    void associate(
+        const std::string& nymID,
+        const network::zeromq::Message& incoming);
+    Partition& partition(const Request& request);
+    std::unique_ptr<Message> parse_request(
+        const std::string_view messageString,
+        const MessageFormat format) const;
     void process_frontend(const network::zeromq::Message& incoming);
     void process_internal(const network::zeromq::Message& incoming);
-    bool processMessage(const std::string& messageString, std::string& reply);
+    bool process_request(
+        const Message& request,
+        const MessageFormat format,
+        std::string& reply,
+        std::vector<std::string>& attachments,
+        std::string& authenticated);
+    bool processMessage(
+        const std::string_view messageString,
+        const MessageFormat format,
+        std::string& reply,
+        std::vector<std::string>& attachments,
+        std::string& authenticated);
     OTZMQMessage process_backend(const network::zeromq::Message& incoming);
+    void process_backend_reply(const network::zeromq::Message& incoming);
+    void process_box_update(const network::zeromq::Message& message);
+    void process_queued(Request& request);
+    void push(const std::string& nymID, std::vector<std::string>&& frames);
+    void queue_request(const network::zeromq::Message& incoming);
+    void release_requests(const Lock& lock);
     void run();
+    void start_partitions(const std::size_t count);
+    void worker(Partition& partition);
 
     MessageProcessor() = delete;
 };
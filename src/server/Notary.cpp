@@ -73,6 +73,135 @@ Notary::Notary(Server& server, const opentxs::api::server::Manager& manager)
 {
 }
 
+LockManager::Locks Notary::LockTransaction(
+    const Identifier& accountID,
+    OTTransaction& transaction) const
+{
+    auto& manager = server_.GetLockManager();
+    LockManager::Keys keys{};
+    LockManager::AddAccount(accountID, keys);
+
+    switch (transaction.GetType()) {
+        case transactionType::transfer: {
+            for (auto& item : transaction.GetItemList()) {
+                if (false == bool(item)) { continue; }
+
+                if (itemType::transfer == item->GetType()) {
+                    LockManager::AddAccount(item->GetDestinationAcctID(), keys);
+                }
+            }
+        } break;
+        case transactionType::deposit: {
+            for (auto& item : transaction.GetItemList()) {
+                if (false == bool(item)) { continue; }
+
+                switch (item->GetType()) {
+                    case itemType::depositCheque: {
+                        String serialized;
+                        item->GetAttachment(serialized);
+                        auto cheque{manager_.Factory().Cheque()};
+
+                        OT_ASSERT(cheque);
+
+                        if (false == cheque->LoadContractFromString(
+                                         serialized)) {
+                            continue;
+                        }
+
+                        LockManager::AddAccount(
+                            cheque->GetSenderAcctID(), keys);
+
+                        if (cheque->HasRemitter()) {
+                            LockManager::AddAccount(
+                                cheque->GetRemitterAcctID(), keys);
+                        }
+                    } break;
+                    case itemType::deposit: {
+                        // Cash deposits touch the reserve account of the
+                        // mint, which is not known until the purse is opened
+                        return manager.AcquireExclusive();
+                    }
+                    default: {
+                    }
+                }
+            }
+        } break;
+        case transactionType::processInbox: {
+            // The sender of each accepted or rejected transfer receives a
+            // notice in their inbox and loses the pending transaction from
+            // their outbox. The inbox loaded here is only used to discover
+            // those accounts. A transaction number always refers to the same
+            // sender, so changes to the inbox before the keys are acquired
+            // do not invalidate the result.
+            auto inbox{manager_.Factory().Ledger(
+                transaction.GetNymID(), accountID, server_.GetServerID())};
+
+            OT_ASSERT(inbox);
+
+            if (false == inbox->LoadInbox()) { break; }
+
+            for (auto& item : transaction.GetItemList()) {
+                if (false == bool(item)) { continue; }
+
+                const auto type = item->GetType();
+
+                if ((itemType::acceptPending != type) &&
+                    (itemType::rejectPending != type)) {
+                    continue;
+                }
+
+                const auto number = item->GetReferenceToNum();
+
+                if (false == inbox->LoadBoxReceipt(number)) { continue; }
+
+                auto pending = inbox->GetTransaction(number);
+
+                if (false == bool(pending)) { continue; }
+
+                String serialized;
+                pending->GetReferenceString(serialized);
+                auto original{manager_.Factory().Item(
+                    serialized,
+                    server_.GetServerID(),
+                    pending->GetReferenceToNum())};
+
+                if (original) {
+                    LockManager::AddAccount(
+                        original->GetPurportedAccountID(), keys);
+                }
+            }
+        } break;
+        case transactionType::marketOffer: {
+            auto item = transaction.GetItem(itemType::marketOffer);
+
+            if (false == bool(item)) { break; }
+
+            String serialized;
+            item->GetAttachment(serialized);
+            auto trade{manager_.Factory().Trade()};
+
+            OT_ASSERT(trade);
+
+            if (trade->LoadContractFromString(serialized)) {
+                LockManager::AddAccount(trade->GetCurrencyAcctID(), keys);
+            }
+        } break;
+        case transactionType::withdrawal:
+        case transactionType::payDividend:
+        case transactionType::exchangeBasket:
+        case transactionType::paymentPlan:
+        case transactionType::smartContract: {
+            // These touch server owned accounts (vouchers, mints, baskets) or
+            // the accounts of an unbounded number of other parties.
+            return manager.AcquireExclusive();
+        }
+        default: {
+        }
+    }
+
+    return manager.Acquire(keys);
+}
+
 void Notary::NotarizeTransfer(
     ClientContext& context,
     ExclusiveAccount& theFromAccount,
@@ -3945,6 +4074,8 @@ void Notary::NotarizePaymentPlan(
     // paymentPlan request"
     tranOut.SetType(transactionType::atPaymentPlan);
 
+    rLock cronLock(server_.CronLock());
+
     std::shared_ptr<Item> pItem = nullptr;
     std::shared_ptr<Item> pBalanceItem = nullptr;
     std::shared_ptr<Item> pResponseItem = nullptr;
@@ -4609,6 +4740,8 @@ void Notary::NotarizeSmartContract(
     // the smartContract request"
     tranOut.SetType(transactionType::atSmartContract);
 
+    rLock cronLock(server_.CronLock());
+
     std::shared_ptr<Item> pItem = nullptr;
     std::shared_ptr<Item> pBalanceItem = nullptr;
     std::shared_ptr<Item> pResponseItem = nullptr;
@@ -5396,6 +5529,8 @@ void Notary::NotarizeCancelCronItem(
     // to the cancelCronItem request"
     tranOut.SetType(transactionType::atCancelCronItem);
 
+    rLock cronLock(server_.CronLock());
+
     std::shared_ptr<Item> pItem = nullptr;
     std::shared_ptr<Item> pBalanceItem = nullptr;
     std::shared_ptr<Item> pResponseItem = nullptr;
@@ -6519,6 +6654,8 @@ void Notary::NotarizeMarketOffer(
     // the marketOffer request"
     tranOut.SetType(transactionType::atMarketOffer);
 
+    rLock cronLock(server_.CronLock());
+
     std::shared_ptr<Item> pItem = nullptr;
     std::shared_ptr<Item> pBalanceItem = nullptr;
     std::shared_ptr<Item> pResponseItem = nullptr;
@@ -6954,6 +7091,8 @@ void Notary::NotarizeTransaction(
     const auto lTransactionNumber = tranIn.GetTransactionNum();
     const auto& NYM_ID = context.RemoteNym().ID();
     const String strIDNym(NYM_ID);
+    const auto locks =
+        LockTransaction(tranIn.GetPurportedAccountID(), tranIn);
     auto theFromAccount =
         manager_.Wallet().mutable_Account(tranIn.GetPurportedAccountID());
 
@@ -7340,6 +7479,7 @@ void Notary::NotarizeProcessNymbox(
     const auto& NYM_ID = context.RemoteNym().ID();
     const auto& NOTARY_ID = context.Server();
     std::set<TransactionNumber> newNumbers;
+    const auto nymboxLock = server_.GetLockManager().AcquireNymbox(NYM_ID);
     auto theNymbox{manager_.Factory().Ledger(NYM_ID, NYM_ID, NOTARY_ID)};
 
     OT_ASSERT(false != bool(theNymbox));
@@ -7,6 +7,8 @@
 
 #include "Internal.hpp"
 
+#include "LockManager.hpp"
+
 namespace opentxs
 {
 namespace server
@@ -14,6 +16,11 @@ namespace server
 class Notary
 {
 public:
+    /** Locks every account and box which processing the transaction will
+     *  modify, other than the nymboxes */
+    LockManager::Locks LockTransaction(
+        const Identifier& accountID,
+        OTTransaction& transaction) const;
     void NotarizeProcessInbox(
         ClientContext& context,
         ExclusiveAccount& account,
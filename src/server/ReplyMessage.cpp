@@ -60,6 +60,11 @@ std::set<RequestNumber> ReplyMessage::Acknowledged() const
     return output;
 }
 
+void ReplyMessage::AddAttachment(std::string&& attachment)
+{
+    message_.m_Attachments.emplace_back(std::move(attachment));
+}
+
 void ReplyMessage::attach_request()
 {
     const std::string command = original_.m_strCommand.Get();
@@ -99,6 +104,7 @@ void ReplyMessage::attach_request()
         case MessageType::sendNymMessage:
         case MessageType::getRequestNumber:
         case MessageType::getTransactionNumbers:
+        case MessageType::getBoxReceipts:
         default: {
         }
     }
@@ -130,6 +136,7 @@ void ReplyMessage::clear_request()
         case MessageType::issueBasket:
         case MessageType::registerAccount:
         case MessageType::getBoxReceipt:
+        case MessageType::getBoxReceipts:
         case MessageType::unregisterAccount:
         case MessageType::notarizeTransaction:
         case MessageType::processInbox:
@@ -226,6 +233,8 @@ void ReplyMessage::SetAcknowledgments(const ClientContext& context)
     message_.SetAcknowledgments(context);
 }
 
+void ReplyMessage::SetBool(const bool value) { message_.m_bBool = value; }
+
 void ReplyMessage::SetDepth(const std::int64_t depth)
 {
     message_.m_lDepth = depth;
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <memory>
 #include <set>
+#include <string>
 
 namespace opentxs
 {
@@ -53,12 +54,15 @@ public:
     const bool& Success() const;
 
     ClientContext& Context();
+    /** Sent as an additional frame after the reply */
+    void AddAttachment(std::string&& attachment);
     void ClearRequest();
     void DropToNymbox(const bool success);
     bool LoadContext();
     void OverrideType(const String& accountID);
     void SetAccount(const String& accountID);
     void SetAcknowledgments(const ClientContext& context);
+    void SetBool(const bool value);
     void SetDepth(const std::int64_t depth);
     void SetInboxHash(const Identifier& hash);
     void SetInstrumentDefinitionID(const String& id);
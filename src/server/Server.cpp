@@ -39,6 +39,7 @@
 #include "opentxs/ext/OTPayment.hpp"
 
 #include "ConfigLoader.hpp"
+#include "ServerSettings.hpp"
 #include "Transactor.hpp"
 
 #include <sys/types.h>
@@ -48,6 +49,7 @@
 
 #include <cinttypes>
 #include <cstdint>
+#include <exception>
 #include <fstream>
 #include <regex>
 #include <string>
@@ -78,10 +80,19 @@ std::int32_t OTCron::__cron_max_items_per_nym =
     10;  // The maximum number of cron
 // items any given Nym can have
 // active at the same time.
+std::int32_t OTCron::__cron_worker_threads =
+    0;  // The number of threads used to
+// process cron items which do not
+// share any accounts.
+std::int32_t OTCron::__market_snapshot_seconds =
+    60;  // The number of seconds between
+// published snapshots of every
+// market.
 #endif
 
 Server::Server(const opentxs::api::server::Manager& manager)
     : manager_(manager)
+    , lock_manager_()
     , mainFile_(*this)
     , notary_(*this, manager_)
     , transactor_(*this)
@@ -93,6 +104,7 @@ Server::Server(const opentxs::api::server::Manager& manager)
     , m_strServerNymID()
     , m_nymServer(nullptr)
     , m_Cron(manager.Factory().Cron(manager))
+    , cron_lock_()
 {
 }
 
@@ -115,6 +127,8 @@ void Server::ProcessCron()
 {
     if (!m_Cron->IsActivated()) return;
 
+    rLock lock(cron_lock_);
+    OTCron::CronKeys keys{};
     bool bAddedNumbers = false;
 
     // Cron requires transaction numbers in order to process.
@@ -133,9 +147,28 @@ void Server::ProcessCron()
 
     if (bAddedNumbers) { m_Cron->SaveCron(); }
 
-    m_Cron->ProcessCronItems();  // This needs to be called regularly for
-                                 // trades, markets, payment plans, etc to
-                                 // process.
+    m_Cron->GetDueCronKeys(keys);
+    lock.unlock();
+
+    // Requests lock their accounts before the cron lock, so cron does the
+    // same. Nymbox keys sort after the account keys, so they are still taken
+    // last.
+    LockManager::Keys lockKeys{};
+
+    for (const auto& account : keys.accounts_) {
+        LockManager::AddAccount(Identifier::Factory(account), lockKeys);
+    }
+
+    for (const auto& nym : keys.nyms_) {
+        LockManager::AddNymbox(Identifier::Factory(nym), lockKeys);
+    }
+
+    const auto locks = keys.all_ ? lock_manager_.AcquireExclusive()
+                                 : lock_manager_.Acquire(lockKeys);
+    lock.lock();
+    m_Cron->ProcessCronItems(&keys);  // This needs to be called regularly for
+                                      // trades, markets, payment plans, etc
+                                      // to process.
 
     // NOTE:  TODO:  OTHER RE-OCCURRING SERVER FUNCTIONS CAN GO HERE AS WELL!!
     //
@@ -491,6 +524,18 @@ void Server::Init(bool readOnly)
         OT_FAIL;
     }
 
+    const auto& workerThreads = manager_.GetWorkerThreads();
+
+    if (false == workerThreads.empty()) {
+        try {
+            ServerSettings::SetWorkerThreads(std::stoul(workerThreads));
+        } catch (const std::exception&) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Invalid worker thread count " << workerThreads
+                  << std::endl;
+        }
+    }
+
     String dataPath = manager_.DataFolder().c_str();
 
     // PID -- Make sure we're not running two copies of OT on the same data
@@ -873,6 +918,7 @@ bool Server::DropMessageToNymbox(
     // Grab a string copy of message.
     //
     const String strInMessage(*message);
+    const auto nymboxLock = lock_manager_.AcquireNymbox(RECIPIENT_NYM_ID);
     auto theLedger{manager_.Factory().Ledger(
         RECIPIENT_NYM_ID, RECIPIENT_NYM_ID, NOTARY_ID)};  // The
                                                           // recipient's
@@ -1003,6 +1049,34 @@ bool Server::GetConnectInfo(
     return (haveIP && havePort);
 }
 
+// Market data is published on the notification port, next to the command
+// endpoint.
+bool Server::StartMarketData(const bool inproc, const OTPassword& privateKey)
+{
+    bool notUsed = false;
+    std::int64_t port = 0;
+    manager_.Config().CheckSet_long(
+        SERVER_CONFIG_LISTEN_SECTION,
+        SERVER_CONFIG_NOTIFY_KEY,
+        DEFAULT_NOTIFY_PORT,
+        port,
+        notUsed);
+    port = (MAX_TCP_PORT < port) ? DEFAULT_NOTIFY_PORT : port;
+    port = (MIN_TCP_PORT > port) ? DEFAULT_NOTIFY_PORT : port;
+    std::string endpoint{};
+
+    if (inproc) {
+        endpoint = std::string("inproc://opentxs/notary/") +
+                   std::to_string(manager_.Instance()) + ":";
+    } else {
+        endpoint = "tcp://*:";
+    }
+
+    endpoint += std::to_string(port);
+
+    return m_Cron->StartMarketData(endpoint, privateKey);
+}
+
 std::unique_ptr<OTPassword> Server::TransportKey(Data& pubkey) const
 {
     auto contract = manager_.Wallet().Server(m_notaryID);
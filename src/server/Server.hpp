@@ -12,14 +12,17 @@
 #include "opentxs/core/Nym.hpp"
 #include "opentxs/core/OTTransaction.hpp"
 
+#include "LockManager.hpp"
 #include "Transactor.hpp"
 #include "Notary.hpp"
 #include "MainFile.hpp"
 #include "UserCommandProcessor.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 
@@ -42,12 +45,16 @@ public:
     UserCommandProcessor& CommandProcessor() { return userCommandProcessor_; }
     std::int64_t ComputeTimeout() { return m_Cron->computeTimeout(); }
     OTCron& Cron() { return *m_Cron; }
+    // Must be held while accessing Cron() from request processing threads.
+    // Acquire any LockManager keys before this lock, never after it.
+    std::recursive_mutex& CronLock() const { return cron_lock_; }
     bool DropMessageToNymbox(
         const Identifier& notaryID,
         const Identifier& senderNymID,
         const Identifier& recipientNymID,
         transactionType transactionType,
         const Message& msg);
+    LockManager& GetLockManager() { return lock_manager_; }
     MainFile& GetMainFile() { return mainFile_; }
     Notary& GetNotary() { return notary_; }
     Transactor& GetTransactor() { return transactor_; }
@@ -60,6 +67,7 @@ public:
         const Identifier& recipientNymID,
         const OTPayment& payment,
         const char* command);
+    bool StartMarketData(const bool inproc, const OTPassword& privateKey);
     String& WalletFilename() { return m_strWalletFilename; }
 
     ~Server();
@@ -77,6 +85,7 @@ private:
     const std::uint32_t MAX_TCP_PORT = 63356;
 
     const opentxs::api::server::Manager& manager_;
+    LockManager lock_manager_;
     MainFile mainFile_;
     Notary notary_;
     Transactor transactor_;
@@ -96,6 +105,7 @@ private:
     ConstNym m_nymServer;
     std::unique_ptr<OTCron> m_Cron;  // This is where re-occurring and expiring
                                      // tasks go.
+    mutable std::recursive_mutex cron_lock_;
 
     void CreateMainFile(bool& mainFileExists);
     // Note: SendInstrumentToNym and SendMessageToNym CALL THIS.
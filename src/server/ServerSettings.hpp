@@ -7,6 +7,7 @@
 
 #include "Internal.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -43,6 +44,13 @@ struct ServerSettings {
         __heartbeat_ms_between_beats = value;
     }
 
+    static std::size_t GetWorkerThreads() { return __worker_threads; }
+
+    static void SetWorkerThreads(std::size_t value)
+    {
+        __worker_threads = value;
+    }
+
     static const std::string& GetOverrideNymID() { return __override_nym_id; }
 
     static void SetOverrideNymID(const std::string& id)
@@ -55,6 +63,10 @@ struct ServerSettings {
     static std::int32_t __heartbeat_no_requests;
     static std::int32_t __heartbeat_ms_between_beats;
 
+    // Number of threads processing client requests in parallel. Zero
+    // processes every request on the socket thread, one at a time.
+    static std::size_t __worker_threads;
+
     // The Nym who's allowed to do certain commands even if they are turned off.
     static std::string __override_nym_id;
     // Are usage credits REQUIRED in order to use this server?
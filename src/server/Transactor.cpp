@@ -33,6 +33,7 @@ namespace opentxs::server
 
 Transactor::Transactor(Server& server)
     : server_(server)
+    , lock_()
     , transactionNumber_(0)
     , idToBasketMap_()
     , contractIdToBasketAccountId_()
@@ -51,6 +52,8 @@ Transactor::Transactor(Server& server)
 bool Transactor::issueNextTransactionNumber(
     TransactionNumber& lTransactionNumber)
 {
+    rLock lock(lock_);
+
     // transactionNumber_ stores the last VALID AND ISSUED transaction number.
     // So first, we increment that, since we don't want to issue the same number
     // twice.
@@ -74,6 +77,8 @@ bool Transactor::issueNextTransactionNumberToNym(
     ClientContext& context,
     TransactionNumber& lTransactionNumber)
 {
+    rLock lock(lock_);
+
     if (!issueNextTransactionNumber(lTransactionNumber)) { return false; }
 
     // Each Nym stores the transaction numbers that have been issued to it.
@@ -107,6 +112,8 @@ bool Transactor::addBasketAccountID(
     const Identifier& BASKET_ACCOUNT_ID,
     const Identifier& BASKET_CONTRACT_ID)
 {
+    rLock lock(lock_);
+
     auto theBasketAcctID = Identifier::Factory();
 
     if (lookupBasketAccountID(BASKET_ID, theBasketAcctID)) {
@@ -132,6 +139,8 @@ bool Transactor::lookupBasketAccountIDByContractID(
     const Identifier& BASKET_CONTRACT_ID,
     OTIdentifier& BASKET_ACCOUNT_ID)
 {
+    rLock lock(lock_);
+
     // Server stores a map of BASKET_ID to BASKET_ACCOUNT_ID. Let's iterate
     // through that map...
     for (auto& it : contractIdToBasketAccountId_) {
@@ -160,6 +169,8 @@ bool Transactor::lookupBasketContractIDByAccountID(
     const Identifier& BASKET_ACCOUNT_ID,
     OTIdentifier& BASKET_CONTRACT_ID)
 {
+    rLock lock(lock_);
+
     // Server stores a map of BASKET_ID to BASKET_ACCOUNT_ID. Let's iterate
     // through that map...
     for (auto& it : contractIdToBasketAccountId_) {
@@ -188,6 +199,8 @@ bool Transactor::lookupBasketAccountID(
     const Identifier& BASKET_ID,
     OTIdentifier& BASKET_ACCOUNT_ID)
 {
+    rLock lock(lock_);
+
     // Server stores a map of BASKET_ID to BASKET_ACCOUNT_ID. Let's iterate
     // through that map...
     for (auto& it : idToBasketMap_) {
@@ -215,6 +228,8 @@ bool Transactor::lookupBasketAccountID(
 ExclusiveAccount Transactor::getVoucherAccount(
     const Identifier& INSTRUMENT_DEFINITION_ID)
 {
+    rLock lock(lock_);
+
     const auto NOTARY_NYM_ID = Identifier::Factory(server_.GetServerNym()),
                NOTARY_ID = Identifier::Factory(server_.GetServerID());
     bool bWasAcctCreated = false;
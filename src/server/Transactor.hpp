@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace opentxs
@@ -32,10 +33,16 @@ public:
         ClientContext& context,
         TransactionNumber& txNumber);
 
-    TransactionNumber transactionNumber() const { return transactionNumber_; }
+    TransactionNumber transactionNumber() const
+    {
+        rLock lock(lock_);
+
+        return transactionNumber_;
+    }
 
     void transactionNumber(TransactionNumber value)
     {
+        rLock lock(lock_);
         transactionNumber_ = value;
     }
 
@@ -70,6 +77,9 @@ private:
     typedef std::map<std::string, std::string> BasketsMap;
 
     Server& server_;
+    // Requests may be processed on several threads at once. Recursive since
+    // saving the main file reads the state below.
+    mutable std::recursive_mutex lock_;
     // This stores the last VALID AND ISSUED transaction number.
     TransactionNumber transactionNumber_;
     // maps basketId with basketAccountId
@@ -58,6 +58,8 @@
 #define OT_METHOD "opentxs::UserCommandProcessor::"
 #define MAX_UNUSED_NUMBERS 100
 #define ISSUE_NUMBER_BATCH 100
+#define BOX_RECEIPT_BATCH 100
+#define BOX_RECEIPT_BATCH_BYTES 4194304
 #define NYMBOX_DEPTH 0
 #define INBOX_DEPTH 1
 #define OUTBOX_DEPTH 2
@@ -178,6 +180,9 @@ bool UserCommandProcessor::add_numbers_to_nymbox(
     Ledger& nymbox,
     Identifier& nymboxHash) const
 {
+    const auto nymboxLock =
+        server_.GetLockManager().AcquireNymbox(nymbox.GetNymID());
+
     if (false == nymbox.LoadNymbox()) {
         otErr << OT_METHOD << __FUNCTION__ << ": Error loading nymbox."
               << std::endl;
@@ -269,6 +274,7 @@ void UserCommandProcessor::check_acknowledgements(ReplyMessage& reply) const
     // list, we will want to save (at the end.)
     auto numlist_ack_reply = reply.Acknowledged();
     const auto nymID = Identifier::Factory(context.RemoteNym().ID());
+    const auto nymboxLock = server_.GetLockManager().AcquireNymbox(nymID);
     auto nymbox{manager_.Factory().Ledger(nymID, nymID, context.Server())};
 
     OT_ASSERT(false != bool(nymbox));
@@ -545,6 +551,9 @@ bool UserCommandProcessor::cmd_delete_asset_account(ReplyMessage& reply) const
     const auto accountID = Identifier::Factory(msgIn.m_strAcctID);
     const auto& context = reply.Context();
     const auto& serverNym = *context.Nym();
+    LockManager::Keys keys{};
+    LockManager::AddAccount(accountID, keys);
+    const auto locks = server_.GetLockManager().Acquire(keys);
     auto account = server_.API().Wallet().mutable_Account(accountID);
 
     if (false == bool(account)) {
@@ -723,6 +732,9 @@ bool UserCommandProcessor::cmd_get_account_data(ReplyMessage& reply) const
     const auto& serverID = context.Server();
     const auto& serverNym = *context.Nym();
     const auto accountID = Identifier::Factory(msgIn.m_strAcctID);
+    LockManager::Keys keys{};
+    LockManager::AddAccount(accountID, keys);
+    const auto locks = server_.GetLockManager().Acquire(keys);
     auto account = server_.API().Wallet().mutable_Account(accountID);
 
     if (false == bool(account)) {
@@ -786,56 +798,11 @@ bool UserCommandProcessor::cmd_get_box_receipt(ReplyMessage& reply) const
     reply.SetAccount(msgIn.m_strAcctID);
     reply.SetDepth(boxType);
     reply.SetTransactionNumber(number);
-
-    switch (boxType) {
-        case NYMBOX_DEPTH: {
-            OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_nymbox)
-        } break;
-        case INBOX_DEPTH: {
-            OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_inbox)
-        } break;
-        case OUTBOX_DEPTH: {
-            OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_outbox)
-        } break;
-        default: {
-            otErr << OT_METHOD << __FUNCTION__ << ": Invalid box type."
-                  << std::endl;
-
-            return false;
-        }
-    }
-
-    const auto& context = reply.Context();
-    const auto& nymID = context.RemoteNym().ID();
-    const auto& serverID = context.Server();
-    const auto& serverNym = *context.Nym();
-    const auto accountID = Identifier::Factory(msgIn.m_strAcctID);
     std::unique_ptr<Ledger> box{};
 
-    switch (boxType) {
-        case NYMBOX_DEPTH: {
-            box = load_nymbox(nymID, serverID, serverNym, false);
-        } break;
-        case INBOX_DEPTH: {
-            box = load_inbox(nymID, accountID, serverID, serverNym, false);
-        } break;
-        case OUTBOX_DEPTH: {
-            box = load_outbox(nymID, accountID, serverID, serverNym, false);
-        } break;
-        default: {
-            otErr << OT_METHOD << __FUNCTION__ << ": Invalid box type."
-                  << std::endl;
+    if (false == load_box(reply, box)) { return false; }
 
-            return false;
-        }
-    }
-
-    if (false == bool(box)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to load or verify box."
-              << std::endl;
-
-        return false;
-    }
+    const auto& serverNym = *reply.Context().Nym();
 
     auto transaction = box->GetTransaction(number);
 
@@ -869,6 +836,85 @@ bool UserCommandProcessor::cmd_get_box_receipt(ReplyMessage& reply) const
     return true;
 }
 
+// Sends many box receipts in one reply, each as an additional frame after the
+// reply message. Either the listed receipts or, if allReceipts is set, every
+// receipt in the box are sent in ascending order until BOX_RECEIPT_BATCH
+// receipts or BOX_RECEIPT_BATCH_BYTES have been attached. The remainder is
+// left for a later request, so the client controls the pace of the download.
+bool UserCommandProcessor::cmd_get_box_receipts(ReplyMessage& reply) const
+{
+    const auto& msgIn = reply.Original();
+    const auto boxType = msgIn.m_lDepth;
+    reply.SetAccount(msgIn.m_strAcctID);
+    reply.SetDepth(boxType);
+    std::unique_ptr<Ledger> box{};
+
+    if (false == load_box(reply, box)) { return false; }
+
+    const auto& serverNym = *reply.Context().Nym();
+
+    std::set<TransactionNumber> requested{};
+
+    if (msgIn.m_bBool) {
+        for (const auto& it : box->GetTransactionMap()) {
+            requested.emplace(it.first);
+        }
+    } else {
+        const NumList numbers(String(msgIn.m_ascPayload));
+        numbers.Output(requested);
+    }
+
+    NumList attached{};
+    std::size_t count{0};
+    std::size_t bytes{0};
+    bool more{false};
+
+    for (const auto& number : requested) {
+        if ((BOX_RECEIPT_BATCH <= count) ||
+            ((0 < count) && (BOX_RECEIPT_BATCH_BYTES <= bytes))) {
+            more = true;
+
+            break;
+        }
+
+        if (nullptr == box->GetTransaction(number)) {
+            otWarn << OT_METHOD << __FUNCTION__
+                   << ": Transaction not found: " << number << std::endl;
+
+            continue;
+        }
+
+        // Replaces the abbreviated transaction in the box, if the full
+        // version is available
+        box->LoadBoxReceipt(number);
+        const auto transaction = box->GetTransaction(number);
+
+        if (false == verify_transaction(transaction.get(), serverNym)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Invalid box item: " << number << std::endl;
+
+            continue;
+        }
+
+        const String serialized(*transaction);
+        bytes += serialized.GetLength();
+        ++count;
+        attached.Add(number);
+        reply.AddAttachment(
+            std::string(serialized.Get(), serialized.GetLength()));
+    }
+
+    String numbers{};
+    attached.Output(numbers);
+    reply.SetTransactionNumber(static_cast<TransactionNumber>(count));
+    reply.SetBool(more);
+    reply.SetSuccess(true);
+
+    if (0 < count) { reply.SetPayload(numbers); }
+
+    return true;
+}
+
 bool UserCommandProcessor::cmd_get_instrument_definition(
     ReplyMessage& reply) const
 {
@@ -906,6 +952,8 @@ bool UserCommandProcessor::cmd_get_market_list(ReplyMessage& reply) const
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_market_list);
 
+    rLock cronLock(server_.CronLock());
+
     Armored output{};
     std::int32_t count{0};
     reply.SetSuccess(server_.Cron().GetMarketList(output, count));
@@ -930,6 +978,8 @@ bool UserCommandProcessor::cmd_get_market_offers(ReplyMessage& reply) const
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_market_offers);
 
+    rLock cronLock(server_.CronLock());
+
     auto depth = msgIn.m_lDepth;
 
     if (depth < 0) { depth = 0; }
@@ -964,6 +1014,8 @@ bool UserCommandProcessor::cmd_get_market_recent_trades(
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_market_recent_trades);
 
+    rLock cronLock(server_.CronLock());
+
     const auto market =
         server_.Cron().GetMarket(Identifier::Factory(msgIn.m_strNymID2));
 
@@ -1012,6 +1064,8 @@ bool UserCommandProcessor::cmd_get_nym_market_offers(ReplyMessage& reply) const
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_nym_market_offers);
 
+    rLock cronLock(server_.CronLock());
+
     const auto& nymID = reply.Context().RemoteNym().ID();
 
     Armored output{};
@@ -1519,10 +1573,6 @@ bool UserCommandProcessor::cmd_process_inbox(ReplyMessage& reply) const
         return false;
     }
 
-    auto account = server_.API().Wallet().mutable_Account(accountID);
-
-    if (false == bool(account)) { return false; }
-
     auto processInbox = input->GetTransaction(transactionType::processInbox);
 
     if (nullptr == processInbox) {
@@ -1533,6 +1583,12 @@ bool UserCommandProcessor::cmd_process_inbox(ReplyMessage& reply) const
         return false;
     }
 
+    const auto locks =
+        server_.GetNotary().LockTransaction(accountID, *processInbox);
+    auto account = server_.API().Wallet().mutable_Account(accountID);
+
+    if (false == bool(account)) { return false; }
+
     const auto inputNumber = processInbox->GetTransactionNum();
 
     if (false == context.VerifyIssuedNumber(inputNumber)) {
@@ -2185,6 +2241,12 @@ bool UserCommandProcessor::cmd_trigger_clause(ReplyMessage& reply) const
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_trigger_clause);
 
+    // A clause may move funds between the accounts of any party, so no other
+    // operation may hold account keys. As in Notary, the account keys are
+    // acquired before the cron lock.
+    const auto locks = server_.GetLockManager().AcquireExclusive();
+    rLock cronLock(server_.CronLock());
+
     const auto& number = msgIn.m_lTransactionNum;
     const auto& context = reply.Context();
     const auto& nym = context.RemoteNym();
@@ -2250,6 +2312,8 @@ bool UserCommandProcessor::cmd_trigger_clause(ReplyMessage& reply) const
 
         theMatchingClauses.insert({clauseID, clause});
         smartContract->ExecuteClauses(theMatchingClauses);
+        server_.Cron().FlagCronItemChanged(smartContract->GetTransactionNum());
+        server_.Cron().SaveCron();
 
         if (smartContract->IsFlaggedForRemoval()) {
             otErr << OT_METHOD << __FUNCTION__ << ": Removing smart contract "
@@ -2395,6 +2459,7 @@ void UserCommandProcessor::drop_reply_notice_to_nymbox(
     const auto& nymID = context.RemoteNym().ID();
     const auto& serverID = context.Server();
     const auto& serverNym = *context.Nym();
+    const auto nymboxLock = server.GetLockManager().AcquireNymbox(nymID);
     auto theNymbox{server.API().Factory().Ledger(nymID, nymID, serverID)};
 
     OT_ASSERT(false != bool(theNymbox));
@@ -2525,6 +2590,68 @@ bool UserCommandProcessor::isAdmin(const Identifier& nymID)
     return (0 == adminNym.compare(String(nymID).Get()));
 }
 
+// Loads the box a box receipt request names, if the nym is allowed to
+// download from that type of box. The account ID is the nym ID for the
+// nymbox.
+bool UserCommandProcessor::load_box(
+    ReplyMessage& reply,
+    std::unique_ptr<Ledger>& box) const
+{
+    const auto& msgIn = reply.Original();
+    const auto boxType = msgIn.m_lDepth;
+
+    switch (boxType) {
+        case NYMBOX_DEPTH: {
+            OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_nymbox)
+        } break;
+        case INBOX_DEPTH: {
+            OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_inbox)
+        } break;
+        case OUTBOX_DEPTH: {
+            OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_outbox)
+        } break;
+        default: {
+            otErr << OT_METHOD << __FUNCTION__ << ": Invalid box type."
+                  << std::endl;
+
+            return false;
+        }
+    }
+
+    const auto& context = reply.Context();
+    const auto& nymID = context.RemoteNym().ID();
+    const auto& serverID = context.Server();
+    const auto& serverNym = *context.Nym();
+    const auto accountID = Identifier::Factory(msgIn.m_strAcctID);
+
+    switch (boxType) {
+        case NYMBOX_DEPTH: {
+            box = load_nymbox(nymID, serverID, serverNym, false);
+        } break;
+        case INBOX_DEPTH: {
+            box = load_inbox(nymID, accountID, serverID, serverNym, false);
+        } break;
+        case OUTBOX_DEPTH: {
+            box = load_outbox(nymID, accountID, serverID, serverNym, false);
+        } break;
+        default: {
+            otErr << OT_METHOD << __FUNCTION__ << ": Invalid box type."
+                  << std::endl;
+
+            return false;
+        }
+    }
+
+    if (false == bool(box)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to load or verify box."
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
 std::unique_ptr<Ledger> UserCommandProcessor::load_inbox(
     const Identifier& nymID,
     const Identifier& accountID,
@@ -2769,6 +2896,9 @@ bool UserCommandProcessor::ProcessUserCommand(
         case MessageType::getBoxReceipt: {
             return cmd_get_box_receipt(reply);
         }
+        case MessageType::getBoxReceipts: {
+            return cmd_get_box_receipts(reply);
+        }
         case MessageType::getAccountData: {
             return cmd_get_account_data(reply);
         }
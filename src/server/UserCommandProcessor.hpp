@@ -91,6 +91,7 @@ private:
     bool cmd_delete_user(ReplyMessage& reply) const;
     bool cmd_get_account_data(ReplyMessage& reply) const;
     bool cmd_get_box_receipt(ReplyMessage& reply) const;
+    bool cmd_get_box_receipts(ReplyMessage& reply) const;
     // Get the publicly-available list of offers on a specific market.
     bool cmd_get_instrument_definition(ReplyMessage& reply) const;
     // Get the list of markets on this server.
@@ -126,6 +127,7 @@ private:
         const Nym& serverNym) const;
     bool hash_check(const ClientContext& context, Identifier& nymboxHash) const;
     RequestNumber initialize_request_number(ClientContext& context) const;
+    bool load_box(ReplyMessage& reply, std::unique_ptr<Ledger>& box) const;
     std::unique_ptr<Ledger> load_inbox(
         const Identifier& nymID,
         const Identifier& accountID,
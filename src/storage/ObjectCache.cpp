@@ -0,0 +1,96 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "ObjectCache.hpp"
+
+#include "opentxs/Types.hpp"
+
+#include <functional>
+
+namespace opentxs::storage
+{
+ObjectCache::ObjectCache(const std::size_t capacity)
+    : shard_capacity_(capacity / OT_STORAGE_CACHE_SHARDS)
+    , shards_()
+    , hits_(0)
+    , misses_(0)
+{
+}
+
+std::size_t ObjectCache::Bytes() const
+{
+    std::size_t output{0};
+
+    for (auto& shard : shards_) {
+        Lock lock(shard.lock_);
+        output += shard.bytes_;
+    }
+
+    return output;
+}
+
+void ObjectCache::Clear()
+{
+    for (auto& shard : shards_) {
+        Lock lock(shard.lock_);
+        shard.index_.clear();
+        shard.lru_.clear();
+        shard.bytes_ = 0;
+    }
+}
+
+ObjectCache::Object ObjectCache::Get(const std::string& key) const
+{
+    auto& shard = this->shard(key);
+    Lock lock(shard.lock_);
+    const auto it = shard.index_.find(key);
+
+    if (shard.index_.end() == it) {
+        ++misses_;
+
+        return {};
+    }
+
+    ++hits_;
+    shard.lru_.splice(shard.lru_.begin(), shard.lru_, it->second);
+
+    return std::get<1>(*it->second);
+}
+
+void ObjectCache::Put(
+    const std::string& key,
+    const Object& object,
+    const std::size_t size) const
+{
+    if (false == bool(object)) { return; }
+
+    const auto bytes = size + key.size();
+
+    if (bytes > shard_capacity_) { return; }
+
+    auto& shard = this->shard(key);
+    Lock lock(shard.lock_);
+
+    if (shard.index_.end() != shard.index_.find(key)) { return; }
+
+    shard.lru_.emplace_front(key, object, bytes);
+    shard.index_.emplace(key, shard.lru_.begin());
+    shard.bytes_ += bytes;
+
+    while (shard.bytes_ > shard_capacity_) {
+        const auto& oldest = shard.lru_.back();
+        shard.bytes_ -= std::get<2>(oldest);
+        shard.index_.erase(std::get<0>(oldest));
+        shard.lru_.pop_back();
+    }
+}
+
+ObjectCache::Shard& ObjectCache::shard(const std::string& key) const
+{
+    return shards_[std::hash<std::string>{}(key) % OT_STORAGE_CACHE_SHARDS];
+}
+}  // namespace opentxs::storage
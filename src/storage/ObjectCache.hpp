@@ -0,0 +1,87 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Internal.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#define OT_STORAGE_CACHE_SHARDS 16
+
+namespace google
+{
+namespace protobuf
+{
+class MessageLite;
+}  // namespace protobuf
+}  // namespace google
+
+namespace opentxs::storage
+{
+/** Least recently used cache of decoded objects, keyed by content hash
+ *
+ *  Keys are hashes of the serialized objects, so entries never go stale and
+ *  are only ever evicted to stay within the capacity. The capacity is split
+ *  evenly between independently locked shards. Object sizes are measured in
+ *  serialized bytes.
+ */
+class ObjectCache
+{
+public:
+    using Object = std::shared_ptr<const google::protobuf::MessageLite>;
+
+    std::size_t Bytes() const;
+    /** Returns an empty pointer if the key is not cached */
+    Object Get(const std::string& key) const;
+    std::uint64_t Hits() const { return hits_.load(); }
+    std::uint64_t Misses() const { return misses_.load(); }
+    void Put(
+        const std::string& key,
+        const Object& object,
+        const std::size_t size) const;
+
+    void Clear();
+
+    explicit ObjectCache(const std::size_t capacity);
+
+    ~ObjectCache() = default;
+
+private:
+    // key, object, size
+    using Entry = std::tuple<std::string, Object, std::size_t>;
+    using LRU = std::list<Entry>;
+
+    struct Shard {
+        std::mutex lock_{};
+        // Most recently used first
+        LRU lru_{};
+        std::map<std::string, LRU::iterator> index_{};
+        std::size_t bytes_{0};
+    };
+
+    const std::size_t shard_capacity_{0};
+    mutable std::array<Shard, OT_STORAGE_CACHE_SHARDS> shards_;
+    mutable std::atomic<std::uint64_t> hits_{0};
+    mutable std::atomic<std::uint64_t> misses_{0};
+
+    Shard& shard(const std::string& key) const;
+
+    ObjectCache() = delete;
+    ObjectCache(const ObjectCache&) = delete;
+    ObjectCache(ObjectCache&&) = delete;
+    ObjectCache& operator=(const ObjectCache&) = delete;
+    ObjectCache& operator=(ObjectCache&&) = delete;
+};
+}  // namespace opentxs::storage
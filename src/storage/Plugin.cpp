@@ -70,6 +70,55 @@ bool Plugin::Load(
     return valid;
 }
 
+bool Plugin::LoadView(
+    const std::string& key,
+    const bool checking,
+    View& value) const
+{
+    if (key.empty()) {
+        if (!checking) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Error: Tried to load empty key" << std::endl;
+        }
+
+        return false;
+    }
+
+    const bool bucket{current_bucket_};
+
+    if (LoadViewFromBucket(key, value, bucket)) { return true; }
+
+    // try again in the other bucket
+    if (LoadViewFromBucket(key, value, !bucket)) { return true; }
+
+    // just in case...
+    if (LoadViewFromBucket(key, value, bucket)) { return true; }
+
+    if (!checking) {
+        otWarn << OT_METHOD << __FUNCTION__
+               << ": Specified object is not found." << std::endl
+               << "Hash: " << key << std::endl;
+    }
+
+    return false;
+}
+
+bool Plugin::LoadViewFromBucket(
+    const std::string& key,
+    View& value,
+    const bool bucket) const
+{
+    std::string bytes{};
+
+    if (false == LoadFromBucket(key, bytes, bucket)) { return false; }
+
+    if (bytes.empty()) { return false; }
+
+    value = View::Own(std::move(bytes));
+
+    return true;
+}
+
 bool Plugin::Migrate(
     const std::string& key,
     const opentxs::api::storage::Driver& to) const
@@ -109,6 +158,8 @@ bool Plugin::Migrate(
     return true;
 }
 
+void Plugin::Release(const std::string&) const {}
+
 bool Plugin::Store(
     const bool isTransaction,
     const std::string& key,
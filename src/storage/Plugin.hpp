@@ -14,7 +14,11 @@
 #include "opentxs/Types.hpp"
 
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace opentxs
 {
@@ -32,6 +36,12 @@ class Plugin : virtual public opentxs::api::storage::Plugin
 {
 public:
     bool EmptyBucket(const bool bucket) const override = 0;
+    bool Erase(const std::vector<std::string>& keys, const bool bucket)
+        const override = 0;
+    bool Keys(
+        const bool bucket,
+        const std::function<void(const std::string&)>& callback)
+        const override = 0;
 
     bool Load(const std::string& key, const bool checking, std::string& value)
         const override;
@@ -39,6 +49,14 @@ public:
         const std::string& key,
         std::string& value,
         const bool bucket) const override = 0;
+    bool LoadView(const std::string& key, const bool checking, View& value)
+        const override;
+    /** Loads an object into a view. The default implementation copies the
+     *  result of LoadFromBucket into a buffer owned by the view. */
+    virtual bool LoadViewFromBucket(
+        const std::string& key,
+        View& value,
+        const bool bucket) const;
     bool Store(
         const bool isTransaction,
         const std::string& key,
@@ -58,6 +76,7 @@ public:
     bool Migrate(
         const std::string& key,
         const opentxs::api::storage::Driver& to) const override;
+    void Release(const std::string& key) const override;
 
     std::string LoadRoot() const override = 0;
     bool StoreRoot(const bool commit, const std::string& hash) const override =
@@ -97,32 +116,53 @@ private:
     Plugin& operator=(Plugin&&) = delete;
 };
 
+// A caller which asks for a const object shares the decoded object with the
+// cache. Any other caller receives its own copy, which it may modify.
 template <class T>
 bool opentxs::api::storage::Driver::LoadProto(
     const std::string& hash,
     std::shared_ptr<T>& serialized,
     const bool checking) const
 {
-    std::string raw;
-    const bool loaded = Load(hash, checking, raw);
+    using Proto = typename std::remove_const<T>::type;
+    const auto output = [&](const std::shared_ptr<const Proto>& object) {
+        if constexpr (std::is_const<T>::value) {
+            serialized = object;
+        } else {
+            serialized.reset(new Proto(*object));
+        }
+    };
+    const auto cached = std::dynamic_pointer_cast<const Proto>(Cached(hash));
+
+    if (cached) {
+        output(cached);
+
+        return true;
+    }
+
+    View raw{};
+    const bool loaded = LoadView(hash, checking, raw);
     bool valid = false;
+    auto parsed = std::make_shared<Proto>();
 
     if (loaded) {
-        serialized.reset(new T);
-        serialized->ParseFromArray(raw.data(), raw.size());
-        valid = proto::Validate<T>(*serialized, VERBOSE);
+        parsed->ParseFromArray(raw.data_, raw.size_);
+        valid = proto::Validate<Proto>(*parsed, VERBOSE);
     }
 
-    if (!valid) {
+    if (valid) {
+        Cache(hash, parsed, raw.size_);
+        output(parsed);
+    } else {
         if (loaded) {
             otErr << "Specified object was located but could not be "
                   << "validated." << std::endl
                   << "Hash: " << hash << std::endl
-                  << "Size: " << raw.size() << std::endl;
+                  << "Size: " << raw.size_ << std::endl;
         } else {
             otWarn << "Specified object is missing." << std::endl
                    << "Hash: " << hash << std::endl
-                   << "Size: " << raw.size() << std::endl;
+                   << "Size: " << raw.size_ << std::endl;
         }
     }
 
@@ -15,6 +15,7 @@
 #define OT_STORAGE_PRIMARY_PLUGIN_SQLITE "sqlite"
 #define OT_STORAGE_PRIMARY_PLUGIN_MEMDB "mem"
 #define OT_STORAGE_PRIMARY_PLUGIN_FS "fs"
+#define OT_STORAGE_PRIMARY_PLUGIN_LMDB "lmdb"
 #define STORAGE_CONFIG_PRIMARY_PLUGIN_KEY "primary_plugin"
 #define STORAGE_CONFIG_FS_BACKUP_DIRECTORY_KEY "fs_backup_directory"
 #define STORAGE_CONFIG_FS_ENCRYPTED_BACKUP_DIRECTORY_KEY "fs_encrypted_backup"
@@ -35,6 +36,8 @@ public:
     std::int64_t gc_interval_ =
         C::duration_cast<C::seconds>(C::hours(1)).count();
     std::string path_{};
+    // Upper bound on the serialized size of decoded objects kept in memory
+    std::int64_t cache_size_{std::int64_t(64) << 20};
     InsertCB dht_callback_{};
 
 #if OT_STORAGE_SQLITE
@@ -51,6 +54,8 @@ public:
     std::string fs_root_file_ = "root";
     std::string fs_backup_directory_{""};
     std::string fs_encrypted_backup_directory_{""};
+    // Compress new archive segments
+    bool fs_archive_compression_{true};
 #endif
 
 #ifdef OT_STORAGE_SQLITE
@@ -59,6 +64,18 @@ public:
     std::string sqlite3_control_table_ = "control";
     std::string sqlite3_root_key_ = "a";
     std::string sqlite3_db_file_ = "opentxs.sqlite3";
+    // OFF, NORMAL, FULL or EXTRA
+    std::string sqlite3_synchronous_ = "FULL";
+#endif
+
+#ifdef OT_STORAGE_LMDB
+    std::string lmdb_primary_bucket_ = "a";
+    std::string lmdb_secondary_bucket_ = "b";
+    std::string lmdb_control_table_ = "control";
+    std::string lmdb_root_key_ = "a";
+    std::string lmdb_db_file_ = "opentxs.lmdb";
+    // Upper bound on the size of the database file, in bytes
+    std::int64_t lmdb_map_size_{std::int64_t(1) << 36};
 #endif
 };
 }  // namespace opentxs
@@ -0,0 +1,869 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "SegmentStore.hpp"
+
+#if OT_STORAGE_FS
+#include "opentxs/core/Log.hpp"
+#include "opentxs/Types.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <ios>
+#include <iostream>
+#include <map>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <zlib.h>
+}
+
+#define OT_ARCHIVE_SEGMENT_EXTENSION ".seg"
+#define OT_ARCHIVE_INDEX_EXTENSION ".idx"
+#define OT_ARCHIVE_TEMP_EXTENSION ".tmp"
+#define OT_ARCHIVE_SEGMENT_MAGIC "OTARCSG1"
+#define OT_ARCHIVE_INDEX_MAGIC "OTARCIX1"
+#define OT_ARCHIVE_MAGIC_SIZE 8
+// Magic, followed by one byte which is set for compressed segments
+#define OT_ARCHIVE_SEGMENT_HEADER_SIZE (OT_ARCHIVE_MAGIC_SIZE + 1)
+// Checksum, tombstone flag, key size, payload size, uncompressed size
+#define OT_ARCHIVE_RECORD_HEADER_SIZE 17
+
+#define OT_METHOD "opentxs::storage::implementation::SegmentStore::"
+
+namespace
+{
+void put_u32(std::string& output, const std::uint32_t value)
+{
+    for (std::size_t i{0}; i < 4; ++i) {
+        output.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+void put_u64(std::string& output, const std::uint64_t value)
+{
+    for (std::size_t i{0}; i < 8; ++i) {
+        output.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+std::uint32_t get_u32(const char* input)
+{
+    std::uint32_t output{0};
+
+    for (std::size_t i{0}; i < 4; ++i) {
+        output |= std::uint32_t(static_cast<unsigned char>(input[i]))
+                  << (8 * i);
+    }
+
+    return output;
+}
+
+std::uint64_t get_u64(const char* input)
+{
+    std::uint64_t output{0};
+
+    for (std::size_t i{0}; i < 8; ++i) {
+        output |= std::uint64_t(static_cast<unsigned char>(input[i]))
+                  << (8 * i);
+    }
+
+    return output;
+}
+
+std::uint32_t checksum(const char* data, const std::size_t size)
+{
+    return static_cast<std::uint32_t>(::crc32(
+        ::crc32(0L, Z_NULL, 0),
+        reinterpret_cast<const Bytef*>(data),
+        static_cast<uInt>(size)));
+}
+
+bool deflate_value(const std::string& input, std::string& output)
+{
+    auto size = ::compressBound(input.size());
+    output.assign(size, '\0');
+    const auto result = ::compress2(
+        reinterpret_cast<Bytef*>(&output[0]),
+        &size,
+        reinterpret_cast<const Bytef*>(input.data()),
+        input.size(),
+        Z_DEFAULT_COMPRESSION);
+
+    if (Z_OK != result) { return false; }
+
+    output.resize(size);
+
+    return true;
+}
+
+bool inflate_value(
+    const std::string& input,
+    const std::uint32_t raw,
+    std::string& output)
+{
+    uLongf size{raw};
+    output.assign(raw, '\0');
+
+    if (0 == raw) { return true; }
+
+    const auto result = ::uncompress(
+        reinterpret_cast<Bytef*>(&output[0]),
+        &size,
+        reinterpret_cast<const Bytef*>(input.data()),
+        input.size());
+
+    return (Z_OK == result) && (raw == size);
+}
+
+bool read_all(const std::string& path, std::string& output)
+{
+    std::ifstream file(path, std::ios::in | std::ios::ate | std::ios::binary);
+
+    if (false == file.good()) { return false; }
+
+    const auto size = file.tellg();
+
+    if (0 > size) { return false; }
+
+    file.seekg(0, std::ios::beg);
+    output.assign(static_cast<std::size_t>(size), '\0');
+    file.read(&output[0], size);
+
+    return file.good();
+}
+
+bool sync_directory(const std::string& path)
+{
+    const auto fd = ::open(path.c_str(), O_DIRECTORY | O_RDONLY);
+
+    if (-1 == fd) { return false; }
+
+    const auto output = (0 == ::fsync(fd));
+    ::close(fd);
+
+    return output;
+}
+
+bool write_all(const int fd, const std::string& data)
+{
+    std::size_t written{0};
+
+    while (written < data.size()) {
+        const auto result =
+            ::write(fd, data.data() + written, data.size() - written);
+
+        if (0 > result) { return false; }
+
+        written += static_cast<std::size_t>(result);
+    }
+
+    return true;
+}
+}  // namespace
+
+namespace opentxs::storage::implementation
+{
+SegmentStore::SegmentStore(
+    const std::string& folder,
+    const bool compress,
+    const Encoder& encode,
+    const Decoder& decode,
+    const std::uint64_t segmentSize)
+    : folder_(folder)
+    , compress_(compress)
+    , segment_size_(segmentSize)
+    , encode_(encode)
+    , decode_(decode)
+    , lock_()
+    , index_()
+    , segments_()
+    , active_records_()
+    , active_(0)
+    , fd_(-1)
+    , dirty_(false)
+{
+    boost::system::error_code ec{};
+    boost::filesystem::create_directories(folder_, ec);
+    std::set<std::uint32_t> existing{};
+    boost::filesystem::directory_iterator it(folder_, ec);
+    const boost::filesystem::directory_iterator end{};
+
+    for (; (false == bool(ec)) && (end != it); it.increment(ec)) {
+        const auto& path = it->path();
+
+        if (OT_ARCHIVE_SEGMENT_EXTENSION != path.extension().string()) {
+            continue;
+        }
+
+        try {
+            existing.emplace(static_cast<std::uint32_t>(
+                std::stoul(path.stem().string(), nullptr, 16)));
+        } catch (...) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Ignoring "
+                  << path.string() << std::endl;
+        }
+    }
+
+    if (ec) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to list " << folder_
+              << ": " << ec.message() << std::endl;
+    }
+
+    for (const auto& number : existing) {
+        load(number, (*existing.crbegin() == number));
+    }
+
+    eLock lock(lock_);
+    active_ = existing.empty() ? 1 : *existing.crbegin();
+
+    // Start a new segment if the newest one could not be used
+    if ((false == existing.empty()) && (0 == segments_.count(active_))) {
+        ++active_;
+    }
+
+    if (false == open_segment(lock, active_)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to open segment "
+              << segment_path(active_) << std::endl;
+    }
+
+    lock.unlock();
+    Compact();
+    otInfo << OT_METHOD << __FUNCTION__ << ": Loaded " << index_.size()
+           << " objects from " << segments_.size() << " segments."
+           << std::endl;
+}
+
+bool SegmentStore::append(
+    const eLock&,
+    const bool tombstone,
+    const std::string& key,
+    const std::string& payload,
+    const std::uint32_t raw) const
+{
+    if (-1 == fd_) { return false; }
+
+    auto& segment = segments_[active_];
+    Record record{tombstone,
+                  key,
+                  segment.size_,
+                  static_cast<std::uint32_t>(payload.size()),
+                  raw};
+    std::string bytes{};
+    bytes.reserve(record_size(key, record.size_));
+    put_u32(bytes, 0);
+    bytes.push_back(tombstone ? 1 : 0);
+    put_u32(bytes, static_cast<std::uint32_t>(key.size()));
+    put_u32(bytes, record.size_);
+    put_u32(bytes, record.raw_);
+    bytes.append(key);
+    bytes.append(payload);
+    const auto crc = checksum(bytes.data() + 4, bytes.size() - 4);
+    std::string header{};
+    put_u32(header, crc);
+    bytes.replace(0, 4, header);
+
+    if (false == write_all(fd_, bytes)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to append to "
+              << segment_path(active_) << std::endl;
+        // Drop any partial record so the segment can still be scanned
+        [[maybe_unused]] const auto notUsed =
+            ::ftruncate(fd_, static_cast<off_t>(segment.size_));
+
+        return false;
+    }
+
+    segment.size_ += bytes.size();
+    dirty_ = true;
+    active_records_.emplace_back(record);
+    apply(active_, record);
+
+    return true;
+}
+
+void SegmentStore::apply(const std::uint32_t number, const Record& record)
+    const
+{
+    auto& segment = segments_[number];
+    const auto it = index_.find(record.key_);
+
+    // A later record supersedes an earlier one with the same key
+    if (index_.end() != it) {
+        const auto& old = it->second;
+        auto& live = segments_[old.segment_].live_;
+        live -= std::min(live, record_size(it->first, old.size_));
+        index_.erase(it);
+    }
+
+    if (record.tombstone_) {
+        segment.tombstones_.emplace(record.key_);
+
+        return;
+    }
+
+    segment.tombstones_.erase(record.key_);
+    index_.emplace(
+        record.key_,
+        Location{number, record.offset_, record.size_, record.raw_});
+    segment.live_ += record_size(record.key_, record.size_);
+}
+
+bool SegmentStore::Compact() const
+{
+    eLock lock(lock_);
+    bool output{true};
+    std::vector<std::uint32_t> targets{};
+
+    for (const auto& it : segments_) {
+        const auto& number = it.first;
+        const auto& segment = it.second;
+
+        if (active_ == number) { continue; }
+
+        if ((2 * segment.live_) < segment.size_) { targets.push_back(number); }
+    }
+
+    for (const auto& number : targets) { output &= compact(lock, number); }
+
+    return output;
+}
+
+bool SegmentStore::compact(const eLock& lock, const std::uint32_t number) const
+{
+    std::vector<std::string> keys{};
+
+    for (const auto& it : index_) {
+        if (number == it.second.segment_) { keys.emplace_back(it.first); }
+    }
+
+    for (const auto& key : keys) {
+        std::string value{};
+
+        if (false == read(key, index_.at(key), value)) { return false; }
+
+        if (false == put(lock, key, value)) { return false; }
+    }
+
+    // Tombstones are only needed while an older segment might still hold
+    // the object they erase
+    const auto older = (segments_.cbegin()->first < number);
+    const auto tombstones = segments_.at(number).tombstones_;
+
+    if (older) {
+        for (const auto& key : tombstones) {
+            if (0 < index_.count(key)) { continue; }
+
+            if (false == append(lock, true, key, {}, 0)) { return false; }
+        }
+    }
+
+    if (false == sync(lock)) { return false; }
+
+    boost::system::error_code ec{};
+    boost::filesystem::remove(segment_path(number), ec);
+    boost::filesystem::remove(index_path(number), ec);
+    segments_.erase(number);
+    sync_directory(folder_);
+    otInfo << OT_METHOD << __FUNCTION__ << ": Compacted segment " << number
+           << " (" << keys.size() << " live objects)." << std::endl;
+
+    return true;
+}
+
+bool SegmentStore::Erase(const std::vector<std::string>& keys) const
+{
+    eLock lock(lock_);
+    bool output{true};
+    bool erased{false};
+
+    for (const auto& key : keys) {
+        if (0 == index_.count(key)) { continue; }
+
+        if (append(lock, true, key, {}, 0)) {
+            erased = true;
+        } else {
+            output = false;
+        }
+    }
+
+    if (erased) {
+        lock.unlock();
+        output &= Compact();
+    }
+
+    return output;
+}
+
+std::string SegmentStore::index_path(const std::uint32_t number) const
+{
+    char name[9]{};
+    std::snprintf(name, sizeof(name), "%08x", number);
+
+    return folder_ + "/" + name + OT_ARCHIVE_INDEX_EXTENSION;
+}
+
+bool SegmentStore::Keys(
+    const std::function<void(const std::string&)>& callback) const
+{
+    sLock lock(lock_);
+
+    for (const auto& it : index_) { callback(it.first); }
+
+    return true;
+}
+
+bool SegmentStore::Load(const std::string& key, std::string& value) const
+{
+    sLock lock(lock_);
+    const auto it = index_.find(key);
+
+    if (index_.end() == it) { return false; }
+
+    return read(key, it->second, value);
+}
+
+void SegmentStore::load(const std::uint32_t number, const bool active)
+{
+    auto& segment = segments_[number];
+    std::vector<Record> records{};
+    bool loaded{false};
+
+    if (false == active) { loaded = load_index(number, segment, records); }
+
+    if (false == loaded) {
+        if (false == scan(number, active, segment, records)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Segment "
+                  << segment_path(number) << " is damaged." << std::endl;
+        }
+
+        if (0 == segment.size_) {
+            segments_.erase(number);
+
+            return;
+        }
+
+        if (false == active) { write_index(number, segment, records); }
+    }
+
+    for (const auto& record : records) { apply(number, record); }
+
+    if (active) { active_records_ = std::move(records); }
+}
+
+bool SegmentStore::load_index(
+    const std::uint32_t number,
+    Segment& segment,
+    std::vector<Record>& records) const
+{
+    std::string header{};
+    std::string bytes{};
+    boost::system::error_code ec{};
+    const auto size = boost::filesystem::file_size(segment_path(number), ec);
+
+    if (ec) { return false; }
+
+    {
+        std::ifstream file(segment_path(number), std::ios::binary);
+        header.assign(OT_ARCHIVE_SEGMENT_HEADER_SIZE, '\0');
+        file.read(&header[0], header.size());
+
+        if (false == file.good()) { return false; }
+    }
+
+    if (0 != header.compare(
+                 0, OT_ARCHIVE_MAGIC_SIZE, OT_ARCHIVE_SEGMENT_MAGIC)) {
+        return false;
+    }
+
+    if (false == read_all(index_path(number), bytes)) { return false; }
+
+    const auto minimum = OT_ARCHIVE_MAGIC_SIZE + 8 + 4 + 4;
+
+    if (minimum > bytes.size()) { return false; }
+
+    const auto body = bytes.size() - 4;
+
+    if (checksum(bytes.data(), body) != get_u32(bytes.data() + body)) {
+        return false;
+    }
+
+    if (0 != bytes.compare(0, OT_ARCHIVE_MAGIC_SIZE, OT_ARCHIVE_INDEX_MAGIC)) {
+        return false;
+    }
+
+    std::size_t position{OT_ARCHIVE_MAGIC_SIZE};
+
+    // The index only describes the segment as it was when sealed
+    if (size != get_u64(bytes.data() + position)) { return false; }
+
+    position += 8;
+    const auto count = get_u32(bytes.data() + position);
+    position += 4;
+    records.clear();
+    records.reserve(count);
+
+    for (std::uint32_t i{0}; i < count; ++i) {
+        if ((position + 5) > body) { return false; }
+
+        Record record{};
+        record.tombstone_ = (0 != bytes[position]);
+        const auto keySize = get_u32(bytes.data() + position + 1);
+        position += 5;
+
+        if ((position + keySize + 16) > body) { return false; }
+
+        record.key_.assign(bytes, position, keySize);
+        position += keySize;
+        record.offset_ = get_u64(bytes.data() + position);
+        record.size_ = get_u32(bytes.data() + position + 8);
+        record.raw_ = get_u32(bytes.data() + position + 12);
+        position += 16;
+        records.emplace_back(std::move(record));
+    }
+
+    segment.compressed_ = (0 != header[OT_ARCHIVE_MAGIC_SIZE]);
+    segment.size_ = size;
+
+    return true;
+}
+
+bool SegmentStore::open_segment(const eLock&, const std::uint32_t number)
+    const
+{
+    if (-1 != fd_) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    const auto path = segment_path(number);
+    auto& segment = segments_[number];
+    fd_ = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0600);
+
+    if (-1 == fd_) { return false; }
+
+    if (0 < segment.size_) { return true; }
+
+    std::string header{OT_ARCHIVE_SEGMENT_MAGIC};
+    header.push_back(compress_ ? 1 : 0);
+    segment.compressed_ = compress_;
+
+    if (false == write_all(fd_, header)) { return false; }
+
+    segment.size_ = header.size();
+
+    if (0 != ::fsync(fd_)) { return false; }
+
+    return sync_directory(folder_);
+}
+
+bool SegmentStore::Owns(const std::string& filename)
+{
+    const auto extension = boost::filesystem::path(filename).extension();
+
+    return (OT_ARCHIVE_SEGMENT_EXTENSION == extension.string()) ||
+           (OT_ARCHIVE_INDEX_EXTENSION == extension.string()) ||
+           (OT_ARCHIVE_TEMP_EXTENSION == extension.string());
+}
+
+bool SegmentStore::put(
+    const eLock& lock,
+    const std::string& key,
+    const std::string& value) const
+{
+    if (segment_size_ <= segments_[active_].size_) {
+        if (false == seal(lock)) { return false; }
+    }
+
+    std::string payload{};
+
+    if (segments_[active_].compressed_) {
+        if (false == deflate_value(value, payload)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to compress "
+                  << key << std::endl;
+
+            return false;
+        }
+    } else {
+        payload = value;
+    }
+
+    if (encode_) { payload = encode_(payload); }
+
+    return append(
+        lock, false, key, payload, static_cast<std::uint32_t>(value.size()));
+}
+
+bool SegmentStore::read(
+    const std::string& key,
+    const Location& location,
+    std::string& value) const
+{
+    const auto path = segment_path(location.segment_);
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+
+    if (-1 == fd) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to open " << path
+              << std::endl;
+
+        return false;
+    }
+
+    std::string payload(location.size_, '\0');
+    const auto offset =
+        location.offset_ + OT_ARCHIVE_RECORD_HEADER_SIZE + key.size();
+    std::size_t done{0};
+
+    while (done < payload.size()) {
+        const auto result = ::pread(
+            fd,
+            &payload[done],
+            payload.size() - done,
+            static_cast<off_t>(offset + done));
+
+        if (0 >= result) { break; }
+
+        done += static_cast<std::size_t>(result);
+    }
+
+    ::close(fd);
+
+    if (done != payload.size()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Short read for " << key
+              << std::endl;
+
+        return false;
+    }
+
+    if (decode_) { payload = decode_(std::move(payload)); }
+
+    if (false == segments_.at(location.segment_).compressed_) {
+        value = std::move(payload);
+
+        return true;
+    }
+
+    if (false == inflate_value(payload, location.raw_, value)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to decompress " << key
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+std::uint64_t SegmentStore::record_size(
+    const std::string& key,
+    const std::uint32_t size)
+{
+    return OT_ARCHIVE_RECORD_HEADER_SIZE + key.size() + size;
+}
+
+bool SegmentStore::scan(
+    const std::uint32_t number,
+    const bool truncate,
+    Segment& segment,
+    std::vector<Record>& records) const
+{
+    const auto path = segment_path(number);
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    std::string header(OT_ARCHIVE_SEGMENT_HEADER_SIZE, '\0');
+    file.read(&header[0], header.size());
+    records.clear();
+    boost::system::error_code ec{};
+    const auto size = boost::filesystem::file_size(path, ec);
+
+    if ((false == file.good()) ||
+        (0 != header.compare(
+                  0, OT_ARCHIVE_MAGIC_SIZE, OT_ARCHIVE_SEGMENT_MAGIC))) {
+        // A segment which was created but never written is recreated by
+        // open_segment
+        if (truncate && (OT_ARCHIVE_SEGMENT_HEADER_SIZE > size)) {
+            file.close();
+            boost::filesystem::remove(path, ec);
+            segment.size_ = 0;
+
+            return true;
+        }
+
+        segment.size_ = 0;
+
+        return false;
+    }
+
+    segment.compressed_ = (0 != header[OT_ARCHIVE_MAGIC_SIZE]);
+    std::uint64_t position{OT_ARCHIVE_SEGMENT_HEADER_SIZE};
+    std::string bytes(OT_ARCHIVE_RECORD_HEADER_SIZE, '\0');
+
+    while (true) {
+        bytes.resize(OT_ARCHIVE_RECORD_HEADER_SIZE);
+        file.read(&bytes[0], OT_ARCHIVE_RECORD_HEADER_SIZE);
+
+        if (false == file.good()) { break; }
+
+        Record record{};
+        const auto crc = get_u32(bytes.data());
+        record.tombstone_ = (0 != bytes[4]);
+        const auto keySize = get_u32(bytes.data() + 5);
+        record.size_ = get_u32(bytes.data() + 9);
+        record.raw_ = get_u32(bytes.data() + 13);
+        record.offset_ = position;
+        const std::uint64_t total = OT_ARCHIVE_RECORD_HEADER_SIZE +
+                                    std::uint64_t(keySize) + record.size_;
+
+        if ((position + total) > size) { break; }
+
+        bytes.resize(total);
+        file.read(
+            &bytes[OT_ARCHIVE_RECORD_HEADER_SIZE],
+            total - OT_ARCHIVE_RECORD_HEADER_SIZE);
+
+        if (false == file.good()) { break; }
+
+        if (crc != checksum(bytes.data() + 4, bytes.size() - 4)) { break; }
+
+        record.key_.assign(bytes, OT_ARCHIVE_RECORD_HEADER_SIZE, keySize);
+        records.emplace_back(std::move(record));
+        position += total;
+    }
+
+    segment.size_ = size;
+
+    if (position == size) { return true; }
+
+    otErr << OT_METHOD << __FUNCTION__ << ": Found " << (size - position)
+          << " unreadable bytes at the end of " << path << std::endl;
+
+    // Only the newest segment can end in an interrupted write
+    if (truncate) {
+        file.close();
+
+        if (0 != ::truncate(path.c_str(), static_cast<off_t>(position))) {
+            return false;
+        }
+
+        segment.size_ = position;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool SegmentStore::seal(const eLock& lock) const
+{
+    if (false == sync(lock)) { return false; }
+
+    if (false == write_index(active_, segments_[active_], active_records_)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write index for "
+              << segment_path(active_) << std::endl;
+    }
+
+    active_records_.clear();
+    ++active_;
+
+    return open_segment(lock, active_);
+}
+
+std::string SegmentStore::segment_path(const std::uint32_t number) const
+{
+    char name[9]{};
+    std::snprintf(name, sizeof(name), "%08x", number);
+
+    return folder_ + "/" + name + OT_ARCHIVE_SEGMENT_EXTENSION;
+}
+
+bool SegmentStore::Store(const std::string& key, const std::string& value)
+    const
+{
+    eLock lock(lock_);
+
+    if (0 < index_.count(key)) { return true; }
+
+    return put(lock, key, value);
+}
+
+bool SegmentStore::Sync() const
+{
+    eLock lock(lock_);
+
+    return sync(lock);
+}
+
+bool SegmentStore::sync(const eLock&) const
+{
+    if (false == dirty_) { return true; }
+
+    if ((-1 == fd_) || (0 != ::fsync(fd_))) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to sync "
+              << segment_path(active_) << std::endl;
+
+        return false;
+    }
+
+    dirty_ = false;
+
+    return true;
+}
+
+bool SegmentStore::write_index(
+    const std::uint32_t number,
+    const Segment& segment,
+    const std::vector<Record>& records) const
+{
+    std::string bytes{OT_ARCHIVE_INDEX_MAGIC};
+    put_u64(bytes, segment.size_);
+    put_u32(bytes, static_cast<std::uint32_t>(records.size()));
+
+    for (const auto& record : records) {
+        bytes.push_back(record.tombstone_ ? 1 : 0);
+        put_u32(bytes, static_cast<std::uint32_t>(record.key_.size()));
+        bytes.append(record.key_);
+        put_u64(bytes, record.offset_);
+        put_u32(bytes, record.size_);
+        put_u32(bytes, record.raw_);
+    }
+
+    put_u32(bytes, checksum(bytes.data(), bytes.size()));
+    const auto path = index_path(number);
+    const auto temp = path + OT_ARCHIVE_TEMP_EXTENSION;
+    const auto fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+
+    if (-1 == fd) { return false; }
+
+    const auto written = write_all(fd, bytes) && (0 == ::fsync(fd));
+    ::close(fd);
+
+    if ((false == written) || (0 != std::rename(temp.c_str(), path.c_str()))) {
+        return false;
+    }
+
+    return sync_directory(folder_);
+}
+
+SegmentStore::~SegmentStore()
+{
+    eLock lock(lock_);
+    sync(lock);
+
+    if (-1 != fd_) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+}  // namespace opentxs::storage::implementation
+#endif  // OT_STORAGE_FS
@@ -0,0 +1,151 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Internal.hpp"
+
+#if OT_STORAGE_FS
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+// Segments are sealed once they reach this size
+#define OT_ARCHIVE_SEGMENT_SIZE (64 * 1024 * 1024)
+
+namespace opentxs::storage::implementation
+{
+// Append-only segment files which hold the objects of a StorageFSArchive
+//
+// Objects are appended to the newest segment until it reaches the segment
+// size, OT_ARCHIVE_SEGMENT_SIZE unless the constructor is given another. It is
+// then sealed and an index of its records is written next to it. The location
+// of every live object is kept in memory and is rebuilt on startup from the
+// index files, or by scanning any segment which lacks one. Keys are content
+// hashes, so an object which is already present is never written twice.
+//
+// Erased objects are recorded as tombstones. Sealed segments which are mostly
+// dead are compacted by copying their live objects into the newest segment.
+//
+// Each segment header records whether the segment is compressed, so changing
+// the setting only affects new segments. The encoder and decoder, which
+// StorageFSArchive uses for encryption, see the compressed bytes.
+class SegmentStore
+{
+public:
+    using Decoder = std::function<std::string(std::string&&)>;
+    using Encoder = std::function<std::string(const std::string&)>;
+
+    /** Returns true for files which belong to the segment store */
+    static bool Owns(const std::string& filename);
+
+    bool Compact() const;
+    bool Erase(const std::vector<std::string>& keys) const;
+    bool Keys(const std::function<void(const std::string&)>& callback) const;
+    bool Load(const std::string& key, std::string& value) const;
+    bool Store(const std::string& key, const std::string& value) const;
+    /** Flushes appended objects to disk */
+    bool Sync() const;
+
+    SegmentStore(
+        const std::string& folder,
+        const bool compress,
+        const Encoder& encode,
+        const Decoder& decode,
+        const std::uint64_t segmentSize = OT_ARCHIVE_SEGMENT_SIZE);
+
+    ~SegmentStore();
+
+private:
+    struct Location {
+        std::uint32_t segment_{0};
+        // Position of the record within the segment
+        std::uint64_t offset_{0};
+        // Stored payload size
+        std::uint32_t size_{0};
+        // Payload size before compression
+        std::uint32_t raw_{0};
+    };
+
+    struct Record {
+        bool tombstone_{false};
+        std::string key_{};
+        std::uint64_t offset_{0};
+        std::uint32_t size_{0};
+        std::uint32_t raw_{0};
+    };
+
+    struct Segment {
+        bool compressed_{false};
+        std::uint64_t size_{0};
+        // Bytes used by records which have not been erased or superseded
+        std::uint64_t live_{0};
+        std::set<std::string> tombstones_{};
+    };
+
+    const std::string folder_;
+    const bool compress_{false};
+    const std::uint64_t segment_size_{0};
+    const Encoder encode_;
+    const Decoder decode_;
+    mutable std::shared_mutex lock_;
+    mutable std::map<std::string, Location> index_;
+    mutable std::map<std::uint32_t, Segment> segments_;
+    // Records of the newest segment, which are indexed when it is sealed
+    mutable std::vector<Record> active_records_;
+    mutable std::uint32_t active_{0};
+    mutable int fd_{-1};
+    mutable bool dirty_{false};
+
+    static std::uint64_t record_size(
+        const std::string& key,
+        const std::uint32_t size);
+
+    bool append(
+        const eLock& lock,
+        const bool tombstone,
+        const std::string& key,
+        const std::string& payload,
+        const std::uint32_t raw) const;
+    void apply(const std::uint32_t number, const Record& record) const;
+    bool compact(const eLock& lock, const std::uint32_t number) const;
+    std::string index_path(const std::uint32_t number) const;
+    void load(const std::uint32_t number, const bool active);
+    bool load_index(
+        const std::uint32_t number,
+        Segment& segment,
+        std::vector<Record>& records) const;
+    bool open_segment(const eLock& lock, const std::uint32_t number) const;
+    bool put(
+        const eLock& lock,
+        const std::string& key,
+        const std::string& value) const;
+    bool read(const std::string& key, const Location& location, std::string&)
+        const;
+    bool scan(
+        const std::uint32_t number,
+        const bool truncate,
+        Segment& segment,
+        std::vector<Record>& records) const;
+    bool seal(const eLock& lock) const;
+    std::string segment_path(const std::uint32_t number) const;
+    bool sync(const eLock& lock) const;
+    bool write_index(
+        const std::uint32_t number,
+        const Segment& segment,
+        const std::vector<Record>& records) const;
+
+    SegmentStore() = delete;
+    SegmentStore(const SegmentStore&) = delete;
+    SegmentStore(SegmentStore&&) = delete;
+    SegmentStore& operator=(const SegmentStore&) = delete;
+    SegmentStore& operator=(SegmentStore&&) = delete;
+};
+}  // namespace opentxs::storage::implementation
+#endif  // OT_STORAGE_FS
@@ -162,6 +162,52 @@ public:
         std::string& value,
         const bool bucket) const override;
 
+    /** Delete values from the backend
+     *
+     *  \param[in] keys the keys of the objects to be deleted
+     *  \param[in] bucket delete from either the primary (true) or secondary
+     *                    (false) bucket
+     *  \returns false if any existing key could not be deleted
+     *
+     *  \note Used by the garbage collector, which calls this method while
+     *        other threads load and store values
+     */
+    bool Erase(const std::vector<std::string>& keys, const bool bucket)
+        const override;
+
+    /** Enumerate the keys stored in a bucket
+     *
+     *  \param[in] bucket list either the primary (true) or secondary (false)
+     *                    bucket
+     *  \param[in] callback called once per key. It must not call back into
+     *                      the backend.
+     *  \returns true if every key was visited
+     */
+    bool Keys(
+        const bool bucket,
+        const std::function<void(const std::string&)>& callback)
+        const override;
+
+    /** Retrieve a previously-stored value without copying it (optional)
+     *
+     *  Backends which can expose stored bytes directly, for example from a
+     *  memory map, should override this method. The default implementation
+     *  wraps the result of LoadFromBucket.
+     *
+     *  \param[in] key the key of the object to be retrieved
+     *  \param[out] value a view of the requested bytes which keeps any
+     *                    backend resources alive while it exists
+     *  \param[in] bucket search for the key in either the primary (true) or
+     *                    secondary (false) bucket
+     *  \returns true if the key was found in and loaded by the backend
+     *
+     *  \warning This method is required to be thread safe
+     */
+    bool LoadViewFromBucket(
+        const std::string& key,
+        View& value,
+        const bool bucket) const override;
+
     using ot_super::Store;  // Needed for overload resolution
     /** Record a new value in the backend
      *
@@ -14,6 +14,7 @@
 
 #include <cstdio>
 #include <fstream>
+#include <functional>
 #include <ios>
 #include <iostream>
 #include <thread>
@@ -53,11 +54,65 @@ void StorageFS::Cleanup_StorageFS()
     // future cleanup actions go here
 }
 
+bool StorageFS::Erase(const std::vector<std::string>& keys, const bool bucket)
+    const
+{
+    bool output{true};
+    std::string directory{};
+
+    for (const auto& key : keys) {
+        boost::system::error_code ec{};
+        boost::filesystem::remove(calculate_path(key, bucket, directory), ec);
+
+        if (ec) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to remove " << key
+                  << ": " << ec.message() << std::endl;
+            output = false;
+        }
+    }
+
+    return output;
+}
+
 void StorageFS::Init_StorageFS()
 {
     // future init actions go here
 }
 
+bool StorageFS::Keys(
+    const bool bucket,
+    const std::function<void(const std::string&)>& callback) const
+{
+    std::string directory{};
+    calculate_path("", bucket, directory);
+    const auto root = root_filename();
+    boost::system::error_code ec{};
+    boost::filesystem::recursive_directory_iterator it(directory, ec);
+    const boost::filesystem::recursive_directory_iterator end{};
+
+    for (; (false == bool(ec)) && (end != it); it.increment(ec)) {
+        const auto& path = it->path();
+        boost::system::error_code notUsed{};
+
+        if (false == boost::filesystem::is_regular_file(path, notUsed)) {
+            continue;
+        }
+
+        if (root == path.string()) { continue; }
+
+        callback(path.filename().string());
+    }
+
+    if (ec) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << ec.message()
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
 bool StorageFS::LoadFromBucket(
     const std::string& key,
     std::string& value,
@@ -87,9 +142,9 @@ std::string StorageFS::LoadRoot() const
     return "";
 }
 
-std::string StorageFS::prepare_read(const std::string& input) const
+std::string StorageFS::prepare_read(std::string&& input) const
 {
-    return input;
+    return std::move(input);
 }
 
 std::string StorageFS::prepare_write(const std::string& input) const
@@ -113,10 +168,10 @@ std::string StorageFS::read_file(const std::string& filename) const
 
         std::uint32_t size(pos);
         file.seekg(0, std::ios::beg);
-        std::vector<char> bytes(size);
+        std::string bytes(size, '\0');
         file.read(&bytes[0], size);
 
-        return prepare_read(std::string(&bytes[0], size));
+        return prepare_read(std::move(bytes));
     }
 
     return {};
@@ -29,6 +29,12 @@ private:
     typedef Plugin ot_super;
 
 public:
+    bool Erase(const std::vector<std::string>& keys, const bool bucket)
+        const override;
+    bool Keys(
+        const bool bucket,
+        const std::function<void(const std::string&)>& callback)
+        const override;
     bool LoadFromBucket(
         const std::string& key,
         std::string& value,
@@ -63,7 +69,7 @@ private:
         const std::string& key,
         const bool bucket,
         std::string& directory) const = 0;
-    virtual std::string prepare_read(const std::string& input) const;
+    virtual std::string prepare_read(std::string&& input) const;
     virtual std::string prepare_write(const std::string& input) const;
     std::string read_file(const std::string& filename) const;
     virtual std::string root_filename() const = 0;
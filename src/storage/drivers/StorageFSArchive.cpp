@@ -18,6 +18,7 @@
 
 #include "storage/Plugin.hpp"
 #include "storage/StorageConfig.hpp"
+#include "SegmentStore.hpp"
 #include "StorageFS.hpp"
 
 #include <boost/filesystem.hpp>
@@ -46,6 +47,7 @@ extern "C" {
 #include "StorageFSArchive.hpp"
 
 #define ROOT_FILE_EXTENSION ".hash"
+#define SEGMENT_DIRECTORY "segments"
 
 #define OT_METHOD "opentxs::StorageFSArchive::"
 
@@ -78,6 +80,8 @@ StorageFSArchive::StorageFSArchive(
     : ot_super(storage, config, hash, random, folder, bucket)
     , encryption_key_(key)
     , encrypted_(bool(encryption_key_))
+    , legacy_(false)
+    , segments_(nullptr)
 {
     Init_StorageFSArchive();
 }
@@ -128,23 +132,97 @@ void StorageFSArchive::Cleanup()
 
 void StorageFSArchive::Cleanup_StorageFSArchive()
 {
-    // future cleanup actions go here
+    if (segments_) { segments_->Sync(); }
 }
 
 bool StorageFSArchive::EmptyBucket(const bool) const { return true; }
 
+bool StorageFSArchive::Erase(
+    const std::vector<std::string>& keys,
+    const bool bucket) const
+{
+    if (false == bool(segments_)) { return false; }
+
+    auto output = segments_->Erase(keys);
+
+    if (legacy_) { output &= ot_super::Erase(keys, bucket); }
+
+    return output;
+}
+
 void StorageFSArchive::Init_StorageFSArchive()
 {
     OT_ASSERT(false == folder_.empty());
 
     boost::system::error_code ec{};
+    boost::filesystem::create_directory(folder_, ec);
+
+    if (false == boost::filesystem::is_directory(folder_, ec)) { return; }
+
+    const auto segments = folder_ + path_seperator_ + SEGMENT_DIRECTORY;
+    const auto root = root_filename();
+    boost::filesystem::directory_iterator it(folder_, ec);
+    const boost::filesystem::directory_iterator end{};
 
-    if (boost::filesystem::create_directory(folder_, ec)) { ready_->On(); }
+    for (; (false == bool(ec)) && (end != it); it.increment(ec)) {
+        const auto path = it->path().string();
+
+        if ((segments != path) && (root != path)) {
+            legacy_ = true;
+
+            break;
+        }
+    }
+
+    segments_.reset(new SegmentStore(
+        segments,
+        config_.fs_archive_compression_,
+        [this](const std::string& input) -> std::string {
+            return prepare_write(input);
+        },
+        [this](std::string&& input) -> std::string {
+            return prepare_read(std::move(input));
+        }));
+
+    OT_ASSERT(segments_);
+
+    ready_->On();
 }
 
-std::string StorageFSArchive::prepare_read(const std::string& input) const
+bool StorageFSArchive::Keys(
+    const bool bucket,
+    const std::function<void(const std::string&)>& callback) const
+{
+    if (false == bool(segments_)) { return false; }
+
+    if (false == segments_->Keys(callback)) { return false; }
+
+    if (false == legacy_) { return true; }
+
+    return ot_super::Keys(bucket, [&](const std::string& key) -> void {
+        if (false == SegmentStore::Owns(key)) { callback(key); }
+    });
+}
+
+bool StorageFSArchive::LoadFromBucket(
+    const std::string& key,
+    std::string& value,
+    const bool bucket) const
 {
-    if (false == encrypted_) { return input; }
+    value.clear();
+
+    if (false == bool(segments_)) { return false; }
+
+    if (segments_->Load(key, value)) { return true; }
+
+    if (legacy_) { return ot_super::LoadFromBucket(key, value, bucket); }
+
+    return false;
+}
+
+std::string StorageFSArchive::prepare_read(std::string&& input) const
+{
+    if (false == encrypted_) { return std::move(input); }
 
     const auto ciphertext = proto::TextToProto<proto::Ciphertext>(input);
 
@@ -187,6 +265,36 @@ std::string StorageFSArchive::root_filename() const
            ROOT_FILE_EXTENSION;
 }
 
+void StorageFSArchive::store(
+    const bool,
+    const std::string& key,
+    const std::string& value,
+    const bool,
+    std::promise<bool>* promise) const
+{
+    OT_ASSERT(nullptr != promise);
+
+    if (ready_.get() && segments_) {
+        promise->set_value(segments_->Store(key, value));
+    } else {
+        promise->set_value(false);
+    }
+}
+
+bool StorageFSArchive::StoreRoot(const bool commit, const std::string& hash)
+    const
+{
+    // Every object the root refers to must be on disk before the root
+    if ((false == bool(segments_)) || (false == segments_->Sync())) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to sync segments."
+              << std::endl;
+
+        return false;
+    }
+
+    return ot_super::StoreRoot(commit, hash);
+}
+
 StorageFSArchive::~StorageFSArchive() { Cleanup_StorageFSArchive(); }
 }  // namespace opentxs::storage::implementation
 #endif
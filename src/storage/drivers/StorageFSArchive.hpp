@@ -8,6 +8,11 @@
 #if OT_STORAGE_FS
 namespace opentxs::storage::implementation
 {
+// Archive implementation of opentxs::storage, used for backups
+//
+// Objects are packed into the segment files of a SegmentStore. Archives
+// written by earlier versions, which stored one file per object, remain
+// readable.
 class StorageFSArchive : public StorageFS,
                          public virtual opentxs::api::storage::Driver
 {
@@ -16,6 +21,17 @@ private:
 
 public:
     bool EmptyBucket(const bool bucket) const override;
+    bool Erase(const std::vector<std::string>& keys, const bool bucket)
+        const override;
+    bool Keys(
+        const bool bucket,
+        const std::function<void(const std::string&)>& callback)
+        const override;
+    bool LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool bucket) const override;
+    bool StoreRoot(const bool commit, const std::string& hash) const override;
 
     void Cleanup() override;
 
@@ -26,14 +42,23 @@ private:
 
     crypto::key::Symmetric& encryption_key_;
     const bool encrypted_{false};
+    // Set if the archive contains objects stored as individual files
+    bool legacy_{false};
+    std::unique_ptr<SegmentStore> segments_{nullptr};
 
     std::string calculate_path(
         const std::string& key,
         const bool bucket,
         std::string& directory) const override;
-    std::string prepare_read(const std::string& ciphertext) const override;
+    std::string prepare_read(std::string&& ciphertext) const override;
     std::string prepare_write(const std::string& plaintext) const override;
     std::string root_filename() const override;
+    void store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>* promise) const override;
 
     void Init_StorageFSArchive();
     void Cleanup_StorageFSArchive();
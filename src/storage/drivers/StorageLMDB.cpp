@@ -0,0 +1,505 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "stdafx.hpp"
+
+#include "Internal.hpp"
+
+#if OT_STORAGE_LMDB
+#include "opentxs/core/Log.hpp"
+
+#include "storage/Plugin.hpp"
+#include "storage/StorageConfig.hpp"
+
+extern "C" {
+#include <lmdb.h>
+}
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "StorageLMDB.hpp"
+
+#define OT_LMDB_DATABASES 3
+#define OT_LMDB_MAX_IDLE_READERS 8
+
+#define OT_METHOD "opentxs::StorageLMDB::"
+
+namespace opentxs
+{
+opentxs::api::storage::Plugin* Factory::StorageLMDB(
+    const api::storage::Storage& storage,
+    const StorageConfig& config,
+    const Digest& hash,
+    const Random& random,
+    const Flag& bucket)
+{
+    return new opentxs::storage::implementation::StorageLMDB(
+        storage, config, hash, random, bucket);
+}
+}  // namespace opentxs
+
+namespace opentxs::storage::implementation
+{
+StorageLMDB::StorageLMDB(
+    const api::storage::Storage& storage,
+    const StorageConfig& config,
+    const Digest& hash,
+    const Random& random,
+    const Flag& bucket)
+    : ot_super(storage, config, hash, random, bucket)
+    , folder_(config.path_)
+    , filename_(folder_ + "/" + config_.lmdb_db_file_)
+    , transaction_lock_()
+    , transaction_bucket_(Flag::Factory(false))
+    , pending_()
+    , env_(nullptr)
+    , primary_(0)
+    , secondary_(0)
+    , control_(0)
+    , reader_lock_()
+    , readers_()
+{
+    Init_StorageLMDB();
+}
+
+void StorageLMDB::Cleanup() { Cleanup_StorageLMDB(); }
+
+void StorageLMDB::Cleanup_StorageLMDB()
+{
+    Lock readerLock(reader_lock_);
+
+    for (auto& txn : readers_) { mdb_txn_abort(txn); }
+
+    readers_.clear();
+    readerLock.unlock();
+    Lock lock(transaction_lock_);
+
+    if (nullptr != env_) {
+        mdb_env_close(env_);
+        env_ = nullptr;
+    }
+}
+
+bool StorageLMDB::commit_transaction(const std::string& rootHash) const
+{
+    Lock lock(transaction_lock_);
+    const auto database = get_database(transaction_bucket_.get());
+    MDB_txn* txn{nullptr};
+    auto result = mdb_txn_begin(env_, nullptr, 0, &txn);
+    bool success = (MDB_SUCCESS == result);
+
+    if (success) {
+        for (const auto& it : pending_) {
+            success = put(lock, txn, database, it.first, it.second);
+
+            if (false == success) { break; }
+        }
+    }
+
+    if (success) {
+        success = put(lock, txn, control_, config_.lmdb_root_key_, rootHash);
+    }
+
+    if (success) {
+        result = mdb_txn_commit(txn);
+        success = (MDB_SUCCESS == result);
+    } else if (nullptr != txn) {
+        mdb_txn_abort(txn);
+    }
+
+    if (false == success) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to commit "
+              << pending_.size() << " objects." << std::endl;
+
+        if (MDB_SUCCESS != result) {
+            otErr << OT_METHOD << __FUNCTION__ << ": "
+                  << mdb_strerror(result) << std::endl;
+        }
+    }
+
+    pending_.clear();
+
+    return success;
+}
+
+bool StorageLMDB::EmptyBucket(const bool bucket) const
+{
+    Lock lock(transaction_lock_);
+    MDB_txn* txn{nullptr};
+    auto result = mdb_txn_begin(env_, nullptr, 0, &txn);
+
+    if (MDB_SUCCESS == result) {
+        result = mdb_drop(txn, get_database(bucket), 0);
+
+        if (MDB_SUCCESS == result) {
+            result = mdb_txn_commit(txn);
+        } else {
+            mdb_txn_abort(txn);
+        }
+    }
+
+    if (MDB_SUCCESS != result) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << mdb_strerror(result)
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool StorageLMDB::Erase(
+    const std::vector<std::string>& keys,
+    const bool bucket) const
+{
+    Lock lock(transaction_lock_);
+    const auto database = get_database(bucket);
+    MDB_txn* txn{nullptr};
+    auto result = mdb_txn_begin(env_, nullptr, 0, &txn);
+
+    if (MDB_SUCCESS == result) {
+        for (const auto& key : keys) {
+            MDB_val k{key.size(), const_cast<char*>(key.data())};
+            result = mdb_del(txn, database, &k, nullptr);
+
+            if (MDB_NOTFOUND == result) { result = MDB_SUCCESS; }
+
+            if (MDB_SUCCESS != result) { break; }
+        }
+
+        if (MDB_SUCCESS == result) {
+            result = mdb_txn_commit(txn);
+        } else {
+            mdb_txn_abort(txn);
+        }
+    }
+
+    if (MDB_SUCCESS != result) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << mdb_strerror(result)
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+MDB_dbi StorageLMDB::get_database(const bool bucket) const
+{
+    return bucket ? secondary_ : primary_;
+}
+
+MDB_txn* StorageLMDB::get_reader() const
+{
+    Lock lock(reader_lock_);
+    MDB_txn* output{nullptr};
+
+    if (false == readers_.empty()) {
+        output = readers_.back();
+        readers_.pop_back();
+        lock.unlock();
+        const auto result = mdb_txn_renew(output);
+
+        if (MDB_SUCCESS == result) { return output; }
+
+        otErr << OT_METHOD << __FUNCTION__ << ": " << mdb_strerror(result)
+              << std::endl;
+        mdb_txn_abort(output);
+
+        return nullptr;
+    }
+
+    lock.unlock();
+    const auto result = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &output);
+
+    if (MDB_SUCCESS != result) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to start read transaction: "
+              << mdb_strerror(result) << std::endl;
+
+        return nullptr;
+    }
+
+    return output;
+}
+
+void StorageLMDB::Init_StorageLMDB()
+{
+    auto result = mdb_env_create(&env_);
+
+    if (MDB_SUCCESS == result) {
+        result = mdb_env_set_mapsize(
+            env_, static_cast<std::size_t>(config_.lmdb_map_size_));
+    }
+
+    if (MDB_SUCCESS == result) {
+        result = mdb_env_set_maxdbs(env_, OT_LMDB_DATABASES);
+    }
+
+    // MDB_NOTLS lets pooled read transactions move between threads
+    if (MDB_SUCCESS == result) {
+        result = mdb_env_open(
+            env_, filename_.c_str(), MDB_NOSUBDIR | MDB_NOTLS, 0600);
+    }
+
+    if (MDB_SUCCESS != result) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to initialize database: " << mdb_strerror(result)
+              << std::endl;
+
+        OT_FAIL
+    }
+
+    MDB_txn* txn{nullptr};
+    result = mdb_txn_begin(env_, nullptr, 0, &txn);
+
+    OT_ASSERT(MDB_SUCCESS == result);
+
+    bool opened =
+        open_database(txn, config_.lmdb_primary_bucket_, primary_) &&
+        open_database(txn, config_.lmdb_secondary_bucket_, secondary_) &&
+        open_database(txn, config_.lmdb_control_table_, control_);
+
+    if (opened) {
+        opened = (MDB_SUCCESS == mdb_txn_commit(txn));
+    } else {
+        mdb_txn_abort(txn);
+    }
+
+    OT_ASSERT(opened);
+}
+
+bool StorageLMDB::Keys(
+    const bool bucket,
+    const std::function<void(const std::string&)>& callback) const
+{
+    auto txn = get_reader();
+
+    if (nullptr == txn) { return false; }
+
+    MDB_cursor* cursor{nullptr};
+    auto result = mdb_cursor_open(txn, get_database(bucket), &cursor);
+
+    if (MDB_SUCCESS == result) {
+        MDB_val k{0, nullptr};
+        MDB_val v{0, nullptr};
+        result = mdb_cursor_get(cursor, &k, &v, MDB_FIRST);
+
+        while (MDB_SUCCESS == result) {
+            callback(
+                std::string(static_cast<const char*>(k.mv_data), k.mv_size));
+            result = mdb_cursor_get(cursor, &k, &v, MDB_NEXT);
+        }
+
+        mdb_cursor_close(cursor);
+    }
+
+    return_reader(txn);
+
+    if (MDB_NOTFOUND != result) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << mdb_strerror(result)
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool StorageLMDB::LoadFromBucket(
+    const std::string& key,
+    std::string& value,
+    const bool bucket) const
+{
+    View view{};
+
+    if (false == read(get_database(bucket), key, view)) { return false; }
+
+    value.assign(view.data_, view.size_);
+
+    return true;
+}
+
+std::string StorageLMDB::LoadRoot() const
+{
+    View view{};
+
+    if (read(control_, config_.lmdb_root_key_, view)) {
+
+        return std::string(view.data_, view.size_);
+    }
+
+    return "";
+}
+
+bool StorageLMDB::LoadViewFromBucket(
+    const std::string& key,
+    View& value,
+    const bool bucket) const
+{
+    return read(get_database(bucket), key, value);
+}
+
+bool StorageLMDB::open_database(
+    MDB_txn* txn,
+    const std::string& name,
+    MDB_dbi& dbi) const
+{
+    const auto result = mdb_dbi_open(txn, name.c_str(), MDB_CREATE, &dbi);
+
+    if (MDB_SUCCESS != result) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to open " << name
+              << ": " << mdb_strerror(result) << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool StorageLMDB::put(
+    const Lock& lock,
+    MDB_txn* txn,
+    const MDB_dbi database,
+    const std::string& key,
+    const std::string& value) const
+{
+    OT_ASSERT(lock.mutex() == &transaction_lock_);
+
+    MDB_val k{key.size(), const_cast<char*>(key.data())};
+    MDB_val v{value.size(), const_cast<char*>(value.data())};
+    const auto result = mdb_put(txn, database, &k, &v, 0);
+
+    if (MDB_SUCCESS == result) { return true; }
+
+    otErr << OT_METHOD << __FUNCTION__ << ": " << mdb_strerror(result)
+          << std::endl;
+
+    if (MDB_MAP_FULL == result) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Increase lmdb_map_size in the storage configuration."
+              << std::endl;
+    }
+
+    return false;
+}
+
+bool StorageLMDB::read(
+    const MDB_dbi database,
+    const std::string& key,
+    View& value) const
+{
+    auto txn = get_reader();
+
+    if (nullptr == txn) { return false; }
+
+    MDB_val k{key.size(), const_cast<char*>(key.data())};
+    MDB_val v{0, nullptr};
+    const auto result = mdb_get(txn, database, &k, &v);
+
+    if ((MDB_SUCCESS == result) && (0 < v.mv_size)) {
+        value.data_ = static_cast<const char*>(v.mv_data);
+        value.size_ = v.mv_size;
+        value.owner_.reset(txn, [this](MDB_txn* txn) { return_reader(txn); });
+
+        return true;
+    }
+
+    if ((MDB_SUCCESS != result) && (MDB_NOTFOUND != result)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << mdb_strerror(result)
+              << std::endl;
+    }
+
+    return_reader(txn);
+
+    return false;
+}
+
+void StorageLMDB::return_reader(MDB_txn* txn) const
+{
+    mdb_txn_reset(txn);
+    Lock lock(reader_lock_);
+
+    if (OT_LMDB_MAX_IDLE_READERS > readers_.size()) {
+        readers_.emplace_back(txn);
+    } else {
+        lock.unlock();
+        mdb_txn_abort(txn);
+    }
+}
+
+void StorageLMDB::store(
+    const bool isTransaction,
+    const std::string& key,
+    const std::string& value,
+    const bool bucket,
+    std::promise<bool>* promise) const
+{
+    OT_ASSERT(nullptr != promise);
+
+    if (isTransaction) {
+        Lock lock(transaction_lock_);
+        transaction_bucket_->Set(bucket);
+        pending_.emplace_back(key, value);
+        promise->set_value(true);
+    } else {
+        promise->set_value(write(get_database(bucket), key, value));
+    }
+}
+
+bool StorageLMDB::StoreRoot(const bool commit, const std::string& hash) const
+{
+    if (commit) {
+
+        return commit_transaction(hash);
+    } else {
+
+        return write(control_, config_.lmdb_root_key_, hash);
+    }
+}
+
+bool StorageLMDB::write(
+    const MDB_dbi database,
+    const std::string& key,
+    const std::string& value) const
+{
+    Lock lock(transaction_lock_);
+    MDB_txn* txn{nullptr};
+    auto result = mdb_txn_begin(env_, nullptr, 0, &txn);
+
+    if (MDB_SUCCESS != result) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << mdb_strerror(result)
+              << std::endl;
+
+        return false;
+    }
+
+    if (false == put(lock, txn, database, key, value)) {
+        mdb_txn_abort(txn);
+
+        return false;
+    }
+
+    result = mdb_txn_commit(txn);
+
+    if (MDB_SUCCESS != result) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << mdb_strerror(result)
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+StorageLMDB::~StorageLMDB() { Cleanup_StorageLMDB(); }
+}  // namespace opentxs::storage::implementation
+#endif
@@ -0,0 +1,104 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#if OT_STORAGE_LMDB
+namespace opentxs::storage::implementation
+{
+// LMDB implementation of opentxs::storage
+//
+// Both buckets and the control table are named databases inside a single
+// memory-mapped environment. Objects stored as part of a transaction are held
+// until the root is committed and then written together with the new root in
+// one LMDB write transaction, so the database always contains a complete tree.
+// Views returned by loads point directly into the map and keep their read
+// transaction open until released.
+class StorageLMDB : public virtual Plugin,
+                    public virtual opentxs::api::storage::Driver
+{
+public:
+    bool EmptyBucket(const bool bucket) const override;
+    bool Erase(const std::vector<std::string>& keys, const bool bucket)
+        const override;
+    bool Keys(
+        const bool bucket,
+        const std::function<void(const std::string&)>& callback)
+        const override;
+    bool LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool bucket) const override;
+    std::string LoadRoot() const override;
+    bool LoadViewFromBucket(
+        const std::string& key,
+        View& value,
+        const bool bucket) const override;
+    bool StoreRoot(const bool commit, const std::string& hash) const override;
+
+    void Cleanup() override;
+    void Cleanup_StorageLMDB();
+
+    ~StorageLMDB();
+
+private:
+    typedef Plugin ot_super;
+
+    friend Factory;
+
+    std::string folder_;
+    std::string filename_;
+    mutable std::mutex transaction_lock_;
+    mutable OTFlag transaction_bucket_;
+    mutable std::vector<std::pair<const std::string, const std::string>>
+        pending_;
+    MDB_env* env_{nullptr};
+    MDB_dbi primary_{0};
+    MDB_dbi secondary_{0};
+    MDB_dbi control_{0};
+    mutable std::mutex reader_lock_;
+    mutable std::vector<MDB_txn*> readers_;
+
+    bool commit_transaction(const std::string& rootHash) const;
+    MDB_dbi get_database(const bool bucket) const;
+    MDB_txn* get_reader() const;
+    bool open_database(MDB_txn* txn, const std::string& name, MDB_dbi& dbi)
+        const;
+    bool put(
+        const Lock& lock,
+        MDB_txn* txn,
+        const MDB_dbi database,
+        const std::string& key,
+        const std::string& value) const;
+    bool read(const MDB_dbi database, const std::string& key, View& value)
+        const;
+    void return_reader(MDB_txn* txn) const;
+    void store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>* promise) const override;
+    bool write(
+        const MDB_dbi database,
+        const std::string& key,
+        const std::string& value) const;
+
+    void Init_StorageLMDB();
+
+    StorageLMDB(
+        const api::storage::Storage& storage,
+        const StorageConfig& config,
+        const Digest& hash,
+        const Random& random,
+        const Flag& bucket);
+    StorageLMDB() = delete;
+    StorageLMDB(const StorageLMDB&) = delete;
+    StorageLMDB(StorageLMDB&&) = delete;
+    StorageLMDB& operator=(const StorageLMDB&) = delete;
+    StorageLMDB& operator=(StorageLMDB&&) = delete;
+};
+}  // namespace opentxs::storage::implementation
+#endif  // OT_STORAGE_LMDB
@@ -45,7 +45,9 @@
 #include "storage/Plugin.hpp"
 #include "storage/StorageConfig.hpp"
 
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "StorageMemDB.hpp"
 
@@ -93,6 +95,30 @@ bool StorageMemDB::EmptyBucket(const bool bucket) const
     return true;
 }
 
+bool StorageMemDB::Erase(
+    const std::vector<std::string>& keys,
+    const bool bucket) const
+{
+    eLock lock(shared_lock_);
+    auto& map = bucket ? a_ : b_;
+
+    for (const auto& key : keys) { map.erase(key); }
+
+    return true;
+}
+
+bool StorageMemDB::Keys(
+    const bool bucket,
+    const std::function<void(const std::string&)>& callback) const
+{
+    sLock lock(shared_lock_);
+    const auto& map = bucket ? a_ : b_;
+
+    for (const auto& it : map) { callback(it.first); }
+
+    return true;
+}
+
 bool StorageMemDB::LoadFromBucket(
     const std::string& key,
     std::string& value,
@@ -130,6 +156,8 @@ void StorageMemDB::store(
 {
     OT_ASSERT(nullptr != promise);
 
+    eLock lock(shared_lock_);
+
     if (bucket) {
         a_[key] = value;
     } else {
@@ -47,6 +47,12 @@ class StorageMemDB final : public Plugin,
 {
 public:
     bool EmptyBucket(const bool bucket) const override;
+    bool Erase(const std::vector<std::string>& keys, const bool bucket)
+        const override;
+    bool Keys(
+        const bool bucket,
+        const std::function<void(const std::string&)>& callback)
+        const override;
     bool LoadFromBucket(
         const std::string& key,
         std::string& value,
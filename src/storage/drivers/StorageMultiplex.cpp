@@ -18,14 +18,32 @@
 
 #include "storage/tree/Root.hpp"
 #include "storage/tree/Tree.hpp"
+#include "storage/ObjectCache.hpp"
 #include "storage/StorageConfig.hpp"
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "StorageMultiplex.hpp"
 
+// Number of objects erased at a time while sweeping
+#define OT_STORAGE_GC_SLICE 1000
+// Pause between slices, which lets waiting writers proceed
+#define OT_STORAGE_GC_PAUSE_MS 10
+// Writes which may wait for the backup plugins before Store blocks
+#define OT_STORAGE_BACKUP_QUEUE 1024
+// Bytes which may wait for the backup plugins before Store blocks
+#define OT_STORAGE_BACKUP_QUEUE_BYTES (64 * 1024 * 1024)
+
 #define OT_METHOD "opentxs::StorageMultiplex::"
 
 namespace opentxs
@@ -71,10 +89,43 @@ StorageMultiplex::StorageMultiplex(
     , digest_(hash)
     , random_(random)
     , null_(crypto::key::Symmetric::Factory())
+    , cache_(static_cast<std::size_t>(config.cache_size_))
+    , batch_lock_()
+    , batch_(false)
+    , pending_()
+    , pending_root_()
+    , gc_lock_()
+    , collecting_(false)
+    , marked_()
+    , backup_lock_()
+    , backup_ready_()
+    , backup_space_()
+    , backup_queue_()
+    , backup_bytes_(0)
+    , backup_busy_(false)
+    , backup_shutdown_(false)
+    , backup_thread_(nullptr)
 {
     Init_StorageMultiplex(primary, migrate, previous);
 }
 
+// Marks start empty on every cycle. Carrying them over would need to know
+// when a key loses its last reference. Keys are content hashes, and several
+// index nodes may refer to the same one. A node that replaces an item simply
+// overwrites the hash in its item_map_. Only store_index() tells the driver
+// about a replaced key, and only for the node's own index, which Release()
+// uses for batch bookkeeping, not as a reference count. StorageItemHash and
+// the other index messages have no field to persist such counts, so they
+// would have to be rebuilt after every restart by the same full walk of the
+// tree. That walk marks leaf keys from each node's in-memory index without
+// loading the objects, so a cycle reads only the index nodes.
+void StorageMultiplex::BeginCollection() const
+{
+    Lock lock(gc_lock_);
+    marked_.clear();
+    collecting_ = true;
+}
+
 std::string StorageMultiplex::BestRoot(bool& primaryOutOfSync)
 {
     OT_ASSERT(primary_plugin_);
@@ -130,14 +181,72 @@ std::string StorageMultiplex::BestRoot(bool& primaryOutOfSync)
     return bestHash;
 }
 
+void StorageMultiplex::Cache(
+    const std::string& key,
+    const std::shared_ptr<const google::protobuf::MessageLite>& object,
+    const std::size_t size) const
+{
+    cache_.Put(key, object, size);
+}
+
+std::uint64_t StorageMultiplex::CacheHits() const { return cache_.Hits(); }
+
+std::uint64_t StorageMultiplex::CacheMisses() const { return cache_.Misses(); }
+
+std::shared_ptr<const google::protobuf::MessageLite> StorageMultiplex::Cached(
+    const std::string& key) const
+{
+    return cache_.Get(key);
+}
+
 void StorageMultiplex::Cleanup() { Cleanup_StorageMultiplex(); }
 
-void StorageMultiplex::Cleanup_StorageMultiplex() {}
+void StorageMultiplex::Cleanup_StorageMultiplex()
+{
+    Lock lock(backup_lock_);
+    backup_shutdown_ = true;
+    lock.unlock();
+    backup_ready_.notify_all();
+
+    // The writer drains the queue before it exits
+    if (backup_thread_) {
+        backup_thread_->join();
+        backup_thread_.reset();
+    }
+
+    otInfo << OT_METHOD << __FUNCTION__ << ": Object cache hits: "
+           << cache_.Hits() << ", misses: " << cache_.Misses() << std::endl;
+}
+
+bool StorageMultiplex::CommitBatch()
+{
+    Lock lock(batch_lock_);
+
+    if (false == batch_) {
+        otErr << OT_METHOD << __FUNCTION__ << ": No batch in progress."
+              << std::endl;
+
+        return false;
+    }
+
+    batch_ = false;
+    const auto output = write_pending(lock);
+
+    if (false == output) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write batch. "
+              << pending_.size() << " objects will be retried before the next "
+              << "root is written." << std::endl;
+    }
+
+    return output;
+}
 
 bool StorageMultiplex::EmptyBucket(const bool bucket) const
 {
     OT_ASSERT(primary_plugin_);
 
+    flush_backups();
+
     for (const auto& plugin : backup_plugins_) {
         OT_ASSERT(plugin);
 
@@ -147,6 +256,44 @@ bool StorageMultiplex::EmptyBucket(const bool bucket) const
     return primary_plugin_->EmptyBucket(bucket);
 }
 
+bool StorageMultiplex::FinishCollection(const bool sweep) const
+{
+    OT_ASSERT(primary_plugin_);
+
+    bool output{true};
+
+    if (sweep) {
+        const auto start = std::chrono::steady_clock::now();
+        Lock lock(gc_lock_);
+        const auto marked = marked_.size();
+        lock.unlock();
+        std::size_t scanned{0};
+        std::size_t erased{0};
+        output &= this->sweep(true, scanned, erased);
+        output &= this->sweep(false, scanned, erased);
+        const auto elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+        otErr << OT_METHOD << __FUNCTION__ << ": Marked " << marked
+              << " objects. Scanned " << scanned << " keys and erased "
+              << erased << " in " << elapsed.count() << " ms." << std::endl;
+    }
+
+    Lock lock(gc_lock_);
+    collecting_ = false;
+    marked_.clear();
+
+    return output;
+}
+
+void StorageMultiplex::flush_backups() const
+{
+    Lock lock(backup_lock_);
+    backup_space_.wait(lock, [&]() -> bool {
+        return backup_queue_.empty() && (false == backup_busy_);
+    });
+}
+
 void StorageMultiplex::init(
     const std::string& primary,
     std::unique_ptr<opentxs::api::storage::Plugin>& plugin)
@@ -157,6 +304,8 @@ void StorageMultiplex::init(
         init_sqlite(plugin);
     } else if (OT_STORAGE_PRIMARY_PLUGIN_FS == primary) {
         init_fs(plugin);
+    } else if (OT_STORAGE_PRIMARY_PLUGIN_LMDB == primary) {
+        init_lmdb(plugin);
     }
 
     OT_ASSERT(plugin);
@@ -177,6 +326,21 @@ void StorageMultiplex::init_fs(
 #endif
 }
 
+void StorageMultiplex::init_lmdb(
+    std::unique_ptr<opentxs::api::storage::Plugin>& plugin)
+{
+#if OT_STORAGE_LMDB
+    otInfo << OT_METHOD << __FUNCTION__
+           << ": Initializing primary LMDB plugin." << std::endl;
+    plugin.reset(Factory::StorageLMDB(
+        storage_, config_, digest_, random_, primary_bucket_));
+#else
+    otErr << OT_METHOD << __FUNCTION__ << ": LMDB driver not compiled in."
+          << std::endl;
+    OT_FAIL;
+#endif
+}
+
 void StorageMultiplex::init_memdb(
     std::unique_ptr<opentxs::api::storage::Plugin>& plugin)
 {
@@ -259,6 +423,17 @@ bool StorageMultiplex::Load(
 {
     OT_ASSERT(primary_plugin_);
 
+    Lock lock(batch_lock_);
+    const auto pending = pending_.find(key);
+
+    if (pending_.end() != pending) {
+        value = pending->second.value_;
+
+        return true;
+    }
+
+    lock.unlock();
+
     if (primary_plugin_->Load(key, checking, value)) { return true; }
 
     if (false == checking) {
@@ -334,12 +509,49 @@ std::string StorageMultiplex::LoadRoot() const
     return root;
 }
 
+bool StorageMultiplex::LoadView(
+    const std::string& key,
+    const bool checking,
+    View& value) const
+{
+    OT_ASSERT(primary_plugin_);
+
+    Lock lock(batch_lock_);
+    const auto pending = pending_.find(key);
+
+    if (pending_.end() != pending) {
+        value = View::Own(std::string(pending->second.value_));
+
+        return true;
+    }
+
+    lock.unlock();
+
+    if (primary_plugin_->LoadView(key, true, value)) { return true; }
+
+    // Fall back to the copying path, which also searches the backups
+    std::string bytes{};
+
+    if (false == Load(key, checking, bytes)) { return false; }
+
+    value = View::Own(std::move(bytes));
+
+    return true;
+}
+
 bool StorageMultiplex::Migrate(
     const std::string& key,
     const opentxs::api::storage::Driver& to) const
 {
     OT_ASSERT(primary_plugin_);
 
+    // Migrating a key to the multiplexer itself marks it as reachable
+    if (&to == this) {
+        mark(key);
+
+        return true;
+    }
+
     if (primary_plugin_->Migrate(key, to)) { return true; }
 
     for (const auto& plugin : backup_plugins_) {
@@ -351,6 +563,13 @@ bool StorageMultiplex::Migrate(
     return false;
 }
 
+void StorageMultiplex::mark(const std::string& key) const
+{
+    Lock lock(gc_lock_);
+
+    if (collecting_) { marked_.emplace(key); }
+}
+
 void StorageMultiplex::migrate_primary(
     const std::string& from,
     const std::string& to)
@@ -400,33 +619,76 @@ opentxs::api::storage::Driver& StorageMultiplex::Primary()
     return *primary_plugin_;
 }
 
+void StorageMultiplex::queue_backup(BackupWrite&& write) const
+{
+    if (backup_plugins_.empty()) { return; }
+
+    Lock lock(backup_lock_);
+
+    const auto size = write.value_.size();
+
+    // Callers are held back once the backups fall too far behind. An object
+    // larger than the byte limit is still accepted into an empty queue.
+    backup_space_.wait(lock, [&]() -> bool {
+        if (backup_queue_.empty()) { return true; }
+
+        return (OT_STORAGE_BACKUP_QUEUE > backup_queue_.size()) &&
+               (OT_STORAGE_BACKUP_QUEUE_BYTES >= backup_bytes_ + size);
+    });
+    backup_queue_.emplace_back(std::move(write));
+    backup_bytes_ += size;
+
+    if (false == bool(backup_thread_)) {
+        backup_thread_.reset(
+            new std::thread(&StorageMultiplex::write_backups, this));
+    }
+
+    lock.unlock();
+    backup_ready_.notify_one();
+}
+
+void StorageMultiplex::Release(const std::string& key) const
+{
+    Lock lock(batch_lock_);
+    auto it = pending_.find(key);
+
+    if (pending_.end() == it) { return; }
+
+    auto& references = it->second.references_;
+
+    if (0 < references) { --references; }
+}
+
+void StorageMultiplex::StartBatch()
+{
+    Lock lock(batch_lock_);
+
+    OT_ASSERT(false == batch_);
+
+    batch_ = true;
+}
+
 bool StorageMultiplex::Store(
     const bool isTransaction,
     const std::string& key,
     const std::string& value,
     const bool bucket) const
 {
-    OT_ASSERT(primary_plugin_);
-
-    std::vector<std::promise<bool>> promises{};
-    std::vector<std::future<bool>> futures{};
-    promises.push_back(std::promise<bool>());
-    auto& primaryPromise = promises.back();
-    futures.push_back(primaryPromise.get_future());
-    primary_plugin_->Store(isTransaction, key, value, bucket, primaryPromise);
-
-    for (const auto& plugin : backup_plugins_) {
-        OT_ASSERT(plugin);
-
-        promises.push_back(std::promise<bool>());
-        auto& promise = promises.back();
-        futures.push_back(promise.get_future());
-        plugin->Store(isTransaction, key, value, bucket, promise);
-    }
+    return store(isTransaction, key, value, bucket);
+}
 
-    bool output = false;
+bool StorageMultiplex::store(
+    const bool isTransaction,
+    const std::string& key,
+    const std::string& value,
+    const bool bucket) const
+{
+    OT_ASSERT(primary_plugin_);
 
-    for (auto& future : futures) { output |= future.get(); }
+    mark(key);
+    const auto output =
+        primary_plugin_->Store(isTransaction, key, value, bucket);
+    queue_backup({false, isTransaction, key, value, bucket});
 
     return output;
 }
@@ -445,34 +707,118 @@ void StorageMultiplex::Store(
 
 bool StorageMultiplex::Store(
     const bool isTransaction,
-    const std::string& key,
-    std::string& value) const
+    const std::string& value,
+    std::string& key) const
 {
     OT_ASSERT(primary_plugin_);
 
-    bool output = primary_plugin_->Store(isTransaction, key, value);
+    if (false == bool(digest_)) { return false; }
 
-    for (const auto& plugin : backup_plugins_) {
-        OT_ASSERT(plugin);
+    if (false == digest_(storage_.HashType(), value, key)) { return false; }
+
+    if (isTransaction) {
+        Lock lock(batch_lock_);
 
-        output |= plugin->Store(isTransaction, key, value);
+        if (batch_) {
+            auto& object = pending_[key];
+            object.value_ = value;
+            ++object.references_;
+
+            return true;
+        }
     }
 
+    // A collection in progress must not erase an object which is being
+    // written, so the key is marked before any plugin sees it
+    mark(key);
+    const bool bucket{primary_bucket_};
+    const auto output =
+        primary_plugin_->Store(isTransaction, key, value, bucket);
+    queue_backup({false, isTransaction, key, value, bucket});
+
     return output;
 }
 
 bool StorageMultiplex::StoreRoot(const bool commit, const std::string& hash)
     const
+{
+    if (commit) {
+        Lock lock(batch_lock_);
+
+        if (batch_) {
+            pending_root_ = hash;
+
+            return true;
+        }
+
+        // Left over from a batch which failed to commit
+        if (false == pending_.empty()) {
+            pending_root_ = hash;
+
+            return write_pending(lock);
+        }
+    }
+
+    return store_root(commit, hash);
+}
+
+bool StorageMultiplex::store_root(const bool commit, const std::string& hash)
+    const
 {
     OT_ASSERT(primary_plugin_);
 
-    for (const auto& plugin : backup_plugins_) {
-        OT_ASSERT(plugin);
+    const auto output = primary_plugin_->StoreRoot(commit, hash);
+    // Queued behind the objects it refers to
+    queue_backup({true, commit, hash, {}, false});
 
-        plugin->StoreRoot(commit, hash);
+    return output;
+}
+
+bool StorageMultiplex::sweep(
+    const bool bucket,
+    std::size_t& scanned,
+    std::size_t& erased) const
+{
+    std::vector<std::string> garbage{};
+    const auto listed =
+        primary_plugin_->Keys(bucket, [&](const std::string& key) -> void {
+            ++scanned;
+            Lock lock(gc_lock_);
+
+            if (0 == marked_.count(key)) { garbage.emplace_back(key); }
+        });
+
+    if (false == listed) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to list keys."
+              << std::endl;
+
+        return false;
     }
 
-    return primary_plugin_->StoreRoot(commit, hash);
+    bool output{true};
+    auto it = garbage.cbegin();
+
+    while (garbage.cend() != it) {
+        std::vector<std::string> slice{};
+        Lock lock(gc_lock_);
+
+        // Objects written since the keys were listed have been marked
+        while ((garbage.cend() != it) && (OT_STORAGE_GC_SLICE > slice.size())) {
+            if (0 == marked_.count(*it)) { slice.emplace_back(*it); }
+
+            ++it;
+        }
+
+        output &= primary_plugin_->Erase(slice, bucket);
+        lock.unlock();
+        erased += slice.size();
+        otInfo << OT_METHOD << __FUNCTION__ << ": Erased " << erased
+               << " objects." << std::endl;
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(OT_STORAGE_GC_PAUSE_MS));
+    }
+
+    return output;
 }
 
 void StorageMultiplex::SynchronizePlugins(
@@ -481,6 +827,7 @@ void StorageMultiplex::SynchronizePlugins(
     const bool syncPrimary)
 {
     const auto& tree = root.Tree();
+    flush_backups();
 
     if (syncPrimary) {
         OT_ASSERT(primary_plugin_);
@@ -532,5 +879,107 @@ void StorageMultiplex::SynchronizePlugins(
     }
 }
 
+void StorageMultiplex::write_backup(
+    const BackupWrite& write,
+    std::vector<bool>& stale) const
+{
+    for (std::size_t i{0}; i < backup_plugins_.size(); ++i) {
+        const auto& plugin = backup_plugins_.at(i);
+
+        OT_ASSERT(plugin);
+
+        // A backup which missed an object keeps its old root so that it is
+        // brought up to date by SynchronizePlugins on the next start
+        if (stale.at(i)) { continue; }
+
+        if (write.root_) {
+            if (false == plugin->StoreRoot(write.flag_, write.key_)) {
+                otErr << OT_METHOD << __FUNCTION__
+                      << ": Backup plugin failed to store root. It will be "
+                      << "resynchronized on the next start." << std::endl;
+                stale.at(i) = true;
+            }
+        } else if (false == plugin->Store(
+                                write.flag_,
+                                write.key_,
+                                write.value_,
+                                write.bucket_)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Backup plugin failed to store object. It will be "
+                  << "resynchronized on the next start." << std::endl;
+            stale.at(i) = true;
+        }
+    }
+}
+
+void StorageMultiplex::write_backups() const
+{
+    std::vector<bool> stale(backup_plugins_.size(), false);
+    Lock lock(backup_lock_);
+
+    while (true) {
+        backup_ready_.wait(lock, [&]() -> bool {
+            return backup_shutdown_ || (false == backup_queue_.empty());
+        });
+
+        if (backup_queue_.empty()) { return; }
+
+        const auto write = std::move(backup_queue_.front());
+        backup_queue_.pop_front();
+        backup_bytes_ -= write.value_.size();
+        backup_busy_ = true;
+        lock.unlock();
+        backup_space_.notify_all();
+        write_backup(write, stale);
+        lock.lock();
+        backup_busy_ = false;
+        backup_space_.notify_all();
+    }
+}
+
+// Written objects leave pending_. The root is only written once every object
+// it may refer to has been written, otherwise it stays in pending_root_.
+bool StorageMultiplex::write_pending(const Lock& lock) const
+{
+    OT_ASSERT(lock.mutex() == &batch_lock_)
+
+    // The lock is held until everything is written so that readers never
+    // miss an object which has left pending_ but not yet reached a plugin.
+    const bool bucket{primary_bucket_};
+    bool output{true};
+    std::size_t written{0};
+    const auto total = pending_.size();
+
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        const auto& key = it->first;
+        const auto& object = it->second;
+
+        if (0 == object.references_) {
+            it = pending_.erase(it);
+
+            continue;
+        }
+
+        if (store(true, key, object.value_, bucket)) {
+            it = pending_.erase(it);
+            ++written;
+        } else {
+            output = false;
+            ++it;
+        }
+    }
+
+    otInfo << OT_METHOD << __FUNCTION__ << ": Wrote " << written << " of "
+           << total << " pending objects." << std::endl;
+
+    if (output && (false == pending_root_.empty())) {
+        output = store_root(true, pending_root_);
+
+        if (output) { pending_root_.clear(); }
+    }
+
+    return output;
+}
+
 StorageMultiplex::~StorageMultiplex() { Cleanup_StorageMultiplex(); }
 }  // namespace opentxs::storage::implementation
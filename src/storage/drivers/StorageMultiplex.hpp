@@ -12,6 +12,12 @@ namespace opentxs::storage::implementation
 class StorageMultiplex : virtual public opentxs::api::storage::Multiplex
 {
 public:
+    void Cache(
+        const std::string& key,
+        const std::shared_ptr<const google::protobuf::MessageLite>& object,
+        const std::size_t size) const override;
+    std::shared_ptr<const google::protobuf::MessageLite> Cached(
+        const std::string& key) const override;
     bool EmptyBucket(const bool bucket) const override;
     bool LoadFromBucket(
         const std::string& key,
@@ -20,9 +26,12 @@ public:
     bool Load(const std::string& key, const bool checking, std::string& value)
         const override;
     std::string LoadRoot() const override;
+    bool LoadView(const std::string& key, const bool checking, View& value)
+        const override;
     bool Migrate(
         const std::string& key,
         const opentxs::api::storage::Driver& to) const override;
+    void Release(const std::string& key) const override;
     bool Store(
         const bool isTransaction,
         const std::string& key,
@@ -40,10 +49,16 @@ public:
         std::string& key) const override;
     bool StoreRoot(const bool commit, const std::string& hash) const override;
 
+    void BeginCollection() const override;
     std::string BestRoot(bool& primaryOutOfSync) override;
+    std::uint64_t CacheHits() const override;
+    std::uint64_t CacheMisses() const override;
+    bool CommitBatch() override;
+    bool FinishCollection(const bool sweep) const override;
     void InitBackup() override;
     void InitEncryptedBackup(crypto::key::Symmetric& key) override;
     opentxs::api::storage::Driver& Primary() override;
+    void StartBatch() override;
     void SynchronizePlugins(
         const std::string& hash,
         const storage::Root& root,
@@ -54,6 +69,22 @@ public:
 private:
     friend Factory;
 
+    // An object or root hash waiting to be written to the backup plugins
+    struct BackupWrite {
+        bool root_{false};
+        // isTransaction for objects, commit for roots
+        bool flag_{false};
+        std::string key_{};
+        std::string value_{};
+        bool bucket_{false};
+    };
+
+    struct PendingObject {
+        std::string value_{};
+        // Number of places in the tree which refer to this object
+        std::size_t references_{0};
+    };
+
     const api::storage::Storage& storage_;
     const Flag& primary_bucket_;
     const StorageConfig& config_;
@@ -62,6 +93,26 @@ private:
     const Digest digest_;
     const Random random_;
     OTSymmetricKey null_;
+    storage::ObjectCache cache_;
+    mutable std::mutex batch_lock_;
+    bool batch_{false};
+    mutable std::map<std::string, PendingObject> pending_;
+    mutable std::string pending_root_;
+    mutable std::mutex gc_lock_;
+    mutable bool collecting_{false};
+    // Keys which must survive the collection in progress
+    mutable std::set<std::string> marked_;
+    mutable std::mutex backup_lock_;
+    // Signalled when a write is queued or on shutdown
+    mutable std::condition_variable backup_ready_;
+    // Signalled when a write is dequeued or finished
+    mutable std::condition_variable backup_space_;
+    mutable std::deque<BackupWrite> backup_queue_;
+    // Total size of the values held in backup_queue_
+    mutable std::size_t backup_bytes_{0};
+    mutable bool backup_busy_{false};
+    mutable bool backup_shutdown_{false};
+    mutable std::unique_ptr<std::thread> backup_thread_{nullptr};
 
     StorageMultiplex(
         const api::storage::Storage& storage,
@@ -80,16 +131,32 @@ private:
 
     void Cleanup();
     void Cleanup_StorageMultiplex();
+    void flush_backups() const;
     void init(
         const std::string& primary,
         std::unique_ptr<opentxs::api::storage::Plugin>& plugin);
     void init_fs(std::unique_ptr<opentxs::api::storage::Plugin>& plugin);
+    void init_lmdb(std::unique_ptr<opentxs::api::storage::Plugin>& plugin);
     void init_memdb(std::unique_ptr<opentxs::api::storage::Plugin>& plugin);
     void init_sqlite(std::unique_ptr<opentxs::api::storage::Plugin>& plugin);
     void Init_StorageMultiplex(
         const String& primary,
         const bool migrate,
         const String& previous);
+    void mark(const std::string& key) const;
     void migrate_primary(const std::string& from, const std::string& to);
+    void queue_backup(BackupWrite&& write) const;
+    bool store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket) const;
+    bool store_root(const bool commit, const std::string& hash) const;
+    bool sweep(const bool bucket, std::size_t& scanned, std::size_t& erased)
+        const;
+    void write_backup(const BackupWrite& write, std::vector<bool>& stale)
+        const;
+    void write_backups() const;
+    bool write_pending(const Lock& lock) const;
 };
 }  // namespace opentxs::storage::implementation
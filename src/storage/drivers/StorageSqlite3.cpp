@@ -17,16 +17,23 @@ extern "C" {
 #include <sqlite3.h>
 }
 
+#include <algorithm>
 #include <atomic>
+#include <cctype>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <mutex>
-#include <sstream>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include "StorageSqlite3.hpp"
 
+#define OT_SQLITE3_BUSY_TIMEOUT_MS 5000
+#define OT_SQLITE3_MAX_IDLE_READERS 8
+
 #define OT_METHOD "opentxs::StorageSqlite3::"
 
 namespace opentxs
@@ -53,51 +60,84 @@ StorageSqlite3::StorageSqlite3(
     const Flag& bucket)
     : ot_super(storage, config, hash, random, bucket)
     , folder_(config.path_)
+    , filename_(folder_ + "/" + config_.sqlite3_db_file_)
     , transaction_lock_()
     , transaction_bucket_(Flag::Factory(false))
     , pending_()
     , db_(nullptr)
+    , upsert_()
+    , reader_lock_()
+    , readers_()
 {
     Init_StorageSqlite3();
 }
 
-std::string StorageSqlite3::bind_key(
-    const std::string& source,
-    const std::string& key,
-    const std::size_t start) const
+StorageSqlite3::Reader::~Reader()
 {
-    sqlite3_stmt* statement{nullptr};
-    sqlite3_prepare_v2(db_, source.c_str(), -1, &statement, nullptr);
-    sqlite3_bind_text(statement, start, key.c_str(), key.size(), SQLITE_STATIC);
-    const auto output = expand_sql(statement);
-    sqlite3_finalize(statement);
+    for (auto& it : select_) { sqlite3_finalize(it.second); }
 
-    return output;
+    select_.clear();
+
+    if (nullptr != db_) {
+        sqlite3_close(db_);
+        db_ = nullptr;
+    }
 }
 
-void StorageSqlite3::Cleanup() { Cleanup_StorageSqlite3(); }
+bool StorageSqlite3::begin() const { return execute("BEGIN TRANSACTION;"); }
 
-void StorageSqlite3::Cleanup_StorageSqlite3() { sqlite3_close(db_); }
+void StorageSqlite3::Cleanup() { Cleanup_StorageSqlite3(); }
 
-void StorageSqlite3::commit(std::stringstream& sql) const
+void StorageSqlite3::Cleanup_StorageSqlite3()
 {
-    sql << "COMMIT TRANSACTION;";
+    Lock readerLock(reader_lock_);
+    readers_.clear();
+    readerLock.unlock();
+    Lock lock(transaction_lock_);
+
+    for (auto& it : upsert_) { sqlite3_finalize(it.second); }
+
+    upsert_.clear();
+
+    if (nullptr != db_) {
+        sqlite3_close(db_);
+        db_ = nullptr;
+    }
 }
 
 bool StorageSqlite3::commit_transaction(const std::string& rootHash) const
 {
     Lock lock(transaction_lock_);
-    std::stringstream sql{};
-    start_transaction(sql);
-    set_data(sql);
-    set_root(rootHash, sql);
-    commit(sql);
+    const std::string tablename{GetTableName(transaction_bucket_.get())};
+    bool success = begin();
+
+    if (success) {
+        for (const auto& it : pending_) {
+            success = upsert(lock, it.first, tablename, it.second);
+
+            if (false == success) { break; }
+        }
+    }
+
+    if (success) {
+        success = upsert(
+            lock,
+            config_.sqlite3_root_key_,
+            config_.sqlite3_control_table_,
+            rootHash);
+    }
+
+    if (success) { success = execute("COMMIT TRANSACTION;"); }
+
+    if (false == success) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to commit "
+              << pending_.size() << " objects." << std::endl;
+        execute("ROLLBACK TRANSACTION;");
+    }
+
     pending_.clear();
-    otInfo << sql.str() << std::endl;
 
-    return (
-        SQLITE_OK ==
-        sqlite3_exec(db_, sql.str().c_str(), nullptr, nullptr, nullptr));
+    return success;
 }
 
 bool StorageSqlite3::Create(const std::string& tablename) const
@@ -106,8 +146,7 @@ bool StorageSqlite3::Create(const std::string& tablename) const
     const std::string tableFormat = " (k text PRIMARY KEY, v BLOB);";
     const std::string sql = createTable + "`" + tablename + "`" + tableFormat;
 
-    return (
-        SQLITE_OK == sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, nullptr));
+    return execute(sql);
 }
 
 bool StorageSqlite3::EmptyBucket(const bool bucket) const
@@ -115,9 +154,88 @@ bool StorageSqlite3::EmptyBucket(const bool bucket) const
     return Purge(GetTableName(bucket));
 }
 
-std::string StorageSqlite3::expand_sql(sqlite3_stmt* statement) const
+bool StorageSqlite3::Erase(
+    const std::vector<std::string>& keys,
+    const bool bucket) const
 {
-    const std::string output{sqlite3_expanded_sql(statement)};
+    Lock lock(transaction_lock_);
+    const auto tablename = GetTableName(bucket);
+    auto statement =
+        prepare(db_, "DELETE FROM `" + tablename + "` WHERE k = ?1;");
+
+    if (nullptr == statement) { return false; }
+
+    bool success = begin();
+
+    if (success) {
+        for (const auto& key : keys) {
+            sqlite3_bind_text(
+                statement, 1, key.c_str(), key.size(), SQLITE_STATIC);
+            const auto result = sqlite3_step(statement);
+            sqlite3_reset(statement);
+            sqlite3_clear_bindings(statement);
+
+            if (SQLITE_DONE != result) {
+                otErr << OT_METHOD << __FUNCTION__ << ": Error (" << result
+                      << "): " << sqlite3_errmsg(db_) << std::endl;
+                success = false;
+
+                break;
+            }
+        }
+    }
+
+    sqlite3_finalize(statement);
+
+    if (success) { success = execute("COMMIT TRANSACTION;"); }
+
+    if (false == success) { execute("ROLLBACK TRANSACTION;"); }
+
+    return success;
+}
+
+bool StorageSqlite3::execute(const std::string& sql) const
+{
+    char* error{nullptr};
+    const auto result =
+        sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, &error);
+
+    if (SQLITE_OK == result) { return true; }
+
+    otErr << OT_METHOD << __FUNCTION__ << ": " << sql << " failed: "
+          << ((nullptr == error) ? "" : error) << std::endl;
+    sqlite3_free(error);
+
+    return false;
+}
+
+std::unique_ptr<StorageSqlite3::Reader> StorageSqlite3::get_reader() const
+{
+    Lock lock(reader_lock_);
+
+    if (false == readers_.empty()) {
+        auto output = std::move(readers_.back());
+        readers_.pop_back();
+
+        return output;
+    }
+
+    lock.unlock();
+    std::unique_ptr<Reader> output{new Reader};
+    const auto opened = sqlite3_open_v2(
+        filename_.c_str(),
+        &output->db_,
+        SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX,
+        nullptr);
+
+    if (SQLITE_OK != opened) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to open read connection." << std::endl;
+
+        return {};
+    }
+
+    sqlite3_busy_timeout(output->db_, OT_SQLITE3_BUSY_TIMEOUT_MS);
 
     return output;
 }
@@ -130,25 +248,61 @@ std::string StorageSqlite3::GetTableName(const bool bucket) const
 
 void StorageSqlite3::Init_StorageSqlite3()
 {
-    const std::string filename = folder_ + "/" + config_.sqlite3_db_file_;
-
-    if (SQLITE_OK ==
+    if (SQLITE_OK !=
         sqlite3_open_v2(
-            filename.c_str(),
+            filename_.c_str(),
             &db_,
-            SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX,
+            SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX,
             nullptr)) {
-        sqlite3_exec(
-            db_, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
-        Create(config_.sqlite3_primary_bucket_);
-        Create(config_.sqlite3_secondary_bucket_);
-        Create(config_.sqlite3_control_table_);
-    } else {
         otErr << OT_METHOD << __FUNCTION__ << "Failed to initialize database."
               << std::endl;
 
         OT_FAIL
     }
+
+    sqlite3_busy_timeout(db_, OT_SQLITE3_BUSY_TIMEOUT_MS);
+    execute("PRAGMA journal_mode=WAL;");
+    execute("PRAGMA synchronous=" + synchronous() + ";");
+    Create(config_.sqlite3_primary_bucket_);
+    Create(config_.sqlite3_secondary_bucket_);
+    Create(config_.sqlite3_control_table_);
+}
+
+bool StorageSqlite3::Keys(
+    const bool bucket,
+    const std::function<void(const std::string&)>& callback) const
+{
+    auto reader = get_reader();
+
+    if (false == bool(reader)) { return false; }
+
+    auto statement = prepare(
+        reader->db_, "SELECT k FROM `" + GetTableName(bucket) + "`;");
+
+    if (nullptr == statement) {
+        return_reader(reader);
+
+        return false;
+    }
+
+    auto result = sqlite3_step(statement);
+
+    while (SQLITE_ROW == result) {
+        const auto key = sqlite3_column_text(statement, 0);
+        const auto size = sqlite3_column_bytes(statement, 0);
+        callback(std::string(reinterpret_cast<const char*>(key), size));
+        result = sqlite3_step(statement);
+    }
+
+    if (SQLITE_DONE != result) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Error (" << result
+              << "): " << sqlite3_errmsg(reader->db_) << std::endl;
+    }
+
+    sqlite3_finalize(statement);
+    return_reader(reader);
+
+    return SQLITE_DONE == result;
 }
 
 bool StorageSqlite3::LoadFromBucket(
@@ -172,136 +326,101 @@ std::string StorageSqlite3::LoadRoot() const
     return "";
 }
 
+sqlite3_stmt* StorageSqlite3::prepare(sqlite3* db, const std::string& sql)
+    const
+{
+    sqlite3_stmt* output{nullptr};
+
+    if (SQLITE_OK != sqlite3_prepare_v2(db, sql.c_str(), -1, &output, 0)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to prepare " << sql
+              << ": " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_finalize(output);
+
+        return nullptr;
+    }
+
+    return output;
+}
+
 bool StorageSqlite3::Purge(const std::string& tablename) const
 {
-    const std::string sql = "DROP TABLE `" + tablename + "`;";
+    Lock lock(transaction_lock_);
+    auto it = upsert_.find(tablename);
+
+    if (upsert_.end() != it) {
+        sqlite3_finalize(it->second);
+        upsert_.erase(it);
+    }
 
-    if (SQLITE_OK ==
-        sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, nullptr)) {
+    if (execute("DROP TABLE `" + tablename + "`;")) {
         return Create(tablename);
     }
 
     return false;
 }
 
+void StorageSqlite3::return_reader(std::unique_ptr<Reader>& reader) const
+{
+    Lock lock(reader_lock_);
+
+    if (OT_SQLITE3_MAX_IDLE_READERS > readers_.size()) {
+        readers_.emplace_back(std::move(reader));
+    } else {
+        lock.unlock();
+        reader.reset();
+    }
+}
+
 bool StorageSqlite3::Select(
     const std::string& key,
     const std::string& tablename,
     std::string& value) const
 {
-    sqlite3_stmt* statement{nullptr};
-    const std::string query =
-        "SELECT v FROM '" + tablename + "' WHERE k GLOB ?1;";
-    const auto sql = bind_key(query, key, 1);
-    sqlite3_prepare_v2(db_, sql.c_str(), -1, &statement, 0);
-    otInfo << sql << std::endl;
-    auto result = sqlite3_step(statement);
-    bool success = false;
-    std::size_t retry{3};
-
-    while (0 < retry) {
-        switch (result) {
-            case SQLITE_DONE:
-            case SQLITE_ROW: {
-                retry = 0;
-                const auto size = sqlite3_column_bytes(statement, 0);
-                success = (0 < size);
-
-                if (success) {
-                    const auto pResult = sqlite3_column_blob(statement, 0);
-                    value.assign(static_cast<const char*>(pResult), size);
-                }
-            } break;
-            case SQLITE_BUSY: {
-                otErr << OT_METHOD << __FUNCTION__ << ": Busy" << std::endl;
-                result = sqlite3_step(statement);
-                --retry;
-            } break;
-            default: {
-                otErr << OT_METHOD << __FUNCTION__ << ": Unknown error ("
-                      << result << ")" << std::endl;
-                result = sqlite3_step(statement);
-                --retry;
-            }
-        }
-    }
+    auto reader = get_reader();
 
-    sqlite3_finalize(statement);
+    if (false == bool(reader)) { return false; }
 
-    return success;
-}
+    auto& statement = reader->select_[tablename];
 
-void StorageSqlite3::set_data(std::stringstream& sql) const
-{
-    sqlite3_stmt* data{nullptr};
-    std::stringstream dataSQL{};
-    const std::string tablename{GetTableName(transaction_bucket_.get())};
-    dataSQL << "INSERT OR REPLACE INTO '" << tablename << "' (k, v) VALUES ";
-    std::size_t counter{0};
-    const auto size = pending_.size();
-
-    for (std::size_t i = 0; i < size; ++i) {
-        dataSQL << "(?" << ++counter << ", ?";
-        dataSQL << ++counter << ")";
-
-        if (counter < (2 * size)) {
-            dataSQL << ", ";
-        } else {
-            dataSQL << "; ";
-        }
+    if (nullptr == statement) {
+        statement = prepare(
+            reader->db_, "SELECT v FROM `" + tablename + "` WHERE k = ?1;");
     }
 
-    sqlite3_prepare_v2(db_, dataSQL.str().c_str(), -1, &data, 0);
-    counter = 0;
+    if (nullptr == statement) {
+        reader->select_.erase(tablename);
+        return_reader(reader);
 
-    for (const auto& it : pending_) {
-        const auto& key = it.first;
-        const auto& value = it.second;
-        auto bound = sqlite3_bind_text(
-            data, ++counter, key.c_str(), key.size(), SQLITE_STATIC);
+        return false;
+    }
 
-        OT_ASSERT(SQLITE_OK == bound);
+    bool success{false};
+    sqlite3_bind_text(statement, 1, key.c_str(), key.size(), SQLITE_STATIC);
+    const auto result = sqlite3_step(statement);
 
-        bound = sqlite3_bind_blob(
-            data, ++counter, value.c_str(), value.size(), SQLITE_STATIC);
+    switch (result) {
+        case SQLITE_ROW: {
+            const auto pResult = sqlite3_column_blob(statement, 0);
+            const auto size = sqlite3_column_bytes(statement, 0);
+            success = (0 < size);
 
-        OT_ASSERT(SQLITE_OK == bound);
+            if (success) {
+                value.assign(static_cast<const char*>(pResult), size);
+            }
+        } break;
+        case SQLITE_DONE: {
+        } break;
+        default: {
+            otErr << OT_METHOD << __FUNCTION__ << ": Error (" << result
+                  << "): " << sqlite3_errmsg(reader->db_) << std::endl;
+        }
     }
 
-    sql << expand_sql(data) << " ";
-    sqlite3_finalize(data);
-}
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+    return_reader(reader);
 
-void StorageSqlite3::set_root(
-    const std::string& rootHash,
-    std::stringstream& sql) const
-{
-    sqlite3_stmt* root{nullptr};
-    std::stringstream rootSQL{};
-    rootSQL << "INSERT OR REPLACE INTO '" << config_.sqlite3_control_table_
-            << "'  (k, v) VALUES (?1, ?2); ";
-    sqlite3_prepare_v2(db_, rootSQL.str().c_str(), -1, &root, 0);
-    auto bound = sqlite3_bind_text(
-        root,
-        1,
-        config_.sqlite3_root_key_.c_str(),
-        config_.sqlite3_root_key_.size(),
-        SQLITE_STATIC);
-
-    OT_ASSERT(SQLITE_OK == bound)
-
-    bound = sqlite3_bind_blob(
-        root, 2, rootHash.c_str(), rootHash.size(), SQLITE_STATIC);
-
-    OT_ASSERT(SQLITE_OK == bound)
-
-    sql << expand_sql(root) << " ";
-    sqlite3_finalize(root);
-}
-
-void StorageSqlite3::start_transaction(std::stringstream& sql) const
-{
-    sql << "BEGIN TRANSACTION; ";
+    return success;
 }
 
 void StorageSqlite3::store(
@@ -335,23 +454,70 @@ bool StorageSqlite3::StoreRoot(const bool commit, const std::string& hash) const
     }
 }
 
-bool StorageSqlite3::Upsert(
+std::string StorageSqlite3::synchronous() const
+{
+    std::string output{config_.sqlite3_synchronous_};
+    std::transform(output.begin(), output.end(), output.begin(), ::toupper);
+
+    if (("OFF" == output) || ("NORMAL" == output) || ("FULL" == output) ||
+        ("EXTRA" == output)) {
+
+        return output;
+    }
+
+    otErr << OT_METHOD << __FUNCTION__ << ": Unknown synchronous level "
+          << config_.sqlite3_synchronous_ << ". Using FULL." << std::endl;
+
+    return "FULL";
+}
+
+bool StorageSqlite3::upsert(
+    const Lock& lock,
     const std::string& key,
     const std::string& tablename,
     const std::string& value) const
 {
-    sqlite3_stmt* statement;
-    const std::string query =
-        "insert or replace into `" + tablename + "` (k, v) values (?1, ?2);";
+    OT_ASSERT(lock.mutex() == &transaction_lock_);
+
+    auto& statement = upsert_[tablename];
+
+    if (nullptr == statement) {
+        statement = prepare(
+            db_,
+            "INSERT OR REPLACE INTO `" + tablename +
+                "` (k, v) VALUES (?1, ?2);");
+    }
+
+    if (nullptr == statement) {
+        upsert_.erase(tablename);
+
+        return false;
+    }
 
-    sqlite3_prepare_v2(db_, query.c_str(), -1, &statement, 0);
     sqlite3_bind_text(statement, 1, key.c_str(), key.size(), SQLITE_STATIC);
-    sqlite3_bind_blob(statement, 2, value.c_str(), value.size(), SQLITE_STATIC);
-    otInfo << expand_sql(statement) << std::endl;
+    sqlite3_bind_blob(statement, 2, value.data(), value.size(), SQLITE_STATIC);
     const auto result = sqlite3_step(statement);
-    sqlite3_finalize(statement);
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+
+    if (SQLITE_DONE != result) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Error (" << result
+              << "): " << sqlite3_errmsg(db_) << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool StorageSqlite3::Upsert(
+    const std::string& key,
+    const std::string& tablename,
+    const std::string& value) const
+{
+    Lock lock(transaction_lock_);
 
-    return (result == SQLITE_DONE);
+    return upsert(lock, key, tablename, value);
 }
 
 StorageSqlite3::~StorageSqlite3() { Cleanup_StorageSqlite3(); }
@@ -9,11 +9,22 @@
 namespace opentxs::storage::implementation
 {
 // SQLite3 implementation of opentxs::storage
+//
+// All writes go through a single connection which keeps a prepared upsert
+// statement for each table. Reads use a pool of read-only connections, each
+// with its own prepared select statements, so that in WAL mode loads proceed
+// in parallel with each other and with a commit in progress.
 class StorageSqlite3 : public virtual Plugin,
                        public virtual opentxs::api::storage::Driver
 {
 public:
     bool EmptyBucket(const bool bucket) const override;
+    bool Erase(const std::vector<std::string>& keys, const bool bucket)
+        const override;
+    bool Keys(
+        const bool bucket,
+        const std::function<void(const std::string&)>& callback)
+        const override;
     bool LoadFromBucket(
         const std::string& key,
         std::string& value,
@@ -31,36 +42,49 @@ private:
 
     friend Factory;
 
+    struct Reader {
+        sqlite3* db_{nullptr};
+        std::map<std::string, sqlite3_stmt*> select_{};
+
+        ~Reader();
+    };
+
     std::string folder_;
+    std::string filename_;
     mutable std::mutex transaction_lock_;
     mutable OTFlag transaction_bucket_;
     mutable std::vector<std::pair<const std::string, const std::string>>
         pending_;
     sqlite3* db_{nullptr};
+    mutable std::map<std::string, sqlite3_stmt*> upsert_;
+    mutable std::mutex reader_lock_;
+    mutable std::vector<std::unique_ptr<Reader>> readers_;
 
-    std::string bind_key(
-        const std::string& source,
-        const std::string& key,
-        const std::size_t start) const;
-    void commit(std::stringstream& sql) const;
+    bool begin() const;
     bool commit_transaction(const std::string& rootHash) const;
     bool Create(const std::string& tablename) const;
-    std::string expand_sql(sqlite3_stmt* statement) const;
+    bool execute(const std::string& sql) const;
+    std::unique_ptr<Reader> get_reader() const;
     std::string GetTableName(const bool bucket) const;
+    sqlite3_stmt* prepare(sqlite3* db, const std::string& sql) const;
+    void return_reader(std::unique_ptr<Reader>& reader) const;
     bool Select(
         const std::string& key,
         const std::string& tablename,
         std::string& value) const;
     bool Purge(const std::string& tablename) const;
-    void set_data(std::stringstream& sql) const;
-    void set_root(const std::string& rootHash, std::stringstream& sql) const;
-    void start_transaction(std::stringstream& sql) const;
     void store(
         const bool isTransaction,
         const std::string& key,
         const std::string& value,
         const bool bucket,
         std::promise<bool>* promise) const override;
+    std::string synchronous() const;
+    bool upsert(
+        const Lock& lock,
+        const std::string& key,
+        const std::string& tablename,
+        const std::string& value) const;
     bool Upsert(
         const std::string& key,
         const std::string& tablename,
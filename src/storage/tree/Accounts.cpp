@@ -322,7 +322,7 @@ Accounts::AccountData& Accounts::get_account_data(
 void Accounts::init(const std::string& hash)
 {
     Lock lock(write_lock_);
-    std::shared_ptr<proto::StorageAccounts> serialized{nullptr};
+    std::shared_ptr<const proto::StorageAccounts> serialized{nullptr};
     driver_.LoadProto(hash, serialized);
 
     if (false == bool(serialized)) {
@@ -380,7 +380,7 @@ bool Accounts::save(const Lock& lock) const
 
     if (false == proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 proto::StorageAccounts Accounts::serialize() const
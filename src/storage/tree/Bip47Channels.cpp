@@ -221,7 +221,7 @@ void Bip47Channels::index_addresses(
 
 void Bip47Channels::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageBip47Contexts> serialized{nullptr};
+    std::shared_ptr<const proto::StorageBip47Contexts> serialized{nullptr};
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -309,7 +309,7 @@ bool Bip47Channels::save(const std::unique_lock<std::mutex>& lock) const
 
     if (!proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 proto::StorageBip47Contexts Bip47Channels::serialize() const
@@ -37,7 +37,8 @@ bool BlockchainTransactions::Delete(const std::string& id)
 
 void BlockchainTransactions::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageBlockchainTransactions> serialized{nullptr};
+    std::shared_ptr<const proto::StorageBlockchainTransactions> serialized{
+        nullptr};
     driver_.LoadProto(hash, serialized);
 
     if (false == bool(serialized)) {
@@ -82,7 +83,7 @@ bool BlockchainTransactions::save(const Lock& lock) const
 
     if (false == proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 proto::StorageBlockchainTransactions BlockchainTransactions::serialize() const
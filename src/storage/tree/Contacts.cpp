@@ -107,7 +107,7 @@ void Contacts::extract_nyms(const Lock& lock, const proto::Contact& data) const
 
 void Contacts::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageContacts> serialized{nullptr};
+    std::shared_ptr<const proto::StorageContacts> serialized{nullptr};
     driver_.LoadProto(hash, serialized);
 
     if (false == bool(serialized)) {
@@ -268,7 +268,7 @@ bool Contacts::save(const Lock& lock) const
 
     if (false == proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 bool Contacts::Save() const
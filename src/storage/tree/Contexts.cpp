@@ -30,7 +30,7 @@ bool Contexts::Delete(const std::string& id) { return delete_item(id); }
 
 void Contexts::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageNymList> serialized;
+    std::shared_ptr<const proto::StorageNymList> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -70,7 +70,7 @@ bool Contexts::save(const std::unique_lock<std::mutex>& lock) const
 
     if (false == proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 proto::StorageNymList Contexts::serialize() const
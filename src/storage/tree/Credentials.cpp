@@ -50,7 +50,7 @@ bool Credentials::check_existing(const bool incoming, Metadata& metadata) const
     // hasn't been updated
     // ...so we have to load the credential just to be sure
     if (!isPrivate) {
-        std::shared_ptr<proto::Credential> existing;
+        std::shared_ptr<const proto::Credential> existing;
 
         if (!driver_.LoadProto(hash, existing, false)) {
             std::cerr << __FUNCTION__ << ": Failed to load object" << std::endl;
@@ -67,7 +67,7 @@ bool Credentials::Delete(const std::string& id) { return delete_item(id); }
 
 void Credentials::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageCredentials> serialized;
+    std::shared_ptr<const proto::StorageCredentials> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -127,7 +127,7 @@ bool Credentials::save(const std::unique_lock<std::mutex>& lock) const
 
     if (!proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 proto::StorageCredentials Credentials::serialize() const
@@ -32,7 +32,7 @@ bool Issuers::Delete(const std::string& id) { return delete_item(id); }
 
 void Issuers::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageIssuers> serialized;
+    std::shared_ptr<const proto::StorageIssuers> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -71,7 +71,7 @@ bool Issuers::save(const std::unique_lock<std::mutex>& lock) const
 
     if (false == proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 proto::StorageIssuers Issuers::serialize() const
@@ -118,16 +118,33 @@ protected:
 
         for (const auto& it : copy) {
             const auto& hash = std::get<0>(it.second);
-            std::shared_ptr<T> serialized;
+            std::shared_ptr<const T> serialized;
 
             if (Node::BLANK_HASH == hash) { continue; }
 
-            if (driver_.LoadProto<T>(hash, serialized, false)) {
+            if (driver_.LoadProto<const T>(hash, serialized, false)) {
                 input(*serialized);
             }
         }
     }
 
+    /** Writes the index for this node and updates root_
+     *
+     *  The previous index is released so that a write batch can skip writing
+     *  versions of the index which were replaced before the batch committed.
+     */
+    template <class T>
+    bool store_index(const T& serialized) const
+    {
+        const auto previous = root_;
+
+        if (false == driver_.StoreProto(serialized, root_)) { return false; }
+
+        driver_.Release(previous);
+
+        return true;
+    }
+
     template <class T>
     bool check_revision(
         const std::string& method,
@@ -143,7 +160,7 @@ protected:
         // hasn't been updated
         // ...so we have to load the object just to be sure
         if (0 == revision) {
-            std::shared_ptr<T> existing{nullptr};
+            std::shared_ptr<const T> existing{nullptr};
 
             if (false == driver_.LoadProto(hash, existing, false)) {
                 otErr << method << __FUNCTION__ << ": Unable to load object."
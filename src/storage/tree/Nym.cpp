@@ -211,7 +211,7 @@ const PeerReplies& Nym::IncomingReplyBox() const
 
 void Nym::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageNym> serialized;
+    std::shared_ptr<const proto::StorageNym> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -533,7 +533,7 @@ bool Nym::save(const Lock& lock) const
 
     if (!proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 template <typename O>
@@ -735,7 +735,7 @@ bool Nym::Store(
             if (checked_.get()) {
                 saveOk = !private_.get();
             } else {
-                std::shared_ptr<proto::CredentialIndex> serialized;
+                std::shared_ptr<const proto::CredentialIndex> serialized;
                 driver_.LoadProto(credentials_, serialized, true);
                 saveOk = !private_.get();
             }
@@ -48,7 +48,7 @@ bool Nyms::Exists(const std::string& id) const
 
 void Nyms::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageNymList> serialized;
+    std::shared_ptr<const proto::StorageNymList> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -91,7 +91,7 @@ void Nyms::Map(NymLambda lambda) const
         const auto& node = *nym(id);
         const auto& hash = node.credentials_;
 
-        std::shared_ptr<proto::CredentialIndex> serialized;
+        std::shared_ptr<const proto::CredentialIndex> serialized;
 
         if (Node::BLANK_HASH == hash) { continue; }
 
@@ -200,7 +200,7 @@ bool Nyms::save(const Lock& lock) const
 
     OT_ASSERT(CURRENT_VERSION == serialized.version())
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 void Nyms::save(class Nym* nym, const Lock& lock, const std::string& id)
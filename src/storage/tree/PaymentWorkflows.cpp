@@ -11,7 +11,15 @@
 
 #include "storage/Plugin.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
 #define CURRENT_VERSION 1
+// Number of workflows in each stored chunk of older workflows
+#define PAYMENT_WORKFLOW_CHUNK_SIZE 100
+// Alias of the workflow entry which holds the hash of the previous chunk
+#define PAYMENT_WORKFLOW_CHUNK_LINK "chunk"
 
 #define OT_METHOD "opentxs::storage::PaymentWorkflows::"
 
@@ -22,12 +30,16 @@ PaymentWorkflows::PaymentWorkflows(
     const std::string& hash)
     : Node(storage, hash)
     , archived_()
+    , sequence_(0)
+    , workflows_()
+    , history_()
+    , chunks_()
+    , sealed_(0)
+    , compact_(false)
     , item_workflow_map_()
-    , account_workflow_map_()
-    , unit_workflow_map_()
-    , workflow_state_map_()
-    , type_workflow_map_()
-    , state_workflow_map_()
+    , account_index_()
+    , unit_index_()
+    , state_index_()
 {
     if (check_hash(hash)) {
         init(hash);
@@ -37,68 +49,82 @@ PaymentWorkflows::PaymentWorkflows(
     }
 }
 
-void PaymentWorkflows::add_state_index(
+void PaymentWorkflows::add_index(
     const Lock& lock,
     const std::string& workflowID,
-    proto::PaymentWorkflowType type,
-    proto::PaymentWorkflowState state)
+    const Entry& entry)
 {
     OT_ASSERT(verify_write_lock(lock))
     OT_ASSERT(false == workflowID.empty())
-    OT_ASSERT(proto::PAYMENTWORKFLOWTYPE_ERROR != type)
-    OT_ASSERT(proto::PAYMENTWORKFLOWSTATE_ERROR != state)
 
-    const State key{type, state};
-    workflow_state_map_.emplace(workflowID, key);
-    type_workflow_map_[type].emplace(workflowID);
-    state_workflow_map_[key].emplace(workflowID);
+    const auto& [type, state] = entry.state_;
+    const auto sequence = invert(entry.sequence_);
+    history_.emplace(entry.sequence_, workflowID);
+
+    for (const auto& account : entry.accounts_) {
+        account_index_.emplace(account, type, state, sequence, workflowID);
+    }
+
+    for (const auto& unit : entry.units_) {
+        unit_index_.emplace(unit, type, state, sequence, workflowID);
+    }
+
+    for (const auto& source : entry.sources_) {
+        item_workflow_map_.emplace(source, workflowID);
+    }
+
+    if ((proto::PAYMENTWORKFLOWTYPE_ERROR != type) &&
+        (proto::PAYMENTWORKFLOWSTATE_ERROR != state)) {
+        state_index_.emplace(type, state, sequence, workflowID);
+    }
 }
 
-bool PaymentWorkflows::Delete(const std::string& id)
+std::string PaymentWorkflows::chunk_link(
+    const proto::StoragePaymentWorkflows& chunk)
 {
-    Lock lock(write_lock_);
-    delete_by_value(id);
-    lock.unlock();
+    for (const auto& it : chunk.workflow()) {
+        if (PAYMENT_WORKFLOW_CHUNK_LINK == it.alias()) { return it.hash(); }
+    }
 
-    return delete_item(id);
+    return {};
 }
 
-void PaymentWorkflows::delete_by_value(const std::string& value)
+bool PaymentWorkflows::Delete(const std::string& id)
 {
-    auto it = item_workflow_map_.begin();
+    Lock lock(write_lock_);
+    const auto it = workflows_.find(id);
 
-    while (it != item_workflow_map_.end()) {
-        if (it->second == value) {
-            it = item_workflow_map_.erase(it);
-        } else {
-            ++it;
-        }
+    if (workflows_.end() != it) {
+        remove_index(lock, id, it->second);
+        workflows_.erase(it);
+
+        // A stored chunk may still hold a record of the deleted workflow
+        if (false == chunks_.empty()) { compact_ = true; }
     }
+
+    lock.unlock();
+
+    return delete_item(id);
 }
 
 PaymentWorkflows::State PaymentWorkflows::GetState(
     const std::string& workflowID) const
 {
-    State output{proto::PAYMENTWORKFLOWTYPE_ERROR,
-                 proto::PAYMENTWORKFLOWSTATE_ERROR};
-    auto& [outType, outState] = output;
     Lock lock(write_lock_);
-    const auto& it = workflow_state_map_.find(workflowID);
-    const bool found = workflow_state_map_.end() != it;
-    lock.unlock();
+    const auto it = workflows_.find(workflowID);
 
-    if (found) {
-        const auto& [type, state] = it->second;
-        outType = type;
-        outState = state;
+    if (workflows_.end() == it) {
+
+        return {proto::PAYMENTWORKFLOWTYPE_ERROR,
+                proto::PAYMENTWORKFLOWSTATE_ERROR};
     }
 
-    return output;
+    return it->second.state_;
 }
 
 void PaymentWorkflows::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StoragePaymentWorkflows> serialized;
+    std::shared_ptr<const proto::StoragePaymentWorkflows> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -111,67 +137,150 @@ void PaymentWorkflows::init(const std::string& hash)
 
     if (CURRENT_VERSION > version_) { version_ = CURRENT_VERSION; }
 
-    for (const auto& it : serialized->workflow()) {
-        item_map_.emplace(
-            it.itemid(), Metadata{it.hash(), it.alias(), 0, false});
-    }
+    for (const auto& it : serialized->archived()) { archived_.emplace(it); }
 
-    for (const auto& it : serialized->items()) {
-        item_workflow_map_.emplace(it.item(), it.workflow());
-    }
+    std::vector<std::shared_ptr<const proto::StoragePaymentWorkflows>> chunks{};
+    // An index written before workflows were chunked has no link
+    auto link = chunk_link(*serialized);
 
-    for (const auto& it : serialized->accounts()) {
-        account_workflow_map_[it.item()].emplace(it.workflow());
-    }
+    while (false == link.empty()) {
+        std::shared_ptr<const proto::StoragePaymentWorkflows> chunk;
+
+        if (false == driver_.LoadProto(link, chunk, false)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to load workflow chunk " << link << std::endl;
+
+            // Saving the index without the missing workflows would lose them
+            OT_FAIL
+        }
 
-    for (const auto& it : serialized->units()) {
-        unit_workflow_map_[it.item()].emplace(it.workflow());
+        chunks_.emplace_back(link);
+        link = chunk_link(*chunk);
+        chunks.emplace_back(chunk);
     }
 
-    for (const auto& it : serialized->archived()) { archived_.emplace(it); }
+    std::reverse(chunks_.begin(), chunks_.end());
+
+    for (auto it = chunks.crbegin(); it != chunks.crend(); ++it) {
+        load_chunk(**it);
+    }
 
+    sealed_ = sequence_;
+    load_chunk(*serialized);
     Lock lock(write_lock_);
 
-    for (const auto& it : serialized->types()) {
-        const auto& workflowID = it.workflow();
-        const auto& type = it.type();
-        const auto& state = it.state();
-        add_state_index(lock, workflowID, type, state);
+    for (const auto& [workflowID, entry] : workflows_) {
+        add_index(lock, workflowID, entry);
     }
 }
 
+PaymentWorkflows::Sequence PaymentWorkflows::invert(const Sequence sequence)
+{
+    return std::numeric_limits<Sequence>::max() - sequence;
+}
+
 PaymentWorkflows::Workflows PaymentWorkflows::ListByAccount(
     const std::string& accountID) const
 {
     Lock lock(write_lock_);
-    const auto it = account_workflow_map_.find(accountID);
 
-    if (account_workflow_map_.end() == it) { return {}; }
+    return scan(account_index_, accountID);
+}
 
-    return it->second;
+PaymentWorkflows::OrderedWorkflows PaymentWorkflows::ListByAccount(
+    const std::string& accountID,
+    const proto::PaymentWorkflowType type,
+    const proto::PaymentWorkflowState state) const
+{
+    OrderedWorkflows output{};
+    Lock lock(write_lock_);
+    auto it = account_index_.lower_bound({accountID, type, state, 0, ""});
+
+    for (; account_index_.end() != it; ++it) {
+        const auto& [account, itemType, itemState, sequence, workflow] = *it;
+
+        if ((accountID != account) || (type != itemType) ||
+            (state != itemState)) {
+            break;
+        }
+
+        output.emplace_back(workflow);
+    }
+
+    return output;
 }
 
 PaymentWorkflows::Workflows PaymentWorkflows::ListByUnit(
-    const std::string& accountID) const
+    const std::string& unitID) const
 {
     Lock lock(write_lock_);
-    const auto it = unit_workflow_map_.find(accountID);
 
-    if (unit_workflow_map_.end() == it) { return {}; }
-
-    return it->second;
+    return scan(unit_index_, unitID);
 }
 
 PaymentWorkflows::Workflows PaymentWorkflows::ListByState(
     proto::PaymentWorkflowType type,
     proto::PaymentWorkflowState state) const
 {
+    Workflows output{};
     Lock lock(write_lock_);
-    const auto it = state_workflow_map_.find(State{type, state});
+    auto it = state_index_.lower_bound({type, state, 0, ""});
 
-    if (state_workflow_map_.end() == it) { return {}; }
+    for (; state_index_.end() != it; ++it) {
+        const auto& [itemType, itemState, sequence, workflow] = *it;
 
-    return it->second;
+        if ((type != itemType) || (state != itemState)) { break; }
+
+        output.emplace(workflow);
+    }
+
+    return output;
+}
+
+// Chunks are loaded oldest first. A workflow which was stored again after its
+// chunk was sealed has a newer record, which replaces the older one.
+void PaymentWorkflows::load_chunk(const proto::StoragePaymentWorkflows& chunk)
+{
+    std::set<std::string> records{};
+    auto record = [&](const std::string& id) -> Entry& {
+        auto& entry = workflows_[id];
+
+        if (records.emplace(id).second) { entry = Entry{}; }
+
+        return entry;
+    };
+
+    for (const auto& it : chunk.workflow()) {
+        if (PAYMENT_WORKFLOW_CHUNK_LINK == it.alias()) { continue; }
+
+        item_map_[it.itemid()] = Metadata{it.hash(), it.alias(), 0, false};
+        record(it.itemid());
+    }
+
+    // The state index is serialized in the order workflows were stored
+    for (const auto& it : chunk.types()) {
+        auto& entry = record(it.workflow());
+        entry.state_ = {it.type(), it.state()};
+        entry.sequence_ = ++sequence_;
+    }
+
+    for (const auto& it : chunk.items()) {
+        record(it.workflow()).sources_.emplace(it.item());
+    }
+
+    for (const auto& it : chunk.accounts()) {
+        record(it.workflow()).accounts_.emplace(it.item());
+    }
+
+    for (const auto& it : chunk.units()) {
+        record(it.workflow()).units_.emplace(it.item());
+    }
+
+    for (const auto& id : records) {
+        auto& entry = workflows_[id];
+
+        if (0 == entry.sequence_) { entry.sequence_ = ++sequence_; }
+    }
 }
 
 bool PaymentWorkflows::Load(
@@ -194,31 +303,54 @@ std::string PaymentWorkflows::LookupBySource(const std::string& sourceID) const
     return it->second;
 }
 
-void PaymentWorkflows::reindex(
+bool PaymentWorkflows::Migrate(const opentxs::api::storage::Driver& to) const
+{
+    Lock lock(write_lock_);
+    bool output{true};
+
+    for (const auto& hash : chunks_) { output &= migrate(hash, to); }
+
+    lock.unlock();
+    output &= Node::Migrate(to);
+
+    return output;
+}
+
+void PaymentWorkflows::remove_index(
     const Lock& lock,
     const std::string& workflowID,
-    const proto::PaymentWorkflowType type,
-    const proto::PaymentWorkflowState newState,
-    proto::PaymentWorkflowState& state)
+    const Entry& entry)
 {
     OT_ASSERT(verify_write_lock(lock))
-    OT_ASSERT(false == workflowID.empty())
 
-    const State oldKey{type, state};
-    auto& oldSet = state_workflow_map_[oldKey];
-    oldSet.erase(workflowID);
+    const auto& [type, state] = entry.state_;
+    const auto sequence = invert(entry.sequence_);
+    history_.erase(entry.sequence_);
 
-    if (0 == oldSet.size()) { state_workflow_map_.erase(oldKey); }
+    for (const auto& account : entry.accounts_) {
+        account_index_.erase({account, type, state, sequence, workflowID});
+    }
 
-    state = newState;
+    for (const auto& unit : entry.units_) {
+        unit_index_.erase({unit, type, state, sequence, workflowID});
+    }
 
-    OT_ASSERT(proto::PAYMENTWORKFLOWTYPE_ERROR != type)
-    OT_ASSERT(proto::PAYMENTWORKFLOWSTATE_ERROR != state)
+    for (const auto& source : entry.sources_) {
+        const auto it = item_workflow_map_.find(source);
 
-    const State newKey{type, newState};
-    state_workflow_map_[newKey].emplace(workflowID);
+        if ((item_workflow_map_.end() != it) && (workflowID == it->second)) {
+            item_workflow_map_.erase(it);
+        }
+    }
+
+    state_index_.erase({type, state, sequence, workflowID});
 }
 
+// Workflows are written in the order they were last stored. Once enough of
+// them accumulate in the index they are sealed into a chunk, so storing a
+// workflow writes only the index. Storing an older workflow again leaves an
+// out of date record in its chunk, and the chunks are rewritten once more
+// than half of their records are out of date.
 bool PaymentWorkflows::save(const Lock& lock) const
 {
     if (!verify_write_lock(lock)) {
@@ -226,69 +358,136 @@ bool PaymentWorkflows::save(const Lock& lock) const
         OT_FAIL
     }
 
-    auto serialized = serialize();
+    auto it = history_.upper_bound(sealed_);
+    auto pending = static_cast<std::size_t>(std::distance(it, history_.cend()));
+    const auto live = history_.size() - pending;
+
+    if (compact_ ||
+        (2 * live < chunks_.size() * PAYMENT_WORKFLOW_CHUNK_SIZE)) {
+        for (const auto& hash : chunks_) { driver_.Release(hash); }
+
+        chunks_.clear();
+        sealed_ = 0;
+        compact_ = false;
+        it = history_.cbegin();
+        pending = history_.size();
+    }
+
+    while (PAYMENT_WORKFLOW_CHUNK_SIZE <= pending) {
+        const auto link = chunks_.empty() ? std::string{} : chunks_.back();
+        const auto chunk =
+            serialize(lock, link, it, PAYMENT_WORKFLOW_CHUNK_SIZE);
+        std::string hash{};
+
+        if (!proto::Validate(chunk, VERBOSE)) { return false; }
+
+        if (false == driver_.StoreProto(chunk, hash)) { return false; }
+
+        chunks_.emplace_back(hash);
+        sealed_ = std::prev(it)->first;
+        pending -= PAYMENT_WORKFLOW_CHUNK_SIZE;
+    }
+
+    const auto link = chunks_.empty() ? std::string{} : chunks_.back();
+    auto serialized = serialize(lock, link, it, pending);
+
+    for (const auto& archived : archived_) {
+        OT_ASSERT(false == archived.empty())
+
+        serialized.add_archived(archived);
+    }
 
     if (!proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
+}
+
+PaymentWorkflows::Workflows PaymentWorkflows::scan(
+    const std::set<ItemKey>& index,
+    const std::string& item)
+{
+    Workflows output{};
+    auto it = index.lower_bound({item,
+                                 proto::PAYMENTWORKFLOWTYPE_ERROR,
+                                 proto::PAYMENTWORKFLOWSTATE_ERROR,
+                                 0,
+                                 ""});
+
+    for (; (index.end() != it) && (item == std::get<0>(*it)); ++it) {
+        output.emplace(std::get<4>(*it));
+    }
+
+    return output;
 }
 
-proto::StoragePaymentWorkflows PaymentWorkflows::serialize() const
+proto::StoragePaymentWorkflows PaymentWorkflows::serialize(
+    const Lock& lock,
+    const std::string& link,
+    History::const_iterator& it,
+    const std::size_t count) const
 {
+    OT_ASSERT(verify_write_lock(lock))
+
     proto::StoragePaymentWorkflows serialized;
     serialized.set_version(version_);
 
-    for (const auto item : item_map_) {
-        const bool goodID = !item.first.empty();
-        const bool goodHash = check_hash(std::get<0>(item.second));
-        const bool good = goodID && goodHash;
+    if (false == link.empty()) {
+        auto& previous = *serialized.add_workflow();
+        set_hash(version_, link, link, previous);
+        previous.set_alias(PAYMENT_WORKFLOW_CHUNK_LINK);
+    }
 
-        if (good) {
-            serialize_index(
-                item.first, item.second, *serialized.add_workflow());
+    for (std::size_t i = 0; (i < count) && (history_.cend() != it); ++i, ++it) {
+        const auto& [sequence, workflow] = *it;
+
+        OT_ASSERT(false == workflow.empty())
+
+        const auto& entry = workflows_.at(workflow);
+        const auto item = item_map_.find(workflow);
+
+        if ((item_map_.end() != item) &&
+            check_hash(std::get<0>(item->second))) {
+            serialize_index(workflow, item->second, *serialized.add_workflow());
         }
-    }
 
-    for (const auto& [item, workflow] : item_workflow_map_) {
-        auto& newIndex = *serialized.add_items();
-        newIndex.set_version(1);
-        newIndex.set_workflow(workflow);
-        newIndex.set_item(item);
-    }
+        for (const auto& source : entry.sources_) {
+            const auto mapped = item_workflow_map_.find(source);
+
+            if ((item_workflow_map_.end() == mapped) ||
+                (workflow != mapped->second)) {
+                continue;
+            }
 
-    for (const auto& [account, workflowSet] : account_workflow_map_) {
-        OT_ASSERT(false == account.empty())
+            auto& newIndex = *serialized.add_items();
+            newIndex.set_version(1);
+            newIndex.set_workflow(workflow);
+            newIndex.set_item(source);
+        }
 
-        for (const auto& workflow : workflowSet) {
-            OT_ASSERT(false == workflow.empty())
+        for (const auto& account : entry.accounts_) {
+            OT_ASSERT(false == account.empty())
 
             auto& newAccount = *serialized.add_accounts();
             newAccount.set_version(1);
             newAccount.set_workflow(workflow);
             newAccount.set_item(account);
         }
-    }
 
-    for (const auto& [unit, workflowSet] : unit_workflow_map_) {
-        OT_ASSERT(false == unit.empty())
-
-        for (const auto& workflow : workflowSet) {
-            OT_ASSERT(false == workflow.empty())
+        for (const auto& unit : entry.units_) {
+            OT_ASSERT(false == unit.empty())
 
             auto& newUnit = *serialized.add_units();
             newUnit.set_version(1);
             newUnit.set_workflow(workflow);
             newUnit.set_item(unit);
         }
-    }
 
-    for (const auto& [workflow, stateTuple] : workflow_state_map_) {
-        OT_ASSERT(false == workflow.empty())
+        const auto& [type, state] = entry.state_;
 
-        const auto& [type, state] = stateTuple;
-
-        OT_ASSERT(proto::PAYMENTWORKFLOWTYPE_ERROR != type)
-        OT_ASSERT(proto::PAYMENTWORKFLOWSTATE_ERROR != state)
+        if ((proto::PAYMENTWORKFLOWTYPE_ERROR == type) ||
+            (proto::PAYMENTWORKFLOWSTATE_ERROR == state)) {
+            continue;
+        }
 
         auto& newIndex = *serialized.add_types();
         newIndex.set_version(1);
@@ -297,12 +496,6 @@ proto::StoragePaymentWorkflows PaymentWorkflows::serialize() const
         newIndex.set_state(state);
     }
 
-    for (const auto& archived : archived_) {
-        OT_ASSERT(false == archived.empty())
-
-        serialized.add_archived(archived);
-    }
-
     return serialized;
 }
 
@@ -313,28 +506,24 @@ bool PaymentWorkflows::Store(
     Lock lock(write_lock_);
     std::string alias;
     const auto& id = data.id();
-    delete_by_value(id);
 
-    for (const auto& source : data.source()) {
-        item_workflow_map_.emplace(source.id(), id);
-    }
+    OT_ASSERT(proto::PAYMENTWORKFLOWTYPE_ERROR != data.type())
+    OT_ASSERT(proto::PAYMENTWORKFLOWSTATE_ERROR != data.state())
 
-    const auto it = workflow_state_map_.find(id);
+    // Only the index entries of this workflow change
+    auto& entry = workflows_[id];
+    remove_index(lock, id, entry);
+    entry.state_ = {data.type(), data.state()};
+    entry.sequence_ = ++sequence_;
+    entry.accounts_ = {data.account().begin(), data.account().end()};
+    entry.units_ = {data.unit().begin(), data.unit().end()};
+    entry.sources_.clear();
 
-    if (workflow_state_map_.end() == it) {
-        add_state_index(lock, id, data.type(), data.state());
-    } else {
-        auto& [type, state] = it->second;
-        reindex(lock, id, type, data.state(), state);
-    }
-
-    for (const auto& account : data.account()) {
-        account_workflow_map_[account].emplace(id);
+    for (const auto& source : data.source()) {
+        entry.sources_.emplace(source.id());
     }
 
-    for (const auto& unit : data.unit()) {
-        unit_workflow_map_[unit].emplace(id);
-    }
+    add_index(lock, id, entry);
 
     return store_proto(lock, data, id, alias, plaintext);
 }
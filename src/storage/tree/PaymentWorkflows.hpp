@@ -13,6 +13,13 @@
 
 #include "Node.hpp"
 
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
 namespace opentxs::storage
 {
 class PaymentWorkflows : public Node
@@ -21,9 +28,15 @@ public:
     using State =
         std::pair<proto::PaymentWorkflowType, proto::PaymentWorkflowState>;
     using Workflows = std::set<std::string>;
+    // Most recently modified first
+    using OrderedWorkflows = std::vector<std::string>;
 
     State GetState(const std::string& workflowID) const;
     Workflows ListByAccount(const std::string& accountID) const;
+    OrderedWorkflows ListByAccount(
+        const std::string& accountID,
+        const proto::PaymentWorkflowType type,
+        const proto::PaymentWorkflowState state) const;
     Workflows ListByState(
         proto::PaymentWorkflowType type,
         proto::PaymentWorkflowState state) const;
@@ -33,6 +46,7 @@ public:
         std::shared_ptr<proto::PaymentWorkflow>& output,
         const bool checking) const;
     std::string LookupBySource(const std::string& sourceID) const;
+    bool Migrate(const opentxs::api::storage::Driver& to) const override;
 
     bool Delete(const std::string& id);
     bool Store(const proto::PaymentWorkflow& data, std::string& plaintext);
@@ -42,30 +56,71 @@ public:
 private:
     friend class Nym;
 
+    // Incremented every time a workflow is stored
+    using Sequence = std::uint64_t;
+    using History = std::map<Sequence, std::string>;
+    // Account or unit, type, state, inverted sequence, workflow
+    using ItemKey = std::tuple<
+        std::string,
+        proto::PaymentWorkflowType,
+        proto::PaymentWorkflowState,
+        Sequence,
+        std::string>;
+    // Type, state, inverted sequence, workflow
+    using StateKey = std::tuple<
+        proto::PaymentWorkflowType,
+        proto::PaymentWorkflowState,
+        Sequence,
+        std::string>;
+
+    struct Entry {
+        State state_{proto::PAYMENTWORKFLOWTYPE_ERROR,
+                     proto::PAYMENTWORKFLOWSTATE_ERROR};
+        Sequence sequence_{0};
+        std::set<std::string> accounts_{};
+        std::set<std::string> units_{};
+        std::set<std::string> sources_{};
+    };
+
     Workflows archived_;
+    Sequence sequence_;
+    std::map<std::string, Entry> workflows_;
+    // Workflows in the order they were last stored
+    History history_;
+    // Hashes of the stored chunks of older workflows, oldest first
+    mutable std::vector<std::string> chunks_;
+    // Workflows stored at or before this sequence are in chunks_
+    mutable Sequence sealed_;
+    // Set when the chunks hold workflows which no longer exist
+    mutable bool compact_;
     std::map<std::string, std::string> item_workflow_map_;
-    std::map<std::string, Workflows> account_workflow_map_;
-    std::map<std::string, Workflows> unit_workflow_map_;
-    std::map<std::string, State> workflow_state_map_;
-    std::map<proto::PaymentWorkflowType, Workflows> type_workflow_map_;
-    std::map<State, Workflows> state_workflow_map_;
+    std::set<ItemKey> account_index_;
+    std::set<ItemKey> unit_index_;
+    std::set<StateKey> state_index_;
+
+    static std::string chunk_link(const proto::StoragePaymentWorkflows& chunk);
+    static Sequence invert(const Sequence sequence);
+    static Workflows scan(
+        const std::set<ItemKey>& index,
+        const std::string& item);
 
     bool save(const Lock& lock) const override;
-    proto::StoragePaymentWorkflows serialize() const;
+    proto::StoragePaymentWorkflows serialize(
+        const Lock& lock,
+        const std::string& link,
+        History::const_iterator& it,
+        const std::size_t count) const;
 
-    void add_state_index(
+    void add_index(
         const Lock& lock,
         const std::string& workflowID,
-        proto::PaymentWorkflowType type,
-        proto::PaymentWorkflowState state);
-    void delete_by_value(const std::string& value);
+        const Entry& entry);
     void init(const std::string& hash) override;
-    void reindex(
+    void load_chunk(const proto::StoragePaymentWorkflows& chunk);
+    void remove_index(
         const Lock& lock,
         const std::string& workflowID,
-        const proto::PaymentWorkflowType type,
-        const proto::PaymentWorkflowState newState,
-        proto::PaymentWorkflowState& state);
+        const Entry& entry);
 
     PaymentWorkflows(
         const opentxs::api::storage::Driver& storage,
@@ -30,7 +30,7 @@ bool PeerReplies::Delete(const std::string& id) { return delete_item(id); }
 
 void PeerReplies::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageNymList> serialized;
+    std::shared_ptr<const proto::StorageNymList> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -95,7 +95,7 @@ bool PeerReplies::save(const std::unique_lock<std::mutex>& lock) const
 
     if (!proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 proto::StorageNymList PeerReplies::serialize() const
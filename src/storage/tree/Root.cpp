@@ -8,6 +8,7 @@
 #include "Root.hpp"
 
 #include "opentxs/api/storage/Driver.hpp"
+#include "opentxs/api/storage/Multiplex.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/Proto.hpp"
 
@@ -66,24 +67,12 @@ void Root::cleanup() const
     }
 }
 
-void Root::collect_garbage(const opentxs::api::storage::Driver* to) const
+void Root::collect_garbage(const opentxs::api::storage::Multiplex* to) const
 {
-    Lock lock(write_lock_);
+    OT_ASSERT(nullptr != to);
+
     otErr << OT_METHOD << __FUNCTION__ << ": Beginning garbage collection."
           << std::endl;
-    const auto resume = gc_resume_->Set(false);
-    bool oldLocation = false;
-
-    if (resume) {
-        oldLocation = !current_bucket_;
-    } else {
-        gc_root_ = tree()->Root();
-        oldLocation = current_bucket_.Toggle();
-        save(lock);
-        driver_.StoreRoot(true, root_);
-    }
-
-    lock.unlock();
     bool success{false};
 
     if (Node::check_hash(gc_root_)) {
@@ -91,14 +80,15 @@ void Root::collect_garbage(const opentxs::api::storage::Driver* to) const
         success = tree.Migrate(*to);
     }
 
-    if (success) {
-        driver_.EmptyBucket(oldLocation);
-    } else {
+    success = to->FinishCollection(success) && success;
+
+    if (false == success) {
         otErr << OT_METHOD << __FUNCTION__ << ": Garbage collection failed. "
               << "Will retry next cycle." << std::endl;
     }
 
     Lock gcLock(gc_lock_, std::defer_lock);
+    Lock lock(write_lock_, std::defer_lock);
     std::lock(gcLock, lock);
     gc_running_->Off();
     gc_root_ = "";
@@ -113,7 +103,7 @@ void Root::collect_garbage(const opentxs::api::storage::Driver* to) const
 
 void Root::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageRoot> serialized;
+    std::shared_ptr<const proto::StorageRoot> serialized;
 
     if (!driver_.LoadProto(hash, serialized)) {
         otErr << OT_METHOD << __FUNCTION__
@@ -144,6 +134,16 @@ bool Root::Migrate(const opentxs::api::storage::Driver& to) const
         return false;
     }
 
+    const auto* multiplex =
+        dynamic_cast<const opentxs::api::storage::Multiplex*>(&to);
+
+    if (nullptr == multiplex) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Garbage collection requires the multiplexer" << std::endl;
+
+        return false;
+    }
+
     const std::uint64_t time = std::time(nullptr);
     const bool intervalExceeded = ((time - last_gc_.load()) > gc_interval_);
     const bool resume = gc_resume_.get();
@@ -154,8 +154,19 @@ bool Root::Migrate(const opentxs::api::storage::Driver& to) const
 
         if (!running) {
             cleanup();
+            Lock lock(write_lock_);
+            gc_resume_->Set(false);
+            gc_root_ = tree()->Root();
+            // Everything written from here on is marked, including the root
+            // saved below, so only the tree as of now needs to be walked.
+            // The snapshot is taken before returning so that the caller can
+            // keep new batches out until every later write is marked.
+            multiplex->BeginCollection();
+            save(lock);
+            driver_.StoreRoot(true, root_);
+            lock.unlock();
             gc_thread_.reset(
-                new std::thread(&Root::collect_garbage, this, &to));
+                new std::thread(&Root::collect_garbage, this, multiplex));
 
             return true;
         }
@@ -180,6 +191,8 @@ bool Root::save(const Lock& lock, const opentxs::api::storage::Driver& to) const
 
     if (false == proto::Validate(serialized, VERBOSE)) { return false; }
 
+    if (&to == &driver_) { return store_index(serialized); }
+
     return to.StoreProto(serialized, root_);
 }
 
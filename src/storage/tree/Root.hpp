@@ -61,7 +61,7 @@ private:
     class Tree* tree() const;
 
     void cleanup() const;
-    void collect_garbage(const opentxs::api::storage::Driver* to) const;
+    void collect_garbage(const opentxs::api::storage::Multiplex* to) const;
     void init(const std::string& hash) override;
     bool save(const Lock& lock, const opentxs::api::storage::Driver& to) const;
     bool save(const Lock& lock) const override;
@@ -43,7 +43,7 @@ bool Seeds::Delete(const std::string& id) { return delete_item(id); }
 
 void Seeds::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageSeeds> serialized;
+    std::shared_ptr<const proto::StorageSeeds> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -85,7 +85,7 @@ bool Seeds::save(const std::unique_lock<std::mutex>& lock) const
 
     if (!proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 proto::StorageSeeds Seeds::serialize() const
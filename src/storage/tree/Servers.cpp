@@ -35,7 +35,7 @@ bool Servers::Delete(const std::string& id) { return delete_item(id); }
 
 void Servers::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageServers> serialized;
+    std::shared_ptr<const proto::StorageServers> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -80,7 +80,7 @@ bool Servers::save(const std::unique_lock<std::mutex>& lock) const
 
     if (!proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 proto::StorageServers Servers::serialize() const
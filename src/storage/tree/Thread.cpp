@@ -14,6 +14,13 @@
 #include "storage/Plugin.hpp"
 #include "Mailbox.hpp"
 
+#include <algorithm>
+#include <iterator>
+
+// Number of items in each stored chunk of older thread history. A chunk is
+// only rewritten when one of its items changes.
+#define THREAD_CHUNK_SIZE 100
+
 #define OT_METHOD "opentxs::storage::Thread::"
 
 namespace opentxs
@@ -33,6 +40,14 @@ Thread::Thread(
     , index_(0)
     , mail_inbox_(mailInbox)
     , mail_outbox_(mailOutbox)
+    , items_()
+    , sorted_()
+    , unread_(0)
+    , chunks_()
+    , dirty_from_(0)
+    , next_chunk_()
+    , loaded_(true)
+    , full_chunks_(true)
     , participants_()
 {
     if (check_hash(hash)) {
@@ -53,6 +68,14 @@ Thread::Thread(
     , id_(id)
     , mail_inbox_(mailInbox)
     , mail_outbox_(mailOutbox)
+    , items_()
+    , sorted_()
+    , unread_(0)
+    , chunks_()
+    , dirty_from_(0)
+    , next_chunk_()
+    , loaded_(true)
+    , full_chunks_(true)
     , participants_(participants)
 {
     version_ = 1;
@@ -69,6 +92,7 @@ bool Thread::Add(
     const std::string& account)
 {
     Lock lock(write_lock_);
+    load_chunks(lock);
 
     bool saved{false};
     bool unread{true};
@@ -108,6 +132,10 @@ bool Thread::Add(
         return false;
     }
 
+    auto existing = items_.find(id);
+
+    if (items_.end() != existing) { unindex_item(lock, existing->second); }
+
     auto& item = items_[id];
     item.set_version(version_);
     item.set_id(id);
@@ -131,6 +159,8 @@ bool Thread::Add(
         return false;
     }
 
+    index_item(lock, item);
+
     return save(lock);
 }
 
@@ -141,9 +171,25 @@ std::string Thread::Alias() const
     return alias_;
 }
 
+void Thread::index_item(
+    const Lock& lock,
+    const proto::StorageThreadItem& item) const
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    if (item.unread()) { ++unread_; }
+
+    const auto& id = item.id();
+
+    if (id.empty()) { return; }
+
+    sorted_.emplace(SortKey{item.index(), item.time(), id}, &item);
+    touch(lock, item);
+}
+
 void Thread::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageThread> serialized;
+    std::shared_ptr<const proto::StorageThread> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (false == bool(serialized)) {
@@ -160,20 +206,20 @@ void Thread::init(const std::string& hash)
         participants_.emplace(participant);
     }
 
-    for (const auto& it : serialized->item()) {
-        const auto& index = it.index();
-        items_.emplace(it.id(), it);
-
-        if (index >= index_) { index_ = index + 1; }
-    }
-
+    // The oldest chunk, like an index written before threads were chunked,
+    // carries the thread ID instead of a link. Older chunks are only loaded
+    // when something needs them.
+    next_chunk_ = serialized->id();
+    loaded_ = (next_chunk_ == id_);
     Lock lock(write_lock_);
+    load_items(lock, *serialized);
     upgrade(lock);
 }
 
 bool Thread::Check(const std::string& id) const
 {
     Lock lock(write_lock_);
+    load_chunks(lock);
 
     return items_.end() != items_.find(id);
 }
@@ -183,18 +229,91 @@ std::string Thread::ID() const { return id_; }
 proto::StorageThread Thread::Items() const
 {
     Lock lock(write_lock_);
+    load_chunks(lock);
 
     return serialize(lock);
 }
 
+proto::StorageThread Thread::Items(const std::size_t count) const
+{
+    Lock lock(write_lock_);
+    load_chunks(lock, count);
+
+    return serialize(lock, count);
+}
+
+void Thread::load_chunks(const Lock& lock, const std::size_t count) const
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    if (loaded_) { return; }
+
+    // Chunks are consecutive slices of sorted_, so the newest count items are
+    // known once the chunks holding them are loaded
+    while ((false == loaded_) && ((0 == count) || (sorted_.size() < count))) {
+        std::shared_ptr<const proto::StorageThread> chunk;
+
+        if ((false == check_hash(next_chunk_)) ||
+            (false == driver_.LoadProto(next_chunk_, chunk, false))) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to load thread chunk " << next_chunk_
+                  << std::endl;
+            // The thread can not be saved without the items in this chunk
+            OT_FAIL;
+        }
+
+        if (THREAD_CHUNK_SIZE != chunk->item_size()) { full_chunks_ = false; }
+
+        load_items(lock, *chunk);
+        chunks_.emplace(chunks_.begin(), next_chunk_);
+        next_chunk_ = chunk->id();
+        loaded_ = (next_chunk_ == id_);
+    }
+
+    if (loaded_) {
+        const bool complete =
+            full_chunks_ &&
+            (sorted_.size() >= chunks_.size() * THREAD_CHUNK_SIZE);
+        dirty_from_ = complete ? chunks_.size() : 0;
+    }
+}
+
+void Thread::load_items(const Lock& lock, const proto::StorageThread& chunk)
+    const
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    // Indexing the loaded items must not be mistaken for changes
+    dirty_from_ = 0;
+
+    for (const auto& it : chunk.item()) {
+        const auto& index = it.index();
+        const auto [item, added] = items_.emplace(it.id(), it);
+
+        // A newer chunk takes precedence
+        if (added) { index_item(lock, item->second); }
+
+        if (index >= index_) { index_ = index + 1; }
+    }
+}
+
 bool Thread::Migrate(const opentxs::api::storage::Driver& to) const
 {
-    return Node::migrate(root_, to);
+    Lock lock(write_lock_);
+    load_chunks(lock);
+    bool output{true};
+
+    for (const auto& hash : chunks_) { output &= migrate(hash, to); }
+
+    output &= Node::migrate(root_, to);
+
+    return output;
 }
 
 bool Thread::Read(const std::string& id, const bool unread)
 {
     Lock lock(write_lock_);
+    load_chunks(lock);
 
     auto it = items_.find(id);
 
@@ -207,7 +326,16 @@ bool Thread::Read(const std::string& id, const bool unread)
 
     auto& item = it->second;
 
+    if (item.unread() != unread) {
+        if (unread) {
+            ++unread_;
+        } else {
+            --unread_;
+        }
+    }
+
     item.set_unread(unread);
+    touch(lock, item);
 
     return save(lock);
 }
@@ -215,6 +343,7 @@ bool Thread::Read(const std::string& id, const bool unread)
 bool Thread::Remove(const std::string& id)
 {
     Lock lock(write_lock_);
+    load_chunks(lock);
 
     auto it = items_.find(id);
 
@@ -222,6 +351,7 @@ bool Thread::Remove(const std::string& id)
 
     auto& item = it->second;
     StorageBox box = static_cast<StorageBox>(item.box());
+    unindex_item(lock, item);
     items_.erase(it);
 
     switch (box) {
@@ -243,6 +373,7 @@ bool Thread::Remove(const std::string& id)
 bool Thread::Rename(const std::string& newID)
 {
     Lock lock(write_lock_);
+    load_chunks(lock);
     const auto oldID = id_;
     id_ = newID;
 
@@ -251,38 +382,88 @@ bool Thread::Rename(const std::string& newID)
         participants_.emplace(newID);
     }
 
+    // Every chunk stores the participants, and the oldest also the thread ID
+    dirty_from_ = 0;
+
     return save(lock);
 }
 
+// Only the chunks from dirty_from_ onward and the index holding the newest
+// items are written. Each is a StorageThread whose id is the hash of the
+// chunk before it.
 bool Thread::save(const Lock& lock) const
 {
     OT_ASSERT(verify_write_lock(lock));
+    OT_ASSERT(loaded_);
+
+    const auto full = sorted_.size() / THREAD_CHUNK_SIZE;
+    const auto first = std::min({dirty_from_, chunks_.size(), full});
+
+    for (auto i = first; i < chunks_.size(); ++i) {
+        driver_.Release(chunks_.at(i));
+    }
+
+    chunks_.resize(first);
+    dirty_from_ = first;
+    auto it = sorted_.cbegin();
+    std::advance(it, first * THREAD_CHUNK_SIZE);
+
+    while (chunks_.size() < full) {
+        const auto& link = chunks_.empty() ? id_ : chunks_.back();
+        const auto chunk = serialize_chunk(lock, link, it, THREAD_CHUNK_SIZE);
+        std::string hash{};
+
+        if (!proto::Validate(chunk, VERBOSE)) { return false; }
+
+        if (false == driver_.StoreProto(chunk, hash)) { return false; }
+
+        chunks_.emplace_back(hash);
+        dirty_from_ = chunks_.size();
+    }
 
-    auto serialized = serialize(lock);
+    const auto& link = chunks_.empty() ? id_ : chunks_.back();
+    const auto serialized = serialize_chunk(lock, link, it, sorted_.size());
 
     if (!proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
-proto::StorageThread Thread::serialize(const Lock& lock) const
+proto::StorageThread Thread::serialize(
+    const Lock& lock,
+    const std::size_t count) const
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    auto start = sorted_.cbegin();
+
+    if ((0 < count) && (count < sorted_.size())) {
+        start = std::prev(sorted_.cend(), count);
+    }
+
+    return serialize_chunk(lock, id_, start, sorted_.size());
+}
+
+proto::StorageThread Thread::serialize_chunk(
+    const Lock& lock,
+    const std::string& link,
+    SortedItems::const_iterator& it,
+    const std::size_t count) const
 {
     OT_ASSERT(verify_write_lock(lock));
 
     proto::StorageThread serialized;
     serialized.set_version(version_);
-    serialized.set_id(id_);
+    serialized.set_id(link);
 
     for (const auto nym : participants_) {
         if (!nym.empty()) { *serialized.add_participant() = nym; }
     }
 
-    auto sorted = sort(lock);
-
-    for (const auto& it : sorted) {
-        OT_ASSERT(nullptr != it.second);
+    for (std::size_t i = 0; (i < count) && (sorted_.cend() != it); ++i, ++it) {
+        OT_ASSERT(nullptr != it->second);
 
-        const auto& item = *it.second;
+        const auto& item = *it->second;
         *serialized.add_item() = item;
     }
 
@@ -298,63 +479,88 @@ bool Thread::SetAlias(const std::string& alias)
     return true;
 }
 
-Thread::SortedItems Thread::sort(const Lock& lock) const
+void Thread::unindex_item(
+    const Lock& lock,
+    const proto::StorageThreadItem& item)
 {
     OT_ASSERT(verify_write_lock(lock));
 
-    SortedItems output;
+    if (item.unread()) { --unread_; }
 
-    for (const auto& it : items_) {
-        const auto& id = it.first;
-        const auto& item = it.second;
+    const auto& id = item.id();
 
-        if (!id.empty()) {
-            SortKey key{item.index(), item.time(), id};
-            output.emplace(key, &item);
-        }
-    }
+    if (id.empty()) { return; }
 
-    return output;
+    touch(lock, item);
+    sorted_.erase(SortKey{item.index(), item.time(), id});
 }
 
-std::size_t Thread::UnreadCount() const
+// Every chunk from the one holding the item onward must be rewritten. Recent
+// items are found by walking back from the end of the thread.
+void Thread::touch(const Lock& lock, const proto::StorageThreadItem& item)
+    const
 {
-    Lock lock(write_lock_);
-    std::size_t output{0};
+    OT_ASSERT(verify_write_lock(lock));
 
-    for (const auto& it : items_) {
-        const auto& item = it.second;
+    if (0 == dirty_from_) { return; }
 
-        if (item.unread()) { ++output; }
-    }
+    const auto it = sorted_.find(SortKey{item.index(), item.time(), item.id()});
 
-    return output;
+    if (sorted_.end() == it) { return; }
+
+    const auto position =
+        sorted_.size() -
+        static_cast<std::size_t>(std::distance(it, sorted_.end()));
+    dirty_from_ = std::min(dirty_from_, position / THREAD_CHUNK_SIZE);
 }
 
-void Thread::upgrade(const Lock& lock)
+std::size_t Thread::UnreadCount() const
 {
-    OT_ASSERT(verify_write_lock(lock));
+    Lock lock(write_lock_);
+    load_chunks(lock);
 
-    bool changed{false};
+    return unread_;
+}
 
-    for (auto& it : items_) {
-        auto& item = it.second;
-        const auto box = static_cast<StorageBox>(item.box());
+void Thread::upgrade(const Lock& lock)
+{
+    OT_ASSERT(verify_write_lock(lock));
 
-        switch (box) {
+    const auto outgoing = [](const proto::StorageThreadItem& item) -> bool {
+        switch (static_cast<StorageBox>(item.box())) {
             case StorageBox::MAILOUTBOX:
             case StorageBox::OUTGOINGBLOCKCHAIN: {
-                if (item.unread()) {
-                    item.set_unread(false);
-                    changed = true;
-                }
-            } break;
+
+                return item.unread();
+            }
             default: {
+
+                return false;
             }
         }
+    };
+    const auto needed = std::any_of(
+        items_.begin(), items_.end(), [&](const auto& it) -> bool {
+            return outgoing(it.second);
+        });
+
+    if (false == needed) { return; }
+
+    // Chunks written since this upgrade was added never need it, so only
+    // threads with an outdated newest chunk are loaded in full
+    load_chunks(lock);
+
+    for (auto& it : items_) {
+        auto& item = it.second;
+
+        if (outgoing(item)) {
+            item.set_unread(false);
+            --unread_;
+            touch(lock, item);
+        }
     }
 
-    if (changed) { save(lock); }
+    save(lock);
 }
 }  // namespace storage
 }  // namespace opentxs
@@ -16,6 +16,8 @@
 #include <list>
 #include <map>
 #include <set>
+#include <string>
+#include <vector>
 
 namespace opentxs
 {
@@ -34,19 +36,51 @@ private:
 
     std::string id_;
     std::string alias_;
-    std::size_t index_{0};
+    // Items from older chunks are added to the containers below the first
+    // time they are needed, which may happen in a const method
+    mutable std::size_t index_{0};
     Mailbox& mail_inbox_;
     Mailbox& mail_outbox_;
-    std::map<std::string, proto::StorageThreadItem> items_;
+    mutable std::map<std::string, proto::StorageThreadItem> items_;
+    // Kept up to date as items change so that appending to a long thread does
+    // not have to sort the entire history
+    mutable SortedItems sorted_;
+    mutable std::size_t unread_{0};
+    // Hashes of the loaded chunks of older items, oldest first
+    mutable std::vector<std::string> chunks_;
+    // The first chunk which no longer matches sorted_
+    mutable std::size_t dirty_from_{0};
+    // Hash of the newest chunk which has not been loaded yet
+    mutable std::string next_chunk_;
+    mutable bool loaded_{true};
+    // False if any loaded chunk holds other than THREAD_CHUNK_SIZE items
+    mutable bool full_chunks_{true};
 
     // It's important to use a sorted container for this so the thread ID can be
     // calculated deterministically
     std::set<std::string> participants_;
 
+    void index_item(const Lock& lock, const proto::StorageThreadItem& item)
+        const;
     void init(const std::string& hash) override;
+    /** Loads older chunks until at least count items are present
+     *
+     *  \param[in] count the number of items needed, or 0 for all of them
+     */
+    void load_chunks(const Lock& lock, const std::size_t count = 0) const;
+    void load_items(const Lock& lock, const proto::StorageThread& chunk)
+        const;
     bool save(const Lock& lock) const override;
-    proto::StorageThread serialize(const Lock& lock) const;
-    SortedItems sort(const Lock& lock) const;
+    proto::StorageThread serialize(
+        const Lock& lock,
+        const std::size_t count = 0) const;
+    proto::StorageThread serialize_chunk(
+        const Lock& lock,
+        const std::string& link,
+        SortedItems::const_iterator& it,
+        const std::size_t count) const;
+    void touch(const Lock& lock, const proto::StorageThreadItem& item) const;
+    void unindex_item(const Lock& lock, const proto::StorageThreadItem& item);
     void upgrade(const Lock& lock);
 
     Thread(
@@ -73,6 +107,11 @@ public:
     bool Check(const std::string& id) const;
     std::string ID() const;
     proto::StorageThread Items() const;
+    /** Returns the thread with only the most recent items
+     *
+     *  \param[in] count the maximum number of items to return, or 0 for all
+     */
+    proto::StorageThread Items(const std::size_t count) const;
     bool Migrate(const opentxs::api::storage::Driver& to) const override;
     std::size_t UnreadCount() const;
 
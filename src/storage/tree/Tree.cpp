@@ -196,7 +196,7 @@ Credentials* Tree::credentials() const
 
 void Tree::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageItems> serialized{nullptr};
+    std::shared_ptr<const proto::StorageItems> serialized{nullptr};
     driver_.LoadProto(hash, serialized);
 
     if (false == bool(serialized)) {
@@ -335,7 +335,7 @@ bool Tree::save(const Lock& lock) const
 
     if (!proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 void Tree::save(Accounts* accounts, const Lock& lock)
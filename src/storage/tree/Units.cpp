@@ -32,7 +32,7 @@ bool Units::Delete(const std::string& id) { return delete_item(id); }
 
 void Units::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageUnits> serialized;
+    std::shared_ptr<const proto::StorageUnits> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -74,7 +74,7 @@ bool Units::save(const std::unique_lock<std::mutex>& lock) const
 
     if (!proto::Validate(serialized, VERBOSE)) { return false; }
 
-    return driver_.StoreProto(serialized, root_);
+    return store_index(serialized);
 }
 
 proto::StorageUnits Units::serialize() const
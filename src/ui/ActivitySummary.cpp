@@ -147,7 +147,9 @@ const proto::StorageThreadItem& ActivitySummary::newest_item(
 void ActivitySummary::process_thread(const std::string& id)
 {
     const auto threadID = Identifier::Factory(id);
-    const auto thread = api_.Activity().Thread(nym_id_, threadID);
+    // Only the most recent item is shown, so the rest of the thread is not
+    // loaded
+    const auto thread = api_.Activity().Thread(nym_id_, threadID, 1);
 
     OT_ASSERT(thread);
 
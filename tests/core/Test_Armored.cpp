@@ -0,0 +1,135 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "opentxs/opentxs.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+// Roughly the size of a typical request, an account ledger, and a large
+// nymbox
+const std::vector<std::size_t> sizes_{1024, 64 * 1024, 1024 * 1024};
+const std::vector<std::int32_t> levels_{0, 1, 6, 9};
+
+// Produces text resembling a serialized ledger: repetitive markup
+// interleaved with base64 encoded signatures which do not compress well
+std::string ledger(const std::size_t size)
+{
+    const std::string base64{
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"};
+    std::mt19937 generator(size);
+    std::uniform_int_distribution<std::size_t> character(0, base64.size() - 1);
+    std::string output{};
+    std::int64_t number{1000};
+
+    while (output.size() < size) {
+        output += "<transaction type=\"pending\" transactionNum=\"" +
+                  std::to_string(++number) + "\" inReferenceTo=\"" +
+                  std::to_string(number - 1) + "\">\n<signature>";
+
+        for (std::size_t i = 0; i < 88; ++i) {
+            output += base64[character(generator)];
+        }
+
+        output += "</signature>\n</transaction>\n";
+    }
+
+    output.resize(size);
+
+    return output;
+}
+}  // namespace
+
+TEST(Armored, round_trip_each_level)
+{
+    for (const auto& size : sizes_) {
+        const auto input = ledger(size);
+
+        for (const auto& level : levels_) {
+            auto armored = Armored::Factory();
+
+            ASSERT_TRUE(armored->SetString(String(input.c_str()), true, level));
+
+            String output{};
+
+            ASSERT_TRUE(armored->GetString(output));
+            EXPECT_EQ(input, std::string(output.Get()));
+        }
+    }
+}
+
+TEST(Armored, configured_level_decodes_any_level)
+{
+    const auto input = ledger(sizes_.at(1));
+    auto fast = Armored::Factory();
+    auto best = Armored::Factory();
+
+    ASSERT_TRUE(fast->SetString(String(input.c_str()), true, 1));
+    ASSERT_TRUE(best->SetString(String(input.c_str()), true, 9));
+    EXPECT_GE(fast->GetLength(), best->GetLength());
+
+    String fromFast{};
+    String fromBest{};
+
+    ASSERT_TRUE(fast->GetString(fromFast));
+    ASSERT_TRUE(best->GetString(fromBest));
+    EXPECT_STREQ(fromFast.Get(), fromBest.Get());
+}
+
+// Run with --gtest_also_run_disabled_tests
+TEST(Armored, DISABLED_benchmark)
+{
+    const std::size_t volume{16 * 1024 * 1024};
+
+    for (const auto& size : sizes_) {
+        const auto input = ledger(size);
+        const String plain(input.c_str());
+        const auto iterations = std::max<std::size_t>(volume / size, 1);
+
+        for (const auto& level : levels_) {
+            auto armored = Armored::Factory();
+            String output{};
+            const auto start = std::chrono::steady_clock::now();
+
+            for (std::size_t i = 0; i < iterations; ++i) {
+                armored->SetString(plain, true, level);
+            }
+
+            const auto encoded = std::chrono::steady_clock::now();
+
+            for (std::size_t i = 0; i < iterations; ++i) {
+                armored->GetString(output);
+            }
+
+            const auto decoded = std::chrono::steady_clock::now();
+            const auto encode =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    encoded - start)
+                    .count() /
+                iterations;
+            const auto decode =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    decoded - encoded)
+                    .count() /
+                iterations;
+
+            std::cout << "size: " << size << " level: " << level
+                      << " armored: " << armored->GetLength()
+                      << " encode: " << encode << " us"
+                      << " decode: " << decode << " us" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,329 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "opentxs/core/trade/OrderBook.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+struct Order {
+    std::int64_t transaction_{0};
+    std::int64_t price_{0};
+    std::int64_t amount_{0};
+};
+
+// One step of synthetic order flow: an order arrives, or an earlier order is
+// cancelled or filled
+struct Event {
+    bool add_{false};
+    std::int64_t transaction_{0};
+    std::int64_t price_{0};
+};
+
+std::vector<std::int64_t> visit(const OrderBook<Order>& book)
+{
+    std::vector<std::int64_t> output{};
+    book.ForEach([&](const Order& order) -> bool {
+        output.emplace_back(order.transaction_);
+
+        return true;
+    });
+
+    return output;
+}
+
+// Orders cluster around the last traded price, and the book stays about
+// depth orders deep
+std::vector<Event> flow(const std::size_t count, const std::size_t depth)
+{
+    std::mt19937 generator(1);
+    std::normal_distribution<double> price(1000.0, 25.0);
+    std::uniform_int_distribution<int> action(0, 99);
+    std::vector<std::int64_t> live{};
+    std::vector<Event> output{};
+    std::int64_t transaction{0};
+
+    while (output.size() < count) {
+        if ((live.size() < depth) || (action(generator) < 50)) {
+            ++transaction;
+            live.emplace_back(transaction);
+            const auto limit = static_cast<std::int64_t>(price(generator));
+            output.push_back({true, transaction, limit});
+        } else {
+            std::uniform_int_distribution<std::size_t> pick(
+                0, live.size() - 1);
+            // Fills come off the oldest orders, cancels come from anywhere.
+            const auto index = (action(generator) < 50) ? 0 : pick(generator);
+            output.push_back({false, live.at(index), 0});
+            live.erase(live.begin() + index);
+        }
+    }
+
+    return output;
+}
+}  // namespace
+
+TEST(OrderBook, best_price_first)
+{
+    Order low{1, 10, 1};
+    Order high{2, 30, 1};
+    Order middle{3, 20, 1};
+    OrderBook<Order> bids(true);
+    OrderBook<Order> asks(false);
+
+    for (auto* order : {&low, &high, &middle}) {
+        ASSERT_TRUE(bids.Insert(order->transaction_, order->price_, *order));
+        ASSERT_TRUE(asks.Insert(order->transaction_, order->price_, *order));
+    }
+
+    EXPECT_EQ(30, bids.BestPrice());
+    EXPECT_EQ(10, asks.BestPrice());
+    EXPECT_EQ(std::vector<std::int64_t>({2, 3, 1}), visit(bids));
+    EXPECT_EQ(std::vector<std::int64_t>({1, 3, 2}), visit(asks));
+    EXPECT_EQ(3, bids.LevelCount());
+}
+
+TEST(OrderBook, fifo_within_price)
+{
+    std::vector<Order> orders{{1, 20, 1}, {2, 10, 1}, {3, 20, 1}, {4, 20, 1}};
+    OrderBook<Order> bids(true);
+
+    for (auto& order : orders) {
+        ASSERT_TRUE(bids.Insert(order.transaction_, order.price_, order));
+    }
+
+    EXPECT_EQ(std::vector<std::int64_t>({1, 3, 4, 2}), visit(bids));
+    EXPECT_EQ(2, bids.LevelCount());
+}
+
+TEST(OrderBook, market_orders)
+{
+    Order market{1, 0, 1};
+    Order limit{2, 15, 1};
+    OrderBook<Order> asks(false);
+
+    EXPECT_EQ(0, asks.BestPrice(true));
+
+    ASSERT_TRUE(asks.Insert(market.transaction_, market.price_, market));
+
+    EXPECT_EQ(0, asks.BestPrice());
+    EXPECT_EQ(0, asks.BestPrice(true));
+
+    ASSERT_TRUE(asks.Insert(limit.transaction_, limit.price_, limit));
+
+    EXPECT_EQ(0, asks.BestPrice());
+    EXPECT_EQ(15, asks.BestPrice(true));
+}
+
+TEST(OrderBook, duplicate_transaction)
+{
+    Order first{1, 10, 1};
+    Order second{1, 20, 1};
+    OrderBook<Order> book(true);
+
+    EXPECT_TRUE(book.Insert(first.transaction_, first.price_, first));
+    EXPECT_FALSE(book.Insert(second.transaction_, second.price_, second));
+    EXPECT_EQ(1, book.size());
+    EXPECT_EQ(&first, book.Find(1));
+}
+
+TEST(OrderBook, remove)
+{
+    std::vector<Order> orders{};
+
+    for (std::int64_t i = 1; i <= 10; ++i) { orders.push_back({i, 10, 1}); }
+
+    orders.push_back({11, 20, 1});
+    OrderBook<Order> book(false);
+
+    for (auto& order : orders) {
+        ASSERT_TRUE(book.Insert(order.transaction_, order.price_, order));
+    }
+
+    EXPECT_EQ(nullptr, book.Remove(12));
+    EXPECT_EQ(&orders.at(10), book.Remove(11));
+    EXPECT_EQ(1, book.LevelCount());
+
+    // Enough removals from the front of the level to force it to compact
+    for (std::int64_t i = 1; i <= 7; ++i) {
+        EXPECT_EQ(&orders.at(i - 1), book.Remove(i));
+        EXPECT_EQ(nullptr, book.Find(i));
+    }
+
+    EXPECT_EQ(3, book.size());
+    EXPECT_EQ(std::vector<std::int64_t>({8, 9, 10}), visit(book));
+
+    for (std::int64_t i = 8; i <= 10; ++i) {
+        EXPECT_EQ(&orders.at(i - 1), book.Find(i));
+    }
+
+    EXPECT_EQ(&orders.at(8), book.Remove(9));
+    EXPECT_EQ(std::vector<std::int64_t>({8, 10}), visit(book));
+    EXPECT_EQ(&orders.at(7), book.Remove(8));
+    EXPECT_EQ(&orders.at(9), book.Remove(10));
+    EXPECT_EQ(0, book.size());
+    EXPECT_EQ(0, book.LevelCount());
+    EXPECT_EQ(0, book.BestPrice());
+}
+
+TEST(OrderBook, replace)
+{
+    Order first{1, 10, 5};
+    Order second{2, 10, 5};
+    Order third{3, 20, 5};
+    Order update{1, 10, 2};
+    Order moved{1, 20, 2};
+    OrderBook<Order> book(false);
+
+    for (auto* order : {&first, &second, &third}) {
+        ASSERT_TRUE(book.Insert(order->transaction_, order->price_, *order));
+    }
+
+    EXPECT_EQ(nullptr, book.Replace(4, 10, update));
+    EXPECT_EQ(nullptr, book.Replace(1, 20, moved));
+    EXPECT_EQ(&first, book.Find(1));
+    EXPECT_EQ(&first, book.Replace(1, 10, update));
+    EXPECT_EQ(&update, book.Find(1));
+    EXPECT_EQ(3, book.size());
+    EXPECT_EQ(std::vector<std::int64_t>({1, 2, 3}), visit(book));
+}
+
+// Replays a market journal the way OTMarket::LoadMarket does: the snapshot
+// is inserted in priority order, then each entry adds, updates or removes
+// an offer. A partially filled offer stays at the front of its price level.
+TEST(OrderBook, journal_replay_keeps_fifo)
+{
+    std::vector<Order> snapshot{{1, 10, 5}, {2, 10, 5}, {3, 10, 5}};
+    std::vector<Order> journal{{4, 10, 5}, {1, 10, 3}, {2, 10, 4}};
+    OrderBook<Order> book(false);
+
+    for (auto& order : snapshot) {
+        ASSERT_TRUE(book.Insert(order.transaction_, order.price_, order));
+    }
+
+    // A new offer arrives behind the others
+    ASSERT_TRUE(book.Insert(
+        journal.at(0).transaction_, journal.at(0).price_, journal.at(0)));
+
+    // Partial fills of the two oldest offers
+    for (std::size_t i = 1; i < journal.size(); ++i) {
+        auto& order = journal.at(i);
+
+        EXPECT_EQ(
+            &snapshot.at(i - 1),
+            book.Replace(order.transaction_, order.price_, order));
+    }
+
+    // The third offer is filled completely
+    EXPECT_EQ(&snapshot.at(2), book.Remove(3));
+
+    EXPECT_EQ(std::vector<std::int64_t>({1, 2, 4}), visit(book));
+    EXPECT_EQ(3, book.Find(1)->amount_);
+    EXPECT_EQ(4, book.Find(2)->amount_);
+    EXPECT_EQ(5, book.Find(4)->amount_);
+}
+
+// Run with --gtest_also_run_disabled_tests
+TEST(OrderBook, DISABLED_benchmark)
+{
+    const std::size_t size{200000};
+    const std::vector<std::size_t> depths{100, 1000, 10000};
+
+    for (const auto& depth : depths) {
+        const auto events = flow(size, depth);
+        std::map<std::int64_t, Order> orders{};
+
+        for (const auto& event : events) {
+            if (event.add_) {
+                orders[event.transaction_] = {
+                    event.transaction_, event.price_, 1};
+            }
+        }
+
+        // After every event the matching loop looks at the first few orders
+        std::int64_t checksum{0};
+        std::size_t visited{0};
+        const auto match = [&](const Order& order) -> bool {
+            checksum += order.transaction_;
+
+            return ++visited < 8;
+        };
+
+        // The structure OTMarket used previously: a multimap ordered by price
+        // with a second map for lookups by transaction number, where removal
+        // searches the multimap for the order.
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::multimap<std::int64_t, Order*> book{};
+            std::map<std::int64_t, Order*> index{};
+
+            for (const auto& event : events) {
+                if (event.add_) {
+                    auto& order = orders.at(event.transaction_);
+                    index[event.transaction_] = &order;
+                    book.insert(
+                        book.upper_bound(order.price_), {order.price_, &order});
+                } else {
+                    auto it = index.find(event.transaction_);
+                    Order* pOrder = it->second;
+                    index.erase(it);
+
+                    for (auto i = book.begin(); i != book.end(); ++i) {
+                        if (i->second == pOrder) {
+                            book.erase(i);
+                            break;
+                        }
+                    }
+                }
+
+                visited = 0;
+
+                for (const auto& level : book) {
+                    if (false == match(*level.second)) { break; }
+                }
+            }
+        }
+        const auto baseline = std::chrono::steady_clock::now();
+        {
+            OrderBook<Order> book(false);
+
+            for (const auto& event : events) {
+                if (event.add_) {
+                    auto& order = orders.at(event.transaction_);
+                    book.Insert(order.transaction_, order.price_, order);
+                } else {
+                    book.Remove(event.transaction_);
+                }
+
+                visited = 0;
+                book.ForEach(match);
+            }
+        }
+        const auto finish = std::chrono::steady_clock::now();
+        const auto before =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                baseline - start)
+                .count() /
+            size;
+        const auto after = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               finish - baseline)
+                               .count() /
+                           size;
+
+        std::cout << "depth: " << depth << " multimap: " << before
+                  << " ns/event order book: " << after
+                  << " ns/event checksum: " << checksum << std::endl;
+    }
+}
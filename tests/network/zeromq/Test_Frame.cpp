@@ -36,6 +36,33 @@ TEST(Frame, Factory3)
     ASSERT_STREQ("testString", messageString.c_str());
 }
 
+TEST(Frame, Factory4)
+{
+    std::string input(1024, 'x');
+    const void* buffer = input.data();
+
+    OTZMQFrame message = network::zeromq::Frame::Factory(std::move(input));
+
+    ASSERT_NE(nullptr, &message.get());
+    ASSERT_EQ(1024, message->size());
+    ASSERT_EQ(buffer, message->data());
+}
+
+TEST(Frame, clone)
+{
+    auto message = network::zeromq::Frame::Factory(std::string(1024, 'x'));
+    OTZMQFrame copy{message};
+
+    ASSERT_EQ(message->size(), copy->size());
+    ASSERT_EQ(message->data(), copy->data());
+
+    auto small = network::zeromq::Frame::Factory("testString");
+    OTZMQFrame smallCopy{small};
+    std::string copyString = smallCopy.get();
+
+    ASSERT_STREQ("testString", copyString.c_str());
+}
+
 TEST(Frame, operator_string)
 {
     auto message =
@@ -75,6 +102,16 @@ TEST(Frame, size)
     ASSERT_EQ(10, zmq_msg_size(zmq_msg));
 }
 
+TEST(Frame, View)
+{
+    auto message = network::zeromq::Frame::Factory("testString");
+    const auto view = message->View();
+
+    ASSERT_EQ(message->data(), view.data());
+    ASSERT_EQ(10, view.size());
+    ASSERT_EQ("testString", view);
+}
+
 TEST(Frame, zmq_msg_t)
 {
     auto message = network::zeromq::Frame::Factory();
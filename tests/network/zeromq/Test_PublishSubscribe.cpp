@@ -314,3 +314,56 @@ TEST_F(Test_PublishSubscribe, Publish_2_Subscribe_2)
     subscribeSocketThread1.join();
     subscribeSocketThread2.join();
 }
+
+TEST_F(Test_PublishSubscribe, Publish_Subscribe_Topic)
+{
+    ASSERT_NE(&Test_PublishSubscribe::context_.get(), nullptr);
+
+    auto publishSocket = network::zeromq::PublishSocket::Factory(
+        Test_PublishSubscribe::context_);
+
+    ASSERT_NE(nullptr, &publishSocket.get());
+
+    publishSocket->SetTimeouts(
+        std::chrono::milliseconds(0),
+        std::chrono::milliseconds(30000),
+        std::chrono::milliseconds(-1));
+    publishSocket->Start(endpoint_ + "/topic");
+
+    auto listenCallback = network::zeromq::ListenCallback::Factory(
+        [this](network::zeromq::Message& input) -> void {
+            const std::string& inputString = *input.Body().begin();
+            EXPECT_EQ(testMessage2_, inputString);
+            ++callbackFinishedCount_;
+        });
+
+    ASSERT_NE(nullptr, &listenCallback.get());
+
+    auto subscribeSocket = network::zeromq::SubscribeSocket::Factory(
+        Test_PublishSubscribe::context_, listenCallback);
+
+    ASSERT_NE(nullptr, &subscribeSocket.get());
+
+    subscribeSocket->SetTimeouts(
+        std::chrono::milliseconds(0),
+        std::chrono::milliseconds(-1),
+        std::chrono::milliseconds(30000));
+
+    ASSERT_TRUE(subscribeSocket->AddTopic(testMessage2_));
+
+    subscribeSocket->Start(endpoint_ + "/topic");
+
+    // Give the subscriber time to connect
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    ASSERT_TRUE(publishSocket->Publish(testMessage_));
+    ASSERT_TRUE(publishSocket->Publish(testMessage2_));
+
+    auto end = std::time(nullptr) + 30;
+    while (!callbackFinishedCount_ && std::time(nullptr) < end)
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    ASSERT_EQ(1, callbackFinishedCount_);
+}
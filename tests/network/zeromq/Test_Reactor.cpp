@@ -0,0 +1,237 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "opentxs/opentxs.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace opentxs;
+
+namespace
+{
+
+class Test_Reactor : public ::testing::Test
+{
+public:
+    static OTZMQContext context_;
+
+    const std::string testMessage_{"zeromq test message"};
+    const std::string testMessage2_{"zeromq test message 2"};
+
+    const std::string endpoint_{"inproc://opentxs/test/reactor_test"};
+    const std::string endpoint2_{"inproc://opentxs/test/reactor_test2"};
+
+    const int socketCount_{20};
+
+    std::atomic_int callbackFinishedCount_{0};
+
+    void wait(const int count, const int seconds) const;
+};
+
+OTZMQContext Test_Reactor::context_{network::zeromq::Context::Factory(2)};
+
+void Test_Reactor::wait(const int count, const int seconds) const
+{
+    auto end = std::time(nullptr) + seconds;
+
+    while ((count > callbackFinishedCount_) && std::time(nullptr) < end) {
+        Log::Sleep(std::chrono::milliseconds(100));
+    }
+}
+
+}  // namespace
+
+TEST_F(Test_Reactor, Publish_Subscribe_Many)
+{
+    ASSERT_NE(nullptr, &Test_Reactor::context_.get());
+
+    auto listenCallback = network::zeromq::ListenCallback::Factory(
+        [this](network::zeromq::Message& input) -> void {
+            EXPECT_EQ(1, input.size());
+            const std::string& inputString = *input.Body().begin();
+
+            EXPECT_EQ(testMessage_, inputString);
+
+            ++callbackFinishedCount_;
+        });
+
+    ASSERT_NE(nullptr, &listenCallback.get());
+
+    auto publishSocket =
+        network::zeromq::PublishSocket::Factory(Test_Reactor::context_);
+
+    ASSERT_NE(nullptr, &publishSocket.get());
+
+    publishSocket->SetTimeouts(
+        std::chrono::milliseconds(0),
+        std::chrono::milliseconds(30000),
+        std::chrono::milliseconds(-1));
+    publishSocket->Start(endpoint_);
+
+    std::vector<OTZMQSubscribeSocket> subscribeSockets{};
+
+    for (int i = 0; i < socketCount_; ++i) {
+        subscribeSockets.emplace_back(network::zeromq::SubscribeSocket::Factory(
+            Test_Reactor::context_, listenCallback));
+        auto& subscribeSocket = subscribeSockets.back();
+
+        ASSERT_NE(nullptr, &subscribeSocket.get());
+
+        subscribeSocket->SetTimeouts(
+            std::chrono::milliseconds(0),
+            std::chrono::milliseconds(-1),
+            std::chrono::milliseconds(30000));
+        subscribeSocket->Start(endpoint_);
+    }
+
+    // Give the subscribers time to connect
+    Log::Sleep(std::chrono::milliseconds(500));
+
+    auto sent = publishSocket->Publish(testMessage_);
+
+    ASSERT_TRUE(sent);
+
+    wait(socketCount_, 15);
+
+    ASSERT_EQ(socketCount_, callbackFinishedCount_);
+
+    // Half of the subscribers stop receiving once they are destroyed
+    subscribeSockets.erase(
+        subscribeSockets.begin() + (socketCount_ / 2), subscribeSockets.end());
+    sent = publishSocket->Publish(testMessage_);
+
+    ASSERT_TRUE(sent);
+
+    wait(socketCount_ + (socketCount_ / 2), 15);
+    Log::Sleep(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(socketCount_ + (socketCount_ / 2), callbackFinishedCount_);
+}
+
+TEST_F(Test_Reactor, Push_Pull_Many)
+{
+    ASSERT_NE(nullptr, &Test_Reactor::context_.get());
+
+    auto pullCallback = network::zeromq::ListenCallback::Factory(
+        [this](network::zeromq::Message& input) -> void {
+            EXPECT_EQ(1, input.size());
+            const std::string& inputString = *input.Body().begin();
+
+            EXPECT_EQ(testMessage_, inputString);
+
+            ++callbackFinishedCount_;
+        });
+
+    ASSERT_NE(nullptr, &pullCallback.get());
+
+    std::vector<OTZMQPullSocket> pullSockets{};
+    std::vector<OTZMQPushSocket> pushSockets{};
+
+    for (int i = 0; i < socketCount_; ++i) {
+        const auto endpoint = endpoint2_ + "/" + std::to_string(i);
+        pullSockets.emplace_back(network::zeromq::PullSocket::Factory(
+            Test_Reactor::context_, false, pullCallback));
+        auto& pullSocket = pullSockets.back();
+
+        ASSERT_NE(nullptr, &pullSocket.get());
+
+        pullSocket->SetTimeouts(
+            std::chrono::milliseconds(0),
+            std::chrono::milliseconds(30000),
+            std::chrono::milliseconds(-1));
+        pullSocket->Start(endpoint);
+        pushSockets.emplace_back(
+            network::zeromq::PushSocket::Factory(Test_Reactor::context_, true));
+        auto& pushSocket = pushSockets.back();
+
+        ASSERT_NE(nullptr, &pushSocket.get());
+
+        pushSocket->SetTimeouts(
+            std::chrono::milliseconds(0),
+            std::chrono::milliseconds(-1),
+            std::chrono::milliseconds(30000));
+        pushSocket->Start(endpoint);
+    }
+
+    for (auto& pushSocket : pushSockets) {
+        auto sent = pushSocket->Push(testMessage_);
+
+        ASSERT_TRUE(sent);
+    }
+
+    wait(socketCount_, 15);
+
+    ASSERT_EQ(socketCount_, callbackFinishedCount_);
+}
+
+TEST_F(Test_Reactor, Dealer_Router)
+{
+    ASSERT_NE(nullptr, &Test_Reactor::context_.get());
+
+    const network::zeromq::RouterSocket* router{nullptr};
+
+    auto routerCallback = network::zeromq::ListenCallback::Factory(
+        [this, &router](network::zeromq::Message& input) -> void {
+            EXPECT_EQ(3, input.size());
+            const std::string& inputString = *input.Body().begin();
+
+            EXPECT_EQ(testMessage_, inputString);
+
+            auto replyMessage = network::zeromq::Message::ReplyFactory(input);
+            replyMessage->AddFrame(testMessage2_);
+
+            ASSERT_NE(nullptr, router);
+
+            // Replies from inside the callback, on the reactor thread
+            router->Send(replyMessage);
+        });
+
+    ASSERT_NE(nullptr, &routerCallback.get());
+
+    auto routerSocket = network::zeromq::RouterSocket::Factory(
+        Test_Reactor::context_, false, routerCallback);
+
+    ASSERT_NE(nullptr, &routerSocket.get());
+
+    router = &routerSocket.get();
+    routerSocket->SetTimeouts(
+        std::chrono::milliseconds(0),
+        std::chrono::milliseconds(30000),
+        std::chrono::milliseconds(-1));
+    routerSocket->Start(endpoint_ + "/router");
+
+    auto dealerCallback = network::zeromq::ListenCallback::Factory(
+        [this](network::zeromq::Message& input) -> void {
+            EXPECT_EQ(2, input.size());
+            const std::string& inputString = *input.Body().begin();
+
+            EXPECT_EQ(testMessage2_, inputString);
+
+            ++callbackFinishedCount_;
+        });
+
+    ASSERT_NE(nullptr, &dealerCallback.get());
+
+    auto dealerSocket = network::zeromq::DealerSocket::Factory(
+        Test_Reactor::context_, true, dealerCallback);
+
+    ASSERT_NE(nullptr, &dealerSocket.get());
+
+    dealerSocket->SetTimeouts(
+        std::chrono::milliseconds(0),
+        std::chrono::milliseconds(-1),
+        std::chrono::milliseconds(30000));
+    dealerSocket->Start(endpoint_ + "/router");
+
+    for (int i = 0; i < socketCount_; ++i) {
+        auto sent = dealerSocket->Send(testMessage_);
+
+        ASSERT_TRUE(sent);
+    }
+
+    wait(socketCount_, 15);
+
+    ASSERT_EQ(socketCount_, callbackFinishedCount_);
+}
@@ -7,6 +7,10 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <future>
+#include <string>
+
 using namespace opentxs;
 
 #define CHEQUE_AMOUNT 144488
@@ -1702,7 +1706,7 @@ TEST_F(Test_Basic, getAccountData_after_cheque_deposited)
     EXPECT_FALSE(inbox->LoadBoxReceipt(number));
 }
 
-TEST_F(Test_Basic, getBoxReceipt_cheque_receipt)
+TEST_F(Test_Basic, getBoxReceipts_cheque_receipt)
 {
     const auto accountID = find_issuer_account();
     const RequestNumber sequence{15};
@@ -1732,6 +1736,84 @@ TEST_F(Test_Basic, getBoxReceipt_cheque_receipt)
 
     ASSERT_NE(0, number);
 
+    verify_state_pre(*clientContext, serverContext.It(), sequence);
+    const auto [requestNumber, transactionNumber, reply] =
+        client_1_.OTAPI().getBoxReceipts(
+            serverContext.It(), accountID, INBOX_TYPE, {});
+    const auto& [result, message] = reply;
+    verify_state_post(
+        client_1_,
+        *clientContext,
+        serverContext.It(),
+        sequence,
+        requestNumber,
+        transactionNumber,
+        result,
+        message,
+        SUCCESS,
+        NYMBOX_UPDATED,
+        NO_TRANSACTION,
+        0);
+
+    EXPECT_EQ(1, message->m_lTransactionNum);
+    EXPECT_FALSE(message->m_bBool);
+    ASSERT_EQ(1, message->m_Attachments.size());
+
+    std::set<TransactionNumber> numbers{};
+    NumList(String(message->m_ascPayload)).Output(numbers);
+
+    ASSERT_EQ(1, numbers.size());
+    EXPECT_EQ(number, *numbers.begin());
+
+    const auto clientAccount = client_1_.Wallet().Account(accountID);
+    std::unique_ptr<Ledger> inbox{
+        clientAccount.get().LoadInbox(*serverContext.It().Nym())};
+
+    ASSERT_TRUE(inbox);
+
+    const auto& transactionMap = inbox->GetTransactionMap();
+
+    ASSERT_EQ(1, transactionMap.size());
+    // The receipt which was attached to the reply has been saved
+    EXPECT_TRUE(inbox->LoadBoxReceipt(number));
+
+    const auto transaction = inbox->GetTransaction(number);
+
+    ASSERT_TRUE(transaction);
+    EXPECT_FALSE(transaction->IsAbbreviated());
+    EXPECT_EQ(transactionType::chequeReceipt, transaction->GetType());
+}
+
+TEST_F(Test_Basic, getBoxReceipt_cheque_receipt)
+{
+    const auto accountID = find_issuer_account();
+    const RequestNumber sequence{16};
+    auto serverContext =
+        client_1_.Wallet().mutable_ServerContext(alice_nym_id_, server_id_);
+    auto clientContext =
+        server_.Wallet().ClientContext(server_.NymID(), alice_nym_id_);
+
+    ASSERT_TRUE(clientContext);
+
+    TransactionNumber number{0};
+
+    {
+        const auto clientAccount = client_1_.Wallet().Account(accountID);
+
+        std::unique_ptr<Ledger> inbox{
+            clientAccount.get().LoadInbox(*serverContext.It().Nym())};
+
+        ASSERT_TRUE(inbox);
+
+        const auto& transactionMap = inbox->GetTransactionMap();
+
+        ASSERT_EQ(1, transactionMap.size());
+
+        number = {transactionMap.begin()->first};
+    }
+
+    ASSERT_NE(0, number);
+
     verify_state_pre(*clientContext, serverContext.It(), sequence);
     const auto [requestNumber, transactionNumber, reply] =
         client_1_.OTAPI().getBoxReceipt(
@@ -1767,7 +1849,7 @@ TEST_F(Test_Basic, getBoxReceipt_cheque_receipt)
 
 TEST_F(Test_Basic, getNymbox_after_cheque_deposited)
 {
-    const RequestNumber sequence{16};
+    const RequestNumber sequence{17};
     auto serverContext =
         client_1_.Wallet().mutable_ServerContext(alice_nym_id_, server_id_);
     auto clientContext =
@@ -1796,7 +1878,7 @@ TEST_F(Test_Basic, getNymbox_after_cheque_deposited)
 
 TEST_F(Test_Basic, processInbox)
 {
-    const RequestNumber sequence{17};
+    const RequestNumber sequence{18};
     auto serverContext =
         client_1_.Wallet().mutable_ServerContext(alice_nym_id_, server_id_);
     auto clientContext =
@@ -1872,7 +1954,7 @@ TEST_F(Test_Basic, processInbox)
 
 TEST_F(Test_Basic, getNymbox_after_processInbox)
 {
-    const RequestNumber sequence{18};
+    const RequestNumber sequence{19};
     auto serverContext =
         client_1_.Wallet().mutable_ServerContext(alice_nym_id_, server_id_);
     auto clientContext =
@@ -1898,4 +1980,99 @@ TEST_F(Test_Basic, getNymbox_after_processInbox)
         NO_TRANSACTION,
         0);
 }
+
+TEST_F(Test_Basic, getBoxReceipts_empty_inbox)
+{
+    const RequestNumber sequence{20};
+    const auto accountID = find_issuer_account();
+    auto serverContext =
+        client_1_.Wallet().mutable_ServerContext(alice_nym_id_, server_id_);
+    auto clientContext =
+        server_.Wallet().ClientContext(server_.NymID(), alice_nym_id_);
+
+    ASSERT_TRUE(clientContext);
+
+    verify_state_pre(*clientContext, serverContext.It(), sequence);
+    const auto [requestNumber, transactionNumber, reply] =
+        client_1_.OTAPI().getBoxReceipts(
+            serverContext.It(), accountID, INBOX_TYPE, {});
+    const auto& [result, message] = reply;
+    verify_state_post(
+        client_1_,
+        *clientContext,
+        serverContext.It(),
+        sequence,
+        requestNumber,
+        transactionNumber,
+        result,
+        message,
+        SUCCESS,
+        NYMBOX_SAME,
+        NO_TRANSACTION,
+        0);
+
+    EXPECT_EQ(0, message->m_lTransactionNum);
+    EXPECT_FALSE(message->m_bBool);
+    EXPECT_TRUE(message->m_Attachments.empty());
+}
+
+TEST_F(Test_Basic, remoteBoxUpdate_nymbox)
+{
+    const RequestNumber sequence{21};
+    auto serverContext =
+        client_1_.Wallet().mutable_ServerContext(alice_nym_id_, server_id_);
+    auto clientContext =
+        server_.Wallet().ClientContext(server_.NymID(), alice_nym_id_);
+
+    ASSERT_TRUE(clientContext);
+
+    // Bob subscribed to his boxes when his first request succeeded
+    ASSERT_TRUE(client_2_.ZMQ().Notifications(server_id_.str()));
+    EXPECT_NE(
+        0, client_2_.ZMQ().Subscription(server_id_.str(), bob_nym_id_->str()));
+
+    std::promise<std::string> promise{};
+    auto future = promise.get_future();
+    std::atomic<bool> received{false};
+    auto callback = network::zeromq::ListenCallback::Factory(
+        [&](const network::zeromq::Message& in) -> void {
+            const auto body = in.Body();
+
+            if (5 != body.size()) { return; }
+            if (server_id_.str() != std::string(body.at(0))) { return; }
+            if (bob_nym_id_->str() != std::string(body.at(1))) { return; }
+            if ("nymbox" != std::string(body.at(2))) { return; }
+            if (received.exchange(true)) { return; }
+
+            promise.set_value(std::string(body.at(4)));
+        });
+    auto subscriber = client_2_.ZMQ().Context().SubscribeSocket(callback);
+
+    ASSERT_TRUE(subscriber->Start(client_2_.Endpoints().RemoteBoxUpdate()));
+
+    Log::Sleep(std::chrono::milliseconds(100));
+    auto messageID = Identifier::Factory();
+    verify_state_pre(*clientContext, serverContext.It(), sequence);
+    const auto [requestNumber, transactionNumber, reply] =
+        client_1_.OTAPI().sendNymMessage(
+            serverContext.It(), bob_nym_id_, CHEQUE_MEMO, messageID);
+    const auto& [result, message] = reply;
+    verify_state_post(
+        client_1_,
+        *clientContext,
+        serverContext.It(),
+        sequence,
+        requestNumber,
+        transactionNumber,
+        result,
+        message,
+        SUCCESS,
+        NYMBOX_SAME,
+        NO_TRANSACTION,
+        0);
+
+    ASSERT_EQ(
+        std::future_status::ready, future.wait_for(std::chrono::seconds(30)));
+    EXPECT_FALSE(future.get().empty());
+}
 }  // namespace
@@ -0,0 +1,275 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "opentxs/opentxs.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+#define REQUEST_COUNT 10
+#define WORKER_THREADS "4"
+
+namespace
+{
+bool init_{false};
+
+class Test_Workers : public ::testing::Test
+{
+public:
+    static const opentxs::ArgList client_args_;
+    static const opentxs::ArgList server_args_;
+    static const OTIdentifier alice_nym_id_;
+    static const OTIdentifier bob_nym_id_;
+    static const OTIdentifier carol_nym_id_;
+
+    const opentxs::api::client::Manager& client_1_;
+    const opentxs::api::client::Manager& client_2_;
+    const opentxs::api::server::Manager& server_;
+    const Identifier& server_id_;
+
+    Test_Workers()
+        : client_1_(OT::App().StartClient(client_args_, 0))
+        , client_2_(OT::App().StartClient(client_args_, 1))
+        , server_(OT::App().StartServer(server_args_, 0, true))
+        , server_id_(server_.ID())
+    {
+        if (false == init_) { init(); }
+    }
+
+    void import_server_contract(
+        const ServerContract& contract,
+        const opentxs::api::client::Manager& client)
+    {
+        auto clientVersion = client.Wallet().Server(contract.PublicContract());
+
+        OT_ASSERT(clientVersion)
+
+        client.Sync().SetIntroductionServer(*clientVersion);
+    }
+
+    void init()
+    {
+        const auto seedA = client_1_.Exec().Wallet_ImportSeed(
+            "spike nominee miss inquiry fee nothing belt list other "
+            "daughter leave valley twelve gossip paper",
+            "");
+        const auto seedB = client_2_.Exec().Wallet_ImportSeed(
+            "trim thunder unveil reduce crop cradle zone inquiry "
+            "anchor skate property fringe obey butter text tank drama "
+            "palm guilt pudding laundry stay axis prosper",
+            "");
+        const_cast<OTIdentifier&>(alice_nym_id_) =
+            Identifier::Factory(client_1_.Exec().CreateNymHD(
+                proto::CITEMTYPE_INDIVIDUAL, "Alice", seedA, 0));
+        const_cast<OTIdentifier&>(bob_nym_id_) =
+            Identifier::Factory(client_2_.Exec().CreateNymHD(
+                proto::CITEMTYPE_INDIVIDUAL, "Bob", seedB, 0));
+        const_cast<OTIdentifier&>(carol_nym_id_) =
+            Identifier::Factory(client_1_.Exec().CreateNymHD(
+                proto::CITEMTYPE_INDIVIDUAL, "Carol", seedA, 1));
+        const auto contract = server_.Wallet().Server(server_id_);
+
+        OT_ASSERT(contract);
+        OT_ASSERT(false == server_id_.empty());
+
+        import_server_contract(*contract, client_1_);
+        import_server_contract(*contract, client_2_);
+
+        init_ = true;
+    }
+
+    static bool success(const CommandResult& result)
+    {
+        const auto& [status, message] = std::get<2>(result);
+
+        return (SendResult::VALID_REPLY == status) && bool(message) &&
+               message->m_bSuccess;
+    }
+
+    bool register_nym(
+        const opentxs::api::client::Manager& client,
+        const Identifier& nymID)
+    {
+        auto context = client.Wallet().mutable_ServerContext(nymID, server_id_);
+
+        return success(client.OTAPI().registerNym(context.It()));
+    }
+
+    int get_nymbox(
+        const opentxs::api::client::Manager& client,
+        const Identifier& nymID)
+    {
+        int output{0};
+
+        for (int i = 0; i < REQUEST_COUNT; ++i) {
+            auto context =
+                client.Wallet().mutable_ServerContext(nymID, server_id_);
+
+            if (success(client.OTAPI().getNymbox(context.It()))) { ++output; }
+        }
+
+        return output;
+    }
+
+    void verify_request_number(
+        const opentxs::api::client::Manager& client,
+        const Identifier& nymID)
+    {
+        const auto serverContext =
+            client.Wallet().ServerContext(nymID, server_id_);
+        const auto clientContext =
+            server_.Wallet().ClientContext(server_.NymID(), nymID);
+
+        ASSERT_TRUE(serverContext);
+        ASSERT_TRUE(clientContext);
+        EXPECT_EQ(serverContext->Request(), clientContext->Request());
+    }
+};
+
+const opentxs::ArgList Test_Workers::client_args_{
+    {{OPENTXS_ARG_STORAGE_PLUGIN, {"mem"}}}};
+const opentxs::ArgList Test_Workers::server_args_{
+    {{OPENTXS_ARG_STORAGE_PLUGIN, {"mem"}},
+     {OPENTXS_ARG_WORKERTHREADS, {WORKER_THREADS}}}};
+const OTIdentifier Test_Workers::alice_nym_id_{Identifier::Factory()};
+const OTIdentifier Test_Workers::bob_nym_id_{Identifier::Factory()};
+const OTIdentifier Test_Workers::carol_nym_id_{Identifier::Factory()};
+
+TEST_F(Test_Workers, registerNym_in_parallel)
+{
+    auto alice = std::async(std::launch::async, [&]() -> bool {
+        return register_nym(client_1_, alice_nym_id_);
+    });
+    auto bob = std::async(std::launch::async, [&]() -> bool {
+        return register_nym(client_2_, bob_nym_id_);
+    });
+
+    EXPECT_TRUE(alice.get());
+    EXPECT_TRUE(bob.get());
+
+    verify_request_number(client_1_, alice_nym_id_);
+    verify_request_number(client_2_, bob_nym_id_);
+}
+
+TEST_F(Test_Workers, getNymbox_in_parallel)
+{
+    auto alice = std::async(std::launch::async, [&]() -> int {
+        return get_nymbox(client_1_, alice_nym_id_);
+    });
+    auto bob = std::async(std::launch::async, [&]() -> int {
+        return get_nymbox(client_2_, bob_nym_id_);
+    });
+
+    EXPECT_EQ(REQUEST_COUNT, alice.get());
+    EXPECT_EQ(REQUEST_COUNT, bob.get());
+
+    verify_request_number(client_1_, alice_nym_id_);
+    verify_request_number(client_2_, bob_nym_id_);
+}
+
+// The notary rejects a request whose number is out of sequence, so every
+// request succeeds only if a nym's requests are processed in arrival order.
+TEST_F(Test_Workers, pipelined_requests_keep_their_order)
+{
+    std::vector<RequestNumber> numbers{};
+    std::vector<std::future<NetworkReplyMessage>> replies{};
+
+    {
+        auto context =
+            client_1_.Wallet().mutable_ServerContext(alice_nym_id_, server_id_);
+        auto& connection = context.It().Connection();
+
+        for (int i = 0; i < REQUEST_COUNT; ++i) {
+            auto [number, request] = context.It().InitializeServerCommand(
+                MessageType::getNymbox, -1);
+
+            ASSERT_TRUE(request);
+            ASSERT_TRUE(context.It().FinalizeServerCommand(*request));
+
+            numbers.push_back(number);
+            replies.emplace_back(connection.SendAsync(*request));
+        }
+    }
+
+    for (std::size_t i = 0; i < replies.size(); ++i) {
+        auto& future = replies.at(i);
+
+        ASSERT_EQ(
+            std::future_status::ready,
+            future.wait_for(std::chrono::seconds(30)));
+
+        const auto [status, reply] = future.get();
+
+        ASSERT_EQ(SendResult::VALID_REPLY, status);
+        ASSERT_TRUE(reply);
+        EXPECT_TRUE(reply->m_bSuccess);
+        EXPECT_EQ(numbers.at(i), reply->m_strRequestNum.ToLong());
+    }
+
+    verify_request_number(client_1_, alice_nym_id_);
+}
+
+// Every nym on a client shares that client's connection to the notary, so
+// each reply must reach the request it answers and not merely the next one.
+TEST_F(Test_Workers, outstanding_requests_from_several_nyms)
+{
+    ASSERT_TRUE(register_nym(client_1_, carol_nym_id_));
+
+    std::vector<std::string> nyms{};
+    std::vector<RequestNumber> numbers{};
+    std::vector<std::future<NetworkReplyMessage>> replies{};
+
+    {
+        auto alice =
+            client_1_.Wallet().mutable_ServerContext(alice_nym_id_, server_id_);
+        auto carol =
+            client_1_.Wallet().mutable_ServerContext(carol_nym_id_, server_id_);
+        auto& connection = alice.It().Connection();
+
+        ASSERT_EQ(&connection, &carol.It().Connection());
+
+        for (int i = 0; i < 2 * REQUEST_COUNT; ++i) {
+            const bool first = (0 == i % 2);
+            auto& context = first ? alice.It() : carol.It();
+            auto [number, request] =
+                context.InitializeServerCommand(MessageType::getNymbox, -1);
+
+            ASSERT_TRUE(request);
+            ASSERT_TRUE(context.FinalizeServerCommand(*request));
+
+            nyms.emplace_back((first ? alice_nym_id_ : carol_nym_id_)->str());
+            numbers.push_back(number);
+            replies.emplace_back(connection.SendAsync(*request));
+        }
+    }
+
+    // Wait for the replies in reverse order
+    for (std::size_t i = replies.size(); 0 < i--;) {
+        auto& future = replies.at(i);
+
+        ASSERT_EQ(
+            std::future_status::ready,
+            future.wait_for(std::chrono::seconds(30)));
+
+        const auto [status, reply] = future.get();
+
+        ASSERT_EQ(SendResult::VALID_REPLY, status);
+        ASSERT_TRUE(reply);
+        EXPECT_TRUE(reply->m_bSuccess);
+        EXPECT_EQ(nyms.at(i), reply->m_strNymID.Get());
+        EXPECT_EQ(numbers.at(i), reply->m_strRequestNum.ToLong());
+    }
+
+    verify_request_number(client_1_, alice_nym_id_);
+    verify_request_number(client_1_, carol_nym_id_);
+}
+}  // namespace
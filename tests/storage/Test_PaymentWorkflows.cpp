@@ -0,0 +1,358 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "opentxs/opentxs.hpp"
+
+#include "api/storage/StorageInternal.hpp"
+#include "storage/StorageConfig.hpp"
+#include "Internal.hpp"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+#if OT_STORAGE_FS
+namespace
+{
+// Two sealed chunks plus the workflows still held in the index
+const int workflow_count{250};
+
+class Test_PaymentWorkflows : public ::testing::Test
+{
+public:
+    const opentxs::api::client::Manager& client_;
+    const std::string folder_;
+    const std::string nym_;
+    const std::string account_;
+    const std::string other_account_;
+    const std::string unit_;
+    const std::string other_unit_;
+    OTFlag running_;
+    std::unique_ptr<api::Settings> settings_;
+    StorageConfig config_;
+    std::unique_ptr<api::storage::StorageInternal> storage_;
+
+    // Matches the workflow written for a new outgoing cheque
+    static proto::PaymentWorkflow cheque(
+        const std::string& account,
+        const std::string& unit)
+    {
+        const auto id = Identifier::Random()->str();
+        proto::PaymentWorkflow workflow{};
+        workflow.set_version(1);
+        workflow.set_id(id);
+        workflow.set_type(proto::PAYMENTWORKFLOWTYPE_OUTGOINGCHEQUE);
+        workflow.set_state(proto::PAYMENTWORKFLOWSTATE_UNSENT);
+        auto& source = *workflow.add_source();
+        source.set_version(1);
+        source.set_id(Identifier::Random()->str());
+        source.set_revision(1);
+        source.set_item("cheque " + id);
+        workflow.set_notary(unit);
+        auto& event = *workflow.add_event();
+        event.set_version(1);
+        event.set_type(proto::PAYMENTEVENTTYPE_CREATE);
+        event.set_time(std::time(nullptr));
+        event.set_method(proto::TRANSPORTMETHOD_NONE);
+        event.set_success(true);
+        workflow.add_unit(unit);
+        workflow.add_account(account);
+
+        return workflow;
+    }
+
+    // Matches the update written when a cheque is sent out of band
+    static void convey(proto::PaymentWorkflow& workflow)
+    {
+        workflow.set_state(proto::PAYMENTWORKFLOWSTATE_CONVEYED);
+        auto& event = *workflow.add_event();
+        event.set_version(1);
+        event.set_type(proto::PAYMENTEVENTTYPE_CONVEY);
+        event.set_time(std::time(nullptr));
+        event.set_method(proto::TRANSPORTMETHOD_OOB);
+        event.set_success(true);
+    }
+
+    std::string add(
+        const std::string& account,
+        const std::string& unit,
+        std::vector<proto::PaymentWorkflow>* stored = nullptr)
+    {
+        const auto workflow = cheque(account, unit);
+
+        EXPECT_TRUE(storage_->Store(nym_, workflow));
+
+        if (nullptr != stored) { stored->emplace_back(workflow); }
+
+        return workflow.id();
+    }
+
+    std::vector<std::string> unsent(const std::string& account) const
+    {
+        return storage_->PaymentWorkflowsByAccount(
+            nym_,
+            account,
+            proto::PAYMENTWORKFLOWTYPE_OUTGOINGCHEQUE,
+            proto::PAYMENTWORKFLOWSTATE_UNSENT);
+    }
+
+    std::vector<std::string> conveyed(const std::string& account) const
+    {
+        return storage_->PaymentWorkflowsByAccount(
+            nym_,
+            account,
+            proto::PAYMENTWORKFLOWTYPE_OUTGOINGCHEQUE,
+            proto::PAYMENTWORKFLOWSTATE_CONVEYED);
+    }
+
+    std::set<std::string> by_state(
+        const proto::PaymentWorkflowState state) const
+    {
+        return storage_->PaymentWorkflowsByState(
+            nym_, proto::PAYMENTWORKFLOWTYPE_OUTGOINGCHEQUE, state);
+    }
+
+    // Every workflow is written and then read back by a new storage instance
+    void reopen()
+    {
+        storage_.reset();
+        config_ = StorageConfig{};
+        auto encrypted = String::Factory();
+        storage_.reset(Factory::Storage(
+            running_,
+            client_.Crypto(),
+            *settings_,
+            folder_,
+            String(OT_STORAGE_PRIMARY_PLUGIN_FS),
+            String(""),
+            std::chrono::seconds(0),
+            encrypted,
+            config_));
+
+        ASSERT_TRUE(storage_);
+
+        storage_->start();
+        // Loads the nym
+        storage_->ThreadList(nym_, false);
+    }
+
+    Test_PaymentWorkflows()
+        : client_(OT::App().StartClient(
+              {{OPENTXS_ARG_STORAGE_PLUGIN, {OT_STORAGE_PRIMARY_PLUGIN_MEMDB}}},
+              0))
+        , folder_((boost::filesystem::temp_directory_path() /
+                   boost::filesystem::unique_path())
+                      .string())
+        , nym_(Identifier::Random()->str())
+        , account_(Identifier::Random()->str())
+        , other_account_(Identifier::Random()->str())
+        , unit_(Identifier::Random()->str())
+        , other_unit_(Identifier::Random()->str())
+        , running_(Flag::Factory(true))
+        , settings_()
+        , config_()
+        , storage_()
+    {
+        boost::filesystem::create_directories(folder_);
+        settings_.reset(
+            Factory::Settings(String((folder_ + "/storage.cfg").c_str())));
+        reopen();
+        // Creates the nym
+        const auto thread = Identifier::Random()->str();
+        storage_->CreateThread(nym_, thread, {thread});
+    }
+
+    ~Test_PaymentWorkflows()
+    {
+        storage_.reset();
+        settings_.reset();
+        boost::system::error_code ec{};
+        boost::filesystem::remove_all(folder_, ec);
+    }
+};
+}  // namespace
+
+TEST_F(Test_PaymentWorkflows, list_by_account_most_recent_first)
+{
+    std::vector<proto::PaymentWorkflow> stored{};
+
+    for (int i = 0; i < 5; ++i) { add(account_, unit_, &stored); }
+
+    add(other_account_, unit_);
+    std::vector<std::string> expected{};
+
+    for (auto it = stored.crbegin(); it != stored.crend(); ++it) {
+        expected.emplace_back(it->id());
+    }
+
+    EXPECT_EQ(expected, unsent(account_));
+    EXPECT_EQ(1, unsent(other_account_).size());
+    EXPECT_TRUE(conveyed(account_).empty());
+
+    // Storing a workflow again makes it the most recent
+    auto& oldest = stored.front();
+
+    ASSERT_TRUE(storage_->Store(nym_, oldest));
+
+    expected.pop_back();
+    expected.insert(expected.begin(), oldest.id());
+
+    EXPECT_EQ(expected, unsent(account_));
+
+    // A workflow which changes state moves to the list for the new state
+    auto& middle = stored.at(2);
+    convey(middle);
+
+    ASSERT_TRUE(storage_->Store(nym_, middle));
+
+    expected.erase(std::find(expected.begin(), expected.end(), middle.id()));
+
+    EXPECT_EQ(expected, unsent(account_));
+    EXPECT_EQ(std::vector<std::string>{middle.id()}, conveyed(account_));
+
+    reopen();
+
+    EXPECT_EQ(expected, unsent(account_));
+    EXPECT_EQ(std::vector<std::string>{middle.id()}, conveyed(account_));
+}
+
+TEST_F(Test_PaymentWorkflows, unit_and_state_indices)
+{
+    std::vector<proto::PaymentWorkflow> stored{};
+    const auto first = add(account_, unit_, &stored);
+    const auto second = add(account_, other_unit_, &stored);
+    const auto third = add(other_account_, unit_, &stored);
+
+    EXPECT_EQ(
+        std::set<std::string>({first, third}),
+        storage_->PaymentWorkflowsByUnit(nym_, unit_));
+    EXPECT_EQ(
+        std::set<std::string>({second}),
+        storage_->PaymentWorkflowsByUnit(nym_, other_unit_));
+    EXPECT_EQ(
+        std::set<std::string>({first, second}),
+        storage_->PaymentWorkflowsByAccount(nym_, account_));
+    EXPECT_EQ(
+        std::set<std::string>({first, second, third}),
+        by_state(proto::PAYMENTWORKFLOWSTATE_UNSENT));
+    EXPECT_TRUE(by_state(proto::PAYMENTWORKFLOWSTATE_CONVEYED).empty());
+
+    convey(stored.at(1));
+
+    ASSERT_TRUE(storage_->Store(nym_, stored.at(1)));
+    EXPECT_EQ(
+        std::set<std::string>({first, third}),
+        by_state(proto::PAYMENTWORKFLOWSTATE_UNSENT));
+    EXPECT_EQ(
+        std::set<std::string>({second}),
+        by_state(proto::PAYMENTWORKFLOWSTATE_CONVEYED));
+
+    const auto [type, state] = storage_->PaymentWorkflowState(nym_, second);
+
+    EXPECT_EQ(proto::PAYMENTWORKFLOWTYPE_OUTGOINGCHEQUE, type);
+    EXPECT_EQ(proto::PAYMENTWORKFLOWSTATE_CONVEYED, state);
+
+    // A deleted workflow is removed from every index
+    ASSERT_TRUE(storage_->DeletePaymentWorkflow(nym_, first));
+    EXPECT_EQ(
+        std::set<std::string>({third}),
+        storage_->PaymentWorkflowsByUnit(nym_, unit_));
+    EXPECT_EQ(
+        std::set<std::string>({second}),
+        storage_->PaymentWorkflowsByAccount(nym_, account_));
+    EXPECT_EQ(
+        std::set<std::string>({third}),
+        by_state(proto::PAYMENTWORKFLOWSTATE_UNSENT));
+    EXPECT_TRUE(
+        storage_->PaymentWorkflowLookup(nym_, stored.at(0).source(0).id())
+            .empty());
+    EXPECT_EQ(
+        second,
+        storage_->PaymentWorkflowLookup(nym_, stored.at(1).source(0).id()));
+
+    reopen();
+
+    EXPECT_EQ(
+        std::set<std::string>({third}),
+        storage_->PaymentWorkflowsByUnit(nym_, unit_));
+    EXPECT_EQ(
+        std::set<std::string>({second}),
+        by_state(proto::PAYMENTWORKFLOWSTATE_CONVEYED));
+    EXPECT_EQ(2, storage_->PaymentWorkflowList(nym_).size());
+}
+
+TEST_F(Test_PaymentWorkflows, chunks_are_sealed_and_reloaded)
+{
+    std::vector<proto::PaymentWorkflow> stored{};
+
+    for (int i = 0; i < workflow_count; ++i) { add(account_, unit_, &stored); }
+
+    std::vector<std::string> expected{};
+
+    for (auto it = stored.crbegin(); it != stored.crend(); ++it) {
+        expected.emplace_back(it->id());
+    }
+
+    EXPECT_EQ(expected, unsent(account_));
+
+    reopen();
+
+    EXPECT_EQ(expected, unsent(account_));
+    EXPECT_EQ(workflow_count, storage_->PaymentWorkflowList(nym_).size());
+
+    for (const auto& workflow : stored) {
+        std::shared_ptr<proto::PaymentWorkflow> loaded;
+
+        ASSERT_TRUE(storage_->Load(nym_, workflow.id(), loaded));
+        EXPECT_EQ(workflow.id(), loaded->id());
+        EXPECT_EQ(
+            workflow.id(),
+            storage_->PaymentWorkflowLookup(nym_, workflow.source(0).id()));
+    }
+
+    // An update to a sealed workflow replaces its record in the chunk
+    auto& sealed = stored.at(10);
+    convey(sealed);
+
+    ASSERT_TRUE(storage_->Store(nym_, sealed));
+
+    expected.erase(std::find(expected.begin(), expected.end(), sealed.id()));
+    reopen();
+
+    EXPECT_EQ(expected, unsent(account_));
+    EXPECT_EQ(std::vector<std::string>{sealed.id()}, conveyed(account_));
+
+    // Deleting a sealed workflow rewrites the chunks without it
+    const auto deleted = stored.at(20).id();
+
+    ASSERT_TRUE(storage_->DeletePaymentWorkflow(nym_, deleted));
+
+    expected.erase(std::find(expected.begin(), expected.end(), deleted));
+    reopen();
+
+    EXPECT_EQ(expected, unsent(account_));
+    EXPECT_EQ(workflow_count - 1, storage_->PaymentWorkflowList(nym_).size());
+
+    const auto [type, state] = storage_->PaymentWorkflowState(nym_, deleted);
+
+    EXPECT_EQ(proto::PAYMENTWORKFLOWTYPE_ERROR, type);
+    EXPECT_EQ(proto::PAYMENTWORKFLOWSTATE_ERROR, state);
+
+    // New workflows still link to the rewritten chunks
+    expected.insert(expected.begin(), add(account_, unit_));
+    reopen();
+
+    EXPECT_EQ(expected, unsent(account_));
+}
+#endif
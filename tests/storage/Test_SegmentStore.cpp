@@ -0,0 +1,236 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "opentxs/opentxs.hpp"
+
+#include "storage/drivers/SegmentStore.hpp"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <string>
+
+#if OT_STORAGE_FS
+using SegmentStore = opentxs::storage::implementation::SegmentStore;
+
+namespace
+{
+// Five of the objects below fill a segment
+const std::uint64_t segment_size{512};
+
+class Test_SegmentStore : public ::testing::Test
+{
+public:
+    const std::string folder_;
+
+    static std::string key(const int i) { return "key-" + std::to_string(i); }
+
+    static std::string value(const int i)
+    {
+        return std::string(100, static_cast<char>('a' + (i % 26))) +
+               std::to_string(i);
+    }
+
+    std::set<std::string> keys(const SegmentStore& store) const
+    {
+        std::set<std::string> output{};
+        store.Keys(
+            [&](const std::string& key) -> void { output.emplace(key); });
+
+        return output;
+    }
+
+    bool loads(const SegmentStore& store, const int i) const
+    {
+        std::string loaded{};
+
+        if (false == store.Load(key(i), loaded)) { return false; }
+
+        return value(i) == loaded;
+    }
+
+    std::unique_ptr<SegmentStore> open(const bool compress = false) const
+    {
+        return std::make_unique<SegmentStore>(
+            folder_, compress, nullptr, nullptr, segment_size);
+    }
+
+    std::string segment(const std::uint32_t number) const
+    {
+        char name[9]{};
+        std::snprintf(name, sizeof(name), "%08x", number);
+
+        return folder_ + "/" + name + ".seg";
+    }
+
+    std::size_t segments() const
+    {
+        std::size_t output{0};
+        boost::filesystem::directory_iterator it(folder_);
+        const boost::filesystem::directory_iterator end{};
+
+        for (; end != it; ++it) {
+            if (".seg" == it->path().extension().string()) { ++output; }
+        }
+
+        return output;
+    }
+
+    Test_SegmentStore()
+        : folder_((boost::filesystem::temp_directory_path() /
+                   boost::filesystem::unique_path())
+                      .string())
+    {
+    }
+
+    ~Test_SegmentStore()
+    {
+        boost::system::error_code ec{};
+        boost::filesystem::remove_all(folder_, ec);
+    }
+};
+}  // namespace
+
+TEST_F(Test_SegmentStore, store_and_reload)
+{
+    {
+        auto store = open();
+
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_TRUE(store->Store(key(i), value(i)));
+        }
+
+        EXPECT_TRUE(loads(*store, 3));
+    }
+
+    auto store = open();
+
+    EXPECT_EQ(10, keys(*store).size());
+
+    for (int i = 0; i < 10; ++i) { EXPECT_TRUE(loads(*store, i)); }
+}
+
+TEST_F(Test_SegmentStore, store_and_reload_compressed)
+{
+    {
+        auto store = open(true);
+
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_TRUE(store->Store(key(i), value(i)));
+        }
+    }
+
+    // Each segment records its own compression setting
+    auto store = open(false);
+
+    for (int i = 0; i < 10; ++i) { EXPECT_TRUE(loads(*store, i)); }
+}
+
+TEST_F(Test_SegmentStore, erase)
+{
+    {
+        auto store = open();
+
+        for (int i = 0; i < 5; ++i) {
+            ASSERT_TRUE(store->Store(key(i), value(i)));
+        }
+
+        ASSERT_TRUE(store->Erase({key(1), key(3)}));
+        EXPECT_FALSE(loads(*store, 1));
+        EXPECT_FALSE(loads(*store, 3));
+        EXPECT_EQ(3, keys(*store).size());
+    }
+
+    auto store = open();
+
+    EXPECT_EQ(3, keys(*store).size());
+    EXPECT_TRUE(loads(*store, 0));
+    EXPECT_FALSE(loads(*store, 1));
+    EXPECT_TRUE(loads(*store, 2));
+    EXPECT_FALSE(loads(*store, 3));
+    EXPECT_TRUE(loads(*store, 4));
+
+    // An erased object can be stored again
+    ASSERT_TRUE(store->Store(key(1), value(1)));
+    EXPECT_TRUE(loads(*store, 1));
+}
+
+TEST_F(Test_SegmentStore, compaction_across_segments)
+{
+    {
+        auto store = open();
+
+        for (int i = 0; i < 20; ++i) {
+            ASSERT_TRUE(store->Store(key(i), value(i)));
+        }
+
+        ASSERT_LT(3, segments());
+        ASSERT_TRUE(boost::filesystem::exists(segment(1)));
+        ASSERT_TRUE(boost::filesystem::exists(segment(2)));
+
+        // Leaves one live object in each of the first two segments
+        ASSERT_TRUE(store->Erase({key(0),
+                                  key(1),
+                                  key(2),
+                                  key(3),
+                                  key(5),
+                                  key(6),
+                                  key(7),
+                                  key(8)}));
+
+        EXPECT_FALSE(boost::filesystem::exists(segment(1)));
+        EXPECT_FALSE(boost::filesystem::exists(segment(2)));
+        EXPECT_EQ(12, keys(*store).size());
+        EXPECT_TRUE(loads(*store, 4));
+        EXPECT_TRUE(loads(*store, 9));
+    }
+
+    auto store = open();
+
+    EXPECT_EQ(12, keys(*store).size());
+
+    for (int i = 0; i < 20; ++i) {
+        const bool erased = (i < 9) && (4 != i);
+
+        EXPECT_EQ(false == erased, loads(*store, i)) << key(i);
+    }
+}
+
+TEST_F(Test_SegmentStore, truncated_last_record)
+{
+    {
+        auto store = open();
+
+        ASSERT_TRUE(store->Store(key(0), value(0)));
+        ASSERT_TRUE(store->Store(key(1), value(1)));
+    }
+
+    // Simulates a crash part way through appending the second object
+    const auto path = segment(1);
+    const auto size = boost::filesystem::file_size(path);
+    boost::filesystem::resize_file(path, size - 10);
+
+    {
+        auto store = open();
+
+        EXPECT_TRUE(loads(*store, 0));
+        EXPECT_FALSE(loads(*store, 1));
+        EXPECT_EQ(1, keys(*store).size());
+        ASSERT_TRUE(store->Store(key(2), value(2)));
+    }
+
+    auto store = open();
+
+    EXPECT_TRUE(loads(*store, 0));
+    EXPECT_FALSE(loads(*store, 1));
+    EXPECT_TRUE(loads(*store, 2));
+    ASSERT_TRUE(store->Store(key(1), value(1)));
+    EXPECT_TRUE(loads(*store, 1));
+}
+#endif  // OT_STORAGE_FS
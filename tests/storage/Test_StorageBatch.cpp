@@ -0,0 +1,199 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "opentxs/opentxs.hpp"
+
+#include "storage/StorageConfig.hpp"
+#include "Internal.hpp"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+
+using namespace opentxs;
+
+namespace
+{
+class Test_StorageBatch : public ::testing::Test
+{
+public:
+    const opentxs::api::client::Manager& client_;
+    const std::string folder_;
+    OTFlag bucket_;
+    StorageConfig config_;
+    std::atomic<int> counter_;
+    const Digest digest_;
+    const Random random_;
+
+    static std::string value(const int i)
+    {
+        return "object-" + std::to_string(i);
+    }
+
+    static bool digest(
+        const std::uint32_t,
+        const std::string& value,
+        std::string& key)
+    {
+        key = std::to_string(std::hash<std::string>{}(value));
+
+        return true;
+    }
+
+    static bool in_primary(
+        api::storage::Multiplex& multiplex,
+        const std::string& key)
+    {
+        std::string loaded{};
+
+        return multiplex.Primary().Load(key, true, loaded);
+    }
+
+    std::unique_ptr<api::storage::Multiplex> open(const std::string& primary)
+    {
+        return std::unique_ptr<api::storage::Multiplex>(
+            Factory::StorageMultiplex(
+                client_.Storage(),
+                bucket_,
+                config_,
+                String(primary.c_str()),
+                false,
+                String(""),
+                digest_,
+                random_));
+    }
+
+    Test_StorageBatch()
+        : client_(OT::App().StartClient(
+              {{OPENTXS_ARG_STORAGE_PLUGIN, {OT_STORAGE_PRIMARY_PLUGIN_MEMDB}}},
+              0))
+        , folder_((boost::filesystem::temp_directory_path() /
+                   boost::filesystem::unique_path())
+                      .string())
+        , bucket_(Flag::Factory(false))
+        , config_()
+        , counter_(0)
+        , digest_(&Test_StorageBatch::digest)
+        , random_([this]() -> std::string {
+            return "random-" + std::to_string(++counter_);
+        })
+    {
+        config_.path_ = folder_;
+        boost::filesystem::create_directories(folder_);
+    }
+
+    ~Test_StorageBatch()
+    {
+        boost::system::error_code ec{};
+        boost::filesystem::remove_all(folder_, ec);
+    }
+};
+}  // namespace
+
+TEST_F(Test_StorageBatch, objects_wait_for_commit)
+{
+    auto multiplex = open(OT_STORAGE_PRIMARY_PLUGIN_MEMDB);
+
+    ASSERT_TRUE(multiplex);
+
+    const auto before = multiplex->Primary().LoadRoot();
+    std::string key{};
+    std::string loaded{};
+    multiplex->StartBatch();
+
+    ASSERT_TRUE(multiplex->Store(true, value(0), key));
+    EXPECT_TRUE(multiplex->Load(key, false, loaded));
+    EXPECT_EQ(value(0), loaded);
+    EXPECT_FALSE(in_primary(*multiplex, key));
+    ASSERT_TRUE(multiplex->StoreRoot(true, "root-1"));
+    EXPECT_EQ(before, multiplex->Primary().LoadRoot());
+
+    ASSERT_TRUE(multiplex->CommitBatch());
+    EXPECT_TRUE(in_primary(*multiplex, key));
+    EXPECT_EQ("root-1", multiplex->Primary().LoadRoot());
+    EXPECT_FALSE(multiplex->CommitBatch());
+}
+
+TEST_F(Test_StorageBatch, release)
+{
+    auto multiplex = open(OT_STORAGE_PRIMARY_PLUGIN_MEMDB);
+
+    ASSERT_TRUE(multiplex);
+
+    std::string shared{};
+    std::string replaced{};
+    multiplex->StartBatch();
+
+    // Two nodes refer to the first object, one to the second
+    ASSERT_TRUE(multiplex->Store(true, value(1), shared));
+    ASSERT_TRUE(multiplex->Store(true, value(1), shared));
+    ASSERT_TRUE(multiplex->Store(true, value(2), replaced));
+
+    multiplex->Release(shared);
+    multiplex->Release(replaced);
+    // Releasing an object which is not pending has no effect
+    multiplex->Release("not-pending");
+
+    ASSERT_TRUE(multiplex->CommitBatch());
+    EXPECT_TRUE(in_primary(*multiplex, shared));
+    EXPECT_FALSE(in_primary(*multiplex, replaced));
+}
+
+#if OT_STORAGE_FS
+TEST_F(Test_StorageBatch, failed_commit_is_retried)
+{
+    auto multiplex = open(OT_STORAGE_PRIMARY_PLUGIN_FS);
+
+    ASSERT_TRUE(multiplex);
+
+    const auto bucket = folder_ + "/" + config_.fs_primary_bucket_;
+    const auto before = multiplex->Primary().LoadRoot();
+    std::string key{};
+    std::string loaded{};
+    multiplex->StartBatch();
+
+    ASSERT_TRUE(multiplex->Store(true, value(3), key));
+    ASSERT_TRUE(multiplex->StoreRoot(true, "root-1"));
+
+    // Objects can not be written while their bucket is missing
+    boost::filesystem::remove_all(bucket);
+
+    EXPECT_FALSE(multiplex->CommitBatch());
+    EXPECT_TRUE(multiplex->Load(key, false, loaded));
+    EXPECT_EQ(value(3), loaded);
+    EXPECT_EQ(before, multiplex->Primary().LoadRoot());
+
+    // The next root is held back until the left over object is written
+    EXPECT_FALSE(multiplex->StoreRoot(true, "root-2"));
+    EXPECT_EQ(before, multiplex->Primary().LoadRoot());
+
+    ASSERT_TRUE(boost::filesystem::create_directory(bucket));
+    ASSERT_TRUE(multiplex->StoreRoot(true, "root-3"));
+    EXPECT_TRUE(in_primary(*multiplex, key));
+    EXPECT_EQ("root-3", multiplex->Primary().LoadRoot());
+}
+#endif
+
+TEST_F(Test_StorageBatch, nested_batches)
+{
+    const auto& storage = client_.Storage();
+
+    storage.StartBatch();
+    storage.StartBatch();
+
+    // Only the outermost commit writes anything
+    EXPECT_TRUE(storage.CommitBatch());
+    EXPECT_TRUE(storage.CommitBatch());
+    EXPECT_FALSE(storage.CommitBatch());
+
+    // Garbage collection is skipped, rather than deferred, during a batch
+    storage.StartBatch();
+    storage.RunGC();
+    EXPECT_TRUE(storage.CommitBatch());
+}
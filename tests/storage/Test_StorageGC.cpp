@@ -0,0 +1,353 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "opentxs/opentxs.hpp"
+
+#include "api/storage/StorageInternal.hpp"
+#include "storage/StorageConfig.hpp"
+#include "Internal.hpp"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace opentxs;
+
+#if OT_STORAGE_FS
+namespace
+{
+// Enough thread items and workflows to fill two chunks of each
+const int object_count{250};
+
+class Test_StorageGC : public ::testing::Test
+{
+public:
+    const opentxs::api::client::Manager& client_;
+    const std::string folder_;
+    const std::string nym_;
+    const std::string thread_;
+    const std::string account_;
+    const std::string unit_;
+    OTFlag running_;
+    std::unique_ptr<api::Settings> settings_;
+    StorageConfig config_;
+    std::unique_ptr<api::storage::StorageInternal> storage_;
+    std::vector<std::string> workflows_;
+
+    static std::string item(const int i)
+    {
+        char id[16]{};
+        std::snprintf(id, sizeof(id), "item-%03d", i);
+
+        return id;
+    }
+
+    static bool digest(
+        const std::uint32_t,
+        const std::string& value,
+        std::string& key)
+    {
+        key = std::to_string(std::hash<std::string>{}(value));
+
+        return true;
+    }
+
+    static bool in_primary(
+        api::storage::Multiplex& multiplex,
+        const std::string& key)
+    {
+        std::string loaded{};
+
+        return multiplex.Primary().Load(key, true, loaded);
+    }
+
+    void add(const int i)
+    {
+        ASSERT_TRUE(storage_->Store(
+            nym_,
+            thread_,
+            item(i),
+            i,
+            "",
+            "",
+            StorageBox::INCOMINGCHEQUE));
+    }
+
+    // Matches the workflow written for a new outgoing cheque
+    void add_workflow()
+    {
+        const auto id = Identifier::Random()->str();
+        proto::PaymentWorkflow workflow{};
+        workflow.set_version(1);
+        workflow.set_id(id);
+        workflow.set_type(proto::PAYMENTWORKFLOWTYPE_OUTGOINGCHEQUE);
+        workflow.set_state(proto::PAYMENTWORKFLOWSTATE_UNSENT);
+        auto& source = *workflow.add_source();
+        source.set_version(1);
+        source.set_id(Identifier::Random()->str());
+        source.set_revision(1);
+        source.set_item("cheque " + id);
+        workflow.set_notary(unit_);
+        auto& event = *workflow.add_event();
+        event.set_version(1);
+        event.set_type(proto::PAYMENTEVENTTYPE_CREATE);
+        event.set_time(std::time(nullptr));
+        event.set_method(proto::TRANSPORTMETHOD_NONE);
+        event.set_success(true);
+        workflow.add_unit(unit_);
+        workflow.add_account(account_);
+
+        ASSERT_TRUE(storage_->Store(nym_, workflow));
+
+        workflows_.emplace_back(id);
+    }
+
+    // Waits for the collection started by RunGC by closing the storage
+    void collect()
+    {
+        // The collection interval is one second
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+        storage_->RunGC();
+        reopen();
+    }
+
+    std::size_t files() const
+    {
+        std::size_t output{0};
+        boost::system::error_code ec{};
+        boost::filesystem::recursive_directory_iterator it(folder_, ec);
+        const boost::filesystem::recursive_directory_iterator end{};
+
+        for (; (false == bool(ec)) && (end != it); it.increment(ec)) {
+            const auto& path = it->path();
+
+            if (config_.fs_primary_bucket_ !=
+                path.parent_path().filename().string()) {
+                continue;
+            }
+
+            if (boost::filesystem::is_regular_file(path)) { ++output; }
+        }
+
+        return output;
+    }
+
+    std::vector<std::string> items() const
+    {
+        std::shared_ptr<proto::StorageThread> thread;
+        std::vector<std::string> output{};
+
+        if (false == storage_->Load(nym_, thread_, thread)) { return output; }
+
+        for (const auto& it : thread->item()) { output.emplace_back(it.id()); }
+
+        return output;
+    }
+
+    std::unique_ptr<api::storage::Multiplex> open_multiplex(
+        const Flag& bucket,
+        const StorageConfig& config) const
+    {
+        return std::unique_ptr<api::storage::Multiplex>(
+            Factory::StorageMultiplex(
+                client_.Storage(),
+                bucket,
+                config,
+                String(OT_STORAGE_PRIMARY_PLUGIN_MEMDB),
+                false,
+                String(""),
+                &Test_StorageGC::digest,
+                []() -> std::string { return "random"; }));
+    }
+
+    void reopen()
+    {
+        storage_.reset();
+        config_ = StorageConfig{};
+        auto encrypted = String::Factory();
+        storage_.reset(Factory::Storage(
+            running_,
+            client_.Crypto(),
+            *settings_,
+            folder_,
+            String(OT_STORAGE_PRIMARY_PLUGIN_FS),
+            String(""),
+            std::chrono::seconds(1),
+            encrypted,
+            config_));
+
+        ASSERT_TRUE(storage_);
+
+        storage_->start();
+        // Loads the nym
+        storage_->ThreadList(nym_, false);
+    }
+
+    void verify(const int count) const
+    {
+        const auto loaded = items();
+
+        ASSERT_EQ(count, loaded.size());
+
+        for (int i = 0; i < count; ++i) { EXPECT_EQ(item(i), loaded.at(i)); }
+
+        const auto listed = storage_->PaymentWorkflowsByAccount(
+            nym_,
+            account_,
+            proto::PAYMENTWORKFLOWTYPE_OUTGOINGCHEQUE,
+            proto::PAYMENTWORKFLOWSTATE_UNSENT);
+
+        ASSERT_EQ(workflows_.size(), listed.size());
+
+        for (const auto& id : workflows_) {
+            std::shared_ptr<proto::PaymentWorkflow> workflow;
+
+            EXPECT_TRUE(storage_->Load(nym_, id, workflow));
+        }
+    }
+
+    Test_StorageGC()
+        : client_(OT::App().StartClient(
+              {{OPENTXS_ARG_STORAGE_PLUGIN, {OT_STORAGE_PRIMARY_PLUGIN_MEMDB}}},
+              0))
+        , folder_((boost::filesystem::temp_directory_path() /
+                   boost::filesystem::unique_path())
+                      .string())
+        , nym_(Identifier::Random()->str())
+        , thread_(Identifier::Random()->str())
+        , account_(Identifier::Random()->str())
+        , unit_(Identifier::Random()->str())
+        , running_(Flag::Factory(true))
+        , settings_()
+        , config_()
+        , storage_()
+        , workflows_()
+    {
+        boost::filesystem::create_directories(folder_);
+        settings_.reset(
+            Factory::Settings(String((folder_ + "/storage.cfg").c_str())));
+        reopen();
+        storage_->CreateThread(nym_, thread_, {thread_});
+    }
+
+    ~Test_StorageGC()
+    {
+        storage_.reset();
+        settings_.reset();
+        boost::system::error_code ec{};
+        boost::filesystem::remove_all(folder_, ec);
+    }
+};
+}  // namespace
+
+TEST_F(Test_StorageGC, sweep_after_chunked_writes)
+{
+    for (int i = 0; i < object_count; ++i) {
+        add(i);
+        add_workflow();
+    }
+
+    // Every object is in the cache when the collection starts
+    verify(object_count);
+    const auto before = files();
+    collect();
+
+    // Each write replaced the indices above it, so most files were garbage
+    EXPECT_LT(files(), before);
+    verify(object_count);
+
+    // The chunks are still linked correctly after more writes
+    add(object_count);
+    add_workflow();
+    reopen();
+    verify(object_count + 1);
+}
+
+TEST_F(Test_StorageGC, sweep_during_batch)
+{
+    for (int i = 0; i < object_count; ++i) { add(i); }
+
+    // A collection is not started while a batch is open
+    storage_->StartBatch();
+    add(object_count);
+    add_workflow();
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    storage_->RunGC();
+    add(object_count + 1);
+    ASSERT_TRUE(storage_->CommitBatch());
+    reopen();
+    verify(object_count + 2);
+
+    // A batch may open once the collection has started
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    storage_->RunGC();
+    storage_->StartBatch();
+
+    for (int i = object_count + 2; i < object_count + 20; ++i) {
+        add(i);
+        add_workflow();
+    }
+
+    ASSERT_TRUE(storage_->CommitBatch());
+    reopen();
+    verify(object_count + 20);
+}
+
+TEST_F(Test_StorageGC, pending_objects_survive_sweep)
+{
+    auto bucket = Flag::Factory(false);
+    const StorageConfig config{};
+    auto multiplex = open_multiplex(bucket, config);
+
+    ASSERT_TRUE(multiplex);
+
+    std::string live{};
+    std::string garbage{};
+    std::string rewritten{};
+    std::string added{};
+    std::string committed{};
+    ASSERT_TRUE(multiplex->Store(true, "live", live));
+    ASSERT_TRUE(multiplex->Store(true, "garbage", garbage));
+    ASSERT_TRUE(multiplex->Store(true, "rewritten", rewritten));
+
+    multiplex->BeginCollection();
+    // Walking the tree marks the live object
+    ASSERT_TRUE(multiplex->Migrate(live, *multiplex));
+
+    // Objects committed during a collection are marked when they are written
+    multiplex->StartBatch();
+    ASSERT_TRUE(multiplex->Store(true, "committed", committed));
+    ASSERT_TRUE(multiplex->CommitBatch());
+
+    // Objects still pending at the sweep are not in the primary plugin yet
+    multiplex->StartBatch();
+    ASSERT_TRUE(multiplex->Store(true, "rewritten", rewritten));
+    ASSERT_TRUE(multiplex->Store(true, "added", added));
+
+    ASSERT_TRUE(multiplex->FinishCollection(true));
+    EXPECT_TRUE(in_primary(*multiplex, live));
+    EXPECT_FALSE(in_primary(*multiplex, garbage));
+    EXPECT_TRUE(in_primary(*multiplex, committed));
+
+    std::string loaded{};
+
+    EXPECT_TRUE(multiplex->Load(rewritten, false, loaded));
+    EXPECT_EQ("rewritten", loaded);
+    EXPECT_TRUE(multiplex->Load(added, false, loaded));
+    EXPECT_EQ("added", loaded);
+
+    ASSERT_TRUE(multiplex->CommitBatch());
+    EXPECT_TRUE(in_primary(*multiplex, rewritten));
+    EXPECT_TRUE(in_primary(*multiplex, added));
+}
+#endif
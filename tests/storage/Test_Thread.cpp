@@ -0,0 +1,203 @@
+// Copyright (c) 2018 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "opentxs/opentxs.hpp"
+
+#include "api/storage/StorageInternal.hpp"
+#include "storage/StorageConfig.hpp"
+#include "Internal.hpp"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+#if OT_STORAGE_FS
+namespace
+{
+// Two full chunks of older items plus the newest items in the thread index
+const int item_count{250};
+
+class Test_Thread : public ::testing::Test
+{
+public:
+    const opentxs::api::client::Manager& client_;
+    const std::string folder_;
+    const std::string nym_;
+    const std::string thread_;
+    OTFlag running_;
+    std::unique_ptr<api::Settings> settings_;
+    StorageConfig config_;
+    std::unique_ptr<api::storage::StorageInternal> storage_;
+
+    static std::string item(const int i)
+    {
+        char id[16]{};
+        std::snprintf(id, sizeof(id), "item-%03d", i);
+
+        return id;
+    }
+
+    void add(const int i)
+    {
+        ASSERT_TRUE(storage_->Store(
+            nym_,
+            thread_,
+            item(i),
+            i,
+            "",
+            "",
+            StorageBox::INCOMINGCHEQUE));
+    }
+
+    std::vector<std::string> items(const std::size_t count = 0) const
+    {
+        std::shared_ptr<proto::StorageThread> thread;
+        std::vector<std::string> output{};
+
+        if (false == storage_->Load(nym_, thread_, count, thread)) {
+            return output;
+        }
+
+        for (const auto& it : thread->item()) { output.emplace_back(it.id()); }
+
+        return output;
+    }
+
+    // Every item is written and then read back by a new storage instance
+    void reopen()
+    {
+        storage_.reset();
+        config_ = StorageConfig{};
+        auto encrypted = String::Factory();
+        storage_.reset(Factory::Storage(
+            running_,
+            client_.Crypto(),
+            *settings_,
+            folder_,
+            String(OT_STORAGE_PRIMARY_PLUGIN_FS),
+            String(""),
+            std::chrono::seconds(0),
+            encrypted,
+            config_));
+
+        ASSERT_TRUE(storage_);
+
+        storage_->start();
+    }
+
+    Test_Thread()
+        : client_(OT::App().StartClient(
+              {{OPENTXS_ARG_STORAGE_PLUGIN, {OT_STORAGE_PRIMARY_PLUGIN_MEMDB}}},
+              0))
+        , folder_((boost::filesystem::temp_directory_path() /
+                   boost::filesystem::unique_path())
+                      .string())
+        , nym_(Identifier::Random()->str())
+        , thread_(Identifier::Random()->str())
+        , running_(Flag::Factory(true))
+        , settings_()
+        , config_()
+        , storage_()
+    {
+        boost::filesystem::create_directories(folder_);
+        settings_.reset(
+            Factory::Settings(String((folder_ + "/storage.cfg").c_str())));
+        reopen();
+        storage_->CreateThread(nym_, thread_, {thread_});
+    }
+
+    ~Test_Thread()
+    {
+        storage_.reset();
+        settings_.reset();
+        boost::system::error_code ec{};
+        boost::filesystem::remove_all(folder_, ec);
+    }
+};
+}  // namespace
+
+TEST_F(Test_Thread, chunk_rollover)
+{
+    for (int i = 0; i < item_count; ++i) { add(i); }
+
+    const auto loaded = items();
+
+    ASSERT_EQ(item_count, loaded.size());
+
+    for (int i = 0; i < item_count; ++i) { EXPECT_EQ(item(i), loaded.at(i)); }
+
+    EXPECT_EQ(item_count, storage_->UnreadCount(nym_, thread_));
+}
+
+TEST_F(Test_Thread, reload)
+{
+    for (int i = 0; i < item_count; ++i) { add(i); }
+
+    reopen();
+
+    // The newest items are served before the older chunks are needed
+    const auto recent = items(10);
+
+    ASSERT_EQ(10, recent.size());
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(item(item_count - 10 + i), recent.at(i));
+    }
+
+    // Reaching into the chunks loads them
+    const auto older = items(120);
+
+    ASSERT_EQ(120, older.size());
+    EXPECT_EQ(item(item_count - 120), older.front());
+
+    const auto loaded = items();
+
+    ASSERT_EQ(item_count, loaded.size());
+
+    for (int i = 0; i < item_count; ++i) { EXPECT_EQ(item(i), loaded.at(i)); }
+
+    // Appending to a reloaded thread keeps the history
+    add(item_count);
+    reopen();
+
+    EXPECT_EQ(item_count + 1, items().size());
+    EXPECT_EQ(item_count + 1, storage_->UnreadCount(nym_, thread_));
+}
+
+TEST_F(Test_Thread, reordering)
+{
+    for (int i = 0; i < item_count; ++i) { add(i); }
+
+    reopen();
+
+    // Adding an existing item again moves it to the end of the thread, which
+    // rewrites every chunk from the one which held it
+    add(5);
+    ASSERT_TRUE(storage_->SetReadState(nym_, thread_, item(150), false));
+    reopen();
+
+    const auto loaded = items();
+
+    ASSERT_EQ(item_count, loaded.size());
+
+    std::vector<std::string> expected{};
+
+    for (int i = 0; i < item_count; ++i) {
+        if (5 != i) { expected.emplace_back(item(i)); }
+    }
+
+    expected.emplace_back(item(5));
+
+    EXPECT_EQ(expected, loaded);
+    EXPECT_EQ(item_count - 1, storage_->UnreadCount(nym_, thread_));
+}
+#endif